@@ -28,6 +28,7 @@
 #include "GateRandomEngine.hh"
 #include "GateApplicationMgr.hh"
 #include "GateSourceMgr.hh"
+#include "GateCheckpointManager.hh"
 #include "GateSignalHandler.hh"
 #include "GateDetectorConstruction.hh"
 #include "GatePhysicsList.hh"
@@ -40,6 +41,7 @@
 #include "GateClock.hh"
 #include "GateUIcontrolMessenger.hh"
 #ifdef G4ANALYSIS_USE_ROOT
+#include "TROOT.h"
 #include "TPluginManager.h"
 #include "GateHitFileReader.hh"
 #endif
@@ -318,13 +320,19 @@ int main( int argc, char* argv[] )
 
   if( aDigiMode == kofflineMode )
 #ifdef G4ANALYSIS_USE_ROOT
-    GateHitFileReader::GetInstance();
+    {
+      // The hit-file reader reads its tree in a prefetching thread while the output
+      // modules write their files: ROOT must be thread-safe before any file is opened
+      ROOT::EnableThreadSafety();
+      GateHitFileReader::GetInstance();
+    }
 #else
   abortIfRootNotFound();
 #endif
 
   GateSourceMgr* sourceMgr = GateSourceMgr::GetInstance();
   GateApplicationMgr* appMgr = GateApplicationMgr::GetInstance();
+  GateCheckpointManager::GetInstance();
   GateClock::GetInstance()->SetTime( 0 );
   GateUIcontrolMessenger* controlMessenger = new GateUIcontrolMessenger;
 
@@ -39,6 +39,7 @@ See LICENSE.md for further details
 
 class GateVActor;
 class GateMultiSensitiveDetector;
+class GateFilterManager;
 
 class GateActorManager
 {
@@ -115,6 +116,7 @@ protected:
   std::vector<GateVActor*> theListOfActorsEnabledForPostUserTrackingAction;
   std::vector<GateVActor*> theListOfActorsEnabledForUserSteppingAction;
   std::vector<GateVActor*> theListOfActorsEnabledForRecordEndOfAcquisition;
+  std::vector<GateFilterManager*> theListOfCompiledFilterManagers;
 
   GateActorManagerMessenger* pActorManagerMessenger;  //pointer to the Messenger
   G4int mCurrentEventId;
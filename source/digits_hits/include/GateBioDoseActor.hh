@@ -33,13 +33,26 @@ public:
 	};
 
 	using VoxelIndex = int;
-	using VoxelIndices = std::set<VoxelIndex>;
+	using VoxelIndices = std::vector<VoxelIndex>;
 
 	using Fragment = std::pair<int, double>;
 	using AlphaBetaInterpolTable = std::map<Fragment, AlphaBetaCoefficients>;
 
 	using EnergyMaxForZ = std::map<int, double>;
 
+	// Flattened database for one Z: segment i covers energies up to
+	// energies[i], cellSegment gives the first candidate segment of each cell
+	// of a regular energy-per-nucleon grid so the lookup is O(1)
+	struct IonTable {
+		std::vector<double> energies;
+		std::vector<AlphaBetaCoefficients> coefficients;
+		std::vector<int> cellSegment;
+		double invCellWidth = 0;
+		double energyMax = 0;
+		int maxSegment = -1; // -1 when Z is not in the database
+	};
+	using IonTables = std::vector<IonTable>;
+
 public:
 	FCT_FOR_AUTO_CREATOR_ACTOR(GateBioDoseActor)
 
@@ -88,6 +101,8 @@ protected:
 
 	void updateData();
 	void buildDatabase();
+	void buildIonTables();
+	AlphaBetaCoefficients const* findCoefficients(int nZ, double kineticEnergyPerNucleon) const;
 	static Coefficients interpol(double x1, double x2, double y1, double y2);
 
 private:
@@ -109,17 +124,23 @@ private:
 	G4double _sobpWeight = 0;
 
 	AlphaBetaInterpolTable _alphaBetaInterpolTable;
+	IonTables _ionTables;
 
+	// Voxels touched during the current event (state 1: energy only,
+	// state 2: known ion), and voxels hit since the last reset
 	VoxelIndices _eventVoxelIndices;
+	std::vector<char> _eventVoxelState;
 	VoxelIndices _voxelIndices;
+	std::vector<char> _voxelHit;
 
 	// Images
 	GateImageWithStatistic _hitEventCountImage;
 
-	GateImageWithStatistic _eventEdepImage;
-	GateImageWithStatistic _eventDoseImage;
-	GateImageWithStatistic _eventAlphaImage;
-	GateImageWithStatistic _eventSqrtBetaImage;
+	// Per event accumulators, reset only where touched
+	std::vector<double> _eventEdep;
+	std::vector<double> _eventDose;
+	std::vector<double> _eventAlpha;
+	std::vector<double> _eventSqrtBeta;
 
 	GateImageWithStatistic _edepImage;
 	GateImageWithStatistic _doseImage;
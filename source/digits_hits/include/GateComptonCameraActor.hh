@@ -25,6 +25,7 @@
 
 #include "GateCCRootDefs.hh"
 #include "GateTreeFileManager.hh"
+#include "GateComptonCameraConeStream.hh"
 
 #include  <iomanip>
 
@@ -76,6 +77,11 @@ public:
   void SetSaveCoincidencesTreeFlag( bool b ){  mSaveCoincidencesTreeFlag= b; }
   void SetSaveCoincidenceChainsTreeFlag( bool b ){  mSaveCoincidenceChainsTreeFlag= b; }
   void SetSaveEventInfoTreeFlag( bool b ){  mSaveEventInfoTreeFlag= b; }
+  void SetSaveConesFlag( bool b ){  mSaveConesFlag= b; }
+  void SetConesCoincidenceName(G4String name){mConesCoincidenceName=name;}
+  void SetBackProjectionFlag( bool b ){  mBackProjectionFlag= b; }
+  void SetBackProjectionFileName(G4String name){mBackProjectionFileName=name;}
+  GateComptonCameraConeStream & GetConeStream() { return mConeStream; }
 
   void SetNumberOfDiffScattererLayers( int numS){mNumberDiffScattLayers=numS;}
   void SetNumberOfTotScattererLayers( int numS){mNumberTotScattLayers=numS;}
@@ -220,6 +226,8 @@ protected:
 
   void readPulses(GatePulseList* pPulseList);
   void processPulsesIntoSinglesTree();
+  //Cone built from the sequence of singles of a coincidence, as GateSequenceCoincidenceTreeReader does offline
+  void processCoincidenceIntoCone(GateCoincidencePulse* coincPulse);
 
 
   //messenger
@@ -228,6 +236,11 @@ protected:
   bool mSaveCoincidencesTreeFlag;
   bool mSaveCoincidenceChainsTreeFlag;
   bool mSaveEventInfoTreeFlag;
+  bool mSaveConesFlag;
+  bool mBackProjectionFlag;
+  G4String mConesCoincidenceName;
+  G4String mBackProjectionFileName;
+  GateComptonCameraConeStream mConeStream;
 
   int mNumberDiffScattLayers;
   int mNumberTotScattLayers;
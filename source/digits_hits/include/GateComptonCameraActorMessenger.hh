@@ -18,6 +18,8 @@
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWith3Vector.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
 
 #include "GateActorMessenger.hh"
 
@@ -51,6 +53,16 @@ protected:
   G4UIcmdWithABool          * pSaveCoincidenceChainsTree;
   G4UIcmdWithABool          * pSaveEventInfoTree;
 
+  //Cones built during the run and their back-projection
+  G4UIcmdWithABool          * pSaveConesCmd;
+  G4UIcmdWithAString        * pConesCoincidenceNameCmd;
+  G4UIcmdWithABool          * pEnableBackProjectionCmd;
+  G4UIcmdWithAString        * pBackProjectionFileNameCmd;
+  G4UIcmdWith3Vector        * pBackProjectionResolutionCmd;
+  G4UIcmdWith3VectorAndUnit * pBackProjectionVoxelSizeCmd;
+  G4UIcmdWith3VectorAndUnit * pBackProjectionPositionCmd;
+  G4UIcmdWithADoubleAndUnit * pBackProjectionWidthCmd;
+  G4UIcmdWithAnInteger      * pBackProjectionNumberOfThreadsCmd;
 
   //Include flags for variables it affects to all the trees (hits, singles, coincidences)
   //(only checked singles variables)
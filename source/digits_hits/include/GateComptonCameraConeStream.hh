@@ -0,0 +1,100 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*!
+  \class  GateComptonCameraConeStream
+  \brief  In-run output of the Compton cones built from the reconstructed sequences
+
+  Cones are packed into fixed size binary records (see Record) and handed to
+  background threads (GateBlockWriter):
+   - the first one writes them to a .cones file: a Header followed by the records,
+   - the second one, when enabled, accumulates a simple back-projection of the
+     cones into an image (voxels close to the surface of each cone are
+     incremented), split between several threads along z.
+  The queues are bounded (GateBlockWriter): when the back-projection is slower
+  than the production of cones, Add waits, and the event loop with it.
+*/
+
+#ifndef GATECOMPTONCAMERACONESTREAM_HH
+#define GATECOMPTONCAMERACONESTREAM_HH
+
+#include <cstdint>
+#include <cstdio>
+
+#include "G4ThreeVector.hh"
+#include "GateComptonCameraCones.hh"
+#include "GateBlockWriter.hh"
+#include "GateImage.hh"
+
+class GateComptonCameraConeStream
+{
+public:
+
+  struct Header
+  {
+    char magic[8];              // "GATECONE"
+    std::uint32_t version;
+    std::uint32_t recordSize;
+  };
+
+  // Energies in MeV, positions in mm (world frame)
+  struct Record
+  {
+    std::int32_t runID;
+    std::int32_t eventID;
+    std::int32_t coincID;
+    float energy1;              // first interaction
+    float energy2;              // second interaction
+    float energyR;              // all the energy except energy1
+    float position1[3];
+    float position2[3];
+    float position3[3];         // zero with less than 3 singles
+    std::int16_t nSingles;
+    std::int16_t trueFlag;      // all singles from the same event
+  };
+
+  GateComptonCameraConeStream();
+  ~GateComptonCameraConeStream();
+
+  void SetBackProjectionResolution(const G4ThreeVector & r) { mResolution = r; }
+  void SetBackProjectionVoxelSize(const G4ThreeVector & v) { mVoxelSize = v; }
+  void SetBackProjectionPosition(const G4ThreeVector & p) { mPosition = p; }
+  // Distance to the cone surface below which a voxel is incremented
+  // (default: half of the voxel diagonal)
+  void SetBackProjectionWidth(G4double w) { mWidth = w; }
+  void SetNumberOfThreads(unsigned int n) { mNumberOfThreads = n; }
+
+  // An empty file name disables the corresponding output
+  void Open(const G4String & conesFileName, const G4String & imageFileName);
+  void Add(const GateComptonCameraCones & cone, G4int runID, G4int eventID, G4int coincID);
+  // Waits for the background threads and writes the image
+  void Close();
+
+  G4bool IsOpen() const { return mIsOpen; }
+  long GetNumberOfCones() const { return mNumberOfCones; }
+
+protected:
+  void BackProject(const std::vector<char> & block);
+  void BackProjectPlanes(const std::vector<char> & block, int firstPlane, int lastPlane);
+
+  G4bool mIsOpen;
+  long mNumberOfCones;
+  FILE * pFile;
+  GateBlockWriter mFileWriter;
+
+  G4String mImageFileName;
+  GateImage mImage;
+  G4ThreeVector mResolution;
+  G4ThreeVector mVoxelSize;
+  G4ThreeVector mPosition;
+  G4double mWidth;
+  unsigned int mNumberOfThreads;
+  GateBlockWriter mBackProjectionWriter;
+};
+
+#endif /* end #define GATECOMPTONCAMERACONESTREAM_HH */
@@ -33,7 +33,7 @@ public:
      inline G4bool GetTrueFlag() const                { return m_IsTrueCoind; }
 
      inline void  SetNumSingles(const G4int& num)     { m_nSingles = num; }
-      inline G4bool GetNumSingles() const                { return m_nSingles; }
+      inline G4int GetNumSingles() const                { return m_nSingles; }
 
 private:
   G4double m_E1;            // energy deposition of the first interaction
@@ -142,6 +142,13 @@ public:
       inline G4int GetNSeptal() const { return m_nSeptal; }
       inline void SetNSeptal(G4int septalNb) { m_nSeptal = septalNb; }
 
+      //! Statistical weight of the pulse (weight of its hits, 1 without variance reduction)
+      inline void     SetWeight(G4double w)    { m_weight = w; }
+      inline G4double GetWeight() const        { return m_weight; }
+      //! Weight of the merge of this pulse and 'right': energy weighted mean of the weights
+      //! (must be called before the energies are summed)
+      void MergeWeight(const GateDigi* right);
+
 
 
 
@@ -231,6 +238,7 @@ public:
   	  G4bool m_optical;               //!< Is the pulse generated by optical photons
   #endif
   G4int m_nSeptal;				  //!< HDS : record septal penetration
+  G4double m_weight;              //!< statistical weight of the pulse
 
   // AE : Added for IdealComptonPhot adder which take into account several Comptons in the same volume
   //These variables no sense for a general pulse but I need them to  process idealy the hits. or create another structure
@@ -16,6 +16,9 @@
   - DoseToWater option added by Loïc Grevillot
   - Dose calculation in inhomogeneous volume added by Thomas Deschler (thomas.deschler@iphc.cnrs.fr)
   - Dose in Regions (Maxime Chauvin, David Sarrut)
+  - Region of interest: a box of the image is also scored with a finer grid,
+    in separate images (-ROI suffix). The whole image keeps the coarse
+    resolution and still includes the deposits of the region of interest.
 */
 
 
@@ -83,10 +86,15 @@ public:
   void SetDoseByRegionsInputFilename(std::string f);
   void SetDoseByRegionsOutputFilename(std::string f);
   void AddRegion(std::string str);
+  //Region of interest
+  void SetROISize(G4ThreeVector v) { mROIHalfSize = v/2.0; mIsROIEnabled = true; }
+  void SetROIPosition(G4ThreeVector v) { mROIPosition = v; }
+  void SetROIVoxelSize(G4ThreeVector v) { mROIVoxelSize = v; }
 
   virtual void BeginOfRunAction(const G4Run*r);
   virtual void BeginOfEventAction(const G4Event * event);
 
+  virtual void UserSteppingAction(const GateVVolume * v, const G4Step* step);
   virtual void UserSteppingActionInVoxel(const int index, const G4Step* step);
   virtual void UserPreTrackActionInVoxel(const int /*index*/, const G4Track* track);
   virtual void UserPostTrackActionInVoxel(const int /*index*/, const G4Track* /*t*/) {}
@@ -94,6 +102,9 @@ public:
   //  Saves the data collected to the file
   virtual void SaveData();
   virtual void ResetData();
+  virtual G4bool SaveCheckpoint(GateCheckpointWriter & w);
+  virtual void LoadCheckpoint(GateCheckpointReader & r);
+  virtual G4bool MergeCheckpoint(GateCheckpointReader & r);
 
   // Scorer related
   virtual void Initialize(G4HCofThisEvent*){}
@@ -101,6 +112,7 @@ public:
 
 protected:
   GateDoseActor(G4String name, G4int depth=0);
+  void MergeNumberOfHits(GateCheckpointReader & r, const G4String & key, GateImageInt & image);
   GateDoseActorMessenger* pMessenger;
   GateVoxelizedMass mVoxelizedMass;
 
@@ -171,6 +183,21 @@ protected:
   GateRegionDoseStat::IdToLabelsMapType mMapIdToLabels;
   G4String mDoseByRegionsInputFilename;
   G4String mDoseByRegionsOutputFilename;
+  //Region of interest
+  bool mIsROIEnabled;
+  G4ThreeVector mROIHalfSize;
+  G4ThreeVector mROIPosition;
+  G4ThreeVector mROIVoxelSize;
+  GateImage mROIImage; // geometry only, not allocated
+  int mROIIndex; // fine index of the current step, -1 if outside
+  GateImageWithStatistic mROIEdepImage;
+  GateImageWithStatistic mROIDoseImage;
+  GateImageWithStatistic mROIDoseToWaterImage;
+  GateImageWithStatistic mROIDoseToOtherMaterialImage;
+  GateImageInt mROINumberOfHitsImage;
+  GateImageInt mROILastHitEventImage;
+  G4String mROINbOfHitsFilename;
+  void ConstructROI();
 
   G4String mDoseAlgorithmType;
   G4String mImportMassImage;
@@ -71,6 +71,10 @@ protected:
   G4UIcmdWithAString * pDoseRegionInputCmd;
   G4UIcmdWithAString * pDoseRegionOutputCmd;
   G4UIcmdWithAString * pDoseRegionAddRegionCmd;
+  //Region of interest
+  G4UIcmdWith3VectorAndUnit * pROISizeCmd;
+  G4UIcmdWith3VectorAndUnit * pROIPositionCmd;
+  G4UIcmdWith3VectorAndUnit * pROIVoxelSizeCmd;
 };
 
 #endif /* end #define GATEDOSEACTORMESSENGER_HH*/
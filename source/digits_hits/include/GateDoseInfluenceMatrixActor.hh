@@ -0,0 +1,78 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*!
+  \class  GateDoseInfluenceMatrixActor
+  \brief  Dose of each spot (or layer) of a GateSourceTPSPencilBeam plan in each voxel
+
+  The deposits of an event are given to the spot that generated its primary. Each
+  spot only keeps the voxels it reaches (sparse columns), and the whole plan is
+  written at the end as a voxel x spot matrix in compressed sparse row (CSR) form,
+  after removing the values below the thresholds.
+*/
+
+#ifndef GATEDOSEINFLUENCEMATRIXACTOR_HH
+#define GATEDOSEINFLUENCEMATRIXACTOR_HH
+
+#include <unordered_map>
+#include <vector>
+
+#include "GateConfiguration.h"
+#include "GateVImageActor.hh"
+#include "GateActorMessenger.hh"
+#include "GateDoseInfluenceMatrixActorMessenger.hh"
+#include "GateSourceMgr.hh"
+
+
+//-----------------------------------------------------------------------------
+class GateDoseInfluenceMatrixActor: public GateVImageActor
+{
+public:
+  virtual ~GateDoseInfluenceMatrixActor();
+
+  FCT_FOR_AUTO_CREATOR_ACTOR(GateDoseInfluenceMatrixActor)
+
+  virtual void Construct();
+  virtual void UserPreTrackActionInVoxel(const int index, const G4Track* t);
+  virtual void UserPostTrackActionInVoxel(const int index, const G4Track* t);
+  virtual void UserSteppingActionInVoxel(const int index, const G4Step* step);
+  virtual void BeginOfEventAction(const G4Event * e);
+
+  virtual void SaveData();
+  virtual void ResetData();
+
+  void SetSpotIDFromSource(G4String nameOfSource){mSourceName = nameOfSource; mSpotOrNot=true;}
+  void SetLayerIDFromSource(G4String nameOfSource){mSourceName = nameOfSource; mSpotOrNot=false;}
+  // Values below a fraction of the maximum of their spot are not written
+  void SetRelativeThreshold(G4double t){mRelativeThreshold = t;}
+  // Values below this dose are not written
+  void SetAbsoluteThreshold(G4double t){mAbsoluteThreshold = t;}
+
+protected:
+  GateDoseInfluenceMatrixActor(G4String name, G4int depth=0);
+  GateDoseInfluenceMatrixActorMessenger * pMessenger;
+
+  GateSourceTPSPencilBeam * pTPSSource;
+  G4String mSourceName;
+  G4bool mSpotOrNot;
+  G4bool mIsInitialized;
+  G4double mRelativeThreshold;
+  G4double mAbsoluteThreshold;
+
+  // column of the current event (spot or layer ID), -1 if none
+  G4int mCurrentColumn;
+  // dose (Gy) per voxel index, one map per column
+  std::vector<std::unordered_map<G4int, G4double> > mColumns;
+  // number of primaries generated for each column
+  std::vector<G4long> mNumberOfPrimaries;
+};
+//-----------------------------------------------------------------------------
+
+MAKE_AUTO_CREATOR_ACTOR(DoseInfluenceMatrixActor,GateDoseInfluenceMatrixActor)
+
+#endif // end GATEDOSEINFLUENCEMATRIXACTOR_HH
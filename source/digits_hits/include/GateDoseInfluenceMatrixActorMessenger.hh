@@ -0,0 +1,38 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#ifndef GATEDOSEINFLUENCEMATRIXACTORMESSENGER_HH
+#define GATEDOSEINFLUENCEMATRIXACTORMESSENGER_HH
+
+#include "GateConfiguration.h"
+#include "GateImageActorMessenger.hh"
+
+class GateDoseInfluenceMatrixActor;
+class G4UIcmdWithADouble;
+
+//-----------------------------------------------------------------------------
+class GateDoseInfluenceMatrixActorMessenger: public GateImageActorMessenger
+{
+public:
+
+  GateDoseInfluenceMatrixActorMessenger(GateDoseInfluenceMatrixActor*);
+  ~GateDoseInfluenceMatrixActorMessenger();
+  void SetNewValue(G4UIcommand*, G4String);
+
+protected:
+  void BuildCommands(G4String base);
+  GateDoseInfluenceMatrixActor* pDoseInfluenceMatrixActor;
+
+  G4UIcmdWithAString* pSpotIDFromSourceCmd;
+  G4UIcmdWithAString* pLayerIDFromSourceCmd;
+  G4UIcmdWithADouble* pRelativeThresholdCmd;
+  G4UIcmdWithADouble* pAbsoluteThresholdCmd;
+};
+//-----------------------------------------------------------------------------
+
+#endif // End GATEDOSEINFLUENCEMATRIXACTORMESSENGER_HH
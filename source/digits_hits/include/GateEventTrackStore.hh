@@ -0,0 +1,95 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateEventTrackStore
+  \brief  Compact per-event log of the tracked particles (track/parent ID,
+          PDG code, charge, vertex) in tracking order, indexed by track ID.
+          It replaces the G4TrajectoryContainer for the ancestry lookups of
+          GateTrajectoryNavigator: G4 trajectories are then only stored when
+          needed (visualisation, detector mode, or on user request).
+*/
+
+#ifndef GATEEVENTTRACKSTORE_HH
+#define GATEEVENTTRACKSTORE_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class G4Track;
+
+//-----------------------------------------------------------------------------
+struct GateTrackRecord
+{
+  G4int         trackID;
+  G4int         parentID;
+  G4int         PDGEncoding;
+  G4double      charge;
+  G4ThreeVector vertexPosition;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+class GateEventTrackStore
+{
+public:
+  static GateEventTrackStore* GetInstance();
+
+  // Begin of event: forget the previous tracks (memory is kept)
+  void Clear();
+  // End of tracking of a track
+  void Record(const G4Track* track);
+
+  size_t GetNumberOfTracks() const { return mTracks.size(); }
+  G4bool IsEmpty() const { return mTracks.empty(); }
+  // i-th tracked particle of the event, in tracking order
+  const GateTrackRecord & GetTrack(size_t i) const { return mTracks[i]; }
+  // Index (tracking order) of the track, -1 if not recorded
+  inline G4int FindTrackIndex(G4int trackID) const;
+  // Parent ID of the track, -1 if not recorded
+  inline G4int GetParentID(G4int trackID) const;
+
+  // User request to store the G4 trajectories in all cases
+  void SetStoreTrajectoriesFlag(G4bool b) { mStoreTrajectoriesFlag = b; }
+  G4bool GetStoreTrajectoriesFlag() const { return mStoreTrajectoriesFlag; }
+  // Set at the beginning of each event, read for each track
+  void SetG4TrajectoriesNeeded(G4bool b) { mG4TrajectoriesNeeded = b; }
+  G4bool GetG4TrajectoriesNeeded() const { return mG4TrajectoriesNeeded; }
+
+protected:
+  GateEventTrackStore();
+  static GateEventTrackStore* theInstance;
+
+  std::vector<GateTrackRecord> mTracks;
+  std::vector<G4int> mIndexOfTrackID;
+  G4bool mStoreTrajectoriesFlag;
+  G4bool mG4TrajectoriesNeeded;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline G4int GateEventTrackStore::FindTrackIndex(G4int trackID) const
+{
+  if (trackID < 0 || trackID >= (G4int)mIndexOfTrackID.size()) return -1;
+  return mIndexOfTrackID[trackID];
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline G4int GateEventTrackStore::GetParentID(G4int trackID) const
+{
+  G4int index = FindTrackIndex(trackID);
+  return (index < 0) ? -1 : mTracks[index].parentID;
+}
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATEEVENTTRACKSTORE_HH */
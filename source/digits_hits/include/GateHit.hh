@@ -88,6 +88,7 @@ public:
   G4double m_scannerRotAngle; // Rotation angle of the scanner
   GateOutputVolumeID m_outputVolumeID;
   G4int m_systemID;           // system ID in for the multi-system approach
+  G4double m_weight;          // statistical weight of the track (variance reduction)
 
   // To use with GateROOTBasicOutput classes
   G4ThreeVector pos;  // position
@@ -201,6 +202,9 @@ public:
       inline void  SetSystemID(const G4int systemID) { m_systemID = systemID; }
       inline G4int GetSystemID() const { return m_systemID; }
 
+      inline void     SetWeight(G4double w)    { m_weight = w; }
+      inline G4double GetWeight() const        { return m_weight; }
+
       inline G4bool GoodForAnalysis() const
       	  { return ( (m_process != "Transportation") || (m_edep!=0.) ); }
 
@@ -15,7 +15,8 @@ See LICENSE.md for further details
 #ifdef G4ANALYSIS_USE_ROOT
 
 #include "globals.hh"
-#include <queue>
+#include <future>
+#include <vector>
 
 #include "G4Event.hh"
 
@@ -41,6 +42,12 @@ class GateHitFileReaderMessenger;
       In this mode, the GateHitFileReader will read hits data from a ROOT simulation-output file.
       Based on these data, it will recreate hit-collections that can be fed to the digitizer to
       reprocess the hits.
+
+    - The hit-tree is read by blocks of entries (through the ROOT tree cache, one request per
+      cluster of baskets), and the next block is read by a prefetching thread while the
+      current one is replayed. Only the prefetching thread uses the file and the tree between
+      PrepareAcquisition() and TerminateAfterAcquisition(); ROOT thread safety is enabled in
+      main(), before any file is opened.
 */
 class GateHitFileReader : public GateClockDependent
 {
@@ -84,6 +91,11 @@ public:
   //! Set the hit file name
   void   SetFileName(const G4String aName)   { m_fileName = aName; };
 
+  //! Set the number of entries read at once by the prefetching thread
+  void   SetBlockSize(G4int n)               { m_blockSize = n; };
+  //! Set the size (in MB) of the ROOT cache of the hit tree
+  void   SetCacheSize(G4int n)               { m_cacheSize = n; };
+
   /*! \brief Overload of the base-class virtual method to print-out a description of the reader
 
       \param indent: the print-out indentation (cosmetic parameter)
@@ -93,9 +105,12 @@ public:
 
 protected:
 
-  //! Reads a set of hit data from the hit-tree, and stores them into the root-hit buffer
+  //! Moves to the next set of hit data (m_currentHit), taking the prefetched block when the current one is over
   void LoadHitData();
 
+  //! Reads the next block of entries of the hit-tree (run by the prefetching thread)
+  void ReadBlock(std::vector<GateRootHitBuffer>* block);
+
 protected:
 
   G4String    	      m_fileName;     	      //!< Name of the input hit-file
@@ -104,14 +119,24 @@ protected:
   TTree*              m_hitTree;       	      //!< the input hit tree
   Stat_t       	      m_entries;      	      //!< Number of entries in the tree
   G4int       	      m_currentEntry; 	      //!< Current entry in the tree
+  G4int       	      m_readEntry;    	      //!< Next entry to be read by the prefetching thread
+  G4bool      	      m_readError;    	      //!< Set by the prefetching thread if an entry could not be read
+  G4int       	      m_blockSize;    	      //!< Number of entries read at once
+  G4int       	      m_cacheSize;    	      //!< Size of the ROOT cache of the hit tree (MB)
 
 
   GateRootHitBuffer        m_hitBuffer;       	      //!< Buffer to store the data read from the hit-tree
       	      	      	      	      	      //!< Each field of this structure is a buffer for one of the branches of the tree
-					      //!< The hit-data are loaded into this buffer by LoadHitData()
-					      //!< They are then transformed into a crystal-hit by PrepareNextEvent()
+					      //!< It is only used by the prefetching thread, which copies it into m_nextBlock
+
+  std::vector<GateRootHitBuffer> m_currentBlock;  //!< Block of hit data being replayed
+  std::vector<GateRootHitBuffer> m_nextBlock;     //!< Block of hit data being read by the prefetching thread
+  size_t                   m_blockPosition;   //!< Position of the current hit data in m_currentBlock
+  GateRootHitBuffer*       m_currentHit;      //!< Current hit data: transformed into a crystal-hit by PrepareNextEvent()
+  GateRootHitBuffer        m_endOfFileBuffer; //!< Current hit data once the end of the file is reached (runID=eventID=-1)
+  std::future<void>        m_prefetch;        //!< Reading of m_nextBlock
 
-  std::queue<GateHit*> m_hitQueue;   //!< Queue of waiting hits for the current event
+  std::vector<GateHit*> m_hitQueue;  //!< Waiting hits for the current event
       	      	      	      	      	      //!< For each event, the queue is filled (from data read out of the hit-file) at
 					      //!< the beginning of each event by PrepareNextEvent(). It is emptied into
 					      //!< a crystal-hit collection at the end of each event by PrepareEndOfEvent()
@@ -17,6 +17,7 @@ See LICENSE.md for further details
 #include "GateClockDependentMessenger.hh"
 
 class GateHitFileReader;
+class G4UIcmdWithAnInteger;
 
 
 /*! \class GateHitFileReaderMessenger
@@ -29,7 +30,7 @@ class GateHitFileReader;
       of a Gate UI directory for a Gate object, plus the UI command 'describe'
 
     - In addition, it proposes and manages commands specific to the hit-file reader:
-      definition of the name of the hit file
+      definition of the name of the hit file, of the block size and of the tree cache size
 
 */
 class GateHitFileReaderMessenger: public GateClockDependentMessenger
@@ -46,6 +47,8 @@ class GateHitFileReaderMessenger: public GateClockDependentMessenger
 
   protected:
     G4UIcmdWithAString*      SetFileNameCmd;
+    G4UIcmdWithAnInteger*    SetBlockSizeCmd;
+    G4UIcmdWithAnInteger*    SetCacheSizeCmd;
 };
 
 //e #endif
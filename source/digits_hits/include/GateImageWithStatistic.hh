@@ -11,6 +11,14 @@ See LICENSE.md for further details
   \author thibault.frisson@creatis.insa-lyon.fr
           laurent.guigues@creatis.insa-lyon.fr
 	  david.sarrut@creatis.insa-lyon.fr
+
+  Precision of the accumulated images:
+  - double : double values, squared values and event values (default)
+  - float  : float for all images
+  - kahan  : float with a compensation term for the values and the squared
+             values (Kahan summation), float event values
+  - mixed  : double values and squared values, float event values
+  The scaled and uncertainty images are only allocated while saving.
 */
 
 
@@ -18,6 +26,7 @@ See LICENSE.md for further details
 #define GATEIMAGEWITHSTATISTIC_HH
 
 #include "GateImage.hh"
+#include "GateCheckpointFile.hh"
 
 //-----------------------------------------------------------------------------
 /// \brief
@@ -30,6 +39,11 @@ class GateImageWithStatistic
   GateImageWithStatistic();
   virtual ~GateImageWithStatistic();
 
+  enum PrecisionType { DoublePrecision, FloatPrecision, KahanPrecision, MixedPrecision };
+  static PrecisionType GetPrecisionFromName(G4String name);
+  void SetPrecision(PrecisionType p);
+  PrecisionType GetPrecision() const { return mPrecision; }
+
   // void SetLastHitEventImage(GateImage * lastHitEventImage) { mLastHitEventImage = lastHitEventImage; }
   void SetResolutionAndHalfSize(const G4ThreeVector & resolution, const G4ThreeVector & halfSize);
   void SetResolutionAndHalfSize(const G4ThreeVector & resolution, const G4ThreeVector & halfSize, const G4ThreeVector & position);
@@ -62,20 +76,42 @@ class GateImageWithStatistic
   virtual void UpdateSquaredImage();
   virtual void UpdateUncertaintyImage(int numberOfEvents);
 
-  GateVImage & GetValueImage() { return mValueImage; }
+  // GateImageDouble, or GateImageFloat with the float and kahan precisions:
+  // do not cast it, use it for the geometry and read the values with GetValue
+  GateVImage & GetValueImage();
   GateVImage & GetUncertaintyImage() { return mUncertaintyImage; }
 
   void SetOrigin(G4ThreeVector v);
   void SetOverWriteFilesFlag(bool b) { mOverWriteFilesFlag = b; }
   void SetTransformMatrix(const G4RotationMatrix & m);
 
+  // Accumulated values (value, squared and not yet squared last event values)
+  void SaveCheckpoint(GateCheckpointWriter & w, const G4String & key);
+  void LoadCheckpoint(GateCheckpointReader & r, const G4String & key);
+  // Forked mode: adds the values saved by another process with SaveCheckpoint
+  void MergeCheckpoint(GateCheckpointReader & r, const G4String & key);
+
   protected:
+  bool IsFloat() const { return mPrecision == FloatPrecision || mPrecision == KahanPrecision; }
+  void FoldCompensation();
+  void AddSquaredValue(const int index, double value);
+
+  PrecisionType mPrecision;
+  bool mIsAllocated;
+  // double and mixed
   GateImageDouble mValueImage;
   GateImageDouble mSquaredImage;
+  // double
   GateImageDouble mTempImage;
+  // float and kahan (values), float, kahan and mixed (event values)
+  GateImageFloat mFloatValueImage;
+  GateImageFloat mFloatSquaredImage;
+  GateImageFloat mFloatTempImage;
+  // kahan
+  GateImageFloat mValueCompensationImage;
+  GateImageFloat mSquaredCompensationImage;
+  // only allocated in SaveData
   GateImageDouble mUncertaintyImage;
-  GateImageDouble mScaledValueImage;
-  GateImageDouble mScaledSquaredImage;
   bool mOverWriteFilesFlag;
   bool mNormalizedToMax;
   bool mNormalizedToIntegral;
@@ -28,41 +28,77 @@ class GateKermaFactorHandler
     GateKermaFactorHandler();
     ~GateKermaFactorHandler() {};
 
-    void SetEnergy(double);
-    void SetCubicVolume(double);
-    void SetDistance(double);
-    void SetMaterial(const G4Material*);
     void SetKFExtrapolation(const bool _KFExtrapolation = true) {mKFExtrapolation = _KFExtrapolation;}
     void SetKFDA           (const bool _KFDA = true)            {mKFDA = _KFDA;}
     void SetKermaEquivalentFactor(const bool _KermaEquivalentFactor = true) {mKermaEquivalentFactor = _KermaEquivalentFactor;}
     void SetPhotonKermaEquivalentFactor(const bool _PhotonKermaEquivalentFactor = true) {mPhotonKermaEquivalentFactor = _PhotonKermaEquivalentFactor;}
 
-    double GetDose();
-    double GetDoseCorrected();
-    double GetDoseCorrectedTLE();
+    // Precompute kerma factor and mu_en/rho tables for every material of the
+    // G4 material table (call at BeginOfRun, once the options are set)
+    void BuildTables();
 
-    double GetFlux();
+    // Per step API: no state, the material is given by G4Material::GetIndex()
+    double GetKermaFactor(size_t materialIndex, double energy) const;
+    double GetMuEnOverRho(size_t materialIndex, double energy) const;
+    double GetPhotonFactor(size_t materialIndex) const;
+    // False if the material has no kerma/mu_en data (vacuum tables are used)
+    bool IsSupported(size_t materialIndex) const;
 
-    TGraph* GetKermaFactorGraph();
+    double GetDose(size_t materialIndex, double energy, double distance, double cubicVolume) const;
+    double GetDoseCorrected(size_t materialIndex, double energy, double distance, double cubicVolume) const;
+    double GetDoseCorrectedTLE(size_t materialIndex, double energy, double distance, double cubicVolume) const;
 
-  private:
-    double GetKermaFactor(double);
-    double GetPhotonFactor(const G4Material*);
-    double GetMuEnOverRho();
+    static double GetFlux(double distance, double cubicVolume);
+
+    TGraph* GetKermaFactorGraph(const G4Material*) const;
 
-    double m_energy;
-    double m_cubicVolume;
-    double m_distance;
-    double m_kerma_factor;
+  private:
+    //-----------------------------------------------------------------------------
+    // Piecewise linear table with a log-uniform grid of cells, each cell
+    // storing the first segment ending after the cell start, so that finding
+    // the segment of an energy is O(1)
+    class InterpolationTable
+    {
+      public:
+        void Build(const std::vector<double>& energies, const std::vector<double>& values, double unit);
+        // Returns i such as energies[i-1] <= e < energies[i], 0 below the
+        // table and size() above it (energies in MeV)
+        size_t FindSegment(double e) const;
+        double Interpolate(size_t i, double e) const;
+        size_t size() const { return mEnergies.size(); }
+        const std::vector<double>& GetEnergies() const { return mEnergies; }
+        const std::vector<double>& GetValues() const { return mValues; }
+
+      private:
+        std::vector<double> mEnergies;
+        std::vector<double> mValues;
+        std::vector<size_t> mCellSegment;
+        double mLogMin;
+        double mInvLogStep;
+    };
+
+    struct MaterialTables
+    {
+      bool built = false;
+      bool supported = false;
+      InterpolationTable kerma;
+      size_t kermaExtrapolationEntry = 0;
+      InterpolationTable muEn;
+      double muEnBelowTable = 0.;
+      double photonFactor = 0.;
+    };
+
+    bool SelectTables(const G4String& name,
+                      const std::vector<double>*& kfTable,
+                      const std::vector<double>*& MuEnTable) const;
+    double ComputePhotonFactor(const G4Material*) const;
+    const MaterialTables& GetTables(size_t materialIndex) const;
 
     bool mKFExtrapolation;
     bool mKFDA;
     bool mKermaEquivalentFactor;
     bool mPhotonKermaEquivalentFactor;
 
-    const G4Material* m_material;
-
-    std::vector<double> kfTable;
-    std::vector<double> MuEnTable;
+    std::vector<MaterialTables> mMaterialTables;
 };
 #endif
@@ -16,6 +16,7 @@ See LICENSE.md for further details
 #define GATEMERGEDVOLUMEACTOR_HH
 
 #include "GateVActor.hh"
+#include "G4AffineTransform.hh"
 class GateMergedVolumeActorMessenger;
 class GateActorMessenger;
 
@@ -33,6 +34,7 @@ class GateMergedVolumeActor : public GateVActor
     //-----------------------------------------------------------------------------
     // Constructs the sensor
     virtual void Construct();
+    virtual void BeginOfRunAction(const G4Run*);
     //virtual void PostUserTrackingAction(const G4Track*);
     //virtual void UserSteppingAction(const GateVVolume *, const G4Step*){}
     virtual void clear(){ ResetData(); }
@@ -42,6 +44,7 @@ class GateMergedVolumeActor : public GateVActor
     virtual void EndOfEvent(G4HCofThisEvent*){}
 
     void ListOfVolumesToMerge( G4String& );
+    void EnableBVH( G4bool b ) { mUseBVH = b; }
 
   protected:
     GateMergedVolumeActor(G4String name, G4int depth);
@@ -54,6 +57,27 @@ class GateMergedVolumeActor : public GateVActor
     std::vector<G4VSolid*>            mSolidVolToMerge;
     std::vector<G4VPhysicalVolume*>   mPhysicalVolToMerge;
     std::vector<G4LogicalVolume*>     mLogicalVolToMerge;
+
+    // World to volume transforms and bounding volume hierarchy over the world
+    // extents of the merged volumes, updated at each run (volumes may move).
+    // Only the volumes whose extent is crossed by the step are tested.
+    struct BVHNode
+    {
+      G4ThreeVector min, max;
+      G4int first; // leaf: first volume in mBVHVolumes, inner: second child
+      G4int count; // leaf: number of volumes, inner: 0 (first child at index+1)
+    };
+    void BuildBVH();
+    G4int BuildBVHNode( G4int begin, G4int end, std::vector<G4ThreeVector> const& centers );
+    void FindCandidates( G4ThreeVector const& position, G4ThreeVector const& direction, G4double length );
+
+    G4bool                            mUseBVH;
+    std::vector<G4AffineTransform>    mTransformVolToMerge;
+    std::vector<G4ThreeVector>        mMinVolToMerge;
+    std::vector<G4ThreeVector>        mMaxVolToMerge;
+    std::vector<BVHNode>              mBVHNodes;
+    std::vector<G4int>                mBVHVolumes;
+    std::vector<G4int>                mCandidates;
 };
 
 MAKE_AUTO_CREATOR_ACTOR(MergedVolumeActor,GateMergedVolumeActor)
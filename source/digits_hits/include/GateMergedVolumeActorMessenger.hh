@@ -32,6 +32,7 @@ class GateMergedVolumeActorMessenger : public GateActorMessenger
   private:
     GateMergedVolumeActor* pMergedVolumeActor;
     G4UIcmdWithAString* ListVolumeToMergeCmd;
+    G4UIcmdWithABool* EnableBVHCmd;
 };
 
 #endif
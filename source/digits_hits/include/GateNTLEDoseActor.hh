@@ -124,6 +124,8 @@ protected:
   int mCurrentEvent;
 
   std::vector<G4String> mMaterialList;
+  // Materials already checked for kerma/mu_en support (by material index)
+  std::vector<bool> mIsMaterialChecked;
 
   bool NeutronParent(const G4Step*);
 
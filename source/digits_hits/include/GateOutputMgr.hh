@@ -10,6 +10,7 @@
 #define GateOutputMgr_H
 
 #include "globals.hh"
+#include <map>
 
 #include "G4Timer.hh"
 #include "GateConfiguration.h"
@@ -109,6 +110,13 @@ public:
   //! If it is not the case the module is disabled and a warning is sent.
   void CheckFileNameForAllOutput();
 
+  //! Used by the forked mode (each process writes its own files) and the resumed simulations:
+  //! the files are named with this suffix, which replaces the previous one
+  void SetFileNameSuffix(const G4String & suffix);
+  const G4String & GetFileNameSuffix() const { return m_fileNameSuffix; }
+  //! Merge (when possible) the files written by the worker processes into the file name given by the user
+  void MergeFileNamesWithSuffixes(const std::vector<G4String> & suffixes);
+
   //! Return the current crystal-hit collection (if nay)
   GateHitsCollection*  	  GetHitCollection();
   std::vector<GateHitsCollection*> GetHitCollections();
@@ -174,6 +182,10 @@ protected:
   G4Timer m_timer;      	  //!< Timer
   std::vector<G4int> m_HCIDs;
 
+  //! File names given by the user (by module name) and suffix currently appended to them
+  std::map<G4String, G4String> m_fileNamesWithoutSuffix;
+  G4String m_fileNameSuffix;
+
 };
 
 #endif
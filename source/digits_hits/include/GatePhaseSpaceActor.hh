@@ -12,6 +12,8 @@
 #include "GateVActor.hh"
 #include "GateImage.hh"
 #include "GateTreeFileManager.hh"
+#include "GateBlockWriter.hh"
+#include "GateCompressedPhaseSpaceFile.hh"
 
 struct iaea_header_type;
 struct iaea_record_type;
@@ -54,6 +56,10 @@ public:
 
   virtual void ResetData();
 
+  /// Checkpoints: the .gphsp file goes on from the checkpoint offset
+  virtual G4bool SaveCheckpoint(GateCheckpointWriter & w);
+  virtual void LoadCheckpoint(GateCheckpointReader & r);
+
   void InitTree();
 
   void SetIsXPositionEnabled(bool b) { EnableXPosition = b; }
@@ -158,6 +164,8 @@ public:
 
   void SetKillParticleFlag(bool b);
 
+  void SetCompressionLevel(int l) { mCompressionLevel = l; }
+
 protected:
   GatePhaseSpaceActor(G4String name, G4int depth = 0);
 
@@ -277,6 +285,13 @@ protected:
 
   iaea_record_type *pIAEARecordType;
   iaea_header_type *pIAEAheader;
+  // IAEA records are written to the file by a background thread
+  GateBlockWriter mIAEAWriter;
+
+  // .gphsp output
+  GateCompressedPhaseSpaceWriter mCompressedFile;
+  int mCompressionLevel;
+  int mLastStoredEventID;
 };
 
 MAKE_AUTO_CREATOR_ACTOR(PhaseSpaceActor, GatePhaseSpaceActor)
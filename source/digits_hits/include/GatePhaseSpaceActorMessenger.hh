@@ -31,6 +31,8 @@ class G4UIcmdWithAString;
 
 class G4UIcmdWith3VectorAndUnit;
 
+class G4UIcmdWithAnInteger;
+
 class GatePhaseSpaceActor;
 
 class GatePhaseSpaceActorMessenger : public GateActorMessenger
@@ -90,6 +92,7 @@ protected:
   G4UIcmdWithABool *pEnableTProdCmd;
   G4UIcmdWithAString *pUseMaskCmd;
   G4UIcmdWithABool *pEnableKillCmd;
+  G4UIcmdWithAnInteger *pCompressionLevelCmd;
 };
 
 #endif /* end #define GATESOURCEACTORMESSENGER_HH*/
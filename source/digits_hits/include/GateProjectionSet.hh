@@ -11,6 +11,7 @@
 
 #include "globals.hh"
 #include <fstream>
+#include <vector>
 #include "GateDetectorConstruction.hh"
 
 /*!
@@ -87,6 +88,7 @@ class GateProjectionSet
 public:
   typedef unsigned short ProjectionDataType;
   typedef G4double ARFProjectionDataType;
+  typedef G4double WeightedProjectionDataType;
 public:
 
   inline GateProjectionSet();       	      	      	  //!< Public constructor
@@ -103,7 +105,20 @@ public:
   void ClearData(size_t projectionID);
 
   //! Store a digi into a projection
-  void Fill(G4int energyWindowID, G4int headID, G4double x, G4double y);
+  void Fill(G4int energyWindowID, G4int headID, G4double x, G4double y, G4double weight = 1.);
+
+  /*! \brief Store a batch of digis of one energy window into the projections
+
+    The pixel indices of the whole batch are computed first (out-of-bounds digis are
+    skipped), then the counts are added directly into the buffers written by StreamOut.
+
+    \param energyWindowID: the energy window of the digis
+    \param n:              the number of digis
+    \param headIDs, x, y:  the head and the projection coordinates of each digi
+    \param weights:        the weight of each digi (1 if null), only kept with weighted projections
+  */
+  void FillBatch(G4int energyWindowID, size_t n, const G4int* headIDs,
+                 const G4double* x, const G4double* y, const G4double* weights = 0);
   void FillARF(G4int, G4double, G4double, G4double, bool addEmToArfCount = false); /*PY Descourt 08/09/2009*/
   //! \name getters and setters
   //@{
@@ -195,6 +210,29 @@ public:
     return m_data;
   }
 
+  //! Returns the weighted data pointer (double precision counts)
+  inline WeightedProjectionDataType*** GetWeightedData() const
+  {
+    return m_weightedData;
+  }
+
+  //! Returns true if the projections (weighted or not) have been allocated
+  inline G4bool HasData() const
+  {
+    return (m_data != 0) || (m_weightedData != 0);
+  }
+
+  //! Returns true if the projections store weighted double precision counts
+  inline G4bool IsWeighted() const
+  {
+    return m_weighted;
+  }
+  //! Store weighted double precision counts instead of 16-bit counters (must be set before Reset)
+  inline void SetWeighted(G4bool flag)
+  {
+    m_weighted = flag;
+  }
+
   //! Set the verbose level
   virtual void SetVerboseLevel(G4int val)
   {
@@ -237,7 +275,7 @@ public:
   //! Returns the nb of bytes per pixel
   inline size_t BytesPerPixel() const
   {
-    return sizeof(ProjectionDataType);
+    return m_weighted ? sizeof(WeightedProjectionDataType) : sizeof(ProjectionDataType);
   }
 
   // Modified by HDS : For multple energy window support. This function only works for ARF data,
@@ -261,6 +299,14 @@ public:
     return 0;
   }
 
+  //! Returns the max weighted data for an energy window for one head
+  inline WeightedProjectionDataType GetWeightedMaxCounts(size_t energyWindowID, size_t headID) const
+  {
+    if (m_weightedDataMax != 0)
+      return m_weightedDataMax[energyWindowID][headID];
+    return 0.;
+  }
+
   //! Returns the data-max counter for a head
   inline size_t GetCurrentProjectionID() const
   {
@@ -339,6 +385,9 @@ public:
   G4double m_matrixLowEdgeX, m_matrixLowEdgeY;    //!< Low edge of the matrix (-n*dx/2)
   ProjectionDataType ***m_data;       	      	      	//!< Array of data sets
   ProjectionDataType **m_dataMax;       	      	      	//!< Max count for each projection
+  G4bool m_weighted;                                    //!< Weighted double precision counts instead of m_data
+  WeightedProjectionDataType ***m_weightedData;         //!< Array of weighted data sets [energyWindow][head][pixel]
+  WeightedProjectionDataType **m_weightedDataMax;       //!< Max weighted count for each projection
   G4int m_currentProjectionID;	      	//!< ID of the current projection
   G4int m_verboseLevel;
 
@@ -348,6 +397,13 @@ public:
   size_t m_numberOfARFFFDHeads;
   //@}
 
+private:
+  //! Add a count into a pixel of the projection of a head
+  inline void AddCount(G4int energyWindowID, G4int headID, G4int pixel, G4double weight);
+  void ReportRejectedDigi(G4int headID, G4double x, G4double y);
+
+  std::vector<G4int> m_batchPixels;   //!< Pixel index of each digi of a batch (-1 if rejected)
+
 };
 
 // Public constructor
@@ -363,6 +419,9 @@ inline GateProjectionSet::GateProjectionSet() :
   m_matrixLowEdgeY(0.),
   m_data(0),
   m_dataMax(0),
+  m_weighted(false),
+  m_weightedData(0),
+  m_weightedDataMax(0),
   m_currentProjectionID(-1),
   m_verboseLevel(0),
   m_numberOfEmEvents(0),
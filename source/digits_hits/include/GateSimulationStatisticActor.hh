@@ -57,6 +57,12 @@ public:
 
     virtual void ResetData();
 
+    virtual G4bool SaveCheckpoint(GateCheckpointWriter &w);
+
+    virtual void LoadCheckpoint(GateCheckpointReader &r);
+
+    virtual G4bool MergeCheckpoint(GateCheckpointReader &r);
+
 protected:
     GateSimulationStatisticActor(G4String name, G4int depth = 0);
 
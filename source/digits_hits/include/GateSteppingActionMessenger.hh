@@ -58,6 +58,7 @@ private: //commands
   G4UIcmdWithAString*    PolicyCmd;
   G4UIcmdWithAString*    GetTxtCmd;
   G4UIcmdWithAnInteger*  SetFilesCmd;
+  G4UIcmdWithABool*      StoreTrajectoriesCmd;
   //G4UIcmdWithAnInteger*  SetPhFilesCmd;
   //G4UIcmdWithAnInteger*  SetRSFilesCmd;
   G4UIcmdWithADoubleAndUnit* setEnergyTcmd;
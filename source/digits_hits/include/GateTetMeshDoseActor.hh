@@ -10,6 +10,8 @@
 
 #include <memory>
 #include <map>
+#include <vector>
+#include <utility>
 
 #include <G4Types.hh>
 #include <G4String.hh>
@@ -67,10 +69,13 @@ class GateTetMeshDoseActor : public GateVActor
     GateTetMeshDoseActor(G4String name, G4int depth = 0);
 
   private:
-    // key = copy number of a tetrahedron's physical volume
+    // key = tetrahedron index
     // value = deposited dose
     std::map<G4int, G4double> mEvtDoseMap;
 
+    // 'mesh' navigation: tets crossed by the current step and fraction of its length
+    std::vector<std::pair<G4int, G4double> > mStepTets;
+
     G4int mRunCounter;
 
     // one entry per tetrahedron
@@ -241,6 +241,12 @@ public:
   inline size_t BytesPerPixel() const
   { return m_projectionSet->BytesPerPixel();}
 
+  //! Store weighted double precision counts instead of 16-bit counters
+  inline void SetWeighted(G4bool flag)
+  { m_projectionSet->SetWeighted(flag);}
+  inline G4bool IsWeighted() const
+  { return m_projectionSet->IsWeighted();}
+
   //@}
 
 protected:
@@ -264,6 +270,12 @@ protected:
   std::vector<G4int> 	      m_inputDataChannelIDList;
   G4String            m_noFileName;
 
+  //! Digis of one energy window of the current event, handed in one batch to the projection set
+  std::vector<G4int>    m_batchHeadIDs;
+  std::vector<G4double> m_batchX;
+  std::vector<G4double> m_batchY;
+  std::vector<G4double> m_batchWeights;
+
   GateToInterfile*    m_gateToInterfile;
   GateToOpticalRaw*   m_gateToOpticalRaw; // v. cuplov -- GateToOpticalRaw for optical photons
 
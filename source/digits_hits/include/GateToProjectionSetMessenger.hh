@@ -12,6 +12,7 @@
 #include "GateOutputModuleMessenger.hh"
 
 class GateToProjectionSet;
+class G4UIcmdWithABool;
 
 class GateToProjectionSetMessenger: public GateOutputModuleMessenger
 {
@@ -32,6 +33,7 @@ class GateToProjectionSetMessenger: public GateOutputModuleMessenger
     G4UIcmdWithAString*     	projectionPlaneCmd;
     G4UIcmdWithAString*         SetInputDataCmd; //!< The UI command "set input data name"
     G4UIcmdWithAString*         AddInputDataCmd; //!< The UI command "add input data name"
+    G4UIcmdWithABool*           WeightedCmd;     //!< The UI command "weighted counts"
 };
 
 #endif
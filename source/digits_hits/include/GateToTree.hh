@@ -155,6 +155,7 @@ private:
   G4float m_edep[2];
   G4float m_stepLength;
   G4float m_trackLength;
+  G4float m_weight;
 
 
   G4int m_runID;
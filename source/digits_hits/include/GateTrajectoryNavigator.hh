@@ -15,7 +15,7 @@ See LICENSE.md for further details
 #include <vector>
 
 class G4TrajectoryContainer;
-class G4Trajectory;
+class GateEventTrackStore;
 
 
 class GateTrajectoryNavigator
@@ -41,8 +41,13 @@ public:
 
   void          Initialize();
 
+  // The tracks are read from the GateEventTrackStore of the current event;
+  // the container is kept for the users of GetTrajectoryContainer()
   void                          SetTrajectoryContainer(G4TrajectoryContainer* trajectoryContainer);
 
+  // True if tracks have been recorded for the current event
+  G4bool                        HasTracks() const;
+
   inline G4TrajectoryContainer* GetTrajectoryContainer()   { return m_trajectoryContainer; };
 
   inline std::vector<G4int>          GetPhotonIDVec()           { return m_photonIDVec; };
@@ -57,10 +62,10 @@ protected:
 
 private:
   G4TrajectoryContainer* m_trajectoryContainer;
+  GateEventTrackStore*   m_trackStore;
 
   std::vector<G4int>          m_photonIDVec;
   G4int                  m_positronTrackID;
-  G4Trajectory*          m_positronTrj;
   G4int                  m_ionID;
 
   G4int                  nVerboseLevel;
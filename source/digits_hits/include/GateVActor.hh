@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "GateActorManager.hh"
+#include "GateCheckpointFile.hh"
 #include "GateNamedObject.hh"
 #include "GateMessageManager.hh"
 #include "GateFilterManager.hh"
@@ -114,6 +115,16 @@ public:
   void EnableResetDataAtEachRun(bool b) { mResetDataAtEachRun = b; }
   //-----------------------------------------------------------------------------
 
+  //-----------------------------------------------------------------------------
+  /// Checkpoint/restart of the accumulated data (see GateCheckpointManager).
+  /// Return false if the actor does not support it (its data then restart from zero).
+  virtual G4bool SaveCheckpoint(GateCheckpointWriter &) { return false; }
+  virtual void LoadCheckpoint(GateCheckpointReader &) {}
+  /// Forked mode: adds the data saved with SaveCheckpoint by another process,
+  /// returns false if the actor does not support it
+  virtual G4bool MergeCheckpoint(GateCheckpointReader &) { return false; }
+  //-----------------------------------------------------------------------------
+
   G4String GetVolumeName(){return mVolumeName;}
   GateVVolume * GetVolume(){return mVolume;}
   void SetVolumeName(G4String name){mVolumeName = name;}
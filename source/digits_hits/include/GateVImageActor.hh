@@ -59,6 +59,8 @@ public :
   //void SetPosition(GateVVolume * v);
   /// Sets the type of the hit
   void SetStepHitType(G4String t);
+  /// Sets the precision of the accumulated images (double, float, kahan or mixed)
+  void SetPrecision(G4String p) { mPrecision = GateImageWithStatistic::GetPrecisionFromName(p); }
   //-----------------------------------------------------------------------------
 
   double GetDoselVolume(){return mVoxelSize.x()*mVoxelSize.y()*mVoxelSize.z();}
@@ -92,6 +94,15 @@ public :
                                        const G4ThreeVector mPosition,
                                        const StepHitType mStepHitType);
 
+  // Pre and post step positions in the frame of the image (false if the
+  // step is not in the volume v)
+  static bool GetStepPositions2(const GateVVolume *,
+                                const G4Step * step,
+                                const bool mPositionIsSet,
+                                const G4ThreeVector mPosition,
+                                G4ThreeVector & prePosition,
+                                G4ThreeVector & postPosition);
+
 protected:
 
   //-----------------------------------------------------------------------------
@@ -106,6 +117,7 @@ protected:
   G4ThreeVector  mOrigin;
   StepHitType    mStepHitType;
   G4String       mStepHitTypeName;
+  GateImageWithStatistic::PrecisionType mPrecision;
   GateImage      mImage;
   bool           mVoxelSizeIsSet;
   bool           mResolutionIsSet;
@@ -52,6 +52,7 @@
 #include "GateCrystalSD.hh"
 
 #include "GateDigitizerMgr.hh"
+#include "GateEventTrackStore.hh"
 
 GateRunAction* GateRunAction::prunAction=0;
 GateEventAction* GateEventAction::peventAction=0;
@@ -162,6 +163,15 @@ inline void GateEventAction::BeginOfEventAction(const G4Event* anEvent)
  // G4cout<<"Begin Of Event " << anEvent->GetEventID() << G4endl;
 
   TrackingMode theMode =( (GateSteppingAction *)(GateRunManager::GetRunManager()->GetUserSteppingAction() ) )->GetMode();
+
+  // The ancestry of the tracks is kept in the compact GateEventTrackStore; the G4
+  // trajectories are only stored for the visualisation, the detector mode or on request
+  GateEventTrackStore* trackStore = GateEventTrackStore::GetInstance();
+  trackStore->Clear();
+  trackStore->SetG4TrajectoriesNeeded(trackStore->GetStoreTrajectoriesFlag()
+                                      || theMode == TrackingMode::kDetector
+                                      || G4VVisManager::GetConcreteInstance() != 0);
+
   if ( theMode != TrackingMode::kTracker )
     {
 
@@ -264,13 +274,8 @@ GateTrackingAction::GateTrackingAction(GateUserActions * cbm)
 
 void GateTrackingAction::PreUserTrackingAction(const G4Track* a)
 {
-  // Create trajectory only for primaries
-  if(a->GetParentID()==0) {
-    fpTrackingManager->SetStoreTrajectory(true);
-  } else {
-    fpTrackingManager->SetStoreTrajectory(true);
-    //fpTrackingManager->SetStoreTrajectory(false);
-  }
+  // Create trajectory only if needed (see GateEventAction::BeginOfEventAction)
+  fpTrackingManager->SetStoreTrajectory(GateEventTrackStore::GetInstance()->GetG4TrajectoriesNeeded());
 
   /* PY Descourt 08/09/2009 */
 
@@ -350,6 +355,8 @@ void GateTrackingAction::PreUserTrackingAction(const G4Track* a)
 /* PY Descourt 08/09/2009 */
 void GateTrackingAction::PostUserTrackingAction(const G4Track* aTrack)
 {
+  GateEventTrackStore::GetInstance()->Record(aTrack);
+
 
   if ( !dummy_track_vector.empty() )
     { for ( size_t i = 0; i < dummy_track_vector.size();i++)
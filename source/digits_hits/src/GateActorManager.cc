@@ -171,6 +171,15 @@ void GateActorManager::BeginOfRunAction(const G4Run* run)
 {
   std::vector<GateVActor*>::iterator sit;
 
+  // Filters are compiled once per run, their track-level part is then
+  // evaluated once per track in PreUserTrackingAction
+  theListOfCompiledFilterManagers.clear();
+  for (sit = theListOfActors.begin(); sit!=theListOfActors.end(); ++sit)
+    if ((*sit)->GetNumberOfFilters()!=0) {
+      (*sit)->GetFilterManager()->Compile();
+      theListOfCompiledFilterManagers.push_back((*sit)->GetFilterManager());
+    }
+
   //GateMessage("Core", 0, "Run " << run->GetRunID() << " is starting.\n");
   for (sit = theListOfActorsEnabledForBeginOfRun.begin(); sit!=theListOfActorsEnabledForBeginOfRun.end(); ++sit)
     (*sit)->BeginOfRunAction(run);
@@ -212,6 +221,9 @@ void GateActorManager::PreUserTrackingAction(const G4Track* track)
 {
   // GateDebugMessage("Actor", 1, "listtrack= " << theListOfActorsEnabledForPreUserTrackingAction.size()
   //                    << Gateendl);
+  for (size_t i = 0; i < theListOfCompiledFilterManagers.size(); i++)
+    theListOfCompiledFilterManagers[i]->BeginOfTrack(track);
+
   std::vector<GateVActor*>::iterator sit;
   for (sit = theListOfActorsEnabledForPreUserTrackingAction.begin(); sit!=theListOfActorsEnabledForPreUserTrackingAction.end(); ++sit)
     {
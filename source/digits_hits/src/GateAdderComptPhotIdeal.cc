@@ -292,6 +292,7 @@ GateDigi* GateAdderComptPhotIdeal::CentroidMergeComptPhotIdeal(GateDigi *right,
     }
     // energy: we compute the sum
     G4double totalEnergy = output->m_energy + right->m_energy;
+    output->MergeWeight(right);
 
     // Local and global positions: keep the original Position
 
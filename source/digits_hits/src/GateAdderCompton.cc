@@ -200,6 +200,7 @@ GateDigi* GateAdderCompton::CentroidMergeCompton(GateDigi *right, GateDigi *outp
 
     // energy: we compute the sum
     G4double totalEnergy = output->m_energy + right->m_energy;
+    output->MergeWeight(right);
 
     // Local and global positions: keep the original Position
 
@@ -120,10 +120,7 @@ void GateAnalysis::RecordEndOfEvent(const G4Event* event)
  if (nVerboseLevel > 2)
     G4cout << "GateAnalysis::RecordEndOfEvent "<< Gateendl;
 
-  G4TrajectoryContainer* trajectoryContainer = event->GetTrajectoryContainer();
-
-  if (trajectoryContainer)
-    m_trajectoryNavigator->SetTrajectoryContainer(trajectoryContainer);
+  m_trajectoryNavigator->SetTrajectoryContainer(event->GetTrajectoryContainer());
 
   G4int eventID = event->GetEventID();
   G4int runID   = GateRunManager::GetRunManager()->GetCurrentRun()->GetRunID();
@@ -131,10 +128,10 @@ void GateAnalysis::RecordEndOfEvent(const G4Event* event)
 
   //G4int i;
 
-  if (!trajectoryContainer)
+  if (!m_trajectoryNavigator->HasTracks())
     {
       if (nVerboseLevel > 0)
-        G4cout << "GateAnalysis::RecordEndOfEvent : WARNING : G4TrajectoryContainer not found\n";
+        G4cout << "GateAnalysis::RecordEndOfEvent : WARNING : no track recorded for this event\n";
     }
   else
     {
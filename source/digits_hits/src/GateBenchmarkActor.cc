@@ -124,7 +124,7 @@ G4double deviationAngle(const G4ThreeVector& dir_orig, const G4ThreeVector& dir_
 
 void GateBenchmarkActor::UserSteppingAction(const GateVVolume*, const G4Step* step)
 {
-  const G4double weight = step->GetTrack()->GetWeight();
+  const G4double weight = step->GetPreStepPoint()->GetWeight();
 
   const G4ThreeVector position_pre = step->GetPreStepPoint()->GetPosition();
   const G4ThreeVector position_post = step->GetPostStepPoint()->GetPosition();
@@ -10,6 +10,7 @@ See LICENSE.md for further details
 #include "GateBioDoseActor.hh"
 #include "GateImageWithStatistic.hh"
 #include <CLHEP/Units/SystemOfUnits.h>
+#include <algorithm>
 #include <G4ios.hh>
 
 #define GATE_BUFFERSIZE
@@ -56,10 +57,13 @@ void GateBioDoseActor::Construct() {
 
 		setupImage(_hitEventCountImage, "hitevent_count");
 
-		setupImage(_eventEdepImage);
-		setupImage(_eventDoseImage);
-		setupImage(_eventAlphaImage);
-		setupImage(_eventSqrtBetaImage);
+		std::size_t const nbOfVoxels = mResolution.x() * mResolution.y() * mResolution.z();
+		_eventEdep.assign(nbOfVoxels, 0);
+		_eventDose.assign(nbOfVoxels, 0);
+		_eventAlpha.assign(nbOfVoxels, 0);
+		_eventSqrtBeta.assign(nbOfVoxels, 0);
+		_eventVoxelState.assign(nbOfVoxels, 0);
+		_voxelHit.assign(nbOfVoxels, 0);
 
 		if(_enableEdep)         setupImage(_edepImage, "edep");
 		setupImage(_doseImage); // dose output can be scaled, see SaveData()
@@ -105,6 +109,7 @@ void GateBioDoseActor::Construct() {
 	//Building the cell line information
 	_dataBase = "data/" + _cellLine + "_" + _bioPhysicalModel + ".db";
 	buildDatabase();
+	buildIonTables();
 
 	if(_alphaRef < 0 || _betaRef < 0)
 		GateError("BioDoseActor " << GetName() << ": setAlphaRef and setBetaRef must be done");
@@ -162,6 +167,71 @@ void GateBioDoseActor::buildDatabase() {
 }
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
+void GateBioDoseActor::buildIonTables() {
+	// Flatten the (Z, energy) map into dense per-Z arrays. The segment used for
+	// an energy E is the first entry with energy > E (or the entry at energyMax
+	// above it), exactly as the map upper_bound/find lookup did.
+	int maxZ = 0;
+	for(auto const& e: _energyMaxForZ) maxZ = std::max(maxZ, e.first);
+	_ionTables.assign(maxZ + 1, IonTable{});
+
+	for(auto const& e: _alphaBetaInterpolTable) {
+		auto& table = _ionTables[e.first.first];
+		table.energies.push_back(e.first.second);
+		table.coefficients.push_back(e.second);
+	}
+
+	// Cell width is the smallest gap between consecutive energies so that a
+	// lookup walks at most one segment, the number of cells is bounded
+	int const maxNbOfCells = 1 << 16;
+	for(auto const& e: _energyMaxForZ) {
+		auto& table = _ionTables[e.first];
+		if(table.energies.empty()) continue;
+
+		auto const& energies = table.energies;
+		table.energyMax = e.second;
+		table.maxSegment = std::lower_bound(energies.begin(), energies.end(), e.second) - energies.begin();
+		if(table.maxSegment >= static_cast<int>(energies.size()))
+			table.maxSegment = energies.size() - 1;
+
+		double cellWidth = energies.front() > 0 ? energies.front() : table.energyMax;
+		for(std::size_t i = 1; i < energies.size(); ++i)
+			if(energies[i] > energies[i - 1])
+				cellWidth = std::min(cellWidth, energies[i] - energies[i - 1]);
+		if(cellWidth <= 0) cellWidth = 1;
+		cellWidth = std::max(cellWidth, table.energyMax / maxNbOfCells);
+		table.invCellWidth = 1. / cellWidth;
+
+		int const nbOfCells = static_cast<int>(table.energyMax * table.invCellWidth) + 1;
+		table.cellSegment.resize(nbOfCells);
+		int segment = 0;
+		int const lastSegment = energies.size() - 1;
+		for(int cell = 0; cell < nbOfCells; ++cell) {
+			double const cellStart = cell * cellWidth;
+			while(segment < lastSegment && energies[segment] <= cellStart) ++segment;
+			table.cellSegment[cell] = segment;
+		}
+	}
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+GateBioDoseActor::AlphaBetaCoefficients const* GateBioDoseActor::findCoefficients(int nZ, double kineticEnergyPerNucleon) const {
+	if(nZ < 0 || nZ >= static_cast<int>(_ionTables.size())) return nullptr;
+	auto const& table = _ionTables[nZ];
+	if(table.maxSegment < 0) return nullptr;
+
+	if(kineticEnergyPerNucleon >= table.energyMax)
+		return &table.coefficients[table.maxSegment];
+
+	int cell = static_cast<int>(kineticEnergyPerNucleon * table.invCellWidth);
+	if(cell < 0) cell = 0;
+	int segment = table.cellSegment[cell];
+	int const lastSegment = table.energies.size() - 1;
+	while(segment < lastSegment && table.energies[segment] <= kineticEnergyPerNucleon) ++segment;
+	return &table.coefficients[segment];
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
 GateBioDoseActor::Coefficients GateBioDoseActor::interpol(double x1, double x2, double y1, double y2) {
 	//Function for a 1D linear interpolation. It returns a pair of a and b coefficients
 	double a = (y2 - y1) / (x2 - x1);
@@ -187,25 +257,33 @@ void GateBioDoseActor::BeginOfEventAction(const G4Event* e) {
 	GateVActor::BeginOfEventAction(e);
 	++_currentEvent;
 
+	// Only reset the voxels touched by the previous event
+	for(auto const index: _eventVoxelIndices) {
+		_eventEdep[index] = 0;
+		_eventDose[index] = 0;
+		_eventAlpha[index] = 0;
+		_eventSqrtBeta[index] = 0;
+		_eventVoxelState[index] = 0;
+	}
 	_eventVoxelIndices.clear();
-
-	_eventEdepImage.Reset();
-	_eventDoseImage.Reset();
-	_eventAlphaImage.Reset();
-	_eventSqrtBetaImage.Reset();
 }
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 void GateBioDoseActor::EndOfEventAction(const G4Event* e) {
 	GateVActor::EndOfEventAction(e);
 
-	for(auto const& index: _eventVoxelIndices) {
-		auto const eventEdep = _eventEdepImage.GetValue(index);
-		auto const eventDose = _eventDoseImage.GetValue(index);
-		auto const eventAlphaMix = _eventAlphaImage.GetValue(index) / eventEdep;
-		auto const eventSqrtBetaMix = _eventSqrtBetaImage.GetValue(index) / eventEdep;
+	for(auto const index: _eventVoxelIndices) {
+		if(_eventVoxelState[index] != 2) continue;
+
+		auto const eventEdep = _eventEdep[index];
+		auto const eventDose = _eventDose[index];
+		auto const eventAlphaMix = _eventAlpha[index] / eventEdep;
+		auto const eventSqrtBetaMix = _eventSqrtBeta[index] / eventEdep;
 
-		_voxelIndices.insert(index);
+		if(!_voxelHit[index]) {
+			_voxelHit[index] = 1;
+			_voxelIndices.push_back(index);
+		}
 		_hitEventCountImage.AddValue(index, 1);
 
 		if(_enableEdep) _edepImage.AddValue(index, eventEdep);
@@ -228,21 +306,25 @@ void GateBioDoseActor::EndOfEventAction(const G4Event* e) {
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 void GateBioDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
-	double const weight     = step->GetTrack()->GetWeight();
+	double const weight     = step->GetPreStepPoint()->GetWeight();
 	double const energyDep  = step->GetTotalEnergyDeposit() * weight;
 
 	if(energyDep == 0)  return;
 	if(index < 0)       return;
 
 	// Accumulate energy inconditionnaly
-	_eventEdepImage.AddValue(index, energyDep);
+	if(_eventVoxelState[index] == 0) {
+		_eventVoxelState[index] = 1;
+		_eventVoxelIndices.push_back(index);
+	}
+	_eventEdep[index] += energyDep;
 
 	auto* currentMaterial = step->GetPreStepPoint()->GetMaterial();
 	double density = currentMaterial->GetDensity();
 	double mass = _bioDoseImage.GetVoxelVolume() * density;
 	double dose = energyDep / mass / CLHEP::gray;
 
-	_eventDoseImage.AddValue(index, dose);
+	_eventDose[index] += dose;
 
 	// Get information from step
 	// Particle
@@ -253,22 +335,12 @@ void GateBioDoseActor::UserSteppingActionInVoxel(const int index, const G4Step*
 
 	// Accumulation of alpha/beta if ion type if known
 	// -> check if the ion type is known
-	if(_energyMaxForZ.count(nZ) != 0) {
+	auto const* coefficients = findCoefficients(nZ, kineticEnergyPerNucleon);
+	if(coefficients) {
 		++_stepWithKnownIonCount;
 
-		double energyMax = _energyMaxForZ.at(nZ);
-
-		AlphaBetaInterpolTable::const_iterator itInterpol;
-		if(kineticEnergyPerNucleon >= energyMax) {
-			Fragment fragmentKineticEnergyMax{nZ, energyMax};
-			itInterpol = _alphaBetaInterpolTable.find(fragmentKineticEnergyMax);
-		} else {
-			Fragment fragmentKineticEnergy{nZ, kineticEnergyPerNucleon};
-			itInterpol = _alphaBetaInterpolTable.upper_bound(fragmentKineticEnergy);
-		}
-
 		// Calculation of alphaDep and betaDep (K = (a*Z+b)*E)
-		auto const& interpol = (*itInterpol).second;
+		auto const& interpol = *coefficients;
 
 		double alpha = (interpol.alpha.a * kineticEnergyPerNucleon + interpol.alpha.b) * energyDep;
 		double sqrtBeta = (interpol.sqrtBeta.a * kineticEnergyPerNucleon + interpol.sqrtBeta.b) * energyDep;
@@ -277,10 +349,10 @@ void GateBioDoseActor::UserSteppingActionInVoxel(const int index, const G4Step*
 		if(sqrtBeta < 0) sqrtBeta = 0;
 
 		// Accumulate alpha/beta
-		_eventAlphaImage.AddValue(index, alpha);
-		_eventSqrtBetaImage.AddValue(index, sqrtBeta);
+		_eventAlpha[index] += alpha;
+		_eventSqrtBeta[index] += sqrtBeta;
 
-		_eventVoxelIndices.insert(index);
+		_eventVoxelState[index] = 2;
 	}
 }
 //-----------------------------------------------------------------------------
@@ -426,10 +498,15 @@ void GateBioDoseActor::SaveData() {
 void GateBioDoseActor::ResetData() {
 	_hitEventCountImage.Reset();
 
-	_eventEdepImage.Reset();
-	_eventDoseImage.Reset();
-	_eventAlphaImage.Reset();
-	_eventSqrtBetaImage.Reset();
+	std::fill(_eventEdep.begin(), _eventEdep.end(), 0);
+	std::fill(_eventDose.begin(), _eventDose.end(), 0);
+	std::fill(_eventAlpha.begin(), _eventAlpha.end(), 0);
+	std::fill(_eventSqrtBeta.begin(), _eventSqrtBeta.end(), 0);
+	std::fill(_eventVoxelState.begin(), _eventVoxelState.end(), 0);
+	_eventVoxelIndices.clear();
+
+	std::fill(_voxelHit.begin(), _voxelHit.end(), 0);
+	_voxelIndices.clear();
 
 	if(_enableEdep)         _edepImage.Reset();
 	_doseImage.Reset();
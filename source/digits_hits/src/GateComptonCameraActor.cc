@@ -10,6 +10,7 @@
   \class  GateComptonCameraActor
 */
 
+#include <algorithm>
 #include <G4EmCalculator.hh>
 #include <G4VoxelLimits.hh>
 #include <G4NistManager.hh>
@@ -57,6 +58,10 @@ GateComptonCameraActor::GateComptonCameraActor(G4String name, G4int depth):
     mSaveCoincidencesTreeFlag=1;
     mSaveCoincidenceChainsTreeFlag=1;
     mSaveEventInfoTreeFlag=false;
+    mSaveConesFlag=false;
+    mBackProjectionFlag=false;
+    mConesCoincidenceName="";
+    mBackProjectionFileName="";
     mParentIDSpecificationFlag=false;
 
     //Messenger load values
@@ -399,6 +404,25 @@ void GateComptonCameraActor::Construct()
        }
    }
 
+   //Cones built during the run from the sequence coincidences (by default the output of the last coincidence chain)
+   if(mSaveConesFlag || mBackProjectionFlag){
+       if(mConesCoincidenceName==""){
+           if(coincidenceChainNames.size()>0) mConesCoincidenceName=coincidenceChainNames.back();
+           else mConesCoincidenceName=thedigitizerSorterName;
+       }
+       if(mConesCoincidenceName!=thedigitizerSorterName && std::find(coincidenceChainNames.begin(), coincidenceChainNames.end(), mConesCoincidenceName)==coincidenceChainNames.end())
+           GateError("Compton camera actor: unknown coincidences for the cones: " << mConesCoincidenceName);
+
+       G4String filenameCones="";
+       if(mSaveConesFlag) filenameCones=filename+"_Cones.cones";
+       G4String filenameBP="";
+       if(mBackProjectionFlag){
+           filenameBP=mBackProjectionFileName;
+           if(filenameBP=="") filenameBP=filename+"_BackProjection.mhd";
+       }
+       mConeStream.Open(filenameCones, filenameBP);
+   }
+
   // General event Info. In this case Electron escape info
    if(mSaveEventInfoTreeFlag){
        G4String filenameC=filename+"_eventGlobalInfo."+extension;
@@ -460,6 +484,7 @@ void GateComptonCameraActor::SaveData()
     if(mSaveEventInfoTreeFlag){
         mFileEvent.close();
     }
+    mConeStream.Close();
 
 
 }
@@ -568,6 +593,9 @@ void GateComptonCameraActor::EndOfEventAction(const G4Event* )
                             aCoinDigi=0;
                         }
                     }
+                    if(mConeStream.IsOpen() && mConesCoincidenceName==thedigitizerSorterName){
+                        processCoincidenceIntoCone(*it);
+                    }
 
 
                 }
@@ -605,6 +633,9 @@ void GateComptonCameraActor::EndOfEventAction(const G4Event* )
 
 
                         }
+                        if(mConeStream.IsOpen() && mConesCoincidenceName==coincidenceChainNames.at(iChain)){
+                            processCoincidenceIntoCone(coincPulse);
+                        }
 
 
                     }
@@ -634,6 +665,35 @@ void GateComptonCameraActor::EndOfEventAction(const G4Event* )
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void GateComptonCameraActor::processCoincidenceIntoCone(GateCoincidencePulse* coincPulse)
+{
+    unsigned int numSingles=coincPulse->size();
+    if(numSingles<2) return;
+
+    GateComptonCameraCones aCone;
+    double energyR=0.0;
+    bool isTrueCoinc=true;
+    int firstEvtID=coincPulse->at(0)->GetEventID();
+    aCone.SetEnergy1(coincPulse->at(0)->GetEnergy());
+    aCone.SetPosition1(coincPulse->at(0)->GetGlobalPos());
+    aCone.SetEnergy2(coincPulse->at(1)->GetEnergy());
+    aCone.SetPosition2(coincPulse->at(1)->GetGlobalPos());
+    if(numSingles>2) aCone.SetPosition3(coincPulse->at(2)->GetGlobalPos());
+    for(unsigned int i=1;i<numSingles;i++){
+        if(coincPulse->at(i)->GetEventID()!=firstEvtID) isTrueCoinc=false;
+        //All the deposited energy except E1
+        energyR+=coincPulse->at(i)->GetEnergy();
+    }
+    aCone.SetEnergyR(energyR);
+    aCone.SetNumSingles(numSingles);
+    aCone.SetTrueFlag(isTrueCoinc);
+
+    mConeStream.Add(aCone, runID, firstEvtID, coincPulse->GetCoincID());
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void GateComptonCameraActor::PreUserTrackingAction(const GateVVolume * , const G4Track* t)
 {
@@ -795,7 +855,7 @@ void GateComptonCameraActor::PostUserTrackingAction(const GateVVolume *, const G
 void GateComptonCameraActor::UserSteppingAction(const GateVVolume *  , const G4Step* step)
 {
     //G4cout<<"######START OF :UserSteppingAction####################################"<<G4endl;
-    assert(step->GetTrack()->GetWeight() == 1.); // edep doesnt handle weight
+    assert(step->GetPreStepPoint()->GetWeight() == 1.); // edep doesnt handle weight
 
     //======================== info of the track ==========================
     G4Track* aTrack = step->GetTrack();
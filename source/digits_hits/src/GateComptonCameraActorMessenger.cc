@@ -32,6 +32,16 @@ GateComptonCameraActorMessenger::~GateComptonCameraActorMessenger()
     delete pSaveCoincidenceChainsTree;
     delete pSaveEventInfoTree;
 
+    delete pSaveConesCmd;
+    delete pConesCoincidenceNameCmd;
+    delete pEnableBackProjectionCmd;
+    delete pBackProjectionFileNameCmd;
+    delete pBackProjectionResolutionCmd;
+    delete pBackProjectionVoxelSizeCmd;
+    delete pBackProjectionPositionCmd;
+    delete pBackProjectionWidthCmd;
+    delete pBackProjectionNumberOfThreadsCmd;
+
 
     delete pNameOfAbsorberSDVol;
     delete pNameOfScattererSDVol;
@@ -106,6 +116,61 @@ void GateComptonCameraActorMessenger::BuildCommands(G4String base)
 
 
 
+  bb = base+"/saveCones";
+  pSaveConesCmd = new G4UIcmdWithABool(bb, this);
+  guidance = G4String("Build the Compton cones from the coincidence sequences during the run and save them in a binary file (_Cones.cones)");
+  pSaveConesCmd->SetGuidance(guidance);
+  pSaveConesCmd->SetParameterName("State",false);
+
+  bb = base+"/setConesCoincidences";
+  pConesCoincidenceNameCmd = new G4UIcmdWithAString(bb, this);
+  guidance = G4String("Name of the coincidences (sorter or coincidence chain) used to build the cones. Default: last coincidence chain");
+  pConesCoincidenceNameCmd->SetGuidance(guidance);
+
+  bb = base+"/enableBackProjection";
+  pEnableBackProjectionCmd = new G4UIcmdWithABool(bb, this);
+  guidance = G4String("Accumulate a simple back-projection image of the cones in background threads");
+  pEnableBackProjectionCmd->SetGuidance(guidance);
+  pEnableBackProjectionCmd->SetParameterName("State",false);
+
+  bb = base+"/setBackProjectionFileName";
+  pBackProjectionFileNameCmd = new G4UIcmdWithAString(bb, this);
+  guidance = G4String("File name of the back-projection image. Default: _BackProjection.mhd");
+  pBackProjectionFileNameCmd->SetGuidance(guidance);
+
+  bb = base+"/setBackProjectionResolution";
+  pBackProjectionResolutionCmd = new G4UIcmdWith3Vector(bb, this);
+  guidance = G4String("Number of voxels of the back-projection image");
+  pBackProjectionResolutionCmd->SetGuidance(guidance);
+  pBackProjectionResolutionCmd->SetParameterName("Nx","Ny","Nz",false);
+
+  bb = base+"/setBackProjectionVoxelSize";
+  pBackProjectionVoxelSizeCmd = new G4UIcmdWith3VectorAndUnit(bb, this);
+  guidance = G4String("Voxel size of the back-projection image");
+  pBackProjectionVoxelSizeCmd->SetGuidance(guidance);
+  pBackProjectionVoxelSizeCmd->SetParameterName("X","Y","Z",false);
+  pBackProjectionVoxelSizeCmd->SetDefaultUnit("mm");
+
+  bb = base+"/setBackProjectionPosition";
+  pBackProjectionPositionCmd = new G4UIcmdWith3VectorAndUnit(bb, this);
+  guidance = G4String("Center of the back-projection image in the world");
+  pBackProjectionPositionCmd->SetGuidance(guidance);
+  pBackProjectionPositionCmd->SetParameterName("X","Y","Z",false);
+  pBackProjectionPositionCmd->SetDefaultUnit("mm");
+
+  bb = base+"/setBackProjectionWidth";
+  pBackProjectionWidthCmd = new G4UIcmdWithADoubleAndUnit(bb, this);
+  guidance = G4String("Distance to the cone surface below which a voxel is incremented. Default: half of the voxel diagonal");
+  pBackProjectionWidthCmd->SetGuidance(guidance);
+  pBackProjectionWidthCmd->SetParameterName("Width",false);
+  pBackProjectionWidthCmd->SetDefaultUnit("mm");
+
+  bb = base+"/setBackProjectionNumberOfThreads";
+  pBackProjectionNumberOfThreadsCmd = new G4UIcmdWithAnInteger(bb, this);
+  guidance = G4String("Number of threads of the back-projection. Default (0): number of cores");
+  pBackProjectionNumberOfThreadsCmd->SetGuidance(guidance);
+  pBackProjectionNumberOfThreadsCmd->SetParameterName("N",false);
+
   bb = base+"/absorberSDVolume";
   pNameOfAbsorberSDVol = new G4UIcmdWithAString(bb,this);
   guidance = "Specifies the absorber volume to track particles";
@@ -286,6 +351,16 @@ void GateComptonCameraActorMessenger::SetNewValue(G4UIcommand* cmd, G4String new
   if(cmd == pSaveCoincidenceChainsTree) pActor->SetSaveCoincidenceChainsTreeFlag(  pSaveCoincidenceChainsTree->GetNewBoolValue(newValue)  ) ;
   if(cmd == pSaveEventInfoTree) pActor->SetSaveEventInfoTreeFlag(  pSaveEventInfoTree->GetNewBoolValue(newValue)  ) ;
 
+  if(cmd == pSaveConesCmd) pActor->SetSaveConesFlag(  pSaveConesCmd->GetNewBoolValue(newValue)  ) ;
+  if(cmd == pConesCoincidenceNameCmd) pActor->SetConesCoincidenceName(newValue) ;
+  if(cmd == pEnableBackProjectionCmd) pActor->SetBackProjectionFlag(  pEnableBackProjectionCmd->GetNewBoolValue(newValue)  ) ;
+  if(cmd == pBackProjectionFileNameCmd) pActor->SetBackProjectionFileName(newValue) ;
+  if(cmd == pBackProjectionResolutionCmd) pActor->GetConeStream().SetBackProjectionResolution(pBackProjectionResolutionCmd->GetNew3VectorValue(newValue));
+  if(cmd == pBackProjectionVoxelSizeCmd) pActor->GetConeStream().SetBackProjectionVoxelSize(pBackProjectionVoxelSizeCmd->GetNew3VectorValue(newValue));
+  if(cmd == pBackProjectionPositionCmd) pActor->GetConeStream().SetBackProjectionPosition(pBackProjectionPositionCmd->GetNew3VectorValue(newValue));
+  if(cmd == pBackProjectionWidthCmd) pActor->GetConeStream().SetBackProjectionWidth(pBackProjectionWidthCmd->GetNewDoubleValue(newValue));
+  if(cmd == pBackProjectionNumberOfThreadsCmd) pActor->GetConeStream().SetNumberOfThreads(pBackProjectionNumberOfThreadsCmd->GetNewIntValue(newValue));
+
 
   if(cmd == pNumberofDiffScattererLayers) pActor->SetNumberOfDiffScattererLayers( pNumberofDiffScattererLayers->GetNewIntValue(newValue)  ) ;
    if(cmd == pNumberofTotScattererLayers) pActor->SetNumberOfTotScattererLayers( pNumberofTotScattererLayers->GetNewIntValue(newValue)  ) ;
@@ -0,0 +1,184 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "GateComptonCameraConeStream.hh"
+#include "GateMessageManager.hh"
+
+//-----------------------------------------------------------------------------
+GateComptonCameraConeStream::GateComptonCameraConeStream()
+{
+  mIsOpen = false;
+  mNumberOfCones = 0;
+  pFile = 0;
+  mResolution = G4ThreeVector(100, 100, 100);
+  mVoxelSize = G4ThreeVector(1*mm, 1*mm, 1*mm);
+  mPosition = G4ThreeVector();
+  mWidth = 0;
+  mNumberOfThreads = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateComptonCameraConeStream::~GateComptonCameraConeStream()
+{
+  Close();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateComptonCameraConeStream::Open(const G4String & conesFileName, const G4String & imageFileName)
+{
+  Close();
+  mNumberOfCones = 0;
+
+  if (conesFileName != "") {
+    pFile = fopen(conesFileName.c_str(), "wb");
+    if (!pFile) GateError("Compton camera: cannot open the cones file " << conesFileName);
+    Header header;
+    memcpy(header.magic, "GATECONE", sizeof(header.magic));
+    header.version = 1;
+    header.recordSize = sizeof(Record);
+    if (fwrite(&header, sizeof(Header), 1, pFile) != 1)
+      GateError("Compton camera: failed to write the cones file " << conesFileName);
+    FILE * file = pFile;
+    mFileWriter.start([file](std::vector<char> & block) {
+        if (fwrite(block.data(), sizeof(char), block.size(), file) != block.size())
+          GateError("Compton camera: failed to write the cones file.");
+      });
+  }
+
+  mImageFileName = imageFileName;
+  if (mImageFileName != "") {
+    mImage.SetResolutionAndVoxelSize(mResolution, mVoxelSize);
+    mImage.SetOrigin(mPosition - mImage.GetHalfSize());
+    mImage.Allocate();
+    mImage.Fill(0);
+    if (mWidth <= 0) mWidth = mVoxelSize.mag()/2.0;
+    // Small blocks, the image is updated during the run. At most 4 blocks
+    // are pending, then Add waits for the back-projection (see the docs)
+    mBackProjectionWriter.start([this](std::vector<char> & block) { BackProject(block); },
+                                1024*sizeof(Record), 4);
+  }
+
+  mIsOpen = true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateComptonCameraConeStream::Add(const GateComptonCameraCones & cone,
+                                      G4int runID, G4int eventID, G4int coincID)
+{
+  Record r;
+  r.runID = runID;
+  r.eventID = eventID;
+  r.coincID = coincID;
+  r.energy1 = cone.GetEnergy1()/MeV;
+  r.energy2 = cone.GetEnergy2()/MeV;
+  r.energyR = cone.GetEnergyR()/MeV;
+  for (int i = 0; i < 3; i++) {
+    r.position1[i] = cone.GetPosition1()[i]/mm;
+    r.position2[i] = cone.GetPosition2()[i]/mm;
+    r.position3[i] = cone.GetPosition3()[i]/mm;
+  }
+  r.nSingles = cone.GetNumSingles();
+  r.trueFlag = cone.GetTrueFlag();
+
+  if (mFileWriter.is_started()) mFileWriter.append(&r, sizeof(Record));
+  if (mBackProjectionWriter.is_started()) mBackProjectionWriter.append(&r, sizeof(Record));
+  mNumberOfCones++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateComptonCameraConeStream::Close()
+{
+  if (!mIsOpen) return;
+  mFileWriter.stop();
+  if (pFile) {
+    fclose(pFile);
+    pFile = 0;
+  }
+  if (mBackProjectionWriter.is_started()) {
+    mBackProjectionWriter.stop();
+    mImage.Write(mImageFileName);
+  }
+  GateMessage("Actor", 1, "Compton camera: " << mNumberOfCones << " cone(s) written\n");
+  mIsOpen = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateComptonCameraConeStream::BackProject(const std::vector<char> & block)
+{
+  int nbPlanes = mImage.GetResolution().z();
+  unsigned int n = mNumberOfThreads;
+  if (n == 0) n = std::thread::hardware_concurrency();
+  if (n == 0) n = 1;
+  if (n > (unsigned int)nbPlanes) n = nbPlanes;
+
+  // Each thread owns a slab of planes, no synchronisation needed on the image
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < n; t++)
+    threads.emplace_back(&GateComptonCameraConeStream::BackProjectPlanes, this, std::cref(block),
+                         t*nbPlanes/n, (t+1)*nbPlanes/n);
+  BackProjectPlanes(block, 0, nbPlanes/n);
+  for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateComptonCameraConeStream::BackProjectPlanes(const std::vector<char> & block,
+                                                    int firstPlane, int lastPlane)
+{
+  const int nbRecords = block.size()/sizeof(Record);
+  const int lineSize = mImage.GetLineSize();
+  const int nbLines = mImage.GetResolution().y();
+  for (int c = 0; c < nbRecords; c++) {
+    Record r;
+    memcpy(&r, block.data() + c*sizeof(Record), sizeof(Record));
+    if (r.nSingles < 2 || r.energyR <= 0) continue;
+
+    // Cone with apex at the first interaction, axis from the second to the
+    // first interaction, half angle from the Compton formula
+    G4double e0 = (r.energy1 + r.energyR)*MeV;
+    G4double cosTheta = 1.0 - electron_mass_c2*(1.0/(r.energyR*MeV) - 1.0/e0);
+    if (cosTheta < -1.0 || cosTheta > 1.0) continue;
+    G4double theta = std::acos(cosTheta);
+    G4ThreeVector apex(r.position1[0]*mm, r.position1[1]*mm, r.position1[2]*mm);
+    G4ThreeVector axis = apex - G4ThreeVector(r.position2[0]*mm, r.position2[1]*mm, r.position2[2]*mm);
+    if (axis.mag2() == 0) continue;
+    axis = axis.unit();
+
+    for (int k = firstPlane; k < lastPlane; k++)
+      for (int j = 0; j < nbLines; j++)
+        for (int i = 0; i < lineSize; i++) {
+          G4ThreeVector d = mImage.GetVoxelCenterFromCoordinates(G4ThreeVector(i, j, k)) + mPosition - apex;
+          G4double distance = d.mag();
+          if (distance > 0) {
+            G4double cosAlpha = std::min(1.0, std::max(-1.0, d.dot(axis)/distance));
+            G4double delta = std::fabs(std::acos(cosAlpha) - theta);
+            if (delta < halfpi) distance *= std::sin(delta);
+          }
+          if (distance <= mWidth) mImage.AddValue(i + j*lineSize + k*mImage.GetPlaneSize(), 1.0);
+        }
+  }
+}
+//-----------------------------------------------------------------------------
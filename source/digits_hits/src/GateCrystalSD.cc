@@ -285,6 +285,7 @@ G4bool GateCrystalSD::ProcessHits(G4Step*aStep, G4TouchableHistory*)
   aHit->SetMomentumDir( momentumDirection );
   aHit->SetParentID( parentID );
   aHit->SetVolumeID( volumeID );
+  aHit->SetWeight( oldStepPoint->GetWeight() );
 
   aHit->SetSourceType( source_type );
   aHit->SetDecayType( decay_type );
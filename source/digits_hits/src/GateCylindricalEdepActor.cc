@@ -181,10 +181,10 @@ void GateCylindricalEdepActor::UserPreTrackActionInVoxel(const int /*index*/, co
 void GateCylindricalEdepActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
   GateDebugMessageInc("Actor", 4, "GateCylindricalEdepActor -- UserSteppingActionInVoxel - begin\n");
   GateDebugMessageInc("Actor", 4, "enedepo = " << step->GetTotalEnergyDeposit() << Gateendl);
-  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetTrack()->GetWeight() << Gateendl);
+  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetPreStepPoint()->GetWeight() << Gateendl);
 
 
-	  const double weight = step->GetTrack()->GetWeight();
+	  const double weight = step->GetPreStepPoint()->GetWeight();
 
   // if energy is deposited outside image => do nothing
 
@@ -203,7 +203,7 @@ void GateCylindricalEdepActor::UserSteppingActionInVoxel(const int index, const
     
   if (mIsEdepImageEnabled || mIsDoseImageEnabled) {
 	  
-	  const double edep = step->GetTotalEnergyDeposit()/MeV*weight;//*step->GetTrack()->GetWeight();
+	  const double edep = step->GetTotalEnergyDeposit()/MeV*weight;//*step->GetPreStepPoint()->GetWeight();
   
 	  // if no energy is deposited => do nothing
 	  if (edep == 0) {
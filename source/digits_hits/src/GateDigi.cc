@@ -44,6 +44,15 @@ GateDigi::GateDigi(const void* itsMother):
       m_localPosError(0.0),
       m_mother(itsMother)
 {
+  m_weight = 1.;
+}
+
+void GateDigi::MergeWeight(const GateDigi* right)
+{
+  // Same weight for all the hits of a pulse without splitting: unchanged
+  G4double totalEnergy = m_energy + right->m_energy;
+  if (totalEnergy > 0)
+    m_weight = (m_weight * m_energy + right->m_weight * right->m_energy) / totalEnergy;
 }
 
 void GateDigi::Draw()
@@ -104,6 +104,7 @@ void GateDigitizerInitializationModule::Digitize()
     		    Digi->SetOptical( (*inHC)[i]->GetPDGEncoding() == -22);
     		  #endif
     		  Digi->SetNSeptal( (*inHC)[i]->GetNSeptal() );  // HDS : septal penetration
+    		  Digi->SetWeight( (*inHC)[i]->GetWeight() );
 
     		  // AE : Added for IdealComptonPhot adder which take into account several Comptons in the same volume
     		  Digi->SetPostStepProcess((*inHC)[i]->GetPostStepProcess());
@@ -28,6 +28,7 @@
 #include "G4SystemOfUnits.hh"
 #include "G4DigiManager.hh"
 #include "G4RunManager.hh"
+#include "G4ProcessTable.hh"
 
 #include "GateVDigitizerModule.hh"
 
@@ -76,6 +77,15 @@ void GateDigitizerMgr::Initialize()
 
 	G4DigiManager *fDM = G4DigiManager::GetDMpointer();
 
+	// The WeightWindow process splits the tracks: the hits carry the weights,
+	// but the singles and coincidences count every copy as a full event
+	G4ProcessVector *weightWindow = G4ProcessTable::GetProcessTable()->FindProcesses("WeightWindow");
+	if (weightWindow->size() > 0 && (m_SingleDigitizersList.size() > 0 || m_CoincidenceSortersList.size() > 0))
+		GateWarning("The WeightWindow process is used with a digitizer or a coincidence sorter: "
+		            "the singles and coincidences do not combine the weights of the hits, "
+		            "their counts are not those of the analog simulation. Use the weighted hits or a scoring actor.");
+	delete weightWindow;
+
 
 	//For SinglesDigitizers:
 	//  - Setting collectionID for all DMs
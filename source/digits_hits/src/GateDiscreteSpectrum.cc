@@ -57,8 +57,10 @@ void GateDiscreteSpectrum::FillBin(int bin, double w) {
 //-----------------------------------------------------------------------------
 int GateDiscreteSpectrum::AddDiscreteEnergy(double e)
 {
-  spectrum.push_back(std::make_pair(e, 0.0));
-  std::sort(spectrum.begin(), spectrum.end());
-  return GetDiscreteEnergy(e);
+  // insert at the sorted position (no full re-sort for each new line)
+  std::vector<EnergyValuePair>::iterator pos;
+  pos = std::lower_bound(spectrum.begin(), spectrum.end(), e, GateDiscreteSpectrum::cmp);
+  pos = spectrum.insert(pos, std::make_pair(e, 0.0));
+  return pos-spectrum.begin();
 }
 //-----------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 // gate
 #include "GateDoseActor.hh"
 #include "GateMiscFunctions.hh"
+#include "GateUtilityForG4ThreeVector.hh"
 
 // g4
 #include <G4EmCalculator.hh>
@@ -25,6 +26,7 @@
 #include <G4Positron.hh>
 #include <G4Deuteron.hh>
 #include <G4Electron.hh>
+#include <Randomize.hh>
 
 #include "G4MaterialTable.hh"
 #include "G4ParticleTable.hh"
@@ -70,6 +72,8 @@ GateDoseActor::GateDoseActor(G4String name, G4int depth):
   mMaterialFilter = "";
   mTestFlag = false;
   mDoseByRegionsFlag = false;
+  mIsROIEnabled = false;
+  mROIIndex = -1;
 
   pMessenger = new GateDoseActorMessenger(this);
   GateDebugMessageDec("Actor",4,"GateDoseActor() -- end\n");
@@ -105,39 +109,64 @@ bool IsEqual(G4ThreeVector a, G4ThreeVector b, double tol)
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+// Used for the region of interest only
+static void AddToImage(GateImageWithStatistic & image, bool withStatistic, bool sameEvent, int index, double value)
+{
+  if (withStatistic) {
+    if (sameEvent) image.AddTempValue(index, value);
+    else image.AddValueAndUpdate(index, value);
+  }
+  else image.AddValue(index, value);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void GateDoseActor::EnableDoseNormalisationToMax(bool b) {
   mIsDoseNormalisationEnabled = b;
   mDoseImage.SetNormalizeToMax(b);
   mDoseImage.SetScaleFactor(1.0);
+  mROIDoseImage.SetNormalizeToMax(b);
+  mROIDoseImage.SetScaleFactor(1.0);
 }
 //-----------------------------------------------------------------------------
 void GateDoseActor::EnableDoseNormalisationToIntegral(bool b) {
   mIsDoseNormalisationEnabled = b;
   mDoseImage.SetNormalizeToIntegral(b);
   mDoseImage.SetScaleFactor(1.0);
+  mROIDoseImage.SetNormalizeToIntegral(b);
+  mROIDoseImage.SetScaleFactor(1.0);
 }
 void GateDoseActor::EnableDoseToWaterNormalisationToMax(bool b) {
   mIsDoseToWaterNormalisationEnabled = b;
   mDoseToWaterImage.SetNormalizeToMax(b);
   mDoseToWaterImage.SetScaleFactor(1.0);
+  mROIDoseToWaterImage.SetNormalizeToMax(b);
+  mROIDoseToWaterImage.SetScaleFactor(1.0);
 }
 //-----------------------------------------------------------------------------
 void GateDoseActor::EnableDoseToWaterNormalisationToIntegral(bool b) {
   mIsDoseToWaterNormalisationEnabled = b;
   mDoseToWaterImage.SetNormalizeToIntegral(b);
   mDoseToWaterImage.SetScaleFactor(1.0);
+  mROIDoseToWaterImage.SetNormalizeToIntegral(b);
+  mROIDoseToWaterImage.SetScaleFactor(1.0);
 }//-----------------------------------------------------------------------------
 void GateDoseActor::EnableDoseToOtherMaterialNormalisationToMax(bool b) {
   mIsDoseToOtherMaterialNormalisationEnabled = b;
   mDoseToOtherMaterialImage.SetNormalizeToMax(b);
   mDoseToOtherMaterialImage.SetScaleFactor(1.0);
+  mROIDoseToOtherMaterialImage.SetNormalizeToMax(b);
+  mROIDoseToOtherMaterialImage.SetScaleFactor(1.0);
 }
 //-----------------------------------------------------------------------------
 void GateDoseActor::EnableDoseToOtherMaterialNormalisationToIntegral(bool b) {
   mIsDoseToOtherMaterialNormalisationEnabled = b;
   mDoseToOtherMaterialImage.SetNormalizeToIntegral(b);
   mDoseToOtherMaterialImage.SetScaleFactor(1.0);
+  mROIDoseToOtherMaterialImage.SetNormalizeToIntegral(b);
+  mROIDoseToOtherMaterialImage.SetScaleFactor(1.0);
 }//-----------------------------------------------------------------------------
 void GateDoseActor::SetEfficiencyFile(G4String b) {
   mDoseEfficiencyFile = b;
@@ -323,6 +352,8 @@ void GateDoseActor::Construct() {
     mNumberOfHitsImage.Allocate();
   }
 
+  if (mIsROIEnabled) ConstructROI();
+
   if (mIsDoseImageEnabled &&
       (mExportMassImage != "" || mDoseAlgorithmType == "MassWeighting" ||
        mVolumeFilter != ""    || mMaterialFilter != "")) {
@@ -389,6 +420,7 @@ void GateDoseActor::Construct() {
               "\tDoseByRegionsInput        = " << mDoseByRegionsInputFilename << Gateendl <<
               "\tDoseByRegionsOutput       = " << mDoseByRegionsOutputFilename << Gateendl <<
               "\tNumber of regions         = " << mMapIdToSingleRegion.size() << Gateendl <<
+              "\tRegion of interest        = " << mIsROIEnabled << Gateendl <<
               "\tNb Hits filename  = " << mNbOfHitsFilename << Gateendl);
 
   ResetData();
@@ -397,6 +429,71 @@ void GateDoseActor::Construct() {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+/// Fine grid of the region of interest
+void GateDoseActor::ConstructROI() {
+  if (mROIVoxelSize.x() <= 0 || mROIVoxelSize.y() <= 0 || mROIVoxelSize.z() <= 0)
+    GateError("The DoseActor " << GetObjectName() << " needs setROIVoxelSize with setROISize.");
+  if (mDoseAlgorithmType == "MassWeighting" || mVolumeFilter != "" || mMaterialFilter != "")
+    GateError("The DoseActor " << GetObjectName() << " : the region of interest is not available with the MassWeighting algorithm or the filters.");
+  if (mStepHitType == RandomStepHitTypeCylindricalCS || mStepHitType == PostStepHitTypeCylindricalCS)
+    GateError("The DoseActor " << GetObjectName() << " : the region of interest is not available with cylindrical hit types.");
+
+  // Whole number of fine voxels, the size of the region is adjusted
+  G4ThreeVector resolution;
+  for (int i=0; i<3; i++)
+    resolution[i] = std::max(1, (int)lrint(2.0*mROIHalfSize[i]/mROIVoxelSize[i]));
+  mROIHalfSize = KroneckerProduct(resolution, mROIVoxelSize)/2.0;
+
+  double tol = 0.000001;
+  for (int i=0; i<3; i++) {
+    if (mROIPosition[i]-mROIHalfSize[i] < -mHalfSize[i]-tol || mROIPosition[i]+mROIHalfSize[i] > mHalfSize[i]+tol)
+      GateError("The DoseActor " << GetObjectName() << " : the region of interest must be inside the dose image.");
+  }
+  mROIImage.SetResolutionAndHalfSize(resolution, mROIHalfSize);
+
+  // Same frame as the dose image, shifted to the corner of the region
+  G4ThreeVector origin = mOrigin + mHalfSize + mROIPosition - mROIHalfSize;
+  auto allocate = [&](GateImageWithStatistic & image, bool squared, bool uncertainty, G4String filename) {
+    SetOriginTransformAndFlagToImage(image);
+    image.SetOrigin(origin);
+    image.EnableSquaredImage(squared || uncertainty);
+    image.EnableUncertaintyImage(uncertainty);
+    image.SetResolutionAndHalfSize(resolution, mROIHalfSize);
+    image.Allocate();
+    image.SetFilename(G4String(removeExtension(filename))+"-ROI."+G4String(getExtension(filename)));
+  };
+  if (mIsEdepImageEnabled)
+    allocate(mROIEdepImage, mIsEdepSquaredImageEnabled, mIsEdepUncertaintyImageEnabled, mEdepFilename);
+  if (mIsDoseImageEnabled)
+    allocate(mROIDoseImage, mIsDoseSquaredImageEnabled, mIsDoseUncertaintyImageEnabled, mDoseFilename);
+  if (mIsDoseToWaterImageEnabled)
+    allocate(mROIDoseToWaterImage, mIsDoseToWaterSquaredImageEnabled,
+             mIsDoseToWaterUncertaintyImageEnabled, mDoseToWaterFilename);
+  if (mIsDoseToOtherMaterialImageEnabled)
+    allocate(mROIDoseToOtherMaterialImage, mIsDoseToOtherMaterialSquaredImageEnabled,
+             mIsDoseToOtherMaterialUncertaintyImageEnabled, mDoseToOtherMaterialFilename);
+  if (mIsLastHitEventImageEnabled) {
+    SetOriginTransformAndFlagToImage(mROILastHitEventImage);
+    mROILastHitEventImage.SetOrigin(origin);
+    mROILastHitEventImage.SetResolutionAndHalfSize(resolution, mROIHalfSize);
+    mROILastHitEventImage.Allocate();
+  }
+  if (mIsNumberOfHitsImageEnabled) {
+    SetOriginTransformAndFlagToImage(mROINumberOfHitsImage);
+    mROINumberOfHitsImage.SetOrigin(origin);
+    mROINumberOfHitsImage.SetResolutionAndHalfSize(resolution, mROIHalfSize);
+    mROINumberOfHitsImage.Allocate();
+    mROINbOfHitsFilename = G4String(removeExtension(mNbOfHitsFilename))+"-ROI."+G4String(getExtension(mNbOfHitsFilename));
+  }
+
+  GateMessage("Actor", 1, "DoseActor '" << GetObjectName() << "' : region of interest of "
+              << resolution.x() << "x" << resolution.y() << "x" << resolution.z() << " voxels of "
+              << G4BestUnit(mROIVoxelSize, "Length") << " at " << G4BestUnit(mROIPosition, "Length") << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 /// Save data
 void GateDoseActor::SaveData() {
@@ -437,6 +534,22 @@ void GateDoseActor::SaveData() {
     mNumberOfHitsImage.Write(f);
   }
 
+  //Region of interest
+  if (mIsROIEnabled) {
+    if (mIsEdepImageEnabled) mROIEdepImage.SaveData(mCurrentEvent+1);
+    if (mIsDoseImageEnabled) mROIDoseImage.SaveData(mCurrentEvent+1, mIsDoseNormalisationEnabled);
+    if (mIsDoseToWaterImageEnabled)
+      mROIDoseToWaterImage.SaveData(mCurrentEvent+1, mIsDoseToWaterNormalisationEnabled);
+    if (mIsDoseToOtherMaterialImageEnabled)
+      mROIDoseToOtherMaterialImage.SaveData(mCurrentEvent+1, mIsDoseToOtherMaterialNormalisationEnabled);
+    if (mIsLastHitEventImageEnabled) mROILastHitEventImage.Fill(-1);
+    if (mIsNumberOfHitsImageEnabled) {
+      G4String f = mROINbOfHitsFilename;
+      if (!mOverWriteFilesFlag) f = GetSaveCurrentFilename(mROINbOfHitsFilename);
+      mROINumberOfHitsImage.Write(f);
+    }
+  }
+
   if (mDoseByRegionsFlag) {
     // Finish unfinished squared dose
     for (auto & m:mMapLabelToSeveralRegions)
@@ -486,6 +599,142 @@ void GateDoseActor::ResetData() {
   if (mIsDoseToWaterImageEnabled) mDoseToWaterImage.Reset();
   if (mIsDoseToOtherMaterialImageEnabled) mDoseToOtherMaterialImage.Reset();
   if (mIsNumberOfHitsImageEnabled) mNumberOfHitsImage.Fill(0);
+  if (mIsROIEnabled) {
+    if (mIsLastHitEventImageEnabled) mROILastHitEventImage.Fill(-1);
+    if (mIsEdepImageEnabled) mROIEdepImage.Reset();
+    if (mIsDoseImageEnabled) mROIDoseImage.Reset();
+    if (mIsDoseToWaterImageEnabled) mROIDoseToWaterImage.Reset();
+    if (mIsDoseToOtherMaterialImageEnabled) mROIDoseToOtherMaterialImage.Reset();
+    if (mIsNumberOfHitsImageEnabled) mROINumberOfHitsImage.Fill(0);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateDoseActor::SaveCheckpoint(GateCheckpointWriter & w) {
+  w.Write("currentEvent", mCurrentEvent);
+  if (mIsEdepImageEnabled) mEdepImage.SaveCheckpoint(w, "edep");
+  if (mIsDoseImageEnabled) mDoseImage.SaveCheckpoint(w, "dose");
+  if (mIsDoseToWaterImageEnabled) mDoseToWaterImage.SaveCheckpoint(w, "doseToWater");
+  if (mIsDoseToOtherMaterialImageEnabled) mDoseToOtherMaterialImage.SaveCheckpoint(w, "doseToOtherMaterial");
+  if (mIsNumberOfHitsImageEnabled) w.WriteImage("numberOfHits", mNumberOfHitsImage);
+  if (mIsLastHitEventImageEnabled) w.WriteImage("lastHitEvent", mLastHitEventImage);
+  if (mIsROIEnabled) {
+    if (mIsEdepImageEnabled) mROIEdepImage.SaveCheckpoint(w, "roi/edep");
+    if (mIsDoseImageEnabled) mROIDoseImage.SaveCheckpoint(w, "roi/dose");
+    if (mIsDoseToWaterImageEnabled) mROIDoseToWaterImage.SaveCheckpoint(w, "roi/doseToWater");
+    if (mIsDoseToOtherMaterialImageEnabled) mROIDoseToOtherMaterialImage.SaveCheckpoint(w, "roi/doseToOtherMaterial");
+    if (mIsNumberOfHitsImageEnabled) w.WriteImage("roi/numberOfHits", mROINumberOfHitsImage);
+    if (mIsLastHitEventImageEnabled) w.WriteImage("roi/lastHitEvent", mROILastHitEventImage);
+  }
+  if (mDoseByRegionsFlag) {
+    for(auto & p:mMapIdToSingleRegion) {
+      auto region = p.second;
+      double sums[6] = { region->sum_edep, region->sum_squared_edep, region->sum_temp_edep,
+                         region->sum_dose, region->sum_squared_dose, region->sum_temp_dose };
+      long counts[3] = { region->last_event_id, region->nb_hits, region->nb_event_hits };
+      w.Write("region/"+std::to_string(p.first)+"/sums", sums);
+      w.Write("region/"+std::to_string(p.first)+"/counts", counts);
+    }
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseActor::LoadCheckpoint(GateCheckpointReader & r) {
+  r.Read("currentEvent", mCurrentEvent);
+  if (mIsEdepImageEnabled) mEdepImage.LoadCheckpoint(r, "edep");
+  if (mIsDoseImageEnabled) mDoseImage.LoadCheckpoint(r, "dose");
+  if (mIsDoseToWaterImageEnabled) mDoseToWaterImage.LoadCheckpoint(r, "doseToWater");
+  if (mIsDoseToOtherMaterialImageEnabled) mDoseToOtherMaterialImage.LoadCheckpoint(r, "doseToOtherMaterial");
+  if (mIsNumberOfHitsImageEnabled) r.ReadImage("numberOfHits", mNumberOfHitsImage);
+  if (mIsLastHitEventImageEnabled) r.ReadImage("lastHitEvent", mLastHitEventImage);
+  if (mIsROIEnabled) {
+    if (mIsEdepImageEnabled) mROIEdepImage.LoadCheckpoint(r, "roi/edep");
+    if (mIsDoseImageEnabled) mROIDoseImage.LoadCheckpoint(r, "roi/dose");
+    if (mIsDoseToWaterImageEnabled) mROIDoseToWaterImage.LoadCheckpoint(r, "roi/doseToWater");
+    if (mIsDoseToOtherMaterialImageEnabled) mROIDoseToOtherMaterialImage.LoadCheckpoint(r, "roi/doseToOtherMaterial");
+    if (mIsNumberOfHitsImageEnabled) r.ReadImage("roi/numberOfHits", mROINumberOfHitsImage);
+    if (mIsLastHitEventImageEnabled) r.ReadImage("roi/lastHitEvent", mROILastHitEventImage);
+  }
+  if (mDoseByRegionsFlag) {
+    for(auto & p:mMapIdToSingleRegion) {
+      auto region = p.second;
+      double sums[6];
+      long counts[3];
+      r.Read("region/"+std::to_string(p.first)+"/sums", sums);
+      r.Read("region/"+std::to_string(p.first)+"/counts", counts);
+      region->sum_edep = sums[0];
+      region->sum_squared_edep = sums[1];
+      region->sum_temp_edep = sums[2];
+      region->sum_dose = sums[3];
+      region->sum_squared_dose = sums[4];
+      region->sum_temp_dose = sums[5];
+      region->last_event_id = counts[0];
+      region->nb_hits = counts[1];
+      region->nb_event_hits = counts[2];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Forked mode: sums of another process. The last hit event images are not
+// merged (only used to count the hits per event).
+G4bool GateDoseActor::MergeCheckpoint(GateCheckpointReader & r) {
+  // The end of run update of the regions (see SaveData) is done again when the merged data are saved
+  if (mDoseByRegionsFlag)
+    for(auto & p:mMapIdToSingleRegion)
+      if (p.second->last_event_id == mCurrentEvent) {
+        p.second->nb_hits--;
+        p.second->nb_event_hits--;
+      }
+  int currentEvent;
+  r.Read("currentEvent", currentEvent);
+  mCurrentEvent += currentEvent+1;
+  if (mIsEdepImageEnabled) mEdepImage.MergeCheckpoint(r, "edep");
+  if (mIsDoseImageEnabled) mDoseImage.MergeCheckpoint(r, "dose");
+  if (mIsDoseToWaterImageEnabled) mDoseToWaterImage.MergeCheckpoint(r, "doseToWater");
+  if (mIsDoseToOtherMaterialImageEnabled) mDoseToOtherMaterialImage.MergeCheckpoint(r, "doseToOtherMaterial");
+  if (mIsNumberOfHitsImageEnabled) MergeNumberOfHits(r, "numberOfHits", mNumberOfHitsImage);
+  if (mIsROIEnabled) {
+    if (mIsEdepImageEnabled) mROIEdepImage.MergeCheckpoint(r, "roi/edep");
+    if (mIsDoseImageEnabled) mROIDoseImage.MergeCheckpoint(r, "roi/dose");
+    if (mIsDoseToWaterImageEnabled) mROIDoseToWaterImage.MergeCheckpoint(r, "roi/doseToWater");
+    if (mIsDoseToOtherMaterialImageEnabled) mROIDoseToOtherMaterialImage.MergeCheckpoint(r, "roi/doseToOtherMaterial");
+    if (mIsNumberOfHitsImageEnabled) MergeNumberOfHits(r, "roi/numberOfHits", mROINumberOfHitsImage);
+  }
+  if (mDoseByRegionsFlag) {
+    for(auto & p:mMapIdToSingleRegion) {
+      auto region = p.second;
+      double sums[6];
+      long counts[3];
+      r.Read("region/"+std::to_string(p.first)+"/sums", sums);
+      r.Read("region/"+std::to_string(p.first)+"/counts", counts);
+      // the pending event of the other process is added to the sums
+      region->sum_edep += sums[0] + sums[2];
+      region->sum_squared_edep += sums[1] + sums[2]*sums[2];
+      region->sum_dose += sums[3] + sums[5];
+      region->sum_squared_dose += sums[4] + sums[5]*sums[5];
+      // each process counted one more hit and event at its end of run update (see SaveData)
+      region->nb_hits += counts[1]-1;
+      region->nb_event_hits += counts[2]-1;
+    }
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseActor::MergeNumberOfHits(GateCheckpointReader & r, const G4String & key, GateImageInt & image) {
+  std::vector<int> hits(image.GetNumberOfValues());
+  r.ReadArray(key, hits.data(), hits.size());
+  for (size_t i = 0; i < hits.size(); i++) image.AddValue(i, hits[i]);
 }
 //-----------------------------------------------------------------------------
 
@@ -519,12 +768,44 @@ void GateDoseActor::UserPreTrackActionInVoxel(const int /*index*/, const G4Track
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+void GateDoseActor::UserSteppingAction(const GateVVolume * v, const G4Step * step)
+{
+  if (!mIsROIEnabled) {
+    GateVImageActor::UserSteppingAction(v, step);
+    return;
+  }
+
+  // The hit point is chosen once, then looked up in the coarse grid and in
+  // the fine grid of the region of interest
+  int index = -1;
+  mROIIndex = -1;
+  G4ThreeVector prePosition, postPosition;
+  if (GetStepPositions2(GetVolume(), step, mPositionIsSet, mPosition, prePosition, postPosition)) {
+    G4ThreeVector direction = postPosition - prePosition;
+    if (mStepHitType == PreStepHitType || mStepHitType == PostStepHitType) {
+      G4ThreeVector p = (mStepHitType == PreStepHitType) ? prePosition : postPosition;
+      index = mImage.GetIndexFromPostPositionAndDirection(p, direction);
+      if (index >= 0) mROIIndex = mROIImage.GetIndexFromPostPositionAndDirection(p - mROIPosition, direction);
+    }
+    else {
+      G4ThreeVector p = (prePosition + postPosition)/2.;
+      if (mStepHitType == RandomStepHitType) p = prePosition + G4UniformRand()*direction;
+      index = mImage.GetIndexFromPosition(p);
+      if (index >= 0) mROIIndex = mROIImage.GetIndexFromPosition(p - mROIPosition);
+    }
+  }
+  UserSteppingActionInVoxel(index, step);
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void GateDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
   GateDebugMessageInc("Actor", 4, "GateDoseActor -- UserSteppingActionInVoxel - begin\n");
   GateDebugMessageInc("Actor", 4, "enedepo = " << step->GetTotalEnergyDeposit() << Gateendl);
-  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetTrack()->GetWeight() << Gateendl);
-  const double weight = step->GetTrack()->GetWeight();
+  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetPreStepPoint()->GetWeight() << Gateendl);
+  const double weight = step->GetPreStepPoint()->GetWeight();
   const double edep = step->GetTotalEnergyDeposit()*weight;
   //current material
   G4Material * current_material = step->GetPreStepPoint()->GetMaterial();
@@ -878,6 +1159,30 @@ void GateDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* ste
     for(auto & r:regions) r->Update(mCurrentEvent, edep, density);
   }
 
+  //Region of interest: same deposit, dose in the smaller voxel
+  if (mIsROIEnabled && mROIIndex >= 0) {
+    bool sameROIEvent = true;
+    if (mIsLastHitEventImageEnabled && mCurrentEvent != mROILastHitEventImage.GetValue(mROIIndex)) {
+      sameROIEvent = false;
+      mROILastHitEventImage.SetValue(mROIIndex, mCurrentEvent);
+    }
+    const double f = VoxelVolume/mROIImage.GetVoxelVolume();
+    if (mIsEdepImageEnabled)
+      AddToImage(mROIEdepImage, mIsEdepUncertaintyImageEnabled || mIsEdepSquaredImageEnabled,
+                 sameROIEvent, mROIIndex, edep);
+    if (mIsDoseImageEnabled)
+      AddToImage(mROIDoseImage, mIsDoseUncertaintyImageEnabled || mIsDoseSquaredImageEnabled,
+                 sameROIEvent, mROIIndex, dose*f);
+    if (mIsDoseToWaterImageEnabled)
+      AddToImage(mROIDoseToWaterImage, mIsDoseToWaterUncertaintyImageEnabled || mIsDoseToWaterSquaredImageEnabled,
+                 sameROIEvent, mROIIndex, doseToWater*f);
+    if (mIsDoseToOtherMaterialImageEnabled)
+      AddToImage(mROIDoseToOtherMaterialImage,
+                 mIsDoseToOtherMaterialUncertaintyImageEnabled || mIsDoseToOtherMaterialSquaredImageEnabled,
+                 sameROIEvent, mROIIndex, DoseToOtherMaterial*f);
+    if (mIsNumberOfHitsImageEnabled) mROINumberOfHitsImage.AddValue(mROIIndex, weight);
+  }
+
   GateDebugMessageDec("Actor", 4, "GateDoseActor -- UserSteppingActionInVoxel -- end\n");
 }
 //-----------------------------------------------------------------------------
@@ -54,6 +54,10 @@ GateDoseActorMessenger::GateDoseActorMessenger(GateDoseActor* sensor)
   pDoseRegionInputCmd = 0;
   pDoseRegionOutputCmd = 0;
   pDoseRegionAddRegionCmd = 0;
+  //Region of interest
+  pROISizeCmd = 0;
+  pROIPositionCmd = 0;
+  pROIVoxelSizeCmd = 0;
 
   BuildCommands(baseName+sensor->GetObjectName());
 }
@@ -100,6 +104,10 @@ GateDoseActorMessenger::~GateDoseActorMessenger()
   if(pDoseRegionOutputCmd) delete pDoseRegionOutputCmd;
   if(pDoseRegionInputCmd) delete pDoseRegionInputCmd;
   if(pDoseRegionAddRegionCmd) delete pDoseRegionAddRegionCmd;
+
+  if(pROISizeCmd) delete pROISizeCmd;
+  if(pROIPositionCmd) delete pROIPositionCmd;
+  if(pROIVoxelSizeCmd) delete pROIVoxelSizeCmd;
 }
 //-----------------------------------------------------------------------------
 
@@ -266,6 +274,26 @@ void GateDoseActorMessenger::BuildCommands(G4String base)
   pDoseRegionAddRegionCmd->SetGuidance("newRegionLabel: imageLabel, imageLabel, ...");
   pDoseRegionAddRegionCmd->SetParameterName("New region",false);
 
+  n = base+"/setROISize";
+  pROISizeCmd = new G4UIcmdWith3VectorAndUnit(n, this);
+  guid = G4String("Size of the region of interest scored with a finer grid (enables the region of interest).");
+  pROISizeCmd->SetGuidance(guid);
+  pROISizeCmd->SetParameterName("size_x","size_y", "size_z", false, false);
+  pROISizeCmd->SetDefaultUnit("mm");
+
+  n = base+"/setROIPosition";
+  pROIPositionCmd = new G4UIcmdWith3VectorAndUnit(n, this);
+  guid = G4String("Center of the region of interest, relative to the center of the dose image.");
+  pROIPositionCmd->SetGuidance(guid);
+  pROIPositionCmd->SetParameterName("position_x","position_y", "position_z", false, false);
+  pROIPositionCmd->SetDefaultUnit("mm");
+
+  n = base+"/setROIVoxelSize";
+  pROIVoxelSizeCmd = new G4UIcmdWith3VectorAndUnit(n, this);
+  guid = G4String("Voxel size of the region of interest grid.");
+  pROIVoxelSizeCmd->SetGuidance(guid);
+  pROIVoxelSizeCmd->SetParameterName("voxelsize_x","voxelsize_y", "voxelsize_z", false, false);
+  pROIVoxelSizeCmd->SetDefaultUnit("mm");
 }
 //-----------------------------------------------------------------------------
 
@@ -312,6 +340,10 @@ void GateDoseActorMessenger::SetNewValue(G4UIcommand* cmd, G4String newValue)
   if (cmd == pDoseRegionInputCmd) pDoseActor->SetDoseByRegionsInputFilename(newValue);
   if (cmd == pDoseRegionOutputCmd) pDoseActor->SetDoseByRegionsOutputFilename(newValue);
   if (cmd == pDoseRegionAddRegionCmd) pDoseActor->AddRegion(newValue);
+  //Region of interest
+  if (cmd == pROISizeCmd) pDoseActor->SetROISize(pROISizeCmd->GetNew3VectorValue(newValue));
+  if (cmd == pROIPositionCmd) pDoseActor->SetROIPosition(pROIPositionCmd->GetNew3VectorValue(newValue));
+  if (cmd == pROIVoxelSizeCmd) pDoseActor->SetROIVoxelSize(pROIVoxelSizeCmd->GetNew3VectorValue(newValue));
 
   GateImageActorMessenger::SetNewValue( cmd, newValue);
 }
@@ -0,0 +1,202 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <G4SystemOfUnits.hh>
+
+#include "GateConfiguration.h"
+#include "GateDoseInfluenceMatrixActor.hh"
+#include "GateDoseInfluenceMatrixActorMessenger.hh"
+
+//-----------------------------------------------------------------------------
+GateDoseInfluenceMatrixActor::GateDoseInfluenceMatrixActor(G4String name, G4int depth):
+  GateVImageActor(name, depth)
+{
+  pMessenger = new GateDoseInfluenceMatrixActorMessenger(this);
+  pTPSSource = 0;
+  mSourceName = "";
+  mSpotOrNot = true;
+  mIsInitialized = false;
+  mRelativeThreshold = 0;
+  mAbsoluteThreshold = 0;
+  mCurrentColumn = -1;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateDoseInfluenceMatrixActor::~GateDoseInfluenceMatrixActor()
+{
+  delete pMessenger;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::Construct()
+{
+  GateVImageActor::Construct();
+
+  // Enable callbacks
+  EnableBeginOfRunAction(false);
+  EnableBeginOfEventAction(true);
+  EnablePreUserTrackingAction(false);
+  EnablePostUserTrackingAction(false);
+  EnableUserSteppingAction(true);
+
+  // Force hit type to random
+  if (mStepHitType != RandomStepHitType) {
+    GateWarning("Actor '" << GetName() << "' : stepHitType forced to 'random'" << std::endl);
+    SetStepHitType("random");
+  }
+
+  if (mSourceName == "")
+    GateError("Actor '" << GetName() << "' : the TPS pencil beam source must be given with "
+              << "enableSpotIDFromSource or enableLayerIDFromSource");
+
+  ResetData();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::ResetData()
+{
+  for (size_t i = 0; i < mColumns.size(); i++) mColumns[i].clear();
+  std::fill(mNumberOfPrimaries.begin(), mNumberOfPrimaries.end(), 0);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::BeginOfEventAction(const G4Event *)
+{
+  // Sources are initialized after the actors: the number of spots is only known here
+  if (!mIsInitialized) {
+    pTPSSource = dynamic_cast<GateSourceTPSPencilBeam *>(GateSourceMgr::GetInstance()->GetSourceByName(mSourceName));
+    if (!pTPSSource)
+      GateError("Actor '" << GetName() << "' : " << mSourceName << " is not a TPS pencil beam source");
+    int nbColumns = mSpotOrNot ? pTPSSource->GetTotalNumberOfSpots() : pTPSSource->GetTotalNumberOfLayers();
+    mColumns.resize(nbColumns);
+    mNumberOfPrimaries.resize(nbColumns, 0);
+    GateMessage("Actor", 1, "Actor '" << GetName() << "' : influence matrix of " << mImage.GetNumberOfValues()
+                << " voxels x " << nbColumns << (mSpotOrNot ? " spots" : " layers") << Gateendl);
+    mIsInitialized = true;
+  }
+
+  mCurrentColumn = mSpotOrNot ? pTPSSource->GetCurrentSpotID() : pTPSSource->GetCurrentLayerID();
+  if (mCurrentColumn < 0 || mCurrentColumn >= (G4int)mColumns.size()) {
+    mCurrentColumn = -1;
+    return;
+  }
+  mNumberOfPrimaries[mCurrentColumn]++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::UserPostTrackActionInVoxel(const int, const G4Track *)
+{
+  // Nothing (but must be implemented because virtual)
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::UserPreTrackActionInVoxel(const int, const G4Track *)
+{
+  // Nothing (but must be implemented because virtual)
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::UserSteppingActionInVoxel(const int index, const G4Step *step)
+{
+  if (index < 0 || mCurrentColumn < 0) return;
+
+  const double edep = step->GetTotalEnergyDeposit()*step->GetPreStepPoint()->GetWeight();
+  if (edep == 0) return;
+
+  const double density = step->GetPreStepPoint()->GetMaterial()->GetDensity();
+  mColumns[mCurrentColumn][index] += edep/density/mImage.GetVoxelVolume()/gray;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActor::SaveData()
+{
+  GateVActor::SaveData();
+
+  const std::int64_t nbRows = mImage.GetNumberOfValues();
+  const std::int64_t nbColumns = mColumns.size();
+
+  // Number of values kept in each row, after thresholding
+  std::vector<G4double> columnThresholds(nbColumns, mAbsoluteThreshold);
+  std::vector<std::int64_t> rowPointers(nbRows+1, 0);
+  for (std::int64_t c = 0; c < nbColumns; c++) {
+    G4double max = 0;
+    for (const auto & v : mColumns[c]) max = std::max(max, v.second);
+    columnThresholds[c] = std::max(mAbsoluteThreshold, mRelativeThreshold*max);
+    for (const auto & v : mColumns[c])
+      if (v.second > 0 && v.second >= columnThresholds[c]) rowPointers[v.first+1]++;
+  }
+  for (std::int64_t r = 0; r < nbRows; r++) rowPointers[r+1] += rowPointers[r];
+  const std::int64_t nbValues = rowPointers[nbRows];
+
+  // Filled column by column: the columns of a row are sorted
+  std::vector<std::int32_t> columnIndices(nbValues);
+  std::vector<float> values(nbValues);
+  std::vector<std::int64_t> next(rowPointers.begin(), rowPointers.end()-1);
+  for (std::int64_t c = 0; c < nbColumns; c++)
+    for (const auto & v : mColumns[c])
+      if (v.second > 0 && v.second >= columnThresholds[c]) {
+        std::int64_t k = next[v.first]++;
+        columnIndices[k] = c;
+        values[k] = v.second;
+      }
+
+  // Binary file: header, number of primaries of each column, then the CSR arrays
+  std::ofstream os(mSaveFilename.c_str(), std::ios::binary);
+  if (!os) GateError("Actor '" << GetName() << "' : cannot open " << mSaveFilename);
+  char magic[8];
+  memcpy(magic, "GATEDIJ", 8);
+  std::uint32_t version = 1;
+  std::uint32_t columnType = mSpotOrNot ? 0 : 1;
+  std::int32_t resolution[3];
+  double voxelSize[3], origin[3];
+  for (int i = 0; i < 3; i++) {
+    resolution[i] = mImage.GetResolution()[i];
+    voxelSize[i] = mImage.GetVoxelSize()[i]/mm;
+    origin[i] = mOrigin[i]/mm;
+  }
+  os.write(magic, sizeof(magic));
+  os.write((const char*)&version, sizeof(version));
+  os.write((const char*)&columnType, sizeof(columnType));
+  os.write((const char*)resolution, sizeof(resolution));
+  os.write((const char*)voxelSize, sizeof(voxelSize));
+  os.write((const char*)origin, sizeof(origin));
+  os.write((const char*)&nbRows, sizeof(nbRows));
+  os.write((const char*)&nbColumns, sizeof(nbColumns));
+  os.write((const char*)&nbValues, sizeof(nbValues));
+  std::vector<std::int64_t> primaries(mNumberOfPrimaries.begin(), mNumberOfPrimaries.end());
+  os.write((const char*)primaries.data(), nbColumns*sizeof(std::int64_t));
+  os.write((const char*)rowPointers.data(), rowPointers.size()*sizeof(std::int64_t));
+  os.write((const char*)columnIndices.data(), nbValues*sizeof(std::int32_t));
+  os.write((const char*)values.data(), nbValues*sizeof(float));
+  if (!os) GateError("Actor '" << GetName() << "' : failed to write " << mSaveFilename);
+
+  GateMessage("Actor", 1, "Actor '" << GetName() << "' : " << nbValues << " non zero values written in "
+              << mSaveFilename << Gateendl);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "G4UIcmdWithADouble.hh"
+
+#include "GateConfiguration.h"
+#include "GateDoseInfluenceMatrixActorMessenger.hh"
+#include "GateDoseInfluenceMatrixActor.hh"
+
+//-----------------------------------------------------------------------------
+GateDoseInfluenceMatrixActorMessenger::
+GateDoseInfluenceMatrixActorMessenger(GateDoseInfluenceMatrixActor* v)
+:GateImageActorMessenger(v), pDoseInfluenceMatrixActor(v)
+{
+  BuildCommands(baseName+pActor->GetObjectName());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateDoseInfluenceMatrixActorMessenger::~GateDoseInfluenceMatrixActorMessenger()
+{
+  delete pSpotIDFromSourceCmd;
+  delete pLayerIDFromSourceCmd;
+  delete pRelativeThresholdCmd;
+  delete pAbsoluteThresholdCmd;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActorMessenger::BuildCommands(G4String base)
+{
+  G4String bb = base+"/enableSpotIDFromSource";
+  pSpotIDFromSourceCmd = new G4UIcmdWithAString(bb,this);
+  G4String guidance = "One column of the matrix per spot of the given TPS pencil beam source.";
+  pSpotIDFromSourceCmd->SetGuidance(guidance);
+
+  bb = base+"/enableLayerIDFromSource";
+  pLayerIDFromSourceCmd = new G4UIcmdWithAString(bb,this);
+  guidance = "One column of the matrix per energy layer of the given TPS pencil beam source.";
+  pLayerIDFromSourceCmd->SetGuidance(guidance);
+
+  bb = base+"/setRelativeThreshold";
+  pRelativeThresholdCmd = new G4UIcmdWithADouble(bb,this);
+  guidance = "Do not write the values below this fraction of the maximum dose of their spot (default 0).";
+  pRelativeThresholdCmd->SetGuidance(guidance);
+  pRelativeThresholdCmd->SetParameterName("Fraction", false);
+  pRelativeThresholdCmd->SetRange("Fraction>=0 && Fraction<=1");
+
+  bb = base+"/setAbsoluteThreshold";
+  pAbsoluteThresholdCmd = new G4UIcmdWithADouble(bb,this);
+  guidance = "Do not write the values below this dose in Gy (default 0).";
+  pAbsoluteThresholdCmd->SetGuidance(guidance);
+  pAbsoluteThresholdCmd->SetParameterName("Dose", false);
+  pAbsoluteThresholdCmd->SetRange("Dose>=0");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateDoseInfluenceMatrixActorMessenger::SetNewValue(G4UIcommand* cmd, G4String newValue)
+{
+  if (cmd == pSpotIDFromSourceCmd) pDoseInfluenceMatrixActor->SetSpotIDFromSource(newValue);
+  if (cmd == pLayerIDFromSourceCmd) pDoseInfluenceMatrixActor->SetLayerIDFromSource(newValue);
+  if (cmd == pRelativeThresholdCmd) pDoseInfluenceMatrixActor->SetRelativeThreshold(pRelativeThresholdCmd->GetNewDoubleValue(newValue));
+  if (cmd == pAbsoluteThresholdCmd) pDoseInfluenceMatrixActor->SetAbsoluteThreshold(pAbsoluteThresholdCmd->GetNewDoubleValue(newValue));
+  GateImageActorMessenger::SetNewValue(cmd,newValue);
+}
+//-----------------------------------------------------------------------------
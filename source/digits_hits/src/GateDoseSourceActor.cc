@@ -141,8 +141,8 @@ void GateDoseSourceActor::UserSteppingActionInVoxel(int index, const G4Step *ste
     return;
   }
   
-  const double weight = step->GetTrack()->GetWeight();
-  const double edep = step->GetTotalEnergyDeposit()*weight;//*step->GetTrack()->GetWeight();
+  const double weight = step->GetPreStepPoint()->GetWeight();
+  const double edep = step->GetTotalEnergyDeposit()*weight;//*step->GetPreStepPoint()->GetWeight();
   
   if (edep == 0) { // if no energy is deposited => do nothing
     GateDebugMessage("Actor", 5, "edep == 0 : do nothing\n");
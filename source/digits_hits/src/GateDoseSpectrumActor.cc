@@ -142,7 +142,7 @@ void GateDoseSpectrumActor::UserSteppingAction(const GateVVolume *, const G4Step
     step->GetTrack()->SetTrackStatus(fKillTrackAndSecondaries);
   }
   else {
-    mTotalEventEnergyDep += step->GetTotalEnergyDeposit()*step->GetTrack()->GetWeight();
+    mTotalEventEnergyDep += step->GetTotalEnergyDeposit()*step->GetPreStepPoint()->GetWeight();
   }
 }
 //-----------------------------------------------------------------------------
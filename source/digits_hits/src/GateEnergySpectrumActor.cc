@@ -445,7 +445,7 @@ void GateEnergySpectrumActor::PostUserTrackingAction(const GateVVolume *, const
 //-----------------------------------------------------------------------------
 void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4Step* step)
 {
-  assert(step->GetTrack()->GetWeight() == 1.); // edep doesnt handle weight
+  assert(step->GetPreStepPoint()->GetWeight() == 1.); // edep doesnt handle weight
 
   if(step->GetTotalEnergyDeposit()>0.01) sumM1+=step->GetTotalEnergyDeposit();
   else if(step->GetTotalEnergyDeposit()>0.00001) sumM2+=step->GetTotalEnergyDeposit();
@@ -518,7 +518,7 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
 
     
     if (mEnableEnergySpectrumNbPartFlag){
-        pEnergySpectrumNbPart->Fill(Ei/MeV/atomicMassScaleFactor,step->GetTrack()->GetWeight());
+        pEnergySpectrumNbPart->Fill(Ei/MeV/atomicMassScaleFactor,step->GetPreStepPoint()->GetWeight());
     }
     
     G4ThreeVector momentumDir = step->GetTrack()->GetMomentumDirection(); 
@@ -528,23 +528,23 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
         if (dz > 0){
             //double Emean = (Ei+Ef)/2/MeV;
             double invAngle = 1/dz;
-            pEnergySpectrumFluenceCos->Fill(Ei/MeV/atomicMassScaleFactor,step->GetTrack()->GetWeight()*invAngle);
+            pEnergySpectrumFluenceCos->Fill(Ei/MeV/atomicMassScaleFactor,step->GetPreStepPoint()->GetWeight()*invAngle);
         }
     }
     // uncommented A.Resch 30.Nov 2018
     //if (mSaveAsDiscreteSpectrumTextFlag) {
-      //mDiscreteSpectrum.Fill(Ei/MeV, step->GetTrack()->GetWeight());
+      //mDiscreteSpectrum.Fill(Ei/MeV, step->GetPreStepPoint()->GetWeight());
     //}
     newTrack=false;
   }
   G4double stepLength = step->GetStepLength();
    if (mEnableEnergySpectrumFluenceTrackFlag){
        
-       pEnergySpectrumFluenceTrack->Fill(Ei/MeV/atomicMassScaleFactor,step->GetTrack()->GetWeight()*stepLength/mm);
+       pEnergySpectrumFluenceTrack->Fill(Ei/MeV/atomicMassScaleFactor,step->GetPreStepPoint()->GetWeight()*stepLength/mm);
        
    }
    if (mEnableEnergySpectrumEdepFlag){
-       pEnergyEdepSpectrum->Fill(Ei/MeV/atomicMassScaleFactor,step->GetTrack()->GetWeight()*step->GetTotalEnergyDeposit()/MeV);
+       pEnergyEdepSpectrum->Fill(Ei/MeV/atomicMassScaleFactor,step->GetPreStepPoint()->GetWeight()*step->GetTotalEnergyDeposit()/MeV);
    }
   if(mEnableLETSpectrumFlag) {
       G4Material* material = step->GetPreStepPoint()->GetMaterial();//->GetName(); 
@@ -554,7 +554,7 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
       G4ParticleDefinition* partname = step->GetTrack()->GetDefinition();//->GetParticleName();
       G4double dedx;
       dedx = emcalc->ComputeElectronicDEDX(energy, partname, material);
-      pLETSpectrum->Fill(dedx/(keV/um),step->GetTrack()->GetWeight()*edep/MeV);
+      pLETSpectrum->Fill(dedx/(keV/um),step->GetPreStepPoint()->GetWeight()*edep/MeV);
             
   }  
   if(mEnableLETFluenceSpectrumFlag) {
@@ -565,7 +565,7 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
       G4ParticleDefinition* partdef = step->GetTrack()->GetDefinition();//->GetParticleName();
       G4double dedx;
       dedx = emcalc->ComputeElectronicDEDX(energyMean, partdef, material);
-      pLETFluenceSpectrum->Fill(dedx/(keV/um),step->GetTrack()->GetWeight()*stepLength/mm);
+      pLETFluenceSpectrum->Fill(dedx/(keV/um),step->GetPreStepPoint()->GetWeight()*stepLength/mm);
             
      if(mEnableLETtoMaterialFluenceSpectrumFlag) {
           
@@ -575,7 +575,7 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
           //// Mainly gamma and neutron
           //DEDX = emcalc->ComputeTotalDEDX(energy, p, current_material, cut);
           dedx = emcalc->ComputeTotalDEDX(energyMean,step->GetTrack()->GetParticleDefinition(), OtherMaterial);
-          pLETtoMaterialFluenceSpectrum->Fill(dedx/(keV/um),step->GetTrack()->GetWeight()*stepLength/mm);
+          pLETtoMaterialFluenceSpectrum->Fill(dedx/(keV/um),step->GetPreStepPoint()->GetWeight()*stepLength/mm);
      }
   }  
   
@@ -589,7 +589,7 @@ void GateEnergySpectrumActor::UserSteppingAction(const GateVVolume *, const G4St
       G4double Q =chargeQ; // to convert Int to Double
       Q*=Q; // now chargeQ is squared
       Q/=(energyQ/MeV); // now we divide chargeQ^2 / energyQ
-      pQSpectrum->Fill(Q,step->GetTrack()->GetWeight()*step->GetTotalEnergyDeposit()/MeV);
+      pQSpectrum->Fill(Q,step->GetPreStepPoint()->GetWeight()*step->GetTotalEnergyDeposit()/MeV);
   }
 }
 //-----------------------------------------------------------------------------
@@ -0,0 +1,61 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateEventTrackStore.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include <algorithm>
+
+GateEventTrackStore* GateEventTrackStore::theInstance = 0;
+
+//-----------------------------------------------------------------------------
+GateEventTrackStore* GateEventTrackStore::GetInstance()
+{
+  if (!theInstance) theInstance = new GateEventTrackStore;
+  return theInstance;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateEventTrackStore::GateEventTrackStore()
+  : mStoreTrajectoriesFlag(false), mG4TrajectoriesNeeded(true)
+{
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateEventTrackStore::Clear()
+{
+  // only reset the entries used by the previous event
+  for (size_t i=0; i<mTracks.size(); i++) mIndexOfTrackID[mTracks[i].trackID] = -1;
+  mTracks.clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateEventTrackStore::Record(const G4Track* track)
+{
+  GateTrackRecord r;
+  r.trackID = track->GetTrackID();
+  r.parentID = track->GetParentID();
+  const G4ParticleDefinition* pd = track->GetDefinition();
+  r.PDGEncoding = pd->GetPDGEncoding();
+  r.charge = pd->GetPDGCharge();
+  r.vertexPosition = track->GetVertexPosition();
+
+  if (r.trackID < 0) return;
+  if (r.trackID >= (G4int)mIndexOfTrackID.size())
+    mIndexOfTrackID.resize(std::max((size_t)r.trackID+1, 2*mIndexOfTrackID.size()), -1);
+  // as in a G4TrajectoryContainer, the first record of a track ID wins
+  if (mIndexOfTrackID[r.trackID] < 0) mIndexOfTrackID[r.trackID] = mTracks.size();
+  mTracks.push_back(r);
+}
+//-----------------------------------------------------------------------------
@@ -239,7 +239,7 @@ void GateFluenceActor::UserPostTrackActionInVoxel(const int /*index*/,
 void GateFluenceActor::UserSteppingActionInVoxel(const int index, const G4Step* step)
 {
   GateDebugMessageInc("Actor", 4, "GateFluenceActor -- UserSteppingActionInVoxel - begin\n");
-  const double weight = step->GetTrack()->GetWeight();
+  const double weight = step->GetPreStepPoint()->GetWeight();
   /* Is this necessary? */
   if (index < 0)
     {
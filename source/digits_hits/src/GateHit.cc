@@ -28,6 +28,7 @@ GateHit::GateHit()
   m_trackID(0),
   m_parentID(0),
   m_systemID(-1),
+  m_weight(1.),
   m_sourceEnergy(-1),
   m_sourcePDG(0),
   m_nCrystalConv(0)
@@ -28,9 +28,16 @@ GateHitFileReader::GateHitFileReader()
   , m_hitTree(0)
   , m_entries(0)
   , m_currentEntry(0)
+  , m_readEntry(0)
+  , m_readError(false)
+  , m_blockSize(10000)
+  , m_cacheSize(64)
+  , m_blockPosition(0)
 {
-  // Clear the root-hit structure
+  // Clear the root-hit structures
   m_hitBuffer.Clear();
+  m_endOfFileBuffer.Clear();
+  m_currentHit = &m_endOfFileBuffer;
 
   // Create the messenger;
   m_messenger = new GateHitFileReaderMessenger(this);
@@ -74,6 +81,9 @@ GateHitFileReader* GateHitFileReader::GetInstance()
 // It opens the ROOT input file, sets up the hit tree, and loads the first series of hits
 void GateHitFileReader::PrepareAcquisition()
 {
+  // The prefetching thread of a previous acquisition must not read the tree any more
+  if (m_prefetch.valid()) m_prefetch.get();
+
   // Open the input file
   m_hitFile = new TFile((m_fileName+".root").c_str(),"READ");
   if (!m_hitFile)
@@ -95,13 +105,23 @@ void GateHitFileReader::PrepareAcquisition()
 	}
   // Reset the entry counters
   m_currentEntry=0;
+  m_readEntry=0;
+  m_readError=false;
   m_entries = m_hitTree->GetEntries();
 
 
   // Set the addresses of the branch buffers: each buffer is a field of the root-hit structure
   GateHitTree::SetBranchAddresses(m_hitTree,m_hitBuffer);
 
-  //  Load the first hit into the root-hit structure
+  // All the branches are read: the baskets of a cluster of entries are read in one request
+  m_hitTree->SetCacheSize((Long64_t)m_cacheSize*1024*1024);
+  m_hitTree->AddBranchToCache("*",kTRUE);
+  m_hitTree->StopCacheLearningPhase();
+
+  // Read the first block, then load the first hit (this starts the prefetching of the next block)
+  m_currentBlock.clear();
+  m_blockPosition = 0;
+  ReadBlock(&m_nextBlock);
   LoadHitData();
 }
 
@@ -119,10 +139,9 @@ void GateHitFileReader::PrepareAcquisition()
 */
 G4int GateHitFileReader::PrepareNextEvent(G4Event* )
 {
-  G4cout << " GateHitFileReader::PrepareNextEvent\n";
   // Store the current runID and eventID
-  G4int currentEventID = m_hitBuffer.eventID;
-  G4int currentRunID = m_hitBuffer.runID;
+  G4int currentEventID = m_currentHit->eventID;
+  G4int currentRunID = m_currentHit->runID;
 
   // We've reached the end-of-file
   if ( (currentEventID==-1) && (currentRunID==-1) )
@@ -130,17 +149,16 @@ G4int GateHitFileReader::PrepareNextEvent(G4Event* )
 
   // Load the hits for the current event
   // We loop until the data that have been read are found to be for a different event or run
-  while ( (currentEventID == m_hitBuffer.eventID) && (currentRunID == m_hitBuffer.runID) ) {
+  while ( (currentEventID == m_currentHit->eventID) && (currentRunID == m_currentHit->runID) ) {
 
-    // Create a new hit and store it into the hit-queue
-    GateHit* aHit =  m_hitBuffer.CreateHit();
-    m_hitQueue.push(aHit);
+    // Create a new hit (from the G4Allocator pool of GateHit) and store it into the hit-queue
+    m_hitQueue.push_back(m_currentHit->CreateHit());
 
     // Load the next set of hit-data into the root-hit structure
     LoadHitData();
   }
 
-  if (currentRunID==m_hitBuffer.runID){
+  if (currentRunID==m_currentHit->runID){
     // We got a set of hits for the current run -> return 1
     return 1;
   }
@@ -156,12 +174,11 @@ G4int GateHitFileReader::PrepareNextEvent(G4Event* )
 // It creates a new hit-collection, based on the queue of hits previously filled by PrepareNextEvent()
 void GateHitFileReader::PrepareEndOfEvent()
 {
-  // We loop until the hit-queue is empty
-  // Each hit is inserted into the crystalSD hit-collection, then removed from the queue
-  while (m_hitQueue.size()) {
-    GateOutputMgr::GetInstance()->GetHitCollection()->insert(m_hitQueue.front());
-    m_hitQueue.pop();
-  }
+  // Each hit is inserted into the crystalSD hit-collection, which owns it
+  GateHitsCollection* hitCollection = GateOutputMgr::GetInstance()->GetHitCollection();
+  for (size_t i=0; i<m_hitQueue.size(); ++i)
+    hitCollection->insert(m_hitQueue[i]);
+  m_hitQueue.clear();
 }
 
 
@@ -170,6 +187,12 @@ void GateHitFileReader::PrepareEndOfEvent()
 // It closes the ROOT input file
 void GateHitFileReader::TerminateAfterAcquisition()
 {
+  // Wait for the prefetching thread before closing the file
+  if (m_prefetch.valid()) m_prefetch.get();
+  m_currentBlock.clear();
+  m_nextBlock.clear();
+  m_currentHit = &m_endOfFileBuffer;
+
   // Close the file
   if (m_hitFile) {
     delete m_hitFile;
@@ -177,10 +200,9 @@ void GateHitFileReader::TerminateAfterAcquisition()
   }
 
   // If the hit queue was not empty (it should be), clear it up
-  while (m_hitQueue.size()) {
-    delete m_hitQueue.front();
-    m_hitQueue.pop();
-  }
+  for (size_t i=0; i<m_hitQueue.size(); ++i)
+    delete m_hitQueue[i];
+  m_hitQueue.clear();
 
   // Note that we don't delete the tree: it was based on the file so
   // I assume it was destroyed at the same time as the file was closed (true?)
@@ -189,22 +211,54 @@ void GateHitFileReader::TerminateAfterAcquisition()
 
 
 
-// Reads a set of hit data from the hit-tree, and stores them into the root-hit buffer
+// Moves to the next set of hit data. When the current block is over, the block read by
+// the prefetching thread becomes the current one and the reading of the next one starts.
 void GateHitFileReader::LoadHitData()
 {
-  // We've reached the end of file: set indicators to tell the caller that the reading failed
-  if (m_currentEntry>=m_entries){
-    m_hitBuffer.runID=-1;
-    m_hitBuffer.eventID=-1;
+  if (++m_blockPosition < m_currentBlock.size()) {
+    m_currentHit = &m_currentBlock[m_blockPosition];
+    m_currentEntry++;
     return;
   }
 
-  // Read a new set of hit-data: if it failed, set indicators to tell the caller that the reading failed
-  if (m_hitTree->GetEntry(m_currentEntry++)<=0) {
+  if (m_prefetch.valid()) m_prefetch.get();
+  if (m_readError) {
     G4cerr << "[GateHitFileReader::LoadHitData]:\n"
       	   << "\tCould not read the next hit!\n";
-    m_hitBuffer.runID=-1;
-    m_hitBuffer.eventID=-1;
+    m_readError = false;
+  }
+  m_currentBlock.swap(m_nextBlock);
+  m_blockPosition = 0;
+
+  // We've reached the end of file (or the reading failed): the current hit data tell it to the caller
+  if (m_currentBlock.empty()) {
+    m_currentHit = &m_endOfFileBuffer;
+    return;
+  }
+  m_currentHit = &m_currentBlock[0];
+  m_currentEntry++;
+
+  if (m_readEntry<m_entries)
+    m_prefetch = std::async(std::launch::async, &GateHitFileReader::ReadBlock, this, &m_nextBlock);
+  else
+    m_nextBlock.clear();
+}
+
+
+
+// Reads the next block of entries of the hit-tree (run by the prefetching thread)
+void GateHitFileReader::ReadBlock(std::vector<GateRootHitBuffer>* block)
+{
+  block->clear();
+  block->reserve(m_blockSize);
+  while ( ((G4int)block->size()<m_blockSize) && (m_readEntry<m_entries) ) {
+    // If the reading failed, stop there as at the end of file
+    if (m_hitTree->GetEntry(m_readEntry++)<=0) {
+      m_readError = true;
+      m_readEntry = (G4int)m_entries;
+      break;
+    }
+    block->push_back(m_hitBuffer);
   }
 }
 
@@ -221,6 +275,8 @@ void GateHitFileReader::Describe(size_t indent)
   GateClockDependent::Describe(indent);
   G4cout << GateTools::Indent(indent) << "Hit-file name:    " << m_fileName << Gateendl;
   G4cout << GateTools::Indent(indent) << "Hit-file status:  " << (m_hitFile ? "open" : "closed" ) << Gateendl;
+  G4cout << GateTools::Indent(indent) << "Block size:       " << m_blockSize << " entries" << Gateendl;
+  G4cout << GateTools::Indent(indent) << "Tree cache size:  " << m_cacheSize << " MB" << Gateendl;
   if (m_hitTree) {
     G4cout << GateTools::Indent(indent) << "Hit-tree entries: " << m_entries << Gateendl;
     G4cout << GateTools::Indent(indent) << "Current entry:    " << m_currentEntry << Gateendl;
@@ -34,6 +34,18 @@ GateHitFileReaderMessenger::GateHitFileReaderMessenger(GateHitFileReader* itsHit
   SetFileNameCmd->SetGuidance("Set the name of the input ROOT hit data file");
   SetFileNameCmd->SetParameterName("Name",false);
 
+  cmdName = GetDirectoryName()+"setBlockSize";
+  SetBlockSizeCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetBlockSizeCmd->SetGuidance("Set the number of hits read at once, while the previous block is replayed (default 10000)");
+  SetBlockSizeCmd->SetParameterName("Number",false);
+  SetBlockSizeCmd->SetRange("Number>0");
+
+  cmdName = GetDirectoryName()+"setCacheSize";
+  SetCacheSizeCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetCacheSizeCmd->SetGuidance("Set the size in MB of the ROOT cache used to read the hit tree (default 64)");
+  SetCacheSizeCmd->SetParameterName("Size",false);
+  SetCacheSizeCmd->SetRange("Size>0");
+
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -41,6 +53,8 @@ GateHitFileReaderMessenger::GateHitFileReaderMessenger(GateHitFileReader* itsHit
 GateHitFileReaderMessenger::~GateHitFileReaderMessenger()
 {
   delete SetFileNameCmd;
+  delete SetBlockSizeCmd;
+  delete SetCacheSizeCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -49,6 +63,10 @@ void GateHitFileReaderMessenger::SetNewValue(G4UIcommand* command,G4String newVa
 {
   if (command == SetFileNameCmd)
     GetHitFileReader()->SetFileName(newValue);
+  else if (command == SetBlockSizeCmd)
+    GetHitFileReader()->SetBlockSize(SetBlockSizeCmd->GetNewIntValue(newValue));
+  else if (command == SetCacheSizeCmd)
+    GetHitFileReader()->SetCacheSize(SetCacheSizeCmd->GetNewIntValue(newValue));
   else
     GateClockDependentMessenger::SetNewValue(command,newValue);
 
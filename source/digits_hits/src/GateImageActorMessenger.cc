@@ -35,6 +35,7 @@ GateImageActorMessenger::~GateImageActorMessenger()
   delete pHalfSizeCmd;
   delete pSizeCmd;
   delete pPositionCmd;
+  delete pPrecisionCmd;
 }
 //-----------------------------------------------------------------------------
 
@@ -83,6 +84,11 @@ void GateImageActorMessenger::BuildCommands(G4String base)
   guidance = G4String("Sets  hit type ('pre', 'post', 'random' or 'middle'). Default is 'middle'.");
   pStepHitTypeCmd->SetGuidance(guidance);
 
+  bb = base +"/setPrecision";
+  pPrecisionCmd = new G4UIcmdWithAString(bb,this);
+  guidance = G4String("Sets the precision of the accumulated images ('double', 'float', 'kahan' or 'mixed'). Default is 'double'.");
+  pPrecisionCmd->SetGuidance(guidance);
+  pPrecisionCmd->SetCandidates("double float kahan mixed");
 }
 //-----------------------------------------------------------------------------
 
@@ -94,6 +100,7 @@ void GateImageActorMessenger::SetNewValue(G4UIcommand* cmd, G4String newValue) {
   if (cmd == pSizeCmd)        pImageActor->SetSize(pSizeCmd->GetNew3VectorValue(newValue));
   if (cmd == pPositionCmd)    pImageActor->SetPosition(pPositionCmd->GetNew3VectorValue(newValue));
   if (cmd == pStepHitTypeCmd) pImageActor->SetStepHitType(newValue);
+  if (cmd == pPrecisionCmd)   pImageActor->SetPrecision(newValue);
   GateActorMessenger::SetNewValue(cmd,newValue);
 }
 //-----------------------------------------------------------------------------
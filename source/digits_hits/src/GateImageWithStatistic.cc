@@ -15,6 +15,123 @@
 #include "GateMessageManager.hh"
 #include "GateMiscFunctions.hh"
 
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+// Compensated (Kahan) summation: compensation holds the low order part lost
+// by the previous additions, the sum is sum - compensation
+static inline void KahanAdd(float & sum, float & compensation, double value)
+{
+  float y = value - compensation;
+  float t = sum + y;
+  compensation = (t - sum) - y;
+  sum = t;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class T>
+static void AllocateOrRelease(GateImageT<T> & image, bool b)
+{
+  if (b) image.Allocate();
+  else image.Deallocate();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// The scaled images are only allocated while writing
+template<class T>
+static void WriteValueAndSquaredImages(GateImageT<T> & value, GateImageT<T> & squared,
+                                       bool writeSquared, bool scaled, double scale,
+                                       const G4String & valueFilename, const G4String & squaredFilename)
+{
+  if (!scaled) {
+    value.Write(valueFilename);
+    if (writeSquared) squared.Write(squaredFilename);
+    return;
+  }
+  {
+    GateImageT<T> scaledImage(value);
+    for (auto & v : scaledImage) v *= scale;
+    scaledImage.Write(valueFilename);
+  }
+  if (writeSquared) {
+    GateImageT<T> scaledImage(squared);
+    for (auto & v : scaledImage) v *= scale*scale;
+    scaledImage.Write(squaredFilename);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class T>
+static void ComputeMaxAndSum(const GateImageT<T> & image, double factor, double & max, double & sum)
+{
+  typename GateImageT<T>::const_iterator pi = image.begin();
+  typename GateImageT<T>::const_iterator pe = image.end();
+  while (pi != pe) {
+    if (*pi > max) max = *pi;
+    sum += *pi*factor;
+    ++pi;
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+template<class T>
+static void ComputeUncertainty(const GateImageT<T> & value, const GateImageT<T> & squaredValue,
+                               GateImageDouble & uncertainty, int numberOfEvents)
+{
+  GateImageDouble::iterator po = uncertainty.begin();
+  typename GateImageT<T>::const_iterator pi = value.begin();
+  typename GateImageT<T>::const_iterator pii = squaredValue.begin();
+  typename GateImageT<T>::const_iterator pe = value.end();
+
+  int N = numberOfEvents;
+
+  while (pi != pe) {
+    double squared = (*pii);
+    double mean = (*pi);
+
+    // Ma2002 p1679 : relative statistical uncertainty
+    /*	if (mean != 0.0)
+     *po = sqrt( (N*squared - mean*mean) / ((N-1)*(mean*mean)) );
+     else *po = 1;*/
+
+    // Chetty2006 p1250 : relative statistical uncertainty
+    // exactly same than Ma2002
+    if (mean != 0.0 && N != 1 && squared != 0.0){
+      *po = sqrt( (1.0/(N-1))*(squared/N - pow(mean/N, 2)))/(mean/N);
+    }
+    else *po = 1;
+
+    /*
+    // Ma2002 p1679 : relative statistical uncertainty (estimation)
+    if (mean != 0.0)
+    *po = sqrt( squared/(mean*mean) );
+    else *po = 1;
+    */
+
+    /*
+    // Walters2002 p2745 : statistical uncertainty
+    if (mean != 0.0) {
+    *po = sqrt((1.0/((double)N-1.0)) *
+    (squared/(double)N - pow(mean/(double)N, 2)));
+    }
+    else *po = 1.0;
+    */
+    ++po;
+    ++pi;
+    ++pii;
+  }
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 /// Constructor
 GateImageWithStatistic::GateImageWithStatistic()  {
@@ -24,6 +141,9 @@ GateImageWithStatistic::GateImageWithStatistic()  {
   mOverWriteFilesFlag = true;
   mNormalizedToMax = false;
   mNormalizedToIntegral = false;
+  mScaleFactor = 1.0;
+  mPrecision = DoublePrecision;
+  mIsAllocated = false;
 }
 //-----------------------------------------------------------------------------
 
@@ -35,14 +155,132 @@ GateImageWithStatistic::~GateImageWithStatistic()  {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+GateImageWithStatistic::PrecisionType GateImageWithStatistic::GetPrecisionFromName(G4String name) {
+  if (name == "double") return DoublePrecision;
+  if (name == "float") return FloatPrecision;
+  if (name == "kahan") return KahanPrecision;
+  if (name == "mixed") return MixedPrecision;
+  GateError("Unknown precision '" << name << "', use double, float, kahan or mixed.");
+  return DoublePrecision;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageWithStatistic::SetPrecision(PrecisionType p) {
+  if (p == mPrecision) return;
+  mPrecision = p;
+  // Set after the allocation: the images of the previous precision are released
+  if (mIsAllocated) {
+    Allocate();
+    Reset();
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateVImage & GateImageWithStatistic::GetValueImage() {
+  if (IsFloat()) return mFloatValueImage;
+  return mValueImage;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageWithStatistic::SaveCheckpoint(GateCheckpointWriter & w, const G4String & key) {
+  if (IsFloat()) {
+    w.WriteImage(key+"/value", mFloatValueImage);
+    w.WriteImage(key+"/squared", mFloatSquaredImage);
+  }
+  else {
+    w.WriteImage(key+"/value", mValueImage);
+    w.WriteImage(key+"/squared", mSquaredImage);
+  }
+  if (mPrecision == DoublePrecision) w.WriteImage(key+"/temp", mTempImage);
+  else w.WriteImage(key+"/temp", mFloatTempImage);
+  if (mPrecision == KahanPrecision) {
+    w.WriteImage(key+"/valueCompensation", mValueCompensationImage);
+    w.WriteImage(key+"/squaredCompensation", mSquaredCompensationImage);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageWithStatistic::LoadCheckpoint(GateCheckpointReader & r, const G4String & key) {
+  if (IsFloat()) {
+    r.ReadImage(key+"/value", mFloatValueImage);
+    r.ReadImage(key+"/squared", mFloatSquaredImage);
+  }
+  else {
+    r.ReadImage(key+"/value", mValueImage);
+    r.ReadImage(key+"/squared", mSquaredImage);
+  }
+  if (mPrecision == DoublePrecision) r.ReadImage(key+"/temp", mTempImage);
+  else r.ReadImage(key+"/temp", mFloatTempImage);
+  if (mPrecision == KahanPrecision) {
+    r.ReadImage(key+"/valueCompensation", mValueCompensationImage);
+    r.ReadImage(key+"/squaredCompensation", mSquaredCompensationImage);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageWithStatistic::MergeCheckpoint(GateCheckpointReader & r, const G4String & key) {
+  // Same layout as SaveCheckpoint: the squared, temp and squared compensation
+  // images are empty without statistic
+  const bool withStatistic = mIsSquaredImageEnabled || mIsUncertaintyImageEnabled;
+  const int n = GetValueImage().GetNumberOfValues();
+  const int m = withStatistic ? n : 0;
+  std::vector<double> value(n), squared(m), temp(m);
+  if (IsFloat()) {
+    std::vector<float> v(n), sq(m);
+    r.ReadArray(key+"/value", v.data(), n);
+    r.ReadArray(key+"/squared", sq.data(), m);
+    if (mPrecision == KahanPrecision) {
+      std::vector<float> vc(n), sqc(m);
+      r.ReadArray(key+"/valueCompensation", vc.data(), n);
+      r.ReadArray(key+"/squaredCompensation", sqc.data(), m);
+      for (int i = 0; i < n; i++) v[i] -= vc[i];
+      for (int i = 0; i < m; i++) sq[i] -= sqc[i];
+    }
+    std::copy(v.begin(), v.end(), value.begin());
+    std::copy(sq.begin(), sq.end(), squared.begin());
+  }
+  else {
+    r.ReadArray(key+"/value", value.data(), n);
+    r.ReadArray(key+"/squared", squared.data(), m);
+  }
+  if (mPrecision == DoublePrecision) r.ReadArray(key+"/temp", temp.data(), m);
+  else {
+    std::vector<float> t(m);
+    r.ReadArray(key+"/temp", t.data(), m);
+    std::copy(t.begin(), t.end(), temp.begin());
+  }
+  for (int i = 0; i < n; i++) AddValue(i, value[i]);
+  // The last event of the other process is not yet in its value and squared images
+  for (int i = 0; i < m; i++) {
+    AddValue(i, temp[i]);
+    AddSquaredValue(i, squared[i] + temp[i]*temp[i]);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::SetOrigin(G4ThreeVector o) {
   mValueImage.SetOrigin(o);
   mSquaredImage.SetOrigin(o);
   mTempImage.SetOrigin(o);
+  mFloatValueImage.SetOrigin(o);
+  mFloatSquaredImage.SetOrigin(o);
+  mFloatTempImage.SetOrigin(o);
+  mValueCompensationImage.SetOrigin(o);
+  mSquaredCompensationImage.SetOrigin(o);
   mUncertaintyImage.SetOrigin(o);
-  mScaledValueImage.SetOrigin(o);
-  mScaledSquaredImage.SetOrigin(o);
 }
 //-----------------------------------------------------------------------------
 
@@ -52,9 +290,12 @@ void GateImageWithStatistic::SetTransformMatrix(const G4RotationMatrix & m) {
   mValueImage.SetTransformMatrix(m);
   mSquaredImage.SetTransformMatrix(m);
   mTempImage.SetTransformMatrix(m);
+  mFloatValueImage.SetTransformMatrix(m);
+  mFloatSquaredImage.SetTransformMatrix(m);
+  mFloatTempImage.SetTransformMatrix(m);
+  mValueCompensationImage.SetTransformMatrix(m);
+  mSquaredCompensationImage.SetTransformMatrix(m);
   mUncertaintyImage.SetTransformMatrix(m);
-  mScaledValueImage.SetTransformMatrix(m);
-  mScaledSquaredImage.SetTransformMatrix(m);
 }
 //-----------------------------------------------------------------------------
 
@@ -68,26 +309,19 @@ void GateImageWithStatistic::SetScaleFactor(double s) {
 
 
 //-----------------------------------------------------------------------------
+// The size is set to all images, only the ones needed are allocated
 void GateImageWithStatistic::SetResolutionAndHalfSize(const G4ThreeVector & resolution,
                                                       const G4ThreeVector & halfSize,
                                                       const G4ThreeVector & position)  {
-
   mValueImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-  if (mIsUncertaintyImageEnabled) {
-    mUncertaintyImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-    if (!mIsSquaredImageEnabled) {
-      mSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-      mTempImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-      mScaledSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-    }
-  }
-  if (mIsSquaredImageEnabled) {
-    mSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-    mTempImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-    mScaledSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
-  }
-
-  mScaledValueImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mTempImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mFloatValueImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mFloatSquaredImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mFloatTempImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mValueCompensationImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mSquaredCompensationImage.SetResolutionAndHalfSize(resolution, halfSize, position);
+  mUncertaintyImage.SetResolutionAndHalfSize(resolution, halfSize, position);
 }
 //-----------------------------------------------------------------------------
 
@@ -104,65 +338,47 @@ void GateImageWithStatistic::SetResolutionAndHalfSize(const G4ThreeVector & reso
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::SetResolutionAndHalfSizeCylinder(const G4ThreeVector & resolution,
 						      const G4ThreeVector & halfSize, const G4ThreeVector & position)  {
-  
   mValueImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-  if (mIsUncertaintyImageEnabled) {
-    mUncertaintyImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-    if (!mIsSquaredImageEnabled) {
-      mSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-      mTempImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-      mScaledSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-    }
-  }
-  if (mIsSquaredImageEnabled) {
-    mSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-    mTempImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-    mScaledSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
-  }
-
-  mScaledValueImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mTempImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mFloatValueImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mFloatSquaredImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mFloatTempImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mValueCompensationImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mSquaredCompensationImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
+  mUncertaintyImage.SetResolutionAndHalfSizeCylinder(resolution, halfSize, position);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::Allocate() {
-  mValueImage.Allocate();
-  if (mIsUncertaintyImageEnabled) {
-    mUncertaintyImage.Allocate();
-    if (!mIsSquaredImageEnabled) {
-      mSquaredImage.Allocate();
-      mTempImage.Allocate();
-      if (mIsValuesMustBeScaled) mScaledSquaredImage.Allocate();
-    }
-  }
-  if (mIsSquaredImageEnabled) {
-    mSquaredImage.Allocate();
-    mTempImage.Allocate();
-    if (mIsValuesMustBeScaled) mScaledSquaredImage.Allocate();
-  }
-  if (mIsValuesMustBeScaled) mScaledValueImage.Allocate();
+  bool withStatistic = mIsSquaredImageEnabled || mIsUncertaintyImageEnabled;
+  bool isDouble = !IsFloat();
+  AllocateOrRelease(mValueImage, isDouble);
+  AllocateOrRelease(mSquaredImage, isDouble && withStatistic);
+  AllocateOrRelease(mTempImage, mPrecision == DoublePrecision && withStatistic);
+  AllocateOrRelease(mFloatValueImage, !isDouble);
+  AllocateOrRelease(mFloatSquaredImage, !isDouble && withStatistic);
+  AllocateOrRelease(mFloatTempImage, mPrecision != DoublePrecision && withStatistic);
+  AllocateOrRelease(mValueCompensationImage, mPrecision == KahanPrecision);
+  AllocateOrRelease(mSquaredCompensationImage, mPrecision == KahanPrecision && withStatistic);
+  mIsAllocated = true;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
+// (images not allocated are empty)
 void GateImageWithStatistic::Reset(double val) {
   mValueImage.Fill(val);
-  if (mIsUncertaintyImageEnabled) {
-    mUncertaintyImage.Fill(0.0);
-    if (!mIsSquaredImageEnabled) {
-      mSquaredImage.Fill(val*val);
-      mTempImage.Fill(0.0);
-      if (mIsValuesMustBeScaled) mScaledSquaredImage.Fill(0.0);
-    }
-  }
-  if (mIsSquaredImageEnabled) {
-    mSquaredImage.Fill(val*val);
-    mTempImage.Fill(0.0);
-    if (mIsValuesMustBeScaled) mScaledSquaredImage.Fill(0.0);
-  }
-  if (mIsValuesMustBeScaled) mScaledValueImage.Fill(0.0);
+  mSquaredImage.Fill(val*val);
+  mTempImage.Fill(0.0);
+  mFloatValueImage.Fill(val);
+  mFloatSquaredImage.Fill(val*val);
+  mFloatTempImage.Fill(0.0);
+  mValueCompensationImage.Fill(0.0);
+  mSquaredCompensationImage.Fill(0.0);
 }
 //-----------------------------------------------------------------------------
 
@@ -170,12 +386,17 @@ void GateImageWithStatistic::Reset(double val) {
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::Fill(double value) {
   mValueImage.Fill(value);
+  mFloatValueImage.Fill(value);
+  mValueCompensationImage.Fill(0.0);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 double GateImageWithStatistic::GetValue(const int index) {
+  if (mPrecision == KahanPrecision)
+    return (double)mFloatValueImage.GetValue(index) - mValueCompensationImage.GetValue(index);
+  if (mPrecision == FloatPrecision) return mFloatValueImage.GetValue(index);
   return mValueImage.GetValue(index);
 }
 //-----------------------------------------------------------------------------
@@ -183,7 +404,9 @@ double GateImageWithStatistic::GetValue(const int index) {
 
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::SetValue(const int index, double value) {
-  mValueImage.SetValue(index, value);
+  if (IsFloat()) mFloatValueImage.SetValue(index, value);
+  else mValueImage.SetValue(index, value);
+  if (mPrecision == KahanPrecision) mValueCompensationImage.SetValue(index, 0.0);
 }
 //-----------------------------------------------------------------------------
 
@@ -191,7 +414,32 @@ void GateImageWithStatistic::SetValue(const int index, double value) {
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::AddValue(const int index, double value) {
   GateDebugMessage("Actor", 2, "AddValue index=" << index << " value=" << value << Gateendl);
-  mValueImage.AddValue(index, value);
+  switch (mPrecision) {
+  case FloatPrecision:
+    mFloatValueImage.AddValue(index, value);
+    break;
+  case KahanPrecision:
+    KahanAdd(mFloatValueImage.GetValue(index), mValueCompensationImage.GetValue(index), value);
+    break;
+  default:
+    mValueImage.AddValue(index, value);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImageWithStatistic::AddSquaredValue(const int index, double value) {
+  switch (mPrecision) {
+  case FloatPrecision:
+    mFloatSquaredImage.AddValue(index, value);
+    break;
+  case KahanPrecision:
+    KahanAdd(mFloatSquaredImage.GetValue(index), mSquaredCompensationImage.GetValue(index), value);
+    break;
+  default:
+    mSquaredImage.AddValue(index, value);
+  }
 }
 //-----------------------------------------------------------------------------
 
@@ -199,7 +447,8 @@ void GateImageWithStatistic::AddValue(const int index, double value) {
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::AddTempValue(const int index, double value) {
   GateDebugMessage("Actor", 2, "AddTempValue index=" << index << " value=" << value << Gateendl);
-  mTempImage.AddValue(index, value);
+  if (mPrecision == DoublePrecision) mTempImage.AddValue(index, value);
+  else mFloatTempImage.AddValue(index, value);
 }
 //-----------------------------------------------------------------------------
 
@@ -208,10 +457,17 @@ void GateImageWithStatistic::AddTempValue(const int index, double value) {
 void GateImageWithStatistic::AddValueAndUpdate(const int index, double value) {
 
   GateDebugMessageInc("Actor", 2, "AddValue and update -- start: "<<mTempImage.GetSize() << Gateendl);
-  double tmp = mTempImage.GetValue(index);
-  mValueImage.AddValue(index, tmp);
-  if (mIsSquaredImageEnabled || mIsUncertaintyImageEnabled) mSquaredImage.AddValue(index, tmp*tmp);
-  mTempImage.SetValue(index, value);
+  double tmp;
+  if (mPrecision == DoublePrecision) {
+    tmp = mTempImage.GetValue(index);
+    mTempImage.SetValue(index, value);
+  }
+  else {
+    tmp = mFloatTempImage.GetValue(index);
+    mFloatTempImage.SetValue(index, value);
+  }
+  AddValue(index, tmp);
+  if (mIsSquaredImageEnabled || mIsUncertaintyImageEnabled) AddSquaredValue(index, tmp*tmp);
   GateDebugMessageDec("Actor", 2, "AddValue and update -- end"<< Gateendl);
 }
 //-----------------------------------------------------------------------------
@@ -241,12 +497,11 @@ void GateImageWithStatistic::SaveData(int numberOfEvents, bool normalise) {
   }
 
   double factor=1.0;
-  if (mIsSquaredImageEnabled || mIsUncertaintyImageEnabled) { UpdateImage(); }
-  if (mIsSquaredImageEnabled) { UpdateSquaredImage(); }
-  if (mIsUncertaintyImageEnabled) {
-    if (!mIsSquaredImageEnabled) UpdateSquaredImage();
-    UpdateUncertaintyImage(numberOfEvents);
+  if (mIsSquaredImageEnabled || mIsUncertaintyImageEnabled) {
+    UpdateImage();
+    UpdateSquaredImage();
   }
+  if (mPrecision == KahanPrecision) FoldCompensation();
 
   if (mIsValuesMustBeScaled == true) {
     factor = mScaleFactor;
@@ -257,13 +512,8 @@ void GateImageWithStatistic::SaveData(int numberOfEvents, bool normalise) {
     mIsValuesMustBeScaled = true;
     double sum = 0.0;
     double max = 0.0;
-    GateImageDouble::const_iterator pi = mValueImage.begin();
-    GateImageDouble::const_iterator pe = mValueImage.end();
-    while (pi != pe) {
-      if (*pi > max) max = *pi;
-      sum += *pi*factor;
-      ++pi;
-    }
+    if (IsFloat()) ComputeMaxAndSum(mFloatValueImage, factor, max, sum);
+    else ComputeMaxAndSum(mValueImage, factor, max, sum);
     if (mNormalizedToMax) SetScaleFactor(factor*1.0/max);
     if (mNormalizedToIntegral) SetScaleFactor(factor*1.0/sum);
   }
@@ -271,45 +521,31 @@ void GateImageWithStatistic::SaveData(int numberOfEvents, bool normalise) {
   GateMessage("Actor", 1, "Save " << mFilename << " with scaling = "
               << mScaleFactor << "(" << mIsValuesMustBeScaled << ")\n");
 
-  if (!mIsValuesMustBeScaled) {
-    mValueImage.Write(mFilename);
-    if (mIsSquaredImageEnabled) mSquaredImage.Write(mSquaredFilename);
-  }
-  else {
-    GateImageDouble::iterator po = mScaledValueImage.begin();
-    GateImageDouble::iterator pi = mValueImage.begin();
-    GateImageDouble::const_iterator pe = mValueImage.end();
-    if (mIsSquaredImageEnabled){
-      GateImageDouble::iterator pii = mSquaredImage.begin();
-      GateImageDouble::iterator poo = mScaledSquaredImage.begin();
-      while (pi != pe) {
-	*po = (*pi)*mScaleFactor;
-	*poo = (*pii)*mScaleFactor*mScaleFactor;
-	++pi;
-	++po;
-	++pii;
-	++poo;
-      }
-      mScaledSquaredImage.Write(mSquaredFilename);
-    }
-    else {
-      while (pi != pe) {
-	*po = (*pi)*mScaleFactor;
-	++pi;
-	++po;
-      }
-    }
-    mScaledValueImage.Write(mFilename);
-    SetScaleFactor(factor); // set back previous scaling factor
-  }
+  if (IsFloat())
+    WriteValueAndSquaredImages(mFloatValueImage, mFloatSquaredImage, mIsSquaredImageEnabled,
+                               mIsValuesMustBeScaled, mScaleFactor, mFilename, mSquaredFilename);
+  else
+    WriteValueAndSquaredImages(mValueImage, mSquaredImage, mIsSquaredImageEnabled,
+                               mIsValuesMustBeScaled, mScaleFactor, mFilename, mSquaredFilename);
+  if (mIsValuesMustBeScaled) SetScaleFactor(factor); // set back previous scaling factor
 
-  if (mIsUncertaintyImageEnabled) mUncertaintyImage.Write(mUncertaintyFilename);
+  if (mIsUncertaintyImageEnabled) {
+    mUncertaintyImage.Allocate();
+    UpdateUncertaintyImage(numberOfEvents);
+    mUncertaintyImage.Write(mUncertaintyFilename);
+    mUncertaintyImage.Deallocate();
+  }
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::UpdateImage() {
+  if (mPrecision != DoublePrecision) {
+    const int n = mFloatTempImage.end() - mFloatTempImage.begin();
+    for (int i = 0; i < n; i++) AddValue(i, mFloatTempImage.GetValue(i));
+    return;
+  }
   GateImageDouble::iterator pi = mValueImage.begin();
   GateImageDouble::iterator pt = mTempImage.begin();
   GateImageDouble::const_iterator pe = mValueImage.end();
@@ -324,6 +560,15 @@ void GateImageWithStatistic::UpdateImage() {
 
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::UpdateSquaredImage() {
+  if (mPrecision != DoublePrecision) {
+    const int n = mFloatTempImage.end() - mFloatTempImage.begin();
+    for (int i = 0; i < n; i++) {
+      double t = mFloatTempImage.GetValue(i);
+      AddSquaredValue(i, t*t);
+      mFloatTempImage.SetValue(i, 0);
+    }
+    return;
+  }
   GateImageDouble::iterator pi = mSquaredImage.begin();
   GateImageDouble::iterator pt = mTempImage.begin();
   GateImageDouble::const_iterator pe = mSquaredImage.end();
@@ -340,51 +585,34 @@ void GateImageWithStatistic::UpdateSquaredImage() {
 //-----------------------------------------------------------------------------
 void GateImageWithStatistic::UpdateUncertaintyImage(int numberOfEvents)
 {
-  GateImageDouble::iterator po = mUncertaintyImage.begin();
-  GateImageDouble::iterator pi;
-  GateImageDouble::iterator pii;
-  GateImageDouble::const_iterator pe;
-
-  pi = mValueImage.begin();
-  pii = mSquaredImage.begin();
-  pe = mValueImage.end();
-
-  int N = numberOfEvents;
-
-  while (pi != pe) {
-    double squared = (*pii);
-    double mean = (*pi);
-
-    // Ma2002 p1679 : relative statistical uncertainty
-    /*	if (mean != 0.0)
-     *po = sqrt( (N*squared - mean*mean) / ((N-1)*(mean*mean)) );
-     else *po = 1;*/
-
-    // Chetty2006 p1250 : relative statistical uncertainty
-    // exactly same than Ma2002
-    if (mean != 0.0 && N != 1 && squared != 0.0){
-      *po = sqrt( (1.0/(N-1))*(squared/N - pow(mean/N, 2)))/(mean/N);
-    }
-    else *po = 1;
+  if (IsFloat())
+    ComputeUncertainty(mFloatValueImage, mFloatSquaredImage, mUncertaintyImage, numberOfEvents);
+  else
+    ComputeUncertainty(mValueImage, mSquaredImage, mUncertaintyImage, numberOfEvents);
+}
+//-----------------------------------------------------------------------------
 
-    /*
-    // Ma2002 p1679 : relative statistical uncertainty (estimation)
-    if (mean != 0.0)
-    *po = sqrt( squared/(mean*mean) );
-    else *po = 1;
-    */
 
-    /*
-    // Walters2002 p2745 : statistical uncertainty
-    if (mean != 0.0) {
-    *po = sqrt((1.0/((double)N-1.0)) *
-    (squared/(double)N - pow(mean/(double)N, 2)));
-    }
-    else *po = 1.0;
-    */
-    ++po;
+//-----------------------------------------------------------------------------
+// Moves the compensation of the Kahan sums into the float images before
+// they are written
+void GateImageWithStatistic::FoldCompensation()
+{
+  GateImageFloat::iterator pc = mValueCompensationImage.begin();
+  GateImageFloat::iterator pi = mFloatValueImage.begin();
+  while (pc != mValueCompensationImage.end()) {
+    *pi -= *pc;
+    *pc = 0;
+    ++pc;
+    ++pi;
+  }
+  pc = mSquaredCompensationImage.begin();
+  pi = mFloatSquaredImage.begin();
+  while (pc != mSquaredCompensationImage.end()) {
+    *pi -= *pc;
+    *pc = 0;
+    ++pc;
     ++pi;
-    ++pii;
   }
 }
 //-----------------------------------------------------------------------------
@@ -279,7 +279,7 @@ void GateKermaActor::BeginOfEventAction(const G4Event * e) {
 void GateKermaActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
   GateDebugMessageInc("Actor", 4, "GateKermaActor -- UserSteppingActionInVoxel - begin\n");
 
-  const double weight = step->GetTrack()->GetWeight();
+  const double weight = step->GetPreStepPoint()->GetWeight();
   double       edep   = 0.0;
 
   if (step->GetTrack()->GetDefinition()->GetParticleName() == "gamma") {
@@ -294,7 +294,7 @@ void GateKermaActor::UserSteppingActionInVoxel(const int index, const G4Step* st
       }
   }
 
-  GateDebugMessageInc("Actor", 4, "weight  = " << step->GetTrack()->GetWeight() << Gateendl);
+  GateDebugMessageInc("Actor", 4, "weight  = " << step->GetPreStepPoint()->GetWeight() << Gateendl);
   GateDebugMessageInc("Actor", 4, "enedepo = " << step->GetTotalEnergyDeposit() << Gateendl);
 
   // if no energy is deposited or energy is deposited outside image => do nothing
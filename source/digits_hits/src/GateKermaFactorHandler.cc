@@ -17,176 +17,320 @@
 #include <G4PhysicalConstants.hh>
 #include <G4UnitsTable.hh>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace CLHEP;
 
 //-----------------------------------------------------------------------------
 GateKermaFactorHandler::GateKermaFactorHandler()
 {
-  m_energy       = 0.;
-  m_cubicVolume  = 0.;
-  m_distance     = 0.;
-  m_kerma_factor = 0.;
-
   mKFExtrapolation             = false;
   mKFDA                        = false;
   mKermaEquivalentFactor       = false;
   mPhotonKermaEquivalentFactor = false;
 
-  kfTable.clear();
-  MuEnTable.clear();
+  mMaterialTables.clear();
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-void GateKermaFactorHandler::SetEnergy(double eEnergy)
+void GateKermaFactorHandler::InterpolationTable::Build(const std::vector<double>& energies,
+                                                      const std::vector<double>& values,
+                                                      double unit)
 {
-  m_energy = eEnergy;
+  mEnergies = energies;
+  mValues.resize(values.size());
+  for (size_t i=0; i<values.size(); i++)
+    mValues[i] = values[i] * unit;
+
+  // Cell width (in log(E)) is the smallest ratio between two consecutive
+  // energies, so that a lookup walks over at most one segment
+  const size_t maxNumberOfCells = 1 << 16;
+  mLogMin = std::log(mEnergies[0]);
+  const double logMax = std::log(mEnergies.back());
+  double logStep = logMax - mLogMin;
+  for (size_t i=1; i<mEnergies.size(); i++)
+    if (mEnergies[i] > mEnergies[i-1])
+      logStep = std::min(logStep, std::log(mEnergies[i]) - std::log(mEnergies[i-1]));
+  logStep = std::max(logStep, (logMax - mLogMin) / maxNumberOfCells);
+  if (logStep <= 0.) logStep = 1.;
+  mInvLogStep = 1. / logStep;
+
+  const size_t nbOfCells = static_cast<size_t>((logMax - mLogMin) * mInvLogStep) + 1;
+  mCellSegment.resize(nbOfCells);
+  size_t segment = 1;
+  for (size_t cell=0; cell<nbOfCells; cell++)
+  {
+    const double cellStart = std::exp(mLogMin + cell * logStep);
+    while (segment < mEnergies.size() - 1 && mEnergies[segment] <= cellStart) segment++;
+    mCellSegment[cell] = segment;
+  }
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-void GateKermaFactorHandler::SetCubicVolume(double eCubicVolume)
+size_t GateKermaFactorHandler::InterpolationTable::FindSegment(double e) const
 {
-  m_cubicVolume = eCubicVolume;
+  if (e < mEnergies[0]) return 0;
+  if (e >= mEnergies.back()) return mEnergies.size();
+
+  size_t cell = static_cast<size_t>((std::log(e) - mLogMin) * mInvLogStep);
+  if (cell >= mCellSegment.size()) cell = mCellSegment.size() - 1;
+  size_t i = mCellSegment[cell];
+  // Small moves only, to absorb the rounding of the log
+  while (i > 1 && mEnergies[i-1] > e) i--;
+  while (mEnergies[i] <= e) i++;
+  return i;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-void GateKermaFactorHandler::SetDistance(double eDistance)
+double GateKermaFactorHandler::InterpolationTable::Interpolate(size_t i, double e) const
 {
-  m_distance = eDistance;
+  const double s_diff_energy = e - mEnergies[i-1];
+  const double b_diff_energy = mEnergies[i] - mEnergies[i-1];
+  const double diff_value = mValues[i] - mValues[i-1];
+
+  return ((s_diff_energy * diff_value) / b_diff_energy) + mValues[i-1];
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-void GateKermaFactorHandler::SetMaterial(const G4Material* eMaterial)
+bool GateKermaFactorHandler::SelectTables(const G4String& name,
+                                          const std::vector<double>*& kfTable,
+                                          const std::vector<double>*& MuEnTable) const
 {
-  GateMessage("Actor", 10, "Material: " << eMaterial->GetName() << Gateendl);
-  m_material = eMaterial;
-
-  const G4String name(m_material->GetName());
-
   if (name == "G4_H" ||
       name == "Hydrogen")
   {
-    kfTable = kerma_factor_table_hydrogen;
-    MuEnTable = MuEnTableHydrogen;
+    kfTable = &kerma_factor_table_hydrogen;
+    MuEnTable = &MuEnTableHydrogen;
   }
   else if (name == "G4_TISSUE_SOFT_ICRU-4" ||
            name == "Soft_Tissue_ICRU")
   {
     if (mKermaEquivalentFactor)
       //kfTable = kerma_equivalent_factor_ICRU33_Soft_Tissue; // Sv.m²
-      kfTable = kerma_equivalent_factor_ICRU33_Soft_Tissue_ICRP60; // Sv.m²
+      kfTable = &kerma_equivalent_factor_ICRU33_Soft_Tissue_ICRP60; // Sv.m²
     else
-      kfTable = kerma_factor_ICRU33_Soft_Tissue; // Gy.m²
+      kfTable = &kerma_factor_ICRU33_Soft_Tissue; // Gy.m²
     if (mPhotonKermaEquivalentFactor)
-      MuEnTable = KEF_ICRUSoftTissue; // Sv.m²
+      MuEnTable = &KEF_ICRUSoftTissue; // Sv.m²
     else
-      MuEnTable = MuEn_ICRU_Soft_Tissue_NIST; // cm²/g
+      MuEnTable = &MuEn_ICRU_Soft_Tissue_NIST; // cm²/g
   }
   else if (name == "G4_MUSCLE_STRIATED_ICRU" ||
            name == "Muscle_Skeletal_ICRP_23")
   {
     if (mKFDA)
-      kfTable = kerma_factor_table_muscle_DA; // Gy.m²
+      kfTable = &kerma_factor_table_muscle_DA; // Gy.m²
     else
-      kfTable = kerma_factor_muscle_tableau;
+      kfTable = &kerma_factor_muscle_tableau;
 
-    MuEnTable = MuEnMuscleTable;
+    MuEnTable = &MuEnMuscleTable;
   }
   else if (name == "G4_LUNG_ICRP" ||
            name == "Lung_ICRP_23")
   {
-    kfTable = kerma_factor_Lung_tableau;
-    MuEnTable = MuEnLungTable;
+    kfTable = &kerma_factor_Lung_tableau;
+    MuEnTable = &MuEnLungTable;
   }
   else if (name == "Griffith_Lung_ICRU")
   {
-    kfTable = kerma_factor_Lung_Griffith_tableau;
-    MuEnTable = MuEn_ICRU44_Lung_Griffith_Table;
+    kfTable = &kerma_factor_Lung_Griffith_tableau;
+    MuEnTable = &MuEn_ICRU44_Lung_Griffith_Table;
   }
   else if (name == "G4_BONE_CORTICAL_ICRP" ||
            name == "Cortical_Bone_ICRP_23")
   {
-    kfTable = kerma_factor_Cortical_Bone_tableau;
-    MuEnTable = MuEnCorticalBoneTable;
+    kfTable = &kerma_factor_Cortical_Bone_tableau;
+    MuEnTable = &MuEnCorticalBoneTable;
   }
   else if (name == "Urinary_bladder_empty_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Urinary_bladder_empty_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Urinary_bladder_empty_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Urinary_bladder_empty_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Urinary_bladder_empty_Adult_ICRU46_tableau;
   }
   else if (name == "Skin_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Skin_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Skin_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Skin_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Skin_Adult_ICRU46_tableau;
   }
   else if (name == "Adipose_tissue_Adult_1_ICRU46")
   {
-    kfTable   = kerma_factor_Adipose_tissue_Adult_1_ICRU46_tableau;
-    MuEnTable = MuEn_Adipose_tissue_Adult_1_ICRU46_tableau;
+    kfTable   = &kerma_factor_Adipose_tissue_Adult_1_ICRU46_tableau;
+    MuEnTable = &MuEn_Adipose_tissue_Adult_1_ICRU46_tableau;
   }
   else if (name == "Testis_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Testis_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Testis_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Testis_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Testis_Adult_ICRU46_tableau;
   }
   else if (name == "Lymph_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Lymph_Adult_ICRU46_ICRU46_tableau;
-    MuEnTable = MuEn_Lymph_Adult_ICRU46_ICRU46_tableau;
+    kfTable   = &kerma_factor_Lymph_Adult_ICRU46_ICRU46_tableau;
+    MuEnTable = &MuEn_Lymph_Adult_ICRU46_ICRU46_tableau;
   }
   else if (name == "Blood_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Blood_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Blood_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Blood_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Blood_Adult_ICRU46_tableau;
   }
   else if (name == "Skeleton_cartilage_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Skeleton_cartilage_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Skeleton_cartilage_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Skeleton_cartilage_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Skeleton_cartilage_Adult_ICRU46_tableau;
   }
   else if (name == "Skeleton_spongiosa_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_Skeleton_spongiosa_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_Skeleton_spongiosa_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_Skeleton_spongiosa_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_Skeleton_spongiosa_Adult_ICRU46_tableau;
   }
   else if (name == "GI_track_intestine_Adult_ICRU46")
   {
-    kfTable   = kerma_factor_GI_track_intestine_Adult_ICRU46_tableau;
-    MuEnTable = MuEn_GI_track_intestine_Adult_ICRU46_tableau;
+    kfTable   = &kerma_factor_GI_track_intestine_Adult_ICRU46_tableau;
+    MuEnTable = &MuEn_GI_track_intestine_Adult_ICRU46_tableau;
   }
   else if (name == "Air_ICRU" ||
            name == "G4_AIR"   ||
            name == "Air")
   {
-    kfTable = kerma_factor_Air_ICRU_tableau;
-    MuEnTable = MuEn_ICRU44_Air_Table;
+    kfTable = &kerma_factor_Air_ICRU_tableau;
+    MuEnTable = &MuEn_ICRU44_Air_Table;
   }
   else if (name == "G4_Galactic" ||
            name == "Vacuum")
   {
-    kfTable = kerma_factor_Vacuum_tableau;
-    MuEnTable = MuEnVacuumTable;
+    kfTable = &kerma_factor_Vacuum_tableau;
+    MuEnTable = &MuEnVacuumTable;
   }
   else
   {
-    GateWarning("Material " << name << " not supported ! Cannot compute dose for this material." << Gateendl);
+    // Not supported: vacuum tables, the actor warns if the material is used
+    kfTable = &kerma_factor_Vacuum_tableau;
+    MuEnTable = &MuEnVacuumTable;
+    return false;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateKermaFactorHandler::BuildTables()
+{
+  const G4MaterialTable* materialTable = G4Material::GetMaterialTable();
+  mMaterialTables.clear();
+  mMaterialTables.resize(materialTable->size());
+
+  // KF EXTRAPOLATION /////////////////////////////////////////////////////////
+  const double extrapEnergyThreshold = 0.025 * eV;
+  //const double extrapEnergyThreshold = 1. * eV;
+
+  for (size_t m=0; m<materialTable->size(); m++)
+  {
+    const G4Material* material = (*materialTable)[m];
+    MaterialTables& tables = mMaterialTables[material->GetIndex()];
+
+    const std::vector<double>* kfTable = 0;
+    const std::vector<double>* MuEnTable = 0;
+    tables.supported = SelectTables(material->GetName(), kfTable, MuEnTable);
+
+    // Kerma factor
+    if (kfTable->size() == 0)
+      GateError("GateKermaFactorHandler -- BuildTables: Kerma Factor table is empty !" << Gateendl);
+
+    const std::vector<double>* energyTable = 0;
+    if      (kfTable->size() == energy_tableau.size() && !mKermaEquivalentFactor)
+      energyTable = &energy_tableau; // MeV
+    else if (kfTable->size() == energy_table_DA.size() && !mKermaEquivalentFactor)
+      energyTable = &energy_table_DA; // MeV
+    else if (kfTable->size() == energy_table_KermaEquivalentFactor.size() && mKermaEquivalentFactor)
+      energyTable = &energy_table_KermaEquivalentFactor; // MeV
+    else if (kfTable->size() == energy_table_KermaEquivalentFactor_ICRP60.size() && mKermaEquivalentFactor)
+      energyTable = &energy_table_KermaEquivalentFactor_ICRP60; // MeV
+    else
+      GateError("GateKermaFactorHandler -- BuildTables: Cannot find an energy table with a good size !" << Gateendl);
 
-    kfTable = kerma_factor_Vacuum_tableau;
-    MuEnTable = MuEnVacuumTable;
+    tables.kerma.Build(*energyTable, *kfTable, 1.);
+
+    // FINDING TABLE ENTRY > EXTRAPENERGYTHRESHOLD ////////////////////////////
+    size_t entry = 0;
+    for(size_t i = 0; i < energyTable->size(); i++)
+      if (entry == 0 && (*energyTable)[i] * MeV >= extrapEnergyThreshold)
+        entry = i;
+    tables.kermaExtrapolationEntry = entry;
+
+    // Mu_en/rho
+    if (MuEnTable->size() == 0)
+      GateError("MuEn table is empty !" << Gateendl);
+
+    double unitCoef = cm2 / g;
+    const std::vector<double>* enTableTLE = 0;
+    if (MuEnTable->size() == energyTableTLE.size())
+    {
+      unitCoef = cm2 / g;
+      enTableTLE = &energyTableTLE;
+    }
+    else if (MuEnTable->size() == energyTableTLE_ICRU44.size())
+    {
+      unitCoef = m2 / kg;
+      enTableTLE = &energyTableTLE_ICRU44;
+    }
+    else if (MuEnTable->size() == energyTableTLE_NIST.size())
+    {
+      unitCoef = cm2 / g;
+      enTableTLE = &energyTableTLE_NIST;
+    }
+    else if (MuEnTable->size() == energyTableKEF.size())
+    {
+      unitCoef = 1.; // Sv.m²
+      enTableTLE = &energyTableKEF; //MeV
+    }
+    else
+      GateError("GateKermaFactorHandler -- BuildTables: Cannot find an energy table with a good size !" << Gateendl);
+
+    tables.muEn.Build(*enTableTLE, *MuEnTable, unitCoef);
+    // Below the table, the KEF value is returned as stored in the table
+    tables.muEnBelowTable = (*MuEnTable)[0];
+
+    tables.photonFactor = ComputePhotonFactor(material);
+    tables.built = true;
+
+    GateMessage("Actor", 5, "GateKermaFactorHandler -- BuildTables: " << material->GetName()
+                << " (kerma factor: " << tables.kerma.size()
+                << " entries, mu_en/rho: " << tables.muEn.size() << " entries)" << Gateendl);
   }
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetPhotonFactor(const G4Material* eMaterial)
+const GateKermaFactorHandler::MaterialTables& GateKermaFactorHandler::GetTables(size_t materialIndex) const
+{
+  if (materialIndex >= mMaterialTables.size() || !mMaterialTables[materialIndex].built)
+    GateError("GateKermaFactorHandler -- no table for material index " << materialIndex
+              << ", BuildTables must be called once all materials are defined !" << Gateendl);
+  return mMaterialTables[materialIndex];
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool GateKermaFactorHandler::IsSupported(size_t materialIndex) const
+{
+  return GetTables(materialIndex).supported;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+double GateKermaFactorHandler::ComputePhotonFactor(const G4Material* eMaterial) const
 {
   GateMessage("Actor", 15, "Material: " << eMaterial->GetName() << Gateendl);
 
@@ -210,197 +354,113 @@ double GateKermaFactorHandler::GetPhotonFactor(const G4Material* eMaterial)
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetKermaFactor(double eEnergy)
+double GateKermaFactorHandler::GetPhotonFactor(size_t materialIndex) const
 {
-  if (kfTable.size() == 0)
-  {
-    GateError("GateKermaFactorHandler -- GetKermaFactor: Kerma Factor table is empty !" << Gateendl);
-    exit(EXIT_FAILURE);
-  }
+  return GetTables(materialIndex).photonFactor;
+}
+//-----------------------------------------------------------------------------
 
-  std::vector<double> energyTable;
 
-  if      (kfTable.size() == energy_tableau.size() && !mKermaEquivalentFactor)
-    energyTable = energy_tableau; // MeV
-  else if (kfTable.size() == energy_table_DA.size() && !mKermaEquivalentFactor)
-    energyTable = energy_table_DA; // MeV
-  else if (kfTable.size() == energy_table_KermaEquivalentFactor.size() && mKermaEquivalentFactor)
-    energyTable = energy_table_KermaEquivalentFactor; // MeV
-  else if (kfTable.size() == energy_table_KermaEquivalentFactor_ICRP60.size() && mKermaEquivalentFactor)
-    energyTable = energy_table_KermaEquivalentFactor_ICRP60; // MeV
-  else
-  {
-    GateError("GateKermaFactorHandler -- GetKermaFactor: Cannot find an energy table with a good size !" << Gateendl);
-    exit(EXIT_FAILURE);
-  }
+//-----------------------------------------------------------------------------
+double GateKermaFactorHandler::GetKermaFactor(size_t materialIndex, double eEnergy) const
+{
+  const MaterialTables& tables = GetTables(materialIndex);
+  const std::vector<double>& energyTable = tables.kerma.GetEnergies();
+  const std::vector<double>& kfTable = tables.kerma.GetValues();
 
   // KF EXTRAPOLATION /////////////////////////////////////////////////////////
   const double extrapEnergyThreshold = 0.025 * eV;
-  //const double extrapEnergyThreshold = 1. * eV;
 
   if (mKFExtrapolation && eEnergy <= extrapEnergyThreshold)
   {
-    // FINDING TABLE ENTRY > EXTRAPENERGYTHRESHOLD ////////////////////////////
-    size_t entry = 0;
-    for(size_t i = 0; i < energyTable.size(); i++)
-      if (entry == 0 && energyTable[i] * MeV >= extrapEnergyThreshold)
-        entry = i;
-    ///////////////////////////////////////////////////////////////////////////
-
-    GateMessage("Actor", 10, "[GateKermaFactorHandler::" << __FUNCTION__ << "] First energyTable entry > extrapEnergyThreshold: " << entry << " (energyTable[" << entry << "]: " << energyTable[entry] * MeV / eV << " eV, extrapEnergyThreshold: " << extrapEnergyThreshold / eV << " eV)" << Gateendl);
-
-    //OLD//const double extrapolatedKF = 7.011e-21 * std::pow(eEnergy/MeV, -0.466);
-    //OLD//const double extrapolatedKF = kfTable[0] * sqrt(energyTable[0] / (eEnergy / MeV));
-    const double extrapolatedKF = kfTable[entry] * sqrt(energyTable[entry] / (eEnergy / MeV));
-
-    GateMessage("Actor", 10, "[GateKermaFactorHandler::" << __FUNCTION__ << "] ===> Doing Kerma Factor Extrapolation ! (Energy: " << eEnergy / eV << " eV, ExtrapolatedKF: " << extrapolatedKF << ")" << Gateendl);
-
-    return extrapolatedKF;
-  }
-  /////////////////////////////////////////////////////////////////////////////
-  else if (eEnergy/MeV < energyTable[0]) // && eEnergy/MeV >= 1e-10)
-  {
-    GateMessage("Actor", 10, "[GateKermaFactorHandler::" << __FUNCTION__ << "] Neutron energy (" << eEnergy/MeV << " MeV) is inferior to minimum energy of kfTable (" << energyTable[0] << " MeV) !" << Gateendl);
-    GateMessage("Actor", 10, "[GateKermaFactorHandler::" << __FUNCTION__ << "] ===> Returning " << energyTable[0] << " MeV Kerma Factor ! (" << kfTable[0] << ")" << Gateendl);
-
-    return kfTable[0];
+    const size_t entry = tables.kermaExtrapolationEntry;
+    return kfTable[entry] * sqrt(energyTable[entry] / (eEnergy / MeV));
   }
 
-  for (size_t i=1; i<energyTable.size(); i++)
-    if (eEnergy/MeV >= energyTable[i-1] && eEnergy/MeV < energyTable[i])
-    {
-      const double s_diff_energy = (eEnergy/MeV) - (energyTable[i-1]);
-      const double b_diff_energy = energyTable[i] - energyTable[i-1];
-      const double diff_kerma_factor = kfTable[i] - kfTable[i-1];
-
-      return ((s_diff_energy * diff_kerma_factor) / b_diff_energy) + kfTable[i-1];
-    }
-
-  return 0.;
+  const size_t i = tables.kerma.FindSegment(eEnergy/MeV);
+  // Below the table, return the first kerma factor
+  if (i == 0) return kfTable[0];
+  if (i == tables.kerma.size()) return 0.;
+  return tables.kerma.Interpolate(i, eEnergy/MeV);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetFlux()
+double GateKermaFactorHandler::GetFlux(double distance, double cubicVolume)
 {
-  return m_distance / m_cubicVolume / m * m3;
+  return distance / cubicVolume / m * m3;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetDose()
+double GateKermaFactorHandler::GetDose(size_t materialIndex, double energy,
+                                       double distance, double cubicVolume) const
 {
-  return GetKermaFactor(m_energy) * m_distance / m_cubicVolume / m * m3;
+  return GetKermaFactor(materialIndex, energy) * distance / cubicVolume / m * m3;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetDoseCorrected()
+double GateKermaFactorHandler::GetDoseCorrected(size_t materialIndex, double energy,
+                                                double distance, double cubicVolume) const
 {
-  if(m_energy <= 0.025*eV)
-    return (GetKermaFactor(m_energy) + GetPhotonFactor(m_material)) * m_distance / m_cubicVolume /m*m3;
+  if(energy <= 0.025*eV)
+    return (GetKermaFactor(materialIndex, energy) + GetPhotonFactor(materialIndex)) * distance / cubicVolume /m*m3;
 
-  return GetKermaFactor(m_energy) * m_distance / m_cubicVolume /m*m3;
+  return GetKermaFactor(materialIndex, energy) * distance / cubicVolume /m*m3;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetDoseCorrectedTLE()
+double GateKermaFactorHandler::GetDoseCorrectedTLE(size_t materialIndex, double energy,
+                                                   double distance, double cubicVolume) const
 {
-  double dose = m_energy * GetMuEnOverRho() * m_distance / m_cubicVolume / gray;
+  const double muEn = GetMuEnOverRho(materialIndex, energy);
+  double dose = energy * muEn * distance / cubicVolume / gray;
 
   if (mPhotonKermaEquivalentFactor)
-    dose = GetMuEnOverRho() * m_distance / m_cubicVolume / m * m3;
+    dose = muEn * distance / cubicVolume / m * m3;
 
-  GateMessage("Actor", 10, "GetDoseCorrectedTLE dose: " << dose << " Gy" << Gateendl);
   return dose;
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-double GateKermaFactorHandler::GetMuEnOverRho()
+double GateKermaFactorHandler::GetMuEnOverRho(size_t materialIndex, double energy) const
 {
-  if (MuEnTable.size() == 0)
-    GateError("MuEn table is empty !" << Gateendl);
-
-  std::vector<double> enTableTLE = energyTableTLE;
+  const InterpolationTable& muEn = GetTables(materialIndex).muEn;
 
-  double unitCoef = cm2 / g;
-
-  if (MuEnTable.size() == energyTableTLE.size())
-  {
-    unitCoef = cm2 / g;
-    enTableTLE = energyTableTLE;
-  }
-  else if (MuEnTable.size() == energyTableTLE_ICRU44.size())
-  {
-    unitCoef = m2 / kg;
-    enTableTLE = energyTableTLE_ICRU44;
-  }
-  else if (MuEnTable.size() == energyTableTLE_NIST.size())
-  {
-    unitCoef = cm2 / g;
-    enTableTLE = energyTableTLE_NIST;
-  }
-  else if (MuEnTable.size() == energyTableKEF.size())
-  {
-    unitCoef = 1.; // Sv.m²
-    enTableTLE = energyTableKEF; //MeV
-  }
-  else
-  {
-    GateError("GateKermaFactorHandler -- GetMuEnOverRho: Cannot find an energy table with a good size !" << Gateendl);
-    exit(EXIT_FAILURE);
-  }
-
-  if (m_energy/MeV < enTableTLE[0])
+  const size_t i = muEn.FindSegment(energy/MeV);
+  if (i == 0)
   {
     if (mPhotonKermaEquivalentFactor)
-      return MuEnTable[0];
+      return GetTables(materialIndex).muEnBelowTable;
     else
       return 0.;
   }
-
-  for (size_t i=1; i<enTableTLE.size(); i++)
-    if (m_energy/MeV >= enTableTLE[i-1] &&
-        m_energy/MeV <  enTableTLE[i])
-    {
-      const double s_diff_energy = (m_energy/MeV) - (enTableTLE[i-1]);
-      const double b_diff_energy = enTableTLE[i] - enTableTLE[i-1];
-      const double diff_MuEn = MuEnTable[i] - MuEnTable[i-1];
-
-      GateMessage("Actor", 5,  "GateKermaFactorHandler -- GetMuEnOverRho:" << Gateendl
-           << " Material name   = " << m_material->GetName() << Gateendl
-           << " Photon energy   = " << G4BestUnit(m_energy, "Energy") << Gateendl
-           << " enTableTLE[i-1] = " << G4BestUnit(enTableTLE[i-1], "Energy") << Gateendl
-           << " enTableTLE[i]   = " << G4BestUnit(enTableTLE[i], "Energy") << Gateendl
-           << " enTableTLE size = " << enTableTLE.size() << Gateendl);
-
-      return (((s_diff_energy * diff_MuEn) / b_diff_energy) + MuEnTable[i-1]) * unitCoef;
-    }
-
-  return 0.;
+  if (i == muEn.size()) return 0.;
+  return muEn.Interpolate(i, energy/MeV);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-TGraph* GateKermaFactorHandler::GetKermaFactorGraph()
+TGraph* GateKermaFactorHandler::GetKermaFactorGraph(const G4Material* material) const
 {
   GateMessage("Actor", 5, "GateKermaFactorHandler -- Begin of GetKermaFactorGraph\n");
   TGraph* g = new TGraph();
-  g->SetTitle((m_material->GetName()+";Neutron energy [MeV];Kerma factor [Gy*m^{2}/neutron]").c_str());
+  g->SetTitle((material->GetName()+";Neutron energy [MeV];Kerma factor [Gy*m^{2}/neutron]").c_str());
   g->SetMarkerStyle(kFullCircle);
   unsigned n(0);
   for (double i= 1e-10; i <= 2.9e1; i=i*10)
   {
     GateMessage("Actor", 5, "i = " << i << "\n");
-    g->SetPoint(n,i,GetKermaFactor(i*MeV));
+    g->SetPoint(n,i,GetKermaFactor(material->GetIndex(), i*MeV));
     n++;
   }
   GateMessage("Actor", 5, "GateKermaFactorHandler -- End of GetKermaFactorGraph\n");
@@ -313,11 +313,11 @@ void GateLETActor::BeginOfEventAction(const G4Event * e) {
 void GateLETActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
   GateDebugMessageInc("Actor", 4, "GateLETActor -- UserSteppingActionInVoxel - begin\n");
   GateDebugMessageInc("Actor", 4, "enedepo = " << step->GetTotalEnergyDeposit() << Gateendl);
-  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetTrack()->GetWeight() << Gateendl);
+  GateDebugMessageInc("Actor", 4, "weight = " <<  step->GetPreStepPoint()->GetWeight() << Gateendl);
   //	G4cout << "In LET actor: " << step->GetTrack()->GetDefinition()->GetAtomicNumber() << G4endl;
 
   // Get edep and current particle weight
-  const double weight = step->GetTrack()->GetWeight();
+  const double weight = step->GetPreStepPoint()->GetWeight();
 
   // A.Resch tested calculation method:
   G4double edep = step->GetTotalEnergyDeposit();
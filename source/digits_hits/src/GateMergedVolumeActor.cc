@@ -13,9 +13,11 @@
 #include "G4TransportationManager.hh"
 #include "G4SteppingManager.hh"
 #include "G4EventManager.hh"
+#include <algorithm>
 
 GateMergedVolumeActor::GateMergedVolumeActor(G4String name, G4int depth)
-: GateVActor(name,depth)
+: GateVActor(name,depth),
+  mUseBVH(true)
 {
   GateMessage("Actor",4,"GateMergedVolumeActor() -- begin\n");
   pActorMessenger = new GateActorMessenger(this);
@@ -36,7 +38,7 @@ void GateMergedVolumeActor::Construct()
   GateVActor::Construct();
 
   // Enable callbacks
-  EnableBeginOfRunAction( false );
+  EnableBeginOfRunAction( true );
   EnableBeginOfEventAction( false );
   EnablePreUserTrackingAction( false );
   EnableUserSteppingAction( true );
@@ -53,6 +55,150 @@ void GateMergedVolumeActor::Construct()
   ResetData();
 }
 
+void GateMergedVolumeActor::BeginOfRunAction(const G4Run* run)
+{
+  GateVActor::BeginOfRunAction(run);
+  BuildBVH();
+}
+
+void GateMergedVolumeActor::BuildBVH()
+{
+  std::vector<G4ThreeVector>::size_type const n = mSolidVolToMerge.size();
+  mTransformVolToMerge.resize( n );
+  mMinVolToMerge.resize( n );
+  mMaxVolToMerge.resize( n );
+  std::vector<G4ThreeVector> centers( n );
+
+  for( std::vector<G4VSolid*>::size_type i = 0; i < n; ++i )
+  {
+    // Same frame as the previous per-step computation (placement in the mother volume)
+    G4AffineTransform const toWorld( mPhysicalVolToMerge[ i ]->GetRotation(), mPhysicalVolToMerge[ i ]->GetTranslation() );
+    mTransformVolToMerge[ i ] = toWorld.Inverse();
+
+    // World extent of the solid: the 8 corners of its bounding box
+    G4ThreeVector localMin, localMax;
+    mSolidVolToMerge[ i ]->BoundingLimits( localMin, localMax );
+    G4double const tolerance = mSolidVolToMerge[ i ]->GetTolerance();
+    for( G4int c = 0; c < 8; ++c )
+    {
+      G4ThreeVector const corner( c & 1 ? localMax.x() : localMin.x(),
+                                  c & 2 ? localMax.y() : localMin.y(),
+                                  c & 4 ? localMax.z() : localMin.z() );
+      G4ThreeVector const p = toWorld.TransformPoint( corner );
+      for( G4int k = 0; k < 3; ++k )
+      {
+        if( c == 0 || p[ k ] - tolerance < mMinVolToMerge[ i ][ k ] ) mMinVolToMerge[ i ][ k ] = p[ k ] - tolerance;
+        if( c == 0 || p[ k ] + tolerance > mMaxVolToMerge[ i ][ k ] ) mMaxVolToMerge[ i ][ k ] = p[ k ] + tolerance;
+      }
+    }
+    centers[ i ] = 0.5 * ( mMinVolToMerge[ i ] + mMaxVolToMerge[ i ] );
+  }
+
+  mBVHVolumes.resize( n );
+  for( std::vector<G4int>::size_type i = 0; i < n; ++i ) mBVHVolumes[ i ] = i;
+  mBVHNodes.clear();
+  if( n > 0 ) BuildBVHNode( 0, n, centers );
+
+  GateMessage("Actor",3,"GateMergedVolumeActor: " << n << " volume(s) to merge, "
+              << mBVHNodes.size() << " BVH nodes\n");
+}
+
+G4int GateMergedVolumeActor::BuildBVHNode( G4int begin, G4int end, std::vector<G4ThreeVector> const& centers )
+{
+  G4int const index = mBVHNodes.size();
+  mBVHNodes.push_back( BVHNode() );
+
+  BVHNode node;
+  node.min = mMinVolToMerge[ mBVHVolumes[ begin ] ];
+  node.max = mMaxVolToMerge[ mBVHVolumes[ begin ] ];
+  G4ThreeVector cmin = centers[ mBVHVolumes[ begin ] ];
+  G4ThreeVector cmax = cmin;
+  for( G4int i = begin; i < end; ++i )
+  {
+    G4int const v = mBVHVolumes[ i ];
+    for( G4int k = 0; k < 3; ++k )
+    {
+      node.min[ k ] = std::min( node.min[ k ], mMinVolToMerge[ v ][ k ] );
+      node.max[ k ] = std::max( node.max[ k ], mMaxVolToMerge[ v ][ k ] );
+      cmin[ k ] = std::min( cmin[ k ], centers[ v ][ k ] );
+      cmax[ k ] = std::max( cmax[ k ], centers[ v ][ k ] );
+    }
+  }
+
+  if( end - begin <= 2 )
+  {
+    node.first = begin;
+    node.count = end - begin;
+    mBVHNodes[ index ] = node;
+    return index;
+  }
+
+  // Median split along the largest extent of the centers
+  G4ThreeVector const extent = cmax - cmin;
+  G4int axis = 0;
+  if( extent.y() > extent[ axis ] ) axis = 1;
+  if( extent.z() > extent[ axis ] ) axis = 2;
+  G4int const middle = ( begin + end ) / 2;
+  std::nth_element( mBVHVolumes.begin() + begin, mBVHVolumes.begin() + middle, mBVHVolumes.begin() + end,
+                    [&centers, axis]( G4int a, G4int b ) { return centers[ a ][ axis ] < centers[ b ][ axis ]; } );
+
+  BuildBVHNode( begin, middle, centers );
+  node.first = BuildBVHNode( middle, end, centers );
+  node.count = 0;
+  mBVHNodes[ index ] = node;
+  return index;
+}
+
+void GateMergedVolumeActor::FindCandidates( G4ThreeVector const& position, G4ThreeVector const& direction, G4double length )
+{
+  mCandidates.clear();
+  if( !mUseBVH )
+  {
+    for( std::vector<G4VSolid*>::size_type i = 0; i < mSolidVolToMerge.size(); ++i ) mCandidates.push_back( i );
+    return;
+  }
+  if( mBVHNodes.empty() ) return;
+
+  // Volumes whose extent is crossed by the segment [position, position + length * direction]
+  G4int stack[ 64 ];
+  G4int size = 0;
+  stack[ size++ ] = 0;
+  while( size > 0 )
+  {
+    G4int const index = stack[ --size ];
+    BVHNode const& node = mBVHNodes[ index ];
+    G4double tNear = 0.0;
+    G4double tFar = length;
+    for( G4int k = 0; k < 3 && tNear <= tFar; ++k )
+    {
+      if( direction[ k ] == 0.0 )
+      {
+        if( position[ k ] < node.min[ k ] || position[ k ] > node.max[ k ] ) tFar = -1.0;
+        continue;
+      }
+      G4double t1 = ( node.min[ k ] - position[ k ] ) / direction[ k ];
+      G4double t2 = ( node.max[ k ] - position[ k ] ) / direction[ k ];
+      if( t1 > t2 ) std::swap( t1, t2 );
+      tNear = std::max( tNear, t1 );
+      tFar = std::min( tFar, t2 );
+    }
+    if( tNear > tFar ) continue;
+
+    if( node.count > 0 )
+    {
+      for( G4int i = node.first; i < node.first + node.count; ++i ) mCandidates.push_back( mBVHVolumes[ i ] );
+    }
+    else
+    {
+      stack[ size++ ] = index + 1;
+      stack[ size++ ] = node.first;
+    }
+  }
+
+  // Keep the priority of the declaration order
+  std::sort( mCandidates.begin(), mCandidates.end() );
+}
+
 void GateMergedVolumeActor::ListOfVolumesToMerge( G4String& vol )
 {
   // Read volume to merge separated by a comma and store the solid
@@ -93,9 +239,12 @@ G4bool GateMergedVolumeActor::ProcessHits(G4Step * step , G4TouchableHistory* )
   G4String const postStepVolName = step->GetPostStepPoint()->GetPhysicalVolume()->GetName();
   G4double const stepLength = step->GetStepLength();
 
-  // Loop over the volume(s) to merge and priority to the first volume
-  for( std::vector<G4VSolid*>::size_type i = 0; i < mSolidVolToMerge.size(); ++i )
+  // Loop over the volume(s) to merge which may be reached during the step, and priority to the first volume
+  FindCandidates( preStepPos, preStepDir, stepLength );
+  for( std::vector<G4int>::size_type c = 0; c < mCandidates.size(); ++c )
   {
+    G4int const i = mCandidates[ c ];
+
     //Get the volume name
     G4String const volToMergeName = mPhysicalVolToMerge[ i ]->GetName();
 
@@ -103,8 +252,7 @@ G4bool GateMergedVolumeActor::ProcessHits(G4Step * step , G4TouchableHistory* )
     G4double const tolerance = mSolidVolToMerge[ i ]->GetTolerance();
 
     // Get the coordinates in the world space
-    G4AffineTransform transform( mPhysicalVolToMerge[ i ]->GetRotation(), mPhysicalVolToMerge[ i ]->GetTranslation() );
-    transform.Invert();
+    G4AffineTransform const& transform = mTransformVolToMerge[ i ];
     // Add a small distance (tolerance) to position to avoid boundary problems
     //G4ThreeVector const preStepTolerance = preStepPos + tolerance * preStepDir;
     G4ThreeVector const positionVolRef = transform.TransformPoint( preStepPos );
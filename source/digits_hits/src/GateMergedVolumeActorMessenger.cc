@@ -8,6 +8,7 @@
 
 #include "GateMergedVolumeActor.hh"
 #include "GateMergedVolumeActorMessenger.hh"
+#include "G4UIcmdWithABool.hh"
 
 GateMergedVolumeActorMessenger::GateMergedVolumeActorMessenger( GateMergedVolumeActor* sensor )
 : GateActorMessenger( sensor ),
@@ -19,6 +20,7 @@ GateMergedVolumeActorMessenger::GateMergedVolumeActorMessenger( GateMergedVolume
 GateMergedVolumeActorMessenger::~GateMergedVolumeActorMessenger()
 {
   delete ListVolumeToMergeCmd;
+  delete EnableBVHCmd;
 }
 
 void GateMergedVolumeActorMessenger::BuildCommands(G4String base)
@@ -28,6 +30,10 @@ void GateMergedVolumeActorMessenger::BuildCommands(G4String base)
   cmdName = base+"/volumeToMerge";
   ListVolumeToMergeCmd = new G4UIcmdWithAString(cmdName,this);
   ListVolumeToMergeCmd->SetGuidance("List of volume(s) to merge within a voxelized phantom");
+
+  cmdName = base+"/enableBVH";
+  EnableBVHCmd = new G4UIcmdWithABool(cmdName,this);
+  EnableBVHCmd->SetGuidance("Only test the volumes to merge whose bounding box is crossed by the step (default true)");
 }
 
 void GateMergedVolumeActorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
@@ -36,4 +42,8 @@ void GateMergedVolumeActorMessenger::SetNewValue(G4UIcommand* command, G4String
   {
     pMergedVolumeActor->ListOfVolumesToMerge(newValue);
   }
+  if( command == EnableBVHCmd )
+  {
+    pMergedVolumeActor->EnableBVH( EnableBVHCmd->GetNewBoolValue(newValue) );
+  }
 }
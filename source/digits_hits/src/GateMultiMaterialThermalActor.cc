@@ -136,10 +136,14 @@ void GateMultiMaterialThermalActor::Construct()
   mAbsorptionImage.Allocate();
   mAbsorptionImage.SetFilename(mAbsorptionFilename);
 
-  // initialize ITK heat map from actor energy map
-  GateImageDouble *energyMap = dynamic_cast<GateImageDouble *>(&(mAbsorptionImage.GetValueImage()));
+  // initialize ITK heat map from actor energy map (read with GetValue, the value
+  // image is a float image with the float and kahan precisions)
+  GateImageDouble energyMap;
+  energyMap.SetResolutionAndHalfSize(mResolution, mHalfSize, mPosition);
+  energyMap.Allocate();
+  for (int i = 0; i < energyMap.GetNumberOfValues(); i++) energyMap.SetValue(i, mAbsorptionImage.GetValue(i));
   DoubleDuplicatorType::Pointer doubleDuplicatorFilter = DoubleDuplicatorType::New();
-  doubleDuplicatorFilter->SetInputImage(ConvertGateToITKImage_double(energyMap));
+  doubleDuplicatorFilter->SetInputImage(ConvertGateToITKImage_double(&energyMap));
   doubleDuplicatorFilter->Update();
   mITKheatMap = doubleDuplicatorFilter->GetOutput();
   mITKheatMap->DisconnectPipeline();
@@ -16,6 +16,8 @@
 #include "GateUserActions.hh"
 
 #include <G4PhysicalConstants.hh>
+#include <G4Neutron.hh>
+#include <G4Gamma.hh>
 
 #include <TCanvas.h>
 
@@ -213,6 +215,10 @@ void GateNTLEDoseActor::UserSteppingAction(const GateVVolume*, const G4Step* ste
 void GateNTLEDoseActor::BeginOfRunAction(const G4Run* r) {
   GateVActor::BeginOfRunAction(r);
   GateDebugMessage("Actor", 3, "GateNTLEDoseActor -- Begin of Run\n");
+
+  // Kerma factor and mu_en/rho tables of all materials, used with the
+  // material index during tracking
+  mKFHandler->BuildTables();
 }
 //-----------------------------------------------------------------------------
 
@@ -228,33 +234,47 @@ void GateNTLEDoseActor::BeginOfEventAction(const G4Event* e) {
 
 //-----------------------------------------------------------------------------
 void GateNTLEDoseActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
-  if ( step->GetTrack()->GetDefinition()->GetParticleName() == "neutron" ||
-      (step->GetTrack()->GetDefinition()->GetParticleName() == "gamma"   &&
-       mIsDoseCorrectionTLEEnabled                                       &&
-       NeutronParent(step))) {
-    mKFHandler->SetEnergy     (step->GetPreStepPoint()->GetKineticEnergy());
-    mKFHandler->SetMaterial   (step->GetPreStepPoint()->GetMaterial());
-    mKFHandler->SetDistance   (step->GetStepLength());
-    mKFHandler->SetCubicVolume(GetDoselVolume());
+  const G4ParticleDefinition* particle = step->GetTrack()->GetDefinition();
+  const bool isNeutron = (particle == G4Neutron::Neutron());
+  const bool isTLEGamma = (particle == G4Gamma::Gamma() &&
+                           mIsDoseCorrectionTLEEnabled   &&
+                           NeutronParent(step));
+
+  if (isNeutron || isTLEGamma) {
+    const G4Material* material = step->GetPreStepPoint()->GetMaterial();
+    const size_t materialIndex = material->GetIndex();
+    if (materialIndex >= mIsMaterialChecked.size()) mIsMaterialChecked.resize(materialIndex + 1, false);
+    if (!mIsMaterialChecked[materialIndex]) {
+      mIsMaterialChecked[materialIndex] = true;
+      if (!mKFHandler->IsSupported(materialIndex))
+        GateWarning("Material " << material->GetName() << " not supported ! Cannot compute dose for this material." << Gateendl);
+    }
+    const double energy        = step->GetPreStepPoint()->GetKineticEnergy();
+    const double distance      = step->GetStepLength();
+    const double cubicVolume   = GetDoselVolume();
 
     double edep(0.);
     double dose(0.);
     double flux(0.);
 
-    if (step->GetTrack()->GetDefinition()->GetParticleName() == "neutron") {
-      dose = mKFHandler->GetDose();
-      flux = mKFHandler->GetFlux();
-
+    if (isNeutron) {
       if (mIsDoseCorrectionEnabled)
-        dose = mKFHandler->GetDoseCorrected();
+        dose = mKFHandler->GetDoseCorrected(materialIndex, energy, distance, cubicVolume);
+      else
+        dose = mKFHandler->GetDose(materialIndex, energy, distance, cubicVolume);
+      flux = GateKermaFactorHandler::GetFlux(distance, cubicVolume);
     }
-    else if (step->GetTrack()->GetDefinition()->GetParticleName() == "gamma" &&
-             mIsDoseCorrectionTLEEnabled) {
-      dose = mKFHandler->GetDoseCorrectedTLE();
-      flux = mKFHandler->GetFlux();
+    else {
+      dose = mKFHandler->GetDoseCorrectedTLE(materialIndex, energy, distance, cubicVolume);
+      flux = GateKermaFactorHandler::GetFlux(distance, cubicVolume);
     }
 
-    edep = (dose * gray) * (GetDoselVolume() * step->GetPreStepPoint()->GetMaterial()->GetDensity());
+    // Weight the step was transported with: the weight window may have
+    // split or killed the track in this step's PostStepDoIt
+    dose *= step->GetPreStepPoint()->GetWeight();
+    flux *= step->GetPreStepPoint()->GetWeight();
+
+    edep = (dose * gray) * (cubicVolume * material->GetDensity());
 
     bool sameEvent = true;
 
@@ -309,13 +329,13 @@ void GateNTLEDoseActor::UserSteppingActionInVoxel(const int index, const G4Step*
     {
       bool found(false);
       for(size_t i=0; i < mMaterialList.size(); i++)
-        if (mMaterialList[i] == step->GetPreStepPoint()->GetMaterial()->GetName())
+        if (mMaterialList[i] == material->GetName())
           found = true;
 
       if(!found)
       {
-        mMaterialList.push_back(step->GetPreStepPoint()->GetMaterial()->GetName());
-        mg->Add(mKFHandler->GetKermaFactorGraph());
+        mMaterialList.push_back(material->GetName());
+        mg->Add(mKFHandler->GetKermaFactorGraph(material));
       }
     }
   }
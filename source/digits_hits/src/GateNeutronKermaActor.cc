@@ -182,7 +182,7 @@ void GateNeutronKermaActor::BeginOfEventAction(const G4Event * e) {
 void GateNeutronKermaActor::UserSteppingActionInVoxel(const int index, const G4Step* step) {
   GateMessageInc("Actor", 4, "GateNeutronKermaActor -- UserSteppingActionInVoxel - begin\n");
 
-  const double weight = step->GetTrack()->GetWeight();
+  const double weight = step->GetPreStepPoint()->GetWeight();
 
   GateDebugMessage("Actor", 4, "weight = " << weight << Gateendl);
 
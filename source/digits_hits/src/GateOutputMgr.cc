@@ -40,6 +40,11 @@
 #include "GateToRoot.hh"
 
 #include "GateToTree.hh"
+#include "GateMessenger.hh"
+
+#ifdef G4ANALYSIS_USE_ROOT
+#include "TFileMerger.h"
+#endif
 
 GateOutputMgr* GateOutputMgr::instance = 0;
 
@@ -73,7 +78,8 @@ GateOutputMgr::GateOutputMgr(const G4String name)
     m_messenger(0),
     mName(name),
     m_acquisitionStarted(false),
-    m_allowNoOutput(false)
+    m_allowNoOutput(false),
+    m_fileNameSuffix("")
 {
   GateMessage("Output",4,"GateOutputMgr() -- begin\n");
 
@@ -559,6 +565,60 @@ void GateOutputMgr::CheckFileNameForAllOutput()
 }
 //----------------------------------------------------------------------------------
 
+//----------------------------------------------------------------------------------
+void GateOutputMgr::SetFileNameSuffix(const G4String & suffix)
+{
+  // Same naming as the job splitter (gjs): the suffix is appended to the file name
+  // given to each enabled output module, through its own setFileName command.
+  // A name that is not the previous one with the previous suffix was given again
+  // by the user (e.g. between two startDAQ).
+  for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
+    GateVOutputModule * module = m_outputModules[iMod];
+    if (!module->IsEnabled()) continue;
+    G4String name = module->GiveNameOfFile();
+    if (name == " " || name == "  ") continue;
+    std::map<G4String, G4String>::iterator it = m_fileNamesWithoutSuffix.find(module->GetName());
+    if (it == m_fileNamesWithoutSuffix.end() || name != it->second + m_fileNameSuffix)
+      m_fileNamesWithoutSuffix[module->GetName()] = name;
+    G4String cmd = GateMessenger::ComputeDirectoryName(mName + "/" + module->GetName())
+      + "setFileName " + m_fileNamesWithoutSuffix[module->GetName()] + suffix;
+    if (G4UImanager::GetUIpointer()->ApplyCommand(cmd) != 0)
+      GateWarning("Could not rename the output of module '" + module->GetName() + "' (" + cmd + ")");
+  }
+  m_fileNameSuffix = suffix;
+}
+//----------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------
+void GateOutputMgr::MergeFileNamesWithSuffixes(const std::vector<G4String> & suffixes)
+{
+  for (size_t iMod=0; iMod<m_outputModules.size(); iMod++) {
+    GateVOutputModule * module = m_outputModules[iMod];
+    if (!module->IsEnabled()) continue;
+    if (m_fileNamesWithoutSuffix.count(module->GetName()) == 0) continue;
+    G4String name = m_fileNamesWithoutSuffix[module->GetName()];
+#ifdef G4ANALYSIS_USE_ROOT
+    // ROOT files are merged as with hadd
+    if (module->GetName() == "root") {
+      TFileMerger merger(false);
+      merger.SetPrintLevel(0);
+      merger.OutputFile((name + ".root").c_str(), "RECREATE");
+      for (size_t i=0; i<suffixes.size(); i++) merger.AddFile((name + suffixes[i] + ".root").c_str(), false);
+      if (merger.Merge()) {
+        GateMessage("Output", 0, "Merged " << suffixes.size() << " files into " << name << ".root" << Gateendl);
+        continue;
+      }
+      GateWarning("Could not merge the ROOT files of the forked processes into " + name + ".root");
+    }
+#endif
+    GateMessage("Output", 0, "Output '" << module->GetName() << "' is not merged, files are "
+                << name << suffixes.front() << " ... " << name << suffixes.back() << Gateendl);
+  }
+}
+//----------------------------------------------------------------------------------
+
+
 //----------------------------------------------------------------------------------
 void GateOutputMgr::BeginOfRunAction(const G4Run* /*aRun*/)
 {
@@ -28,6 +28,7 @@
 #include "GateSourceTPSPencilBeam.hh"
 #include "GatePhaseSpaceActorMessenger.hh"
 #include "GateIAEAHeader.h"
+#include "GateCheckpointManager.hh"
 
 // --------------------------------------------------------------------
 GatePhaseSpaceActor::GatePhaseSpaceActor(G4String name, G4int depth) : GateVActor(name, depth)
@@ -93,6 +94,8 @@ GatePhaseSpaceActor::GatePhaseSpaceActor(G4String name, G4int depth) : GateVActo
     pIAEARecordType = 0;
     pIAEAheader = 0;
     mFileSize = 0;
+    mCompressionLevel = 1;
+    mLastStoredEventID = -1;
 
     GateDebugMessageDec("Actor", 4, "GatePhaseSpaceActor() -- end\n");
 
@@ -181,6 +184,12 @@ void GatePhaseSpaceActor::Construct()
         }
         if (pIAEAheader->set_record_contents(pIAEARecordType) == FAIL)
             GateError("Record contents not setted.");
+
+        FILE *file = pIAEARecordType->p_file;
+        mIAEAWriter.start([file](std::vector<char> &block) {
+            if (fwrite(block.data(), sizeof(char), block.size(), file) != block.size())
+                GateError("Actor phase space: failed to write IAEA phase space data.");
+        });
     }
     else
     {
@@ -196,6 +205,10 @@ void GatePhaseSpaceActor::Construct()
         {
             mFileType = "txtFile";
         }
+        else if (extension == "gphsp")
+        {
+            mFileType = "gphspFile";
+        }
         else
             GateError("Unknown extension for phasespace");
     }
@@ -204,6 +217,17 @@ void GatePhaseSpaceActor::Construct()
 
 void GatePhaseSpaceActor::InitTree()
 {
+    if (mFileType == "gphspFile")
+    {
+        mLastStoredEventID = -1;
+        // Resumed simulation: the file is reopened at the checkpoint offset by LoadCheckpoint
+        GateCheckpointManager *checkpoint = GateCheckpointManager::GetInstance();
+        if (checkpoint->IsActorRestorePending() && checkpoint->IsActorInRestart(GetObjectName()))
+            return;
+        mCompressedFile.Open(mSaveFilename, mCompressionLevel, EnableTime || EnableLocalTime);
+        return;
+    }
+
     mFile = new GateOutputTreeFileManager();
 
     if (mFileType == "npyFile")
@@ -316,8 +340,8 @@ void GatePhaseSpaceActor::BeginOfRunAction(const G4Run *r)
     }
     else
     {
-        // Only init the tree at the first run
-        if (r->GetRunID() == 0)
+        // Only init the tree at the first run (or the first run of a resumed simulation)
+        if (r->GetRunID() == 0 || GateCheckpointManager::GetInstance()->IsActorRestorePending())
         {
             InitTree();
         }
@@ -331,8 +355,13 @@ void GatePhaseSpaceActor::RecordEndOfAcquisition()
     // For npy output, write and close must be done at the end.
     if (this->mOverWriteFilesFlag)
     {
-        mFile->write();
-        mFile->close();
+        if (mFileType == "gphspFile")
+            mCompressedFile.Close();
+        else
+        {
+            mFile->write();
+            mFile->close();
+        }
     }
 }
 // --------------------------------------------------------------------
@@ -816,10 +845,28 @@ void GatePhaseSpaceActor::UserSteppingAction(const GateVVolume *, const G4Step *
 
         // pIAEARecordType->IsNewHistory = 0;  // not yet used
 
-        pIAEARecordType->write_particle();
+        char record[IAEA_MAX_RECORD_LENGTH];
+        mIAEAWriter.append(record, pIAEARecordType->pack_particle(record));
 
         pIAEAheader->update_counters(pIAEARecordType);
-    } 
+    }
+    else if (mFileType == "gphspFile")
+    {
+        GateCompressedPhaseSpaceRecord r;
+        r.PDGCode = bPDGCode;
+        r.newEvent = (eventid != mLastStoredEventID);
+        mLastStoredEventID = eventid;
+        r.x = x;
+        r.y = y;
+        r.z = z;
+        r.dx = dx;
+        r.dy = dy;
+        r.dz = dz;
+        r.energy = e;
+        r.weight = w;
+        r.time = t;
+        mCompressedFile.Fill(r);
+    }
     else
     {
         mFile->fill();
@@ -860,8 +907,14 @@ void GatePhaseSpaceActor::SaveData()
             GateError("Phase space header not written.");
 
         fclose(pIAEAheader->fheader);
+        mIAEAWriter.stop();
         fclose(pIAEARecordType->p_file);
     }
+    else if (mFileType == "gphspFile")
+    {
+        if (!this->mOverWriteFilesFlag)
+            mCompressedFile.Close();
+    }
     else 
     {
         if (!this->mOverWriteFilesFlag)
@@ -880,3 +933,29 @@ void GatePhaseSpaceActor::ResetData()
     GateError("Can't reset phase space");
 }
 // --------------------------------------------------------------------
+
+// --------------------------------------------------------------------
+// Only the .gphsp file is written as a stream that can be cut at the checkpoint:
+// its size is saved, the blocks written after it are dropped when resuming.
+G4bool GatePhaseSpaceActor::SaveCheckpoint(GateCheckpointWriter &w)
+{
+    if (mFileType != "gphspFile")
+        return false;
+    w.WriteString("filename", mSaveFilename);
+    w.Write("offset", G4long(mCompressedFile.Flush()));
+    return true;
+}
+// --------------------------------------------------------------------
+
+// --------------------------------------------------------------------
+void GatePhaseSpaceActor::LoadCheckpoint(GateCheckpointReader &r)
+{
+    G4long offset;
+    r.Read("offset", offset);
+    if (r.ReadString("filename") != mSaveFilename)
+        GateError("Actor phase space: the checkpoint was written for " << r.ReadString("filename")
+                  << ", not " << mSaveFilename);
+    mCompressedFile.Resume(mSaveFilename, offset, mCompressionLevel, EnableTime || EnableLocalTime);
+    GateMessage("Actor", 0, "Phase space " << mSaveFilename << " resumed at byte " << offset << Gateendl);
+}
+// --------------------------------------------------------------------
@@ -66,6 +66,7 @@ GatePhaseSpaceActorMessenger::~GatePhaseSpaceActorMessenger()
     delete pUseMaskCmd;
     delete pEnableKillCmd;
     delete pEnableTrackLengthCmd;
+    delete pCompressionLevelCmd;
 }
 //-----------------------------------------------------------------------------
 
@@ -314,6 +315,13 @@ void GatePhaseSpaceActorMessenger::BuildCommands(G4String base)
     guidance = "Kill particle once stored.";
     pEnableKillCmd->SetGuidance(guidance);
     pEnableKillCmd->SetParameterName("State", false);
+
+    bb = base + "/setCompressionLevel";
+    pCompressionLevelCmd = new G4UIcmdWithAnInteger(bb, this);
+    guidance = "zlib compression level (0: none, 1: fastest (default), 9: smallest) of the blocks of a .gphsp phase space file.";
+    pCompressionLevelCmd->SetGuidance(guidance);
+    pCompressionLevelCmd->SetParameterName("Level", false);
+    pCompressionLevelCmd->SetRange("Level>=0 && Level<=9");
 }
 //-----------------------------------------------------------------------------
 
@@ -371,6 +379,8 @@ void GatePhaseSpaceActorMessenger::SetNewValue(G4UIcommand *command, G4String pa
     if (command == pSaveEveryNEventsCmd || command == pSaveEveryNSecondsCmd)
         GateError(
             "saveEveryNEvents and saveEveryNSeconds commands are not available with phase space actor. But you can use the setMaxFileSize command.");
+    if (command == pCompressionLevelCmd)
+        pActor->SetCompressionLevel(pCompressionLevelCmd->GetNewIntValue(param));
     if (command == pMaxSizeCmd)
         pActor->SetMaxFileSize(pMaxSizeCmd->GetNewDoubleValue(param));
     if (command == bEnablePrimaryEnergyCmd)
@@ -79,6 +79,25 @@ void GateProjectionSet::Reset(size_t energyWindowNumber, size_t headNumber, size
           free(m_dataMax[energyWindowID]);
         }
       free(m_dataMax);
+      m_dataMax = 0;
+    }
+
+  // Same for the weighted projections
+  if (m_weightedData)
+    {
+      for (energyWindowID = 0; energyWindowID < m_energyWindowNb; energyWindowID++)
+        {
+          for (headID = 0; headID < m_headNb; headID++)
+            {
+              free(m_weightedData[energyWindowID][headID]);
+            }
+          free(m_weightedData[energyWindowID]);
+          free(m_weightedDataMax[energyWindowID]);
+        }
+      free(m_weightedData);
+      free(m_weightedDataMax);
+      m_weightedData = 0;
+      m_weightedDataMax = 0;
     }
 
   // Store the new number of projections
@@ -161,6 +180,39 @@ void GateProjectionSet::Reset(size_t energyWindowNumber, size_t headNumber, size
            << m_pixelNbY
            << Gateendl;
 
+  if (m_weighted)
+    {
+      // Weighted projections: one double precision buffer per energy window and head,
+      // in the layout written by StreamOut
+      m_weightedData = (WeightedProjectionDataType***) malloc(m_energyWindowNb * sizeof(WeightedProjectionDataType**));
+      m_weightedDataMax = (WeightedProjectionDataType**) malloc(m_energyWindowNb * sizeof(WeightedProjectionDataType*));
+      if ((!m_weightedData) || (!m_weightedDataMax))
+        G4Exception("GateProjectionSet::Reset",
+                    "Reset",
+                    FatalException,
+                    "Could not allocate a new projection set (out of memory?)");
+      for (energyWindowID = 0; energyWindowID < m_energyWindowNb; energyWindowID++)
+        {
+          m_weightedData[energyWindowID] = (WeightedProjectionDataType**) malloc(m_headNb * sizeof(WeightedProjectionDataType*));
+          m_weightedDataMax[energyWindowID] = (WeightedProjectionDataType*) calloc(m_headNb, sizeof(WeightedProjectionDataType));
+          if ((!m_weightedData[energyWindowID]) || (!m_weightedDataMax[energyWindowID]))
+            G4Exception("GateProjectionSet::Reset",
+                        "Reset",
+                        FatalException,
+                        "Could not allocate a new projection (out of memory?)");
+          for (headID = 0; headID < m_headNb; headID++)
+            {
+              m_weightedData[energyWindowID][headID] = (WeightedProjectionDataType*) calloc(PixelsPerProjection(), sizeof(WeightedProjectionDataType));
+              if (!(m_weightedData[energyWindowID][headID]))
+                G4Exception("GateProjectionSet::Reset",
+                            "Reset",
+                            FatalException,
+                            "Could not allocate a new projection (out of memory?)");
+            }
+        }
+      return;
+    }
+
   // Allocate the data pointer
   // Modified by HDS : allocation of a 3D array
   m_data = (ProjectionDataType***) malloc(m_energyWindowNb * sizeof(ProjectionDataType**));
@@ -202,7 +254,7 @@ void GateProjectionSet::Reset(size_t energyWindowNumber, size_t headNumber, size
 
   for (energyWindowID = 0; energyWindowID < m_energyWindowNb; energyWindowID++)
     {
-      m_dataMax[energyWindowID] = (ProjectionDataType*) calloc(m_headNb, BytesPerPixel());
+      m_dataMax[energyWindowID] = (ProjectionDataType*) calloc(m_headNb, sizeof(ProjectionDataType));
       if (!m_dataMax[energyWindowID])
         G4Exception("GateProjectionSet::Reset",
                     "Reset",
@@ -243,7 +295,10 @@ void GateProjectionSet::ClearData(size_t projectionID)
         {
           for (size_t headID = 0; headID < m_headNb; headID++)
             {
-              memset(m_data[energyWindowID][headID], 0, BytesPerProjection());
+              if (m_weighted)
+                memset(m_weightedData[energyWindowID][headID], 0, BytesPerProjection());
+              else
+                memset(m_data[energyWindowID][headID], 0, BytesPerProjection());
             }
         }
 
@@ -254,7 +309,7 @@ void GateProjectionSet::ClearData(size_t projectionID)
 
 // Store a digi into a projection
 // Modified by HDS : multiple energy window support
-void GateProjectionSet::Fill(G4int energyWindowID, G4int headID, G4double x, G4double y)
+void GateProjectionSet::Fill(G4int energyWindowID, G4int headID, G4double x, G4double y, G4double weight)
 {
   // Check that energyWindowID is valid
   if (energyWindowID < 0)
@@ -335,16 +390,31 @@ void GateProjectionSet::Fill(G4int energyWindowID, G4int headID, G4double x, G4d
            << ") of head "
            << headID
            << Gateendl;
-  ProjectionDataType& dest = m_data[energyWindowID][headID][binX + binY * m_pixelNbX];
+  AddCount(energyWindowID, headID, binX + binY * m_pixelNbX, weight);
+}
+
+// Add a count into a pixel of the projection of a head
+inline void GateProjectionSet::AddCount(G4int energyWindowID, G4int headID, G4int pixel, G4double weight)
+{
+  if (m_weighted)
+    {
+      WeightedProjectionDataType& dest = m_weightedData[energyWindowID][headID][pixel];
+      dest += weight;
+      if (dest > m_weightedDataMax[energyWindowID][headID])
+        m_weightedDataMax[energyWindowID][headID] = dest;
+      return;
+    }
+
+  ProjectionDataType& dest = m_data[energyWindowID][headID][pixel];
   if (dest < USHRT_MAX)
     dest++;
   else {
     static bool already_here = false;
     if (!already_here)
       G4cerr << "[GateProjectionSet]: bin ("
-             << binX
+             << pixel % m_pixelNbX
              << ","
-             << binY
+             << pixel / m_pixelNbX
              << ") of energy window "
              << energyWindowID
              << "and head "
@@ -362,6 +432,91 @@ void GateProjectionSet::Fill(G4int energyWindowID, G4int headID, G4double x, G4d
     }
 }
 
+// Store a batch of digis of one energy window into the projections
+void GateProjectionSet::FillBatch(G4int energyWindowID, size_t n, const G4int* headIDs,
+                                  const G4double* x, const G4double* y, const G4double* weights)
+{
+  if ((energyWindowID < 0) || (static_cast<size_t>(energyWindowID) >= m_energyWindowNb))
+    {
+      G4cerr << "[GateToProjectionSet::FillBatch]:\n"
+             << "Received hits with a wrong energy window ("
+             << energyWindowID
+             << "): ignored!\n";
+      return;
+    }
+
+  // First pass: pixel index of each digi, without branches so that it can be vectorised
+  m_batchPixels.resize(n);
+  const G4double invSizeX = 1. / m_pixelSizeX;
+  const G4double invSizeY = 1. / m_pixelSizeY;
+  const G4int headNb = static_cast<G4int>(m_headNb);
+  for (size_t i = 0; i < n; i++)
+    {
+      G4int binX = static_cast<G4int>(floor((x[i] - m_matrixLowEdgeX) * invSizeX));
+      G4int binY = static_cast<G4int>(floor((y[i] - m_matrixLowEdgeY) * invSizeY));
+      G4bool inside = (binX >= 0) & (binX < m_pixelNbX) & (binY >= 0) & (binY < m_pixelNbY)
+        & (headIDs[i] >= 0) & (headIDs[i] < headNb);
+      m_batchPixels[i] = inside ? binX + binY * m_pixelNbX : -1;
+    }
+
+  // Second pass: accumulation into the projections, with the diagnostics of Fill
+  for (size_t i = 0; i < n; i++)
+    {
+      if (m_batchPixels[i] < 0)
+        {
+          ReportRejectedDigi(headIDs[i], x[i], y[i]);
+          continue;
+        }
+      if (m_verboseLevel >= 2)
+        G4cout << "[GateProjectionSet]: binning hit at ("
+               << G4BestUnit(x[i], "Length")
+               << ","
+               << G4BestUnit(y[i], "Length")
+               << ") "
+               << "into bin ("
+               << m_batchPixels[i] % m_pixelNbX
+               << ","
+               << m_batchPixels[i] / m_pixelNbX
+               << ") of head "
+               << headIDs[i]
+               << Gateendl;
+      AddCount(energyWindowID, headIDs[i], m_batchPixels[i], weights ? weights[i] : 1.);
+    }
+}
+
+// Messages of Fill for a digi rejected by FillBatch (wrong head ID or outside the matrix)
+void GateProjectionSet::ReportRejectedDigi(G4int headID, G4double x, G4double y)
+{
+  if ((headID < 0) || ((size_t) headID >= m_headNb))
+    {
+      G4cerr << "[GateToProjectionSet::Fill]:\n"
+             << "Received a hit with a wrong head ID ("
+             << headID
+             << "): ignored!\n";
+      return;
+    }
+  if (m_verboseLevel < 1)
+    return;
+  // Same binning as FillBatch
+  G4int binX = static_cast<G4int>(floor((x - m_matrixLowEdgeX) * (1. / m_pixelSizeX)));
+  if ((binX < 0) || (binX >= m_pixelNbX))
+    G4cerr << "[GateProjectionSet]: coordinate x ("
+           << G4BestUnit(x, "Length")
+           << ") outside the matrix boundaries ("
+           << G4BestUnit(m_matrixLowEdgeX, "Length")
+           << "-"
+           << G4BestUnit(-m_matrixLowEdgeX, "Length")
+           << "): ignored!\n";
+  else
+    G4cerr << "[GateProjectionSet]: coordinate y ("
+           << G4BestUnit(y, "Length")
+           << ") outside the matrix boundaries ("
+           << G4BestUnit(m_matrixLowEdgeY, "Length")
+           << "-"
+           << G4BestUnit(-m_matrixLowEdgeY, "Length")
+           << "): ignored!\n";
+}
+
 /* Writes a head-projection onto an output stream
 
    dest:    	  the destination stream
@@ -378,7 +533,10 @@ void GateProjectionSet::StreamOut(std::ofstream& dest, size_t energyWindowID, si
                 "StreamOut",
                 FatalException,
                 "Could not write a projection onto the disk (out of disk space?)!\n");
-  dest.write((const char*) (m_data[energyWindowID][headID]), BytesPerProjection());
+  if (m_weighted)
+    dest.write((const char*) (m_weightedData[energyWindowID][headID]), BytesPerProjection());
+  else
+    dest.write((const char*) (m_data[energyWindowID][headID]), BytesPerProjection());
   if (dest.bad())
     G4Exception("GateProjectionSet::StreamOut",
                 "StreamOut",
@@ -241,7 +241,7 @@ void GatePromptGammaTLEActor::UserSteppingActionInVoxel(int index, const G4Step
     // 	   << " -- upEdge " << h->GetXaxis()->GetNbins() << " = " << h->GetXaxis()->GetBinUpEdge(h->GetXaxis()->GetNbins()) << G4endl;
     
     // Also take the particle weight into account
-    double w = step->GetTrack()->GetWeight();
+    double w = step->GetPreStepPoint()->GetWeight();
 
     // Do not scale h directly because it will be reused
     mImageGamma->AddValueDouble(index, h, w * distance * material->GetDensity() / (g / cm3));
@@ -120,7 +120,6 @@ void GateSETLEMultiplicityActor::BeginOfEventAction(const G4Event *event)
         {
           G4Event *modifiedEvent = new G4Event();
           int vertexNumber = modifiedEvent->GetNumberOfPrimaryVertex();
-          double weight = 1.0 / mDefaultPrimaryMultiplicity;
           for(int i=0; i<mDefaultPrimaryMultiplicity; i++)
             {
               vertexNumber += source->GeneratePrimaries(modifiedEvent);
@@ -130,6 +129,7 @@ void GateSETLEMultiplicityActor::BeginOfEventAction(const G4Event *event)
                 {
                   // create a hybrid struct for raycasting
                   // primary or not - energy - weight - position - direction
+                  double weight = hybridParticle->GetWeight() / mDefaultPrimaryMultiplicity;
                   mListOfRaycasting.push_back(RaycastingStruct(true, hybridParticle->GetKineticEnergy(), weight,
                                                                position, hybridParticle->GetMomentumDirection()));
                   hybridParticle = hybridParticle->GetNext();
@@ -242,7 +242,7 @@ void GateSETLEMultiplicityActor::UserSteppingAction(const GateVVolume *, const G
                       G4ThreeVector position = step->GetTrack()->GetPosition();
                       G4double globalTime = step->GetTrack()->GetGlobalTime();
                       G4int parentID = step->GetTrack()->GetTrackID();
-                      G4double trackWeight = step->GetTrack()->GetWeight() / currentSecondaryMultiplicity;
+                      G4double trackWeight = step->GetPreStepPoint()->GetWeight() / currentSecondaryMultiplicity;
 	    
                       // Main loop dedicated to secondary hybrid particle 
                       for(int i=0; i<currentSecondaryMultiplicity; i++)
@@ -307,7 +307,7 @@ void GateSETLEMultiplicityActor::UserSteppingAction(const GateVVolume *, const G
               G4ThreeVector position = step->GetTrack()->GetPosition();
               G4double globalTime = step->GetTrack()->GetGlobalTime();
               G4int parentID = step->GetTrack()->GetTrackID();
-              G4double trackWeight = step->GetTrack()->GetWeight() / currentSecondaryMultiplicity;
+              G4double trackWeight = step->GetPreStepPoint()->GetWeight() / currentSecondaryMultiplicity;
               G4VParticleChange* particleChange(0);
               G4TrackVector *trackVector = (const_cast<G4Step *>(step))->GetfSecondary();
 
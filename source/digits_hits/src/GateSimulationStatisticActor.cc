@@ -190,4 +190,55 @@ void GateSimulationStatisticActor::ResetData() {
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+G4bool GateSimulationStatisticActor::SaveCheckpoint(GateCheckpointWriter &w) {
+    long long int counts[6] = {mNumberOfRuns, mNumberOfEvents, mNumberOfTrack, mNumberOfSteps,
+                               mNumberOfGeometricalSteps, mNumberOfPhysicalSteps};
+    w.Write("counts", counts);
+    std::ostringstream types;
+    for (auto &t: mTrackTypes) types << t.first << " " << t.second << std::endl;
+    w.WriteString("trackTypes", types.str());
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSimulationStatisticActor::LoadCheckpoint(GateCheckpointReader &r) {
+    long long int counts[6];
+    r.Read("counts", counts);
+    mNumberOfRuns = counts[0];
+    mNumberOfEvents = counts[1];
+    mNumberOfTrack = counts[2];
+    mNumberOfSteps = counts[3];
+    mNumberOfGeometricalSteps = counts[4];
+    mNumberOfPhysicalSteps = counts[5];
+    mTrackTypes.clear();
+    std::istringstream types(r.ReadString("trackTypes"));
+    std::string name;
+    int n;
+    while (types >> name >> n) mTrackTypes[name] = n;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Forked mode: the processes simulate the same runs, only their counts are added
+G4bool GateSimulationStatisticActor::MergeCheckpoint(GateCheckpointReader &r) {
+    long long int counts[6];
+    r.Read("counts", counts);
+    mNumberOfEvents += counts[1];
+    mNumberOfTrack += counts[2];
+    mNumberOfSteps += counts[3];
+    mNumberOfGeometricalSteps += counts[4];
+    mNumberOfPhysicalSteps += counts[5];
+    std::istringstream types(r.ReadString("trackTypes"));
+    std::string name;
+    int n;
+    while (types >> name >> n) mTrackTypes[name] += n;
+    return true;
+}
+//-----------------------------------------------------------------------------
+
+
 #endif /* end #define GATESIMULATIONSTATISTICACTOR_CC */
@@ -8,6 +8,7 @@
 
 #include "GateSteppingActionMessenger.hh"
 #include "GateActions.hh"
+#include "GateEventTrackStore.hh"
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithABool.hh"
@@ -55,6 +56,12 @@ GateSteppingActionMessenger::GateSteppingActionMessenger(GateSteppingAction * ms
   GetTxtCmd->SetGuidance(" If On write Tracks infos to the file \"PostStepInfo.txt\".");
 
   SetFilesCmd = new G4UIcmdWithAnInteger("/gate/stepping/SetNumberOfTrackerDataFiles",this);
+
+  StoreTrajectoriesCmd = new G4UIcmdWithABool("/gate/stepping/storeTrajectories",this);
+  StoreTrajectoriesCmd->SetGuidance("Store the G4 trajectories of all tracks (default: only for visualisation and detector mode).");
+  StoreTrajectoriesCmd->SetGuidance("The trajectory navigator of the outputs does not need them.");
+  StoreTrajectoriesCmd->SetParameterName("flag",true);
+  StoreTrajectoriesCmd->SetDefaultValue(true);
 }
 
 GateSteppingActionMessenger::~GateSteppingActionMessenger()
@@ -65,6 +72,7 @@ GateSteppingActionMessenger::~GateSteppingActionMessenger()
   delete  PolicyCmd;
   delete GetTxtCmd;
   delete SetFilesCmd;
+  delete StoreTrajectoriesCmd;
   //delete SetPhFilesCmd;
   //delete SetRSFilesCmd;
   delete setEnergyTcmd;
@@ -79,6 +87,11 @@ void GateSteppingActionMessenger::SetNewValue(G4UIcommand * command,G4String new
      myAction->SetEnergyThreshold( setEnergyTcmd->GetNewDoubleValue(newValue) );
      return;
   }
+  if ( command == StoreTrajectoriesCmd )
+  {
+    GateEventTrackStore::GetInstance()->SetStoreTrajectoriesFlag(StoreTrajectoriesCmd->GetNewBoolValue(newValue));
+    return;
+  }
   if ( command == SetFilesCmd )
   {
     myAction->SetFiles( SetFilesCmd->GetNewIntValue(newValue) );
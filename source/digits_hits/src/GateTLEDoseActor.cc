@@ -226,6 +226,11 @@ void GateTLEDoseActor::UserSteppingActionInVoxel(const int index, const G4Step *
       step->GetTrack()->SetTrackStatus(fStopAndKill);
     }
 
+    // Weight the step was transported with: the weight window may have
+    // split or killed the track in this step's PostStepDoIt
+    dose *= step->GetPreStepPoint()->GetWeight();
+    edep *= step->GetPreStepPoint()->GetWeight();
+
     if (mIsDoseImageEnabled) {
       if (mIsDoseUncertaintyImageEnabled || mIsDoseSquaredImageEnabled) {
         if (sameEvent) mDoseImage.AddTempValue(index, dose);
@@ -20,10 +20,14 @@
 #include <G4Tet.hh>
 #include <G4LogicalVolume.hh>
 #include <G4AssemblyVolume.hh>
+#include <G4VTouchable.hh>
+#include <G4NavigationHistory.hh>
 
 #include "GateMessageManager.hh"
 #include "GateVVolume.hh"
 #include "GateTetMeshBox.hh"
+#include "GateTetMesh.hh"
+#include "GateTetMeshRegionSolid.hh"
 #include "GateVActor.hh"
 #include "GateActorMessenger.hh"
 
@@ -34,7 +38,7 @@
 
 
 GateTetMeshDoseActor::GateTetMeshDoseActor(G4String name, G4int depth)
-  : GateVActor(name, depth), mEvtDoseMap(), mRunCounter(),
+  : GateVActor(name, depth), mEvtDoseMap(), mStepTets(), mRunCounter(),
     mRunData(), pMessenger(new GateActorMessenger(this))
 {
 }
@@ -106,13 +110,10 @@ void GateTetMeshDoseActor::EndOfRunAction(const G4Run* run)
 
 void GateTetMeshDoseActor::EndOfEventAction(const G4Event*)
 {  
-  // get the TetMeshBox this actor is attached to
-  GateTetMeshBox* tetMeshBox = dynamic_cast<GateTetMeshBox*>(GateVActor::mVolume);
-  
   // Accumulate event dose in the run's dose map.
   for (const auto& keyValuePair : mEvtDoseMap)
   {
-    G4int iTetrahedron = tetMeshBox->GetTetIndex(keyValuePair.first);
+    G4int iTetrahedron = keyValuePair.first;
     G4double dose = keyValuePair.second;
 
     Estimators& tetEstimator = mRunData[iTetrahedron];
@@ -147,13 +148,11 @@ void GateTetMeshDoseActor::SaveData()
 
   for (std::size_t iTet = 0; iTet < tetMeshBox->GetNumberOfTetrahedra(); ++iTet)
   {
-    const G4LogicalVolume* tetLogical = tetMeshBox->GetTetLogical(iTet);
-
     G4double dose = mRunData[iTet].dose;
     G4double relativeUncertainty = mRunData[iTet].relativeUncertainty;
     G4double sumOfSquaredDose = mRunData[iTet].sumOfSquaredDose;
-    G4double cubicVolume = tetLogical->GetSolid()->GetCubicVolume();
-    G4double density = tetLogical->GetMaterial()->GetDensity();
+    G4double cubicVolume = tetMeshBox->GetTetVolume(iTet);
+    G4double density = tetMeshBox->GetTetMaterial(iTet)->GetDensity();
     G4int regionMarker = tetMeshBox->GetRegionMarker(iTet);
 
     csvTable << iTet << ", " << dose / gray << ", " << relativeUncertainty << ", "
@@ -192,28 +191,58 @@ void GateTetMeshDoseActor::clear()
 void GateTetMeshDoseActor::UserSteppingAction(const GateVVolume*, const G4Step* aStep)
 {
   G4VPhysicalVolume* physVol = aStep->GetPreStepPoint()->GetPhysicalVolume();
-  G4int copyNum = physVol->GetCopyNo();
+  G4LogicalVolume* logVol = physVol->GetLogicalVolume();
 
   G4double edep = aStep->GetTotalEnergyDeposit();
   G4double weight = aStep->GetPreStepPoint()->GetWeight();
 
+  GateTetMeshBox* tetMeshBox = dynamic_cast<GateTetMeshBox*>(GateVActor::mVolume);
+  if (tetMeshBox->IsMeshNavigation())
+  {
+    // discard steps in bounding box volume or without energy deposition
+    const GateTetMeshRegionSolid* regionSolid =
+      dynamic_cast<const GateTetMeshRegionSolid*>(logVol->GetSolid());
+    if (regionSolid == nullptr || edep == 0)
+      return;
+
+    // Steps only stop at region boundaries: the energy is shared between the tets
+    // crossed by the step, in proportion to the length travelled in each of them.
+    const G4AffineTransform& toLocal =
+      aStep->GetPreStepPoint()->GetTouchable()->GetHistory()->GetTopTransform();
+    G4ThreeVector preStepPosition =
+      regionSolid->ToMesh(toLocal.TransformPoint(aStep->GetPreStepPoint()->GetPosition()));
+    G4ThreeVector postStepPosition =
+      regionSolid->ToMesh(toLocal.TransformPoint(aStep->GetPostStepPoint()->GetPosition()));
+    tetMeshBox->GetMesh()->GetSegmentTets(preStepPosition, postStepPosition, mStepTets);
+
+    G4double density = logVol->GetMaterial()->GetDensity();
+    for (const auto& tetFraction : mStepTets)
+    {
+      G4double cubicVolume = tetMeshBox->GetMesh()->GetTetVolume(tetFraction.first);
+      mEvtDoseMap[tetFraction.first] += (edep * weight * tetFraction.second) / (density * cubicVolume);
+    }
+    return;
+  }
+
+  G4int copyNum = physVol->GetCopyNo();
+
   // discard steps in bounding box volume or without energy deposition
   if (copyNum == 0 || edep == 0)
     return;
 
-  G4LogicalVolume* logVol = physVol->GetLogicalVolume();
   G4double cubicVolume = logVol->GetSolid()->GetCubicVolume();
   G4double density = logVol->GetMaterial()->GetDensity();
 
   G4double dose = (edep * weight) / (density * cubicVolume);
 
   // accumulate or add
-  if (mEvtDoseMap.find(copyNum) == mEvtDoseMap.end())
+  G4int iTetrahedron = tetMeshBox->GetTetIndex(copyNum);
+  if (mEvtDoseMap.find(iTetrahedron) == mEvtDoseMap.end())
   {
-    mEvtDoseMap[copyNum] = dose;
+    mEvtDoseMap[iTetrahedron] = dose;
   }
   else
   {
-    mEvtDoseMap[copyNum] += dose;    
+    mEvtDoseMap[iTetrahedron] += dose;    
   }
 }
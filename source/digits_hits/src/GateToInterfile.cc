@@ -261,7 +261,7 @@ void GateToInterfile::RecordEndOfRun(const G4Run*)
     return;
 
   // Write the projection sets
-  if (m_system->GetProjectionSetMaker()->GetProjectionSet()->GetData() != 0) {
+  if (m_system->GetProjectionSetMaker()->GetProjectionSet()->HasData()) {
 
 	  for (size_t energyWindowID = 0;
 			  energyWindowID < m_system->GetProjectionSetMaker()->GetEnergyWindowNb();
@@ -423,7 +423,7 @@ void GateToInterfile::WriteGeneralInfo()
                        << Gateendl<< "!process status := " << "Acquired\n"
                        << "!matrix size [1] := " << setMaker->GetPixelNbX() << Gateendl
                        << "!matrix size [2] := " << setMaker->GetPixelNbY() << Gateendl;
-          if(m_system->GetProjectionSetMaker()->GetProjectionSet()->GetARFData() != 0)
+          if(m_system->GetProjectionSetMaker()->GetProjectionSet()->GetARFData() != 0 || setMaker->IsWeighted())
             {
               m_headerFile << "!number format := " << "double\n" // Modified from "UNSIGNED INTEGER" to fit the i33 standard
                            << "!number of bytes per pixel := " << 8 << Gateendl;
@@ -439,8 +439,12 @@ void GateToInterfile::WriteGeneralInfo()
                        << "!extent of rotation := " << setMaker->GetAngularSpan()/deg << Gateendl
                        << "!time per projection (sec) := " << setMaker->GetTimePerProjection() / second << Gateendl
                        << "study duration (sec) := " << setMaker->GetStudyDuration() / second << Gateendl // Modified from "study duration (acquired) sec" to fit the i33 standard
-                       << "!maximum pixel count := " << setMaker->GetProjectionSet()->GetMaxCounts(energyWindowID, headID) << Gateendl
-                       << ";\n";
+                       << "!maximum pixel count := ";
+          if (setMaker->IsWeighted())
+            m_headerFile << setMaker->GetProjectionSet()->GetWeightedMaxCounts(energyWindowID, headID) << Gateendl;
+          else
+            m_headerFile << setMaker->GetProjectionSet()->GetMaxCounts(energyWindowID, headID) << Gateendl;
+          m_headerFile << ";\n";
 
           G4double rotationDirection = ( ( m_system->GetBaseComponent()->GetOrbitingVelocity()>=0) ? +1. : -1 );
 
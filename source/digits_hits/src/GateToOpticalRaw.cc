@@ -119,7 +119,7 @@ void GateToOpticalRaw::RecordEndOfRun(const G4Run* )
   if (!(m_system->GetProjectionSetMaker()->IsEnabled())) return;
 
   // Write the projection sets
-	if (m_system->GetProjectionSetMaker()->GetProjectionSet()->GetData() != 0) {
+	if (m_system->GetProjectionSetMaker()->GetProjectionSet()->HasData()) {
 		for (size_t energyWindowID = 0; energyWindowID < m_system->GetProjectionSetMaker()->GetEnergyWindowNb(); energyWindowID++) {
   			for (size_t headID=0 ; headID < m_system->GetProjectionSetMaker()->GetHeadNb(); headID++) {
 
@@ -470,11 +470,19 @@ void GateToProjectionSet::RecordEndOfEvent(const G4Event*)
         }
 
       G4int n_digi = SDC->entries();
+      m_batchHeadIDs.resize(n_digi);
+      m_batchX.resize(n_digi);
+      m_batchY.resize(n_digi);
+      m_batchWeights.resize(n_digi);
       for (G4int iDigi = 0; iDigi < n_digi; iDigi++)
         {
           G4int headID = m_system->GetMainComponentIDGND((*SDC)[iDigi]);
           G4double xProj = (*SDC)[iDigi]->GetLocalPos()[m_coordX];
           G4double yProj = (*SDC)[iDigi]->GetLocalPos()[m_coordY];
+          m_batchHeadIDs[iDigi] = headID;
+          m_batchX[iDigi] = xProj;
+          m_batchY[iDigi] = yProj;
+          m_batchWeights[iDigi] = (*SDC)[iDigi]->GetWeight();
           if (nVerboseLevel >= 2)
             {
               G4cout << "[GateToProjectionSet]: Processing count on head "
@@ -486,12 +494,14 @@ void GateToProjectionSet::RecordEndOfEvent(const G4Event*)
                      << Gateendl;
               G4cout << "Extracting projection coordinates: " << G4BestUnit(xProj,"Length") << " , " << G4BestUnit(yProj,"Length") << Gateendl;
             }
-          m_projectionSet->Fill(static_cast<G4int>(energyWindowID),
-                                headID,
-                                xProj,
-                                yProj);
-
         }
+      // The weights are only kept with weighted counts
+      m_projectionSet->FillBatch(static_cast<G4int>(energyWindowID),
+                                 n_digi,
+                                 m_batchHeadIDs.data(),
+                                 m_batchX.data(),
+                                 m_batchY.data(),
+                                 m_batchWeights.data());
     }
 
   if (nVerboseLevel > 2)
@@ -527,9 +537,13 @@ void GateToProjectionSet::Describe(size_t indent)
          << " x "
          << G4BestUnit(GetPixelSizeY(), "Length")
          << Gateendl;
+  G4cout << GateTools::Indent(indent)
+         << "Counts                 "
+         << (IsWeighted() ? "weighted (double)" : "unsigned short")
+         << Gateendl;
   G4cout << GateTools::Indent(indent)
          << "Filled?                "
-         << (m_projectionSet->GetData() ? "Yes" : "No")
+         << (m_projectionSet->HasData() ? "Yes" : "No")
          << Gateendl;
   if (GetProjectionNb())
     G4cout << GateTools::Indent(indent)
@@ -77,6 +77,11 @@ GateToProjectionSetMessenger::GateToProjectionSetMessenger(GateToProjectionSet*
   AddInputDataCmd->SetGuidance("Add the name of the input data to store into the sinogram");
   AddInputDataCmd->SetParameterName("Name",false);
 
+  cmdName = GetDirectoryName()+"setWeightedCounts";
+  WeightedCmd = new G4UIcmdWithABool(cmdName,this);
+  WeightedCmd->SetGuidance("Store double precision (weighted) counts instead of 16-bit counters");
+  WeightedCmd->SetParameterName("Flag",false);
+
 }
 
 
@@ -93,6 +98,7 @@ GateToProjectionSetMessenger::~GateToProjectionSetMessenger()
   delete projectionPlaneCmd;
   delete SetInputDataCmd;
   delete AddInputDataCmd;
+  delete WeightedCmd;
 }
 
 
@@ -118,6 +124,9 @@ void GateToProjectionSetMessenger::SetNewValue(G4UIcommand* command,G4String new
   else if( command==PixelNumberYCmd )
     { m_gateToProjectionSet->SetPixelNbY(PixelNumberYCmd->GetNewIntValue(newValue)); }
 
+  else if( command==WeightedCmd )
+    { m_gateToProjectionSet->SetWeighted(WeightedCmd->GetNewBoolValue(newValue)); }
+
   else if (command == SetInputDataCmd)
     {
 	  G4String newName;
@@ -69,6 +69,7 @@
 // v. cuplov - optical photons
 #include "G4OpticalPhoton.hh"
 #include "GateTrajectoryNavigator.hh"
+#include "GateEventTrackStore.hh"
 // v. cuplov - optical photons
 
 ComptonRayleighData::ComptonRayleighData() { ; }
@@ -920,8 +921,7 @@ void GateToRoot::RecordOpticalData(const G4Event *event) {
 	   if (nVerboseLevel > 2)
 	        G4cout << "GateToRoot::RecordOpticalData\n";
 
-	G4TrajectoryContainer *trajectoryContainer = event->GetTrajectoryContainer();
-    if (trajectoryContainer) m_trajectoryNavigator->SetTrajectoryContainer(trajectoryContainer);
+    m_trajectoryNavigator->SetTrajectoryContainer(event->GetTrajectoryContainer());
 
 
 
@@ -1030,7 +1030,7 @@ void GateToRoot::RecordOpticalData(const G4Event *event) {
 		if (nCrystalOpticalWLS > 0) NumCrystalWLS++;
 		if (nPhantomOpticalWLS > 0) NumPhantomWLS++;
 
-		if (m_rootOpticalFlag && trajectoryContainer) {
+		if (m_rootOpticalFlag && !GateEventTrackStore::GetInstance()->IsEmpty()) {
 			m_OpticalTrees[i]->Fill();
 		}
 
@@ -31,6 +31,7 @@ See LICENSE.md for further details
 #include "GateMiscFunctions.hh"
 #include "G4DigiManager.hh"
 #include "GateDigitizerMgr.hh"
+#include "GateEventTrackStore.hh"
 
 char GateToTree::m_outputIDName[GateToTree::MAX_NB_SYSTEM][GateToTree::MAX_DEPTH_SYSTEM][GateToTree::MAX_OUTPUTIDNAME_SIZE];
 bool GateToTree::m_outputIDHasName[GateToTree::MAX_NB_SYSTEM][GateToTree::MAX_DEPTH_SYSTEM];
@@ -84,6 +85,7 @@ GateToTree::GateToTree(const G4String &name, GateOutputMgr *outputMgr, DigiMode
     m_hitsParams_to_write.emplace("edep", SaveDataParam());
     m_hitsParams_to_write.emplace("stepLength", SaveDataParam());
     m_hitsParams_to_write.emplace("trackLength", SaveDataParam());
+    m_hitsParams_to_write.emplace("weight", SaveDataParam());
     m_hitsParams_to_write.emplace("rotationAngle", SaveDataParam());
     m_hitsParams_to_write.emplace("axialPos", SaveDataParam());
     m_hitsParams_to_write.emplace("processName", SaveDataParam());
@@ -278,6 +280,9 @@ void GateToTree::RecordBeginOfAcquisition() {
                if (m_hitsParams_to_write.at("trackLength").toSave())
                    m_manager_hits.write_variable("trackLength", &m_trackLength);
 
+               if (m_hitsParams_to_write.at("weight").toSave())
+                   m_manager_hits.write_variable("weight", &m_weight);
+
                if (m_hitsParams_to_write.at("rotationAngle").toSave())
                    m_manager_hits.write_variable("rotationAngle", &m_rotationAngle);
 
@@ -435,6 +440,9 @@ void GateToTree::RecordBeginOfAcquisition() {
         if (m_hitsParams_to_write.at("trackLength").toSave())
             mm.write_variable("trackLength", &m_trackLength);
 
+        if (m_hitsParams_to_write.at("weight").toSave())
+            mm.write_variable("weight", &m_weight);
+
         if (m_hitsParams_to_write.at("rotationAngle").toSave())
             mm.write_variable("rotationAngle", &m_rotationAngle);
 
@@ -969,6 +977,7 @@ void GateToTree::RecordEndOfEvent(const G4Event *event) {
 			m_edep[0] = hit->GetEdep() / MeV;
 			m_stepLength = hit->GetStepLength() / mm;
 			m_trackLength = hit->GetTrackLength() / mm;
+			m_weight = hit->GetWeight();
 
 			m_processName = hit->GetProcess();
 
@@ -1521,7 +1530,7 @@ void GateToTree::RecordOpticalData(const G4Event *event) {
     if (m_nCrystalOpticalWLS > 0) m_NumCrystalWLS++;
     if (m_nPhantomOpticalWLS > 0) m_NumPhantomWLS++;
 
-    if (event->GetTrajectoryContainer())
+    if (!GateEventTrackStore::GetInstance()->IsEmpty())
     	m.second.fill();
 
     }
@@ -25,6 +25,7 @@ See LICENSE.md for further details
 #include "GateOutputMgr.hh"
 #include "GateToRoot.hh"
 #include "GatePrimTrackInformation.hh"
+#include "GateCheckpointManager.hh"
 //class GateRecorderBase;
 GateUserActions* GateUserActions::pUserActions=0;
 
@@ -95,6 +96,9 @@ void GateUserActions::BeginOfRunAction(const G4Run* run)
   mCurrentRun = run;
   GateActorManager::GetInstance()->BeginOfRunAction(run);
 
+  // Resumed run: actor data are restored after their begin of run actions
+  GateCheckpointManager::GetInstance()->BeginOfRunAction(run);
+
   // Prepare the visualization
   if (G4VVisManager::GetConcreteInstance()) {
     G4UImanager* UI = G4UImanager::GetUIpointer();
@@ -136,6 +140,7 @@ void GateUserActions::BeginOfEventAction(const G4Event* evt)
 void GateUserActions::EndOfEventAction(const G4Event* evt)
 {
   GateActorManager::GetInstance()->EndOfEventAction(evt);
+  GateCheckpointManager::GetInstance()->EndOfEventAction(evt);
 //sizeof(v) + sizeof(T) * v.capacity();
 // G4cout<< Gateendl;
  // GateTrackIDInfo trInfo;
@@ -236,6 +236,7 @@ GateDigi* GateVDigitizerModule::CentroidMerge(GateDigi* right, GateDigi* output
     // energy: we compute the sum, but do not store it yet
     // (storing it now would mess up the centroid computations)
     G4double totalEnergy = output->m_energy + right->m_energy;
+    output->MergeWeight(right);
 
     if (output->m_sourceEnergy != right->m_sourceEnergy) output->m_sourceEnergy=-1;
     if (output->m_sourcePDG != right->m_sourcePDG) output->m_sourcePDG=0;
@@ -328,6 +329,7 @@ GateDigi* GateVDigitizerModule::MergePositionEnergyWin(GateDigi *right, GateDigi
 
     }
     //G4cout<<output->m_energy <<" + "<< right->m_energy<<G4endl;
+    output->MergeWeight(right);
     output->m_energy = output->m_energy + right->m_energy;
     //G4cout<<output->m_energy <<G4endl;
 
@@ -31,6 +31,7 @@ GateVImageActor::GateVImageActor(G4String name, G4int depth):
   mPosition(0.0, 0.0, 0.0),
   mStepHitType(MiddleStepHitType),
   mStepHitTypeName("middle"),
+  mPrecision(GateImageWithStatistic::DoublePrecision),
   mVoxelSizeIsSet(false),
   mResolutionIsSet(false),
   mHalfSizeIsSet(false),
@@ -234,6 +235,9 @@ void GateVImageActor::SetOriginTransformAndFlagToImage(GateImageWithStatistic &
 
   // Set Overwrite flag
   image.SetOverWriteFilesFlag(mOverWriteFilesFlag);
+
+  // Set precision of the accumulated images
+  image.SetPrecision(mPrecision);
 }
 //-----------------------------------------------------------------------------
 
@@ -393,14 +397,14 @@ int GateVImageActor::GetIndexFromStepPosition(const GateVVolume * v, const G4Ste
 
 
 //-----------------------------------------------------------------------------
-int GateVImageActor::GetIndexFromStepPosition2(const GateVVolume * v,
-                                               const G4Step * step,
-                                               const GateImage & image,
-                                               const bool mPositionIsSet,
-                                               const G4ThreeVector mPosition,
-                                               const StepHitType mStepHitType)
+bool GateVImageActor::GetStepPositions2(const GateVVolume * v,
+                                        const G4Step * step,
+                                        const bool mPositionIsSet,
+                                        const G4ThreeVector mPosition,
+                                        G4ThreeVector & prePosition,
+                                        G4ThreeVector & postPosition)
 {
-  if(v==0) return -1;
+  if(v==0) return false;
 
   const G4ThreeVector & worldPos = step->GetPostStepPoint()->GetPosition();
   const G4ThreeVector & worldPre =  step->GetPreStepPoint()->GetPosition() ;
@@ -425,12 +429,12 @@ int GateVImageActor::GetIndexFromStepPosition2(const GateVVolume * v,
       currentVol = theTouchable->GetVolume(depth)->GetLogicalVolume();
     }
 
-  if(depth>=maxDepth) return -1;
+  if(depth>=maxDepth) return false;
 
   GateDebugMessage("Step",3,"GateVImageActor -- GetIndexFromStepPosition: Logical volume "<<currentVol->GetName() <<" found! - Depth = "<<depth << Gateendl );
 
-  G4ThreeVector postPosition = theTouchable->GetHistory()->GetTransform(transDepth).TransformPoint(worldPos);
-  G4ThreeVector prePosition = theTouchable->GetHistory()->GetTransform(transDepth).TransformPoint(worldPre);
+  postPosition = theTouchable->GetHistory()->GetTransform(transDepth).TransformPoint(worldPos);
+  prePosition = theTouchable->GetHistory()->GetTransform(transDepth).TransformPoint(worldPre);
 
   if (mPositionIsSet) {
     GateDebugMessage("Step", 3, "GateVImageActor -- GetIndexFromStepPosition: Step postPosition (vol reference) = " << postPosition << Gateendl);
@@ -439,6 +443,21 @@ int GateVImageActor::GetIndexFromStepPosition2(const GateVVolume * v,
     prePosition -= mPosition;
     postPosition -= mPosition;
   }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+int GateVImageActor::GetIndexFromStepPosition2(const GateVVolume * v,
+                                               const G4Step * step,
+                                               const GateImage & image,
+                                               const bool mPositionIsSet,
+                                               const G4ThreeVector mPosition,
+                                               const StepHitType mStepHitType)
+{
+  G4ThreeVector prePosition, postPosition;
+  if (!GetStepPositions2(v, step, mPositionIsSet, mPosition, prePosition, postPosition)) return -1;
 
   GateDebugMessage("Step", 2, "GateVImageActor -- GetIndexFromStepPosition:Actor  UserSteppingAction (type = " << GetStepHitName(mStepHitType) << ")\n"
 		   << "\tPreStep     = " << prePosition << Gateendl
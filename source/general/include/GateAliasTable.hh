@@ -0,0 +1,56 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateAliasTable
+  \brief  Walker/Vose alias table: O(1) sampling of a discrete distribution
+          given by (non normalised) bin weights, with a single uniform draw.
+*/
+
+#ifndef GATEALIASTABLE_HH
+#define GATEALIASTABLE_HH
+
+#include "globals.hh"
+#include <vector>
+
+class GateAliasTable
+{
+public:
+  GateAliasTable() : mTotalWeight(0.) {}
+
+  // Build the table from the weights (negative weights are set to zero)
+  void Build(const std::vector<G4double> & weights);
+  void Clear();
+
+  // Sample a bin index, u is uniform in [0,1)
+  inline size_t Sample(G4double u) const;
+  size_t Sample() const;
+  // Sample n bin indices into 'bins' (resized)
+  void Sample(size_t n, std::vector<size_t> & bins) const;
+
+  size_t GetNumberOfBins() const { return mProbability.size(); }
+  G4bool IsEmpty() const { return mProbability.empty(); }
+  G4double GetTotalWeight() const { return mTotalWeight; }
+
+protected:
+  std::vector<G4double> mProbability;
+  std::vector<size_t> mAlias;
+  G4double mTotalWeight;
+};
+
+//-----------------------------------------------------------------------------
+inline size_t GateAliasTable::Sample(G4double u) const
+{
+  const G4double x = u * mProbability.size();
+  size_t i = static_cast<size_t>(x);
+  if (i >= mProbability.size()) i = mProbability.size() - 1;
+  return (x - i < mProbability[i]) ? i : mAlias[i];
+}
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATEALIASTABLE_HH */
@@ -14,6 +14,7 @@
 #include "G4ThreeVector.hh"
 #include "GateConfiguration.h"
 #include "GateApplicationMgrMessenger.hh"
+#include <map>
 #include <vector>
 
 class GateApplicationMgr
@@ -43,6 +44,12 @@ public:
   void StartDAQCluster(G4ThreeVector param);
 
   void StartDAQComplete(G4ThreeVector param);
+
+  //! Forked mode: the application is initialised once, then N processes share it copy-on-write
+  void SetNumberOfForkedProcesses(G4int n);
+  G4int GetNumberOfForkedProcesses() { return mNumberOfForkedProcesses; }
+  G4int GetForkedProcessIndex() { return mForkedProcessIndex; }
+  void ForkWorkers();
   void StopDAQ() {};
   void PauseDAQ() {};
 
@@ -115,6 +122,19 @@ protected:
   double mTimeStepInTotalAmountOfPrimariesMode;
 
   void InitializeTimeSlices();
+  G4long ResumeFromCheckpoint(G4int & slice);
+
+  void StartDAQForked();
+  G4String GetForkedFileNameSuffix(G4int index);
+  // Actor data of the workers, summed by the parent process (same format as the checkpoints)
+  G4String GetForkedActorDataFileName(G4int index);
+  void WriteForkedActorData();
+  void MergeForkedActorData();
+  G4int mNumberOfForkedProcesses;
+  G4int mForkedProcessIndex; // -1 when not forked, 0 for the parent process
+  std::vector<int> mForkedProcessIds;
+  int mForkedParentId;
+  std::map<G4String, G4String> mForkedActorFileNames; // actor name -> file name without suffix
 
   GateApplicationMgrMessenger* m_appMgrMessenger;
 
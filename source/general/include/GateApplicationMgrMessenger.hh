@@ -46,6 +46,7 @@ private:
   //dk cluster
   G4UIcmdWith3VectorAndUnit* StartDAQClusterCmd;
   //dk cluster end
+  G4UIcmdWithAnInteger*      NumberOfForkedProcessesCmd;
   G4UIcmdWithoutParameter*   StopDAQCmd;
   G4UIcmdWithoutParameter*   PauseDAQCmd;
   G4UIcmdWithAnInteger*      VerboseCmd;
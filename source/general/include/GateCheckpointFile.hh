@@ -0,0 +1,161 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateCheckpointWriter / GateCheckpointReader
+
+  Checkpoint files used to resume an interrupted simulation (see
+  GateCheckpointManager). A checkpoint is a list of named entries: small
+  values (counters, times, random engine status...) and arrays (images).
+
+  Two slots are used alternately, each made of <prefix>.<slot>.chk (the
+  list of entries, with the values) and <prefix>.<slot>.dat (the arrays).
+  The .chk of a slot is removed before its .dat is modified and written
+  (temporary file + rename) once the .dat is complete, so a job killed
+  during a write always leaves the other slot valid.
+
+  Arrays are cut in blocks. The writer remembers a hash of each block
+  written in each slot and only copies and writes the blocks that changed
+  since that slot was last written. Writes are done in a background thread.
+  The reader verifies the array checksums and falls back to the older slot
+  if the most recent one is damaged.
+
+  Native byte order: checkpoints are meant to be read back on the same
+  kind of machine.
+*/
+
+#ifndef GATECHECKPOINTFILE_HH
+#define GATECHECKPOINTFILE_HH
+
+#include "globals.hh"
+#include "GateImageT.hh"
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+class GateCheckpointWriter
+{
+public:
+  GateCheckpointWriter();
+  ~GateCheckpointWriter();
+
+  void SetFileName(const G4String & prefix) { mFileName = prefix; }
+  void SetBlockSize(size_t n) { mBlockSize = n; }
+  //! Sequence number of the next checkpoint (the slot is sequence % 2)
+  void SetSequence(G4long n) { mSequence = n; }
+  G4long GetSequence() const { return mSequence; }
+
+  //! Start a new checkpoint (waits for the previous one to be written)
+  void Begin();
+  //! Prefix prepended to the following keys (e.g. "actors/dose/")
+  void SetPrefix(const G4String & prefix) { mPrefix = prefix; }
+
+  template<class T> void Write(const G4String & key, const T & value)
+  { WriteBytes(key, &value, sizeof(T)); }
+  void WriteString(const G4String & key, const std::string & value)
+  { WriteBytes(key, value.data(), value.size()); }
+  template<class T> void WriteArray(const G4String & key, const T * data, size_t n)
+  { WriteArrayBytes(key, data, n*sizeof(T)); }
+  template<class T> void WriteImage(const G4String & key, const GateImageT<T> & image)
+  { WriteArray(key, image.begin() == image.end() ? 0 : &*image.begin(), image.end() - image.begin()); }
+
+  //! Hand the checkpoint to the background thread
+  void Commit();
+  //! Wait until the last committed checkpoint is on disk
+  void Wait();
+  G4bool IsWriting();
+
+protected:
+  struct Array {
+    std::string key;
+    uint64_t size;
+    uint64_t offset;
+    std::vector<uint64_t> hashes[2]; // hash of the blocks last written in each slot
+  };
+  struct Block {
+    uint64_t offset;
+    std::string bytes;
+  };
+  struct Job {
+    std::string dataFileName;
+    std::string metaFileName;
+    std::string meta;
+    std::vector<Block> blocks;
+  };
+
+  void WriteBytes(const G4String & key, const void * data, size_t size);
+  void WriteArrayBytes(const G4String & key, const void * data, size_t size);
+  static std::string WriteJob(std::shared_ptr<Job> job);
+
+  G4String mFileName;
+  G4String mPrefix;
+  size_t mBlockSize;
+  G4long mSequence;
+  G4int mPendingSlot;
+  uint64_t mDataSize;
+  std::map<std::string, size_t> mArrayIndex;
+  std::vector<Array> mArrays;
+  std::string mMeta;
+  uint64_t mNumberOfEntries;
+  std::shared_ptr<Job> mJob;
+  std::future<std::string> mPendingJob;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+class GateCheckpointReader
+{
+public:
+  GateCheckpointReader();
+
+  //! Select the most recent valid checkpoint written with this prefix, false if none
+  G4bool Open(const G4String & prefix);
+  void Close();
+  G4long GetSequence() const { return mSequence; }
+
+  void SetPrefix(const G4String & prefix) { mPrefix = prefix; }
+  G4bool Has(const G4String & key) const { return mEntries.count(mPrefix+key) != 0; }
+
+  template<class T> void Read(const G4String & key, T & value)
+  { ReadBytes(key, &value, sizeof(T)); }
+  std::string ReadString(const G4String & key);
+  template<class T> void ReadArray(const G4String & key, T * data, size_t n)
+  { ReadArrayBytes(key, data, n*sizeof(T)); }
+  template<class T> void ReadImage(const G4String & key, GateImageT<T> & image)
+  { ReadArray(key, image.begin() == image.end() ? 0 : &*image.begin(), image.end() - image.begin()); }
+
+protected:
+  struct Entry {
+    G4bool isArray;
+    std::string value;
+    uint64_t size;
+    uint64_t offset;
+    uint64_t digest;
+  };
+
+  G4bool ReadSlot(const G4String & prefix, G4int slot);
+  G4bool CheckArrays();
+  const Entry & GetEntry(const G4String & key, G4bool isArray);
+  void ReadBytes(const G4String & key, void * data, size_t size);
+  void ReadArrayBytes(const G4String & key, void * data, size_t size);
+
+  G4String mPrefix;
+  G4String mDataFileName;
+  G4long mSequence;
+  uint64_t mBlockSize;
+  std::map<std::string, Entry> mEntries;
+};
+//-----------------------------------------------------------------------------
+
+#endif
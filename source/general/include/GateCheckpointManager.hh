@@ -0,0 +1,107 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#ifndef GATECHECKPOINTMANAGER_HH
+#define GATECHECKPOINTMANAGER_HH 1
+
+#include "globals.hh"
+#include "G4Event.hh"
+#include "GateCheckpointFile.hh"
+
+#include <chrono>
+#include <set>
+
+class GateCheckpointManagerMessenger;
+class G4Run;
+
+/*! \class  GateCheckpointManager
+    \brief  Periodic checkpoints of a simulation, and restart from the last one
+
+    - Every N events and/or every T seconds (wall clock), at the end of an event, the
+      state needed to go on exactly (run and event counters, random engine status,
+      sources and actors accumulated data) is handed to a GateCheckpointWriter, which
+      writes the modified blocks in a background thread. If the previous checkpoint is
+      still being written, the next one is delayed to a later event.
+    - To resume, the same macro is run with restartFrom (before the initialization):
+      the acquisition starts again at the run of the checkpoint, skipping the events
+      already simulated. Actors are restored after their begin of run actions, the
+      random engine and the sources after GateSourceMgr::PrepareNextRun, just before
+      the first event. The outputs that are not in the checkpoint (output modules, other
+      actors) restart from zero under new file names (resume suffix), so that the ones
+      of the interrupted job are not overwritten.
+    - Checkpoints are not written at the last event of a run, the end of run saves the
+      outputs.
+*/
+//-----------------------------------------------------------------------------
+class GateCheckpointManager
+{
+public:
+  static GateCheckpointManager * GetInstance();
+  ~GateCheckpointManager();
+
+  void SetFileName(const G4String & f) { mFileName = f; mWriter.SetFileName(f); }
+  void SetEventInterval(G4int n) { mEventInterval = n; }
+  void SetTimeInterval(G4double t) { mTimeInterval = t; }
+  void SetRestartFileName(const G4String & f) { mRestartFileName = f; }
+  //! Forked mode: each process has its own checkpoints
+  void AppendSuffixToFileNames(const G4String & suffix);
+
+  G4bool IsEnabled() const { return mFileName != "" && (mEventInterval > 0 || mTimeInterval > 0); }
+  G4bool IsRestartRequested() const { return mRestartFileName != ""; }
+
+  //! Read the checkpoint to resume from (at the initialization, before the actors open their files)
+  void OpenRestart();
+  G4bool IsRestartOpen() const { return mIsRestartOpen; }
+  //! Appended to the file names of the outputs that restart from zero
+  const G4String & GetResumeSuffix() const { return mResumeSuffix; }
+  G4int GetRestartRunID() const { return mRestartRunID; }
+  G4long GetRestartNumberOfEvents() const { return mRestartNumberOfEvents; }
+
+  //! Restores the actors of a resumed run (after the begin of run actions of the actors)
+  void BeginOfRunAction(const G4Run * run);
+  void EndOfEventAction(const G4Event * e);
+  G4bool IsActorRestorePending() const { return mActorRestorePending; }
+  //! True if the data of this actor are restored from the checkpoint
+  G4bool IsActorInRestart(const G4String & name) const { return mRestartedActors.count(name) != 0; }
+  void RestoreActors();
+  G4bool IsSourceRestorePending() const { return mSourceRestorePending; }
+  void RestoreSources();
+  //! Wait for the last checkpoint to be written
+  void EndOfAcquisition();
+
+protected:
+  GateCheckpointManager();
+  void Save(const G4Event * e);
+
+  static GateCheckpointManager * mInstance;
+  GateCheckpointManagerMessenger * pMessenger;
+
+  G4String mFileName;
+  G4String mRestartFileName;
+  G4int mEventInterval;
+  G4double mTimeInterval;
+  G4long mNumberOfEventsSinceLastCheckpoint;
+  std::chrono::steady_clock::time_point mLastCheckpointTime;
+  G4int mNumberOfCheckpoints;
+  GateCheckpointWriter mWriter;
+
+  GateCheckpointReader mReader;
+  G4int mRestartRunID;
+  G4long mRestartNumberOfEvents;
+  //! Events of the current run simulated before the restart (event IDs start at 0 in the resumed run)
+  G4long mRunEventOffset;
+  G4bool mIsRestartOpen;
+  G4String mResumeSuffix;
+  std::set<G4String> mRestartedActors;
+  G4bool mActorRestorePending;
+  G4bool mSourceRestorePending;
+};
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,41 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#ifndef GateCheckpointManagerMessenger_h
+#define GateCheckpointManagerMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class GateCheckpointManager;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+
+//-----------------------------------------------------------------------------
+class GateCheckpointManagerMessenger: public G4UImessenger
+{
+public:
+  GateCheckpointManagerMessenger(GateCheckpointManager * manager);
+  ~GateCheckpointManagerMessenger();
+
+  void SetNewValue(G4UIcommand*, G4String);
+
+private:
+  GateCheckpointManager * pManager;
+
+  G4UIdirectory *             pCheckpointDir;
+  G4UIcmdWithAString *        pFileNameCmd;
+  G4UIcmdWithAnInteger *      pEventIntervalCmd;
+  G4UIcmdWithADoubleAndUnit * pTimeIntervalCmd;
+  G4UIcmdWithAString *        pRestartCmd;
+};
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,143 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateCompressedPhaseSpaceWriter / GateCompressedPhaseSpaceReader
+
+  Block compressed phase space (.gphsp). Particles are grouped in blocks
+  stored column by column (better compression): an 8 bits particle type
+  (index in the PDG codes table of the block, the high bit flags the first
+  particle of a new event), position (mm), direction, kinetic energy (MeV)
+  and weight as floats, and optionally the time (ns) as double. Positions,
+  directions and energies are already floats in the other phase space
+  formats, so nothing is lost. Each block is compressed with zlib.
+
+  File: "GATEPHSP" + uint32 version, then blocks of
+  uint32 nbOfParticles, uint32 rawSize, uint32 storedSize + data
+  (stored raw when storedSize == rawSize). Native byte order.
+
+  The writer compresses and writes blocks in a background thread, the
+  reader decompresses the next block in the background while the current
+  one is used.
+*/
+
+#ifndef GATECOMPRESSEDPHASESPACEFILE_HH
+#define GATECOMPRESSEDPHASESPACEFILE_HH
+
+#include "globals.hh"
+#include "GateBlockWriter.hh"
+
+#include <cstdio>
+#include <future>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+struct GateCompressedPhaseSpaceRecord
+{
+  G4int PDGCode;
+  G4bool newEvent;
+  float x, y, z;
+  float dx, dy, dz;
+  float energy;
+  float weight;
+  double time;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+class GateCompressedPhaseSpaceBlock
+{
+public:
+  enum { kX, kY, kZ, kDX, kDY, kDZ, kEnergy, kWeight, kNumberOfColumns };
+  static const G4int kMaxNumberOfTypes = 127;
+  static const unsigned char kNewEventFlag = 0x80;
+
+  void Clear();
+  size_t GetNumberOfParticles() const { return mType.size(); }
+  // index of the PDG code in the table, -1 if the table is full
+  G4int FindOrAddType(G4int PDGCode);
+  void Push(const GateCompressedPhaseSpaceRecord & r, G4int typeIndex);
+  void Get(size_t i, GateCompressedPhaseSpaceRecord & r) const;
+
+  void Serialize(std::vector<char> & raw) const;
+  G4bool Unserialize(const std::vector<char> & raw);
+
+  G4bool mHasTime;
+  std::vector<G4int> mPDGCodes;
+  std::vector<unsigned char> mType;
+  std::vector<float> mColumns[kNumberOfColumns];
+  std::vector<double> mTime;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+class GateCompressedPhaseSpaceWriter
+{
+public:
+  GateCompressedPhaseSpaceWriter();
+  ~GateCompressedPhaseSpaceWriter();
+
+  // compressionLevel: zlib level, 0 (no compression) to 9
+  void Open(const G4String & filename, G4int compressionLevel, G4bool storeTime);
+  // Reopen a file written up to offset (see Flush) and go on writing after it
+  void Resume(const G4String & filename, long offset, G4int compressionLevel, G4bool storeTime);
+  void Fill(const GateCompressedPhaseSpaceRecord & r);
+  // Write the pending particles now, returns the size of the file (checkpoints)
+  long Flush();
+  void Close();
+  G4bool IsOpen() const { return mFile != 0; }
+
+  void SetNumberOfParticlesPerBlock(size_t n) { mNumberOfParticlesPerBlock = n; }
+
+protected:
+  void SubmitBlock();
+  void WriteBlock(std::vector<char> & raw); // background thread
+
+  FILE * mFile;
+  G4int mCompressionLevel;
+  size_t mNumberOfParticlesPerBlock;
+  GateCompressedPhaseSpaceBlock mBlock;
+  GateBlockWriter mWriter;
+};
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+class GateCompressedPhaseSpaceReader
+{
+public:
+  GateCompressedPhaseSpaceReader();
+  ~GateCompressedPhaseSpaceReader();
+
+  // Returns the number of particles in the file
+  G4long Open(const G4String & filename);
+  void Close();
+  // Restarts from the first particle
+  void Rewind();
+  // false at the end of the file
+  G4bool Next(GateCompressedPhaseSpaceRecord & r);
+
+protected:
+  G4bool ReadBlock(GateCompressedPhaseSpaceBlock & b); // background thread
+  void Prefetch();
+
+  FILE * mFile;
+  G4String mFilename;
+  long mFirstBlockPosition;
+  GateCompressedPhaseSpaceBlock mCurrentBlock;
+  size_t mCurrentIndex;
+  GateCompressedPhaseSpaceBlock mNextBlock;
+  std::future<G4bool> mNextBlockReady;
+  std::vector<char> mStored;
+  std::vector<char> mRaw;
+};
+//-----------------------------------------------------------------------------
+
+#endif
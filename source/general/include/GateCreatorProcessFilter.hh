@@ -30,6 +30,7 @@ class  GateCreatorProcessFilter :
     FCT_FOR_AUTO_CREATOR_FILTER(GateCreatorProcessFilter)
 
     virtual G4bool Accept(const G4Track*);
+    virtual G4bool IsTrackLevel() const { return true; }
 
     void AddCreatorProcess(const G4String& processName);
 
@@ -24,6 +24,8 @@ See LICENSE.md for further details
 #include "itkGDCMImageIO.h"
 #include "itkGDCMSeriesFileNames.h"
 #include "itkImageSeriesReader.h"
+#include "itkImageFileReader.h"
+#include "itkMetaDataObject.h"
 #include "itkImageFileWriter.h"
 //#include <itkDCMTKImageIO.h>
 
@@ -32,6 +34,7 @@ See LICENSE.md for further details
 #include "GateMiscFunctions.hh"
 
 #include <string>
+#include <thread>
 
 template<class PixelType> class GateImageT;
 
@@ -45,6 +48,8 @@ class GateDICOMImage
 
     void Read(const std::string);
     void ReadSeries(const std::string, const std::string);
+    // Series UID of a DICOM file (header only)
+    std::string ReadSeriesUID(const std::string);
     std::vector<long unsigned int> GetResolution();
     std::vector<double> GetSpacing();
     std::vector<double> GetOrigin();
@@ -63,6 +68,12 @@ class GateDICOMImage
     template<class PixelType>
     void SetPixels(std::vector<PixelType>& data);
 
+    // Decoded series are cached as <directory>/<seriesUID>.mhd ("" = no cache)
+    static void SetCacheDirectory(std::string d) { mCacheDirectory = d; }
+    static std::string GetCacheFileName(const std::string seriesUID);
+    // Number of threads decoding the slices (0 = number of cores)
+    static void SetNumberOfThreads(unsigned int n) { mNumberOfThreads = n; }
+
   private:
     typedef itk::Image<signed short,3>          ImageType;
     typedef itk::ImageSeriesReader< ImageType > ReaderType;
@@ -70,7 +81,19 @@ class GateDICOMImage
     typedef itk::GDCMSeriesFileNames            NamesGeneratorType;
     //typedef itk::DCMTKImageIO                   DCMTKIOType;
 
+    // Geometry of the series; the pixels are only buffered here for multi-frame files
     ImageType::Pointer image;
+    bool mPixelsInImage;
+    std::vector<std::string> mFileNames;
+
+    // Decode the file of slice z into 'slice' (size nx*ny). It runs in the
+    // decoding threads: it returns the error message ("" if none) instead of
+    // raising it
+    std::string ReadSlice(size_t z, std::vector<signed short> & slice);
+    unsigned int GetNumberOfThreads(size_t nbSlices);
+
+    static std::string mCacheDirectory;
+    static unsigned int mNumberOfThreads;
 
     ImageType::Pointer dicomIO;
 
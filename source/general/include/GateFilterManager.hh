@@ -39,14 +39,29 @@ public:
   virtual G4bool Accept(const G4Step*) const;
   virtual G4bool Accept(const G4Track*) const;
 
-  void AddFilter(GateVFilter* filter){theFilters.push_back(filter);}
+  void AddFilter(GateVFilter* filter){theFilters.push_back(filter); mIsCompiled = false;}
   G4int GetNumberOfFilters(){return theFilters.size();}
   void show();
 
+  // Split the filters into track-level and step-level lists (BeginOfRun)
+  void Compile();
+  // Evaluate and cache the track-level verdict (PreUserTrackingAction)
+  void BeginOfTrack(const G4Track*);
+
 protected:
+  G4bool AcceptTrackLevel(const G4Track*) const;
+
   G4String mFilterName;
   std::vector<GateVFilter*> theFilters;
 
+  bool mIsCompiled;
+  std::vector<GateVFilter*> theTrackFilters;
+  std::vector<GateVFilter*> theStepFilters;
+
+  mutable const G4Track * mCachedTrack;
+  mutable G4int mCachedTrackID;
+  mutable G4bool mCachedTrackVerdict;
+
 private:
   
 };
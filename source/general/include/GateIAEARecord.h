@@ -25,6 +25,8 @@
                             // 4 neutrons
                             // 5 protons
 #define MAX_NUM_SOURCES 30
+// type + (energy, x, y, z, u, v, weight, extra floats) + extra longs
+#define IAEA_MAX_RECORD_LENGTH (1 + (NUM_EXTRA_FLOAT+7)*4 + NUM_EXTRA_LONG*4)
 
 #define OK     0
 #define FAIL  -1
@@ -60,6 +62,9 @@ struct iaea_record_type
 public:
       short read_particle();
       short write_particle();
+      // Serializes the record into buffer (IAEA_MAX_RECORD_LENGTH bytes
+      // at most), as write_particle would write it. Returns its length.
+      int pack_particle(char *buffer);
       short initialize();
 };
 
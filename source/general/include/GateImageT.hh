@@ -24,6 +24,8 @@
 // std
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include "G4Timer.hh"
 
 // gate
 #include "GateVImage.hh"
@@ -56,6 +58,8 @@ public:
 
   /// Allocates the data
   virtual void Allocate();
+  /// Releases the data (the image size is kept)
+  inline void Deallocate() { std::vector<PixelType>().swap(data); }
 
   // Access to the image values
   /// Returns the value of the image at voxel of index provided
@@ -95,6 +99,10 @@ public:
 
   void MergeDataByAddition(G4String filename);
 
+  /// Merges voxels by blocks so that the voxel size is (the nearest integer
+  /// multiple of the current one to) targetVoxelSize. mode: mean, max or label
+  void Downsample(const G4ThreeVector & targetVoxelSize, const G4String & mode);
+
   // iterators
   iterator begin() { return data.begin(); }
   iterator end()   { return data.end(); }
@@ -0,0 +1,79 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#ifndef GATEINTERFILEFRAMECACHE_HH
+#define GATEINTERFILEFRAMECACHE_HH 1
+
+// std
+#include <algorithm>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// g4
+#include "globals.hh"
+
+// gate
+#include "GateInterfileHeader.hh"
+
+/*! \class  GateInterfileFrameCache
+    \brief  Shared store of the raw frames read by the time-dependent (RTPhantom) interfile readers
+
+    - Frames are keyed by data file name. Up to SetMaxNumberOfFrames() decoded frames are kept
+      (least recently used first out) so that a cyclic motion (e.g. respiratory or cardiac frames)
+      does not read the same files from disk again at every cycle.
+    - Prefetch() starts reading a frame in a background thread, using a copy of the header of the
+      reader. The next GetFrame() on the same file waits for this read instead of starting a new one.
+    - Frames are shared (read-only) between the geometry and source readers, so a file used both as
+      attenuation and activity map is read once.
+*/
+//-----------------------------------------------------------------------------
+class GateInterfileFrameCache
+{
+public:
+
+  typedef GateInterfileHeader::DefaultPixelType PixelType;
+  typedef std::vector<PixelType> FrameType;
+  typedef std::shared_ptr<const FrameType> FramePointer;
+
+  static GateInterfileFrameCache * GetInstance();
+
+  //! Return the frame stored in dataFileName, read with the given header information
+  FramePointer GetFrame(const GateInterfileHeader & header, G4String dataFileName);
+
+  //! Start reading dataFileName in the background (no effect if already cached or pending)
+  void Prefetch(const GateInterfileHeader & header, G4String dataFileName);
+
+  void SetMaxNumberOfFrames(G4int n);
+  G4int GetMaxNumberOfFrames() const { return mMaxNumberOfFrames; }
+  void SetPrefetchEnabled(G4bool b) { mPrefetchEnabled = b; }
+  G4bool IsPrefetchEnabled() const { return mPrefetchEnabled; }
+
+  //! Drop all cached frames (pending reads are completed first)
+  void Clear();
+
+protected:
+  GateInterfileFrameCache();
+  static FramePointer ReadFrame(GateInterfileHeader header, G4String dataFileName);
+  void Store(const G4String & dataFileName, FramePointer frame);
+
+  static GateInterfileFrameCache * mInstance;
+  std::mutex mMutex;
+  std::map<G4String, FramePointer> mFrames;
+  std::list<G4String> mFramesOrder;
+  std::map<G4String, std::shared_future<FramePointer> > mPendingFrames;
+  G4int mMaxNumberOfFrames;
+  G4bool mPrefetchEnabled;
+};
+//-----------------------------------------------------------------------------
+
+#endif
@@ -78,6 +78,7 @@ See LICENSE.md for further details
 
 #include <string>
 #include <map>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include "G4ExceptionHandler.hh"
@@ -123,14 +124,14 @@ See LICENSE.md for further details
 //-----------------------------------------------------------
 
 //-----------------------------------------------------------
-#define GateOnMessageLevel(key,value)			\
-  int __GateOnMessageLevelVariable =			\
-    GateMessageManager::GetMessageLevel(key);		\
-  if ( __GateOnMessageLevelVariable<0)			\
-    {							\
-      GateWarning("message type '"<<key<<"' unknown");	\
-    }							\
-  else if (value<= __GateOnMessageLevelVariable)
+// The key of each call site is interned once (function-local static)
+// into an integer category, so that a disabled message only costs the
+// load of the category level and a comparison. The key must therefore
+// be the same at each execution of a given call site (a literal).
+#define GateOnMessageLevel(key,value)					\
+  static const int __GateOnMessageCategoryVariable =			\
+    GateMessageManager::GetMessageCategory(key);			\
+  if (value <= GateMessageManager::GetCategoryLevel(__GateOnMessageCategoryVariable))
 
 //-----------------------------------------------------------
 #ifdef GATE_PREPEND_MESSAGE_WITH_CODE
@@ -358,7 +359,9 @@ See LICENSE.md for further details
 #define GateWarning(MESSAGE)						\
   do									\
     {									\
-      int lev = GateMessageManager::GetMessageLevel("Warning");		\
+      static const int __GateWarningCategory =				\
+        GateMessageManager::GetMessageCategory("Warning");		\
+      int lev = GateMessageManager::GetCategoryLevel(__GateWarningCategory); \
       if (lev >0)							\
 	{								\
 	  std::cout << " <!> *** WARNING *** <!>  " << MESSAGE << Gateendl; \
@@ -447,6 +450,14 @@ public:
 				  unsigned char default_level = 9);
   static void SetMessageLevel(std::string key, unsigned char level);
   static int GetMessageLevel(std::string key);
+
+  // Integer categories used by the message macros. Unknown keys are
+  // registered on the fly, beyond kMaxMessageCategories they share the
+  // category 0 which follows the "All" level.
+  static const int kMaxMessageCategories = 256;
+  static int GetMessageCategory(const std::string & key);
+  static int GetCategoryLevel(int category)
+  { return sCategoryLevel[category].load(std::memory_order_relaxed); }
   static std::string& GetTab() { static std::string s; return s; }
   static std::string GetSpace(int n);
   static void IncTab() { GetTab() += std::string("   "); }
@@ -463,9 +474,16 @@ public:
   void EnableG4Messages(bool b);
 
 protected:
+  int InternCategory(const std::string & key);
+  void UpdateCategoryLevels();
+
   GateMessageMessenger *pMessenger;
   std::map<std::string,int> mMessageLevel;
   std::map<std::string,std::string> mMessageHelp;
+  std::map<std::string,int> mMessageCategory;
+  int mNumberOfCategories;
+  // Effective level (max of the type level and of the "All" level)
+  static std::atomic<int> sCategoryLevel[kMaxMessageCategories];
   unsigned int mMaxMessageLength;
   int mAllLevel;
   int mEnableG4Message;
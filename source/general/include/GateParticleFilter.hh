@@ -26,6 +26,9 @@ See LICENSE.md for further details
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
 
+#include <set>
+#include <unordered_map>
+
 class  GateParticleFilter :
   public GateVFilter
 {
@@ -36,6 +39,8 @@ public:
   FCT_FOR_AUTO_CREATOR_FILTER(GateParticleFilter)
 
   virtual G4bool Accept(const G4Track *);
+  virtual G4bool IsTrackLevel() const { return true; }
+  virtual void Compile();
 
   void Add(const G4String &particleName);
   void AddZ(const G4int &particleZ);
@@ -48,6 +53,9 @@ public:
   virtual void show();
 
 private:
+  G4bool AcceptDefinition(const G4ParticleDefinition * def);
+  G4bool EvaluateDefinition(const G4ParticleDefinition * def) const;
+
   std::vector<G4String> thePdef;
   std::vector<G4int> thePdefZ;
   std::vector<G4int> thePdefA;
@@ -57,6 +65,18 @@ private:
   GateParticleFilterMessenger *pPartMessenger;
 
   int nFilteredParticles;
+
+  // Compiled form of the name/Z/A/PDG lists, and verdict per definition
+  bool mIsCompiled;
+  std::set<const G4ParticleDefinition*> mDefinitions;
+  std::vector<G4String> mUnresolvedNames;
+  bool mAcceptGenericIon;
+  std::vector<bool> mZMask;
+  std::vector<bool> mAMask;
+  std::set<G4int> mPDGs;
+  std::unordered_map<const G4ParticleDefinition*, G4bool> mDefinitionVerdicts;
+  const G4ParticleDefinition * mLastDefinition;
+  G4bool mLastVerdict;
 };
 
 MAKE_AUTO_CREATOR_FILTER(particleFilter, GateParticleFilter)
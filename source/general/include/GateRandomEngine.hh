@@ -35,6 +35,11 @@ public:
   void resetEngineFrom(const G4String& file); //TC
   void ShowStatus();
   void Initialize();
+  //! Select an independent stream (e.g. one per forked worker), derived from the seed
+  inline void SetStreamIndex(G4int i) {theStreamIndex=i;}
+  //! Full status (engine and cached distribution values), used by the checkpoints
+  std::string GetEngineStatus();
+  void SetEngineStatus(const std::string& status);
 
 private:
   // Private constructor because the class is a singleton
@@ -45,6 +50,7 @@ private:
   GateRandomEngineMessenger* theMessenger;
   G4String theSeed;
   G4String theSeedFile; //TC
+  G4int theStreamIndex;
 };
 
 #endif
@@ -228,6 +228,7 @@ class GateRootHitBuffer
     Int_t    sourceID;	      	      	      	//!< Source ID
     Int_t    eventID; 	      	      	      	//!< Event ID
     Int_t    runID;   	      	      	      	//!< Run ID
+    Float_t  weight;  	      	      	      	//!< Statistical weight of the track
     Float_t  axialPos;	      	      	      	//!< Scanner axial position (in millimeters)
     Float_t  rotationAngle;           	      	//!< Rotation angle (in degrees)
     Char_t   processName[40]; 	      	      	//!< Name of the process that generated the hit
@@ -42,6 +42,15 @@ public:
  
   virtual void show();
 
+  // Track-level filters only look at quantities that do not change along a
+  // track (particle definition, IDs, parents, creator process). The
+  // GateFilterManager evaluates them once per track and caches the verdict.
+  virtual G4bool IsTrackLevel() const { return false; }
+
+  // Called at BeginOfRun, once the filter parameters are known, to build
+  // whatever lookup structures the filter needs during tracking.
+  virtual void Compile() {}
+
   void setInvert(){IsInverted = true;}
  
 
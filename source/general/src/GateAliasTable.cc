@@ -0,0 +1,83 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateAliasTable.hh"
+#include "GateMessageManager.hh"
+#include "Randomize.hh"
+
+//-----------------------------------------------------------------------------
+void GateAliasTable::Build(const std::vector<G4double> & weights)
+{
+  Clear();
+  const size_t n = weights.size();
+  if (n == 0) return;
+
+  for (size_t i = 0; i < n; i++)
+    if (weights[i] > 0.) mTotalWeight += weights[i];
+  if (mTotalWeight <= 0.) {
+    GateError("GateAliasTable: the sum of the weights must be positive");
+  }
+
+  // Vose's method: scaled probabilities, split in small (<1) and large (>=1)
+  mProbability.resize(n);
+  mAlias.resize(n);
+  std::vector<size_t> small, large;
+  small.reserve(n);
+  large.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    mProbability[i] = (weights[i] > 0. ? weights[i] : 0.) * n / mTotalWeight;
+    mAlias[i] = i;
+    if (mProbability[i] < 1.) small.push_back(i);
+    else large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    const size_t s = small.back();
+    small.pop_back();
+    const size_t l = large.back();
+    mAlias[s] = l;
+    mProbability[l] = (mProbability[l] + mProbability[s]) - 1.;
+    if (mProbability[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Remaining bins are full (up to rounding errors)
+  for (size_t i = 0; i < large.size(); i++) mProbability[large[i]] = 1.;
+  for (size_t i = 0; i < small.size(); i++) mProbability[small[i]] = 1.;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateAliasTable::Clear()
+{
+  mProbability.clear();
+  mAlias.clear();
+  mTotalWeight = 0.;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+size_t GateAliasTable::Sample() const
+{
+  return Sample(G4UniformRand());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateAliasTable::Sample(size_t n, std::vector<size_t> & bins) const
+{
+  bins.resize(n);
+  std::vector<G4double> u(n);
+  G4Random::getTheEngine()->flatArray(n, u.data());
+  for (size_t i = 0; i < n; i++) bins[i] = Sample(u[i]);
+}
+//-----------------------------------------------------------------------------
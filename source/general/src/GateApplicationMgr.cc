@@ -21,7 +21,16 @@
 #include "GateVSource.hh"
 #include "GateSourceMgr.hh"
 #include "GateOutputMgr.hh"
+#include "GateActorManager.hh"
+#include "GateVActor.hh"
+#include "GateCheckpointManager.hh"
 #include <algorithm> /* min and max */
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
 
 GateApplicationMgr* GateApplicationMgr::instance = 0;
 //------------------------------------------------------------------------------------------
@@ -50,6 +59,10 @@ GateApplicationMgr::GateApplicationMgr():
 
   m_clusterStart = -1.;
   m_clusterStop = -1.;
+
+  mNumberOfForkedProcesses = 1;
+  mForkedProcessIndex = -1;
+  mForkedParentId = 0;
 }
 //------------------------------------------------------------------------------------------
 
@@ -329,6 +342,10 @@ void GateApplicationMgr::StartDAQComplete(G4ThreeVector param)
 //------------------------------------------------------------------------------------------
 void GateApplicationMgr::StartDAQ()
 {
+  if (mForkedProcessIndex >= 0) {
+    StartDAQForked();
+    return;
+  }
 
   // With this method we check for all output module enabled but with no
   // filename given. In this case we disable the output module and send a warning.
@@ -360,10 +377,12 @@ void GateApplicationMgr::StartDAQ()
   m_clusterStart = mTimeSlices.front();
   m_clusterStop = mTimeSlices.back();
 
+  G4int slice=0;
+  G4long nbOfEventsDone = ResumeFromCheckpoint(slice);
+
   if (mOutputMode)
     GateOutputMgr::GetInstance()->RecordBeginOfAcquisition();
 
-  G4int slice=0;
   m_time = mTimeSlices.front();
   while(m_time < mTimeSlices.back())
     {
@@ -382,7 +401,7 @@ void GateApplicationMgr::StartDAQ()
 
       if (mReadNumberOfPrimariesInAFileIsUsed) {
         GateRunManager::GetRunManager()->SetRunIDCounter(slice); // Must explicitly keep the RunID in sync with the slice #  
-        GateRunManager::GetRunManager()->BeamOn(mNumberOfPrimariesPerRun[slice]);
+        GateRunManager::GetRunManager()->BeamOn(mNumberOfPrimariesPerRun[slice] - nbOfEventsDone);
         m_time = mTimeSlices[slice+1];
       }
       // calculate the time steps for total primaries mode
@@ -400,7 +419,7 @@ void GateApplicationMgr::StartDAQ()
                 - int(mTimeSlices[slice]/mTimeStepInTotalAmountOfPrimariesMode);
             }
           GateRunManager::GetRunManager()->SetRunIDCounter(slice);                    // Must explicitly keep the RunID in sync with the slice #      
-          GateRunManager::GetRunManager()->BeamOn(mRequestedAmountOfPrimariesPerRun); // otherwise RunID is automatically incremented
+          GateRunManager::GetRunManager()->BeamOn(mRequestedAmountOfPrimariesPerRun - nbOfEventsDone); // otherwise RunID is automatically incremented
           m_time = mTimeSlices[slice+1];
         }
       else
@@ -414,7 +433,9 @@ void GateApplicationMgr::StartDAQ()
         }
 
       slice++;
+      nbOfEventsDone = 0;
     }
+  GateCheckpointManager::GetInstance()->EndOfAcquisition();
 
   if (mOutputMode) GateOutputMgr::GetInstance()->RecordEndOfAcquisition();
 
@@ -428,6 +449,213 @@ void GateApplicationMgr::StartDAQ()
 //------------------------------------------------------------------------------------------
 
 
+//------------------------------------------------------------------------------------------
+// With /gate/checkpoint/restartFrom, the acquisition loop starts at the run of the
+// checkpoint and its first BeamOn skips the events already simulated (the state is
+// restored at the beginning of this run, see GateCheckpointManager). Called before the
+// output modules open their files: they restart from zero under the resume suffix.
+G4long GateApplicationMgr::ResumeFromCheckpoint(G4int & slice)
+{
+  GateCheckpointManager* checkpoint = GateCheckpointManager::GetInstance();
+  if (!checkpoint->IsRestartRequested()) return 0;
+  if (!checkpoint->IsRestartOpen())
+    GateError("Checkpoint: /gate/checkpoint/restartFrom must be given before /gate/run/initialize");
+  G4int run = checkpoint->GetRestartRunID();
+  if (run < slice || run >= (G4int)mTimeSlices.size()-1)
+    GateError("Checkpoint: run " << run << " is not part of this acquisition (different time slices ?)");
+  slice = run;
+  GateOutputMgr::GetInstance()->SetFileNameSuffix(GateOutputMgr::GetInstance()->GetFileNameSuffix()
+                                                   + checkpoint->GetResumeSuffix());
+  GateMessage("Acquisition", 0, "Output modules restart from zero with the suffix " << checkpoint->GetResumeSuffix()
+              << ". The events of run " << run << " from ID " << checkpoint->GetRestartNumberOfEvents()
+              << " on, and of the later runs, are simulated again: drop them from the outputs of the interrupted job before merging.\n");
+  return checkpoint->GetRestartNumberOfEvents();
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+void GateApplicationMgr::SetNumberOfForkedProcesses(G4int n)
+{
+  if (mForkedProcessIndex >= 0)
+    GateError("The number of forked processes must be set before /gate/run/initialize");
+  mNumberOfForkedProcesses = n;
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+G4String GateApplicationMgr::GetForkedFileNameSuffix(G4int index)
+{
+  // Same numbering as the job splitter (gjs)
+  std::ostringstream oss;
+  oss << index+1;
+  return oss.str();
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+// Called by GateRunManager::InitializeAll once geometry, materials and physics tables
+// are built, before the actors allocate their own data. Each process (the parent is
+// the process 0) then gets its own random stream and actor output file names.
+void GateApplicationMgr::ForkWorkers()
+{
+  if (mNumberOfForkedProcesses < 2 || mForkedProcessIndex >= 0) return;
+
+  GateMessage("Core", 0, "Forking " << mNumberOfForkedProcesses-1 << " worker processes\n");
+  G4cout << std::flush;
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+
+  mForkedProcessIndex = 0;
+  mForkedParentId = getpid();
+  for (G4int i=1; i<mNumberOfForkedProcesses; i++) {
+    pid_t pid = fork();
+    if (pid < 0) GateError("Cannot fork the worker process " << i << ": " << strerror(errno));
+    if (pid == 0) {
+      mForkedProcessIds.clear();
+      mForkedProcessIndex = i;
+      break;
+    }
+    mForkedProcessIds.push_back(pid);
+  }
+
+  GateRandomEngine::GetInstance()->SetStreamIndex(mForkedProcessIndex);
+
+  G4String suffix = GetForkedFileNameSuffix(mForkedProcessIndex);
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i=0; i<actors.size(); i++) {
+    G4String f = actors[i]->GetSaveFilename();
+    if (f == "FilenameNotGivenForThisActor") continue;
+    mForkedActorFileNames[actors[i]->GetObjectName()] = f;
+    if (f.find_last_of(".") == std::string::npos) actors[i]->SetSaveFilename(f + suffix);
+    else actors[i]->SetSaveFilename(removeExtension(f) + suffix + "." + getExtension(f));
+  }
+  GateCheckpointManager::GetInstance()->AppendSuffixToFileNames(suffix);
+  GateMessage("Core", 1, "Process " << mForkedProcessIndex << " (pid " << getpid()
+              << ") writes its outputs with suffix '" << suffix << "'\n");
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+// Each process simulates an equal part of the acquisition time, as a cluster job would do
+// with startDAQCluster. The parent process then waits for the workers and merges outputs.
+void GateApplicationMgr::StartDAQForked()
+{
+  InitializeTimeSlices();
+  G4double duration = (mTimeSlices.back() - mTimeSlices.front())/mNumberOfForkedProcesses;
+  G4double start = mTimeSlices.front() + mForkedProcessIndex*duration;
+  G4double stop = (mForkedProcessIndex == mNumberOfForkedProcesses-1) ? mTimeSlices.back() : start + duration;
+
+  GateOutputMgr::GetInstance()->SetFileNameSuffix(GetForkedFileNameSuffix(mForkedProcessIndex));
+  StartDAQCluster(G4ThreeVector(start, stop, 0));
+  GateActorManager::GetInstance()->RecordEndOfAcquisition();
+
+  if (mForkedProcessIndex > 0) {
+    WriteForkedActorData();
+    // A worker must not go on with the rest of the macro
+    G4cout << std::flush;
+    std::cout.flush();
+    fflush(NULL);
+    std::exit(EXIT_SUCCESS);
+  }
+
+  G4int nbOfFailures = 0;
+  for (size_t i=0; i<mForkedProcessIds.size(); i++) {
+    int status = 0;
+    if (waitpid(mForkedProcessIds[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      GateWarning("Forked process " << i+1 << " did not terminate normally");
+      nbOfFailures++;
+    }
+  }
+  mForkedProcessIds.clear();
+  if (nbOfFailures > 0) GateError(nbOfFailures << " forked process(es) failed, outputs are not merged.");
+
+  MergeForkedActorData();
+  std::vector<G4String> suffixes;
+  for (G4int i=0; i<mNumberOfForkedProcesses; i++) suffixes.push_back(GetForkedFileNameSuffix(i));
+  if (GateCheckpointManager::GetInstance()->IsRestartRequested())
+    GateMessage("Acquisition", 0, "Resumed simulation: the outputs of the forked processes are not merged\n");
+  else GateOutputMgr::GetInstance()->MergeFileNamesWithSuffixes(suffixes);
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+G4String GateApplicationMgr::GetForkedActorDataFileName(G4int index)
+{
+  const char * dir = getenv("TMPDIR");
+  std::ostringstream oss;
+  oss << (dir ? dir : "/tmp") << "/gate-fork-" << mForkedParentId << "-" << index;
+  return oss.str();
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+// The accumulated data of the actors (sums, not the normalised outputs) are written as a
+// checkpoint, read back by the parent process.
+void GateApplicationMgr::WriteForkedActorData()
+{
+  GateCheckpointWriter writer;
+  writer.SetFileName(GetForkedActorDataFileName(mForkedProcessIndex));
+  writer.Begin();
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i=0; i<actors.size(); i++) {
+    writer.SetPrefix("actors/" + actors[i]->GetObjectName() + "/");
+    if (actors[i]->SaveCheckpoint(writer)) writer.Write("checkpointed", G4int(1));
+  }
+  writer.Commit();
+  writer.Wait();
+}
+//------------------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------------------
+// The actors that support it add the data of the workers to their own ones and are saved
+// again under the file names given by the user. The others keep one output per process.
+void GateApplicationMgr::MergeForkedActorData()
+{
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  std::vector<G4int> nbOfMerges(actors.size(), 0);
+  for (G4int p=1; p<mNumberOfForkedProcesses; p++) {
+    G4String name = GetForkedActorDataFileName(p);
+    GateCheckpointReader reader;
+    if (!reader.Open(name)) GateError("Cannot read the actor data of the forked process " << p << " (" << name << ")");
+    for (size_t i=0; i<actors.size(); i++) {
+      reader.SetPrefix("actors/" + actors[i]->GetObjectName() + "/");
+      if (reader.Has("checkpointed") && actors[i]->MergeCheckpoint(reader)) nbOfMerges[i]++;
+    }
+    reader.Close();
+    for (G4int slot=0; slot<2; slot++) {
+      std::ostringstream oss;
+      oss << name << "." << slot;
+      std::remove((oss.str() + ".chk").c_str());
+      std::remove((oss.str() + ".dat").c_str());
+    }
+  }
+
+  for (size_t i=0; i<actors.size(); i++) {
+    std::map<G4String, G4String>::iterator f = mForkedActorFileNames.find(actors[i]->GetObjectName());
+    if (f == mForkedActorFileNames.end()) continue;
+    if (nbOfMerges[i] == mNumberOfForkedProcesses-1) {
+      actors[i]->SetSaveFilename(f->second);
+      actors[i]->SaveData();
+      GateMessage("Acquisition", 0, "Actor " << actors[i]->GetObjectName() << ": outputs of the "
+                  << mNumberOfForkedProcesses << " processes summed into " << f->second << Gateendl);
+    }
+    else
+      GateMessage("Acquisition", 0, "Actor " << actors[i]->GetObjectName() << " is not merged, its outputs are written by each process with suffixes "
+                  << GetForkedFileNameSuffix(0) << " ... " << GetForkedFileNameSuffix(mNumberOfForkedProcesses-1)
+                  << " (merge them as gjs outputs)\n");
+  }
+}
+//------------------------------------------------------------------------------------------
+
+
 //------------------------------------------------------------------------------------------
 void GateApplicationMgr::StartDAQCluster(G4ThreeVector param)
 {
@@ -467,11 +695,12 @@ void GateApplicationMgr::StartDAQCluster(G4ThreeVector param)
   if (nVerboseLevel>0)
     G4cout << "Cluster: virtual time start " << m_clusterStart/s <<", virtual time stop "<<m_clusterStop/s<< Gateendl;
 
-  if (mOutputMode) GateOutputMgr::GetInstance()->RecordBeginOfAcquisition();
-
   G4int slice=0;
   while(m_clusterStart > mTimeSlices[slice+1])
     slice++;
+  G4long nbOfEventsDone = ResumeFromCheckpoint(slice);
+
+  if (mOutputMode) GateOutputMgr::GetInstance()->RecordBeginOfAcquisition();
 
   while(m_time < m_clusterStop)
     {
@@ -493,7 +722,7 @@ void GateApplicationMgr::StartDAQCluster(G4ThreeVector param)
     // This if is Not tested in cluster mode
      if (mReadNumberOfPrimariesInAFileIsUsed) {
         GateRunManager::GetRunManager()->SetRunIDCounter(slice); // Must explicitly keep the RunID in sync with the slice #  
-        GateRunManager::GetRunManager()->BeamOn(mNumberOfPrimariesPerRun[slice]);
+        GateRunManager::GetRunManager()->BeamOn(mNumberOfPrimariesPerRun[slice] - nbOfEventsDone);
         m_time = mTimeSlices[slice+1];
       }
 
@@ -512,7 +741,7 @@ void GateApplicationMgr::StartDAQCluster(G4ThreeVector param)
                 - int(mTimeSlices[slice]/mTimeStepInTotalAmountOfPrimariesMode);
             }
           GateRunManager::GetRunManager()->SetRunIDCounter(slice);                    // Must explicitly keep the RunID in sync with the slice #
-          GateRunManager::GetRunManager()->BeamOn(mRequestedAmountOfPrimariesPerRun); // otherwise RunID is automatically incremented
+          GateRunManager::GetRunManager()->BeamOn(mRequestedAmountOfPrimariesPerRun - nbOfEventsDone); // otherwise RunID is automatically incremented
           m_time = mTimeSlices[slice+1];
         }
       else
@@ -525,8 +754,9 @@ void GateApplicationMgr::StartDAQCluster(G4ThreeVector param)
             }
         }
       slice++;
-
+      nbOfEventsDone = 0;
     }
+  GateCheckpointManager::GetInstance()->EndOfAcquisition();
 
   if (mOutputMode) GateOutputMgr::GetInstance()->RecordEndOfAcquisition();
 
@@ -76,6 +76,12 @@ GateApplicationMgrMessenger::GateApplicationMgrMessenger()
   StartDAQClusterCmd->SetUnitCategory("Time");
   StartDAQClusterCmd->SetDefaultUnit("s");
 
+  NumberOfForkedProcessesCmd = new G4UIcmdWithAnInteger("/gate/application/setNumberOfForkedProcesses",this);
+  NumberOfForkedProcessesCmd->SetGuidance("Initialize once then fork N processes sharing geometry, materials and physics tables (must be set before /gate/run/initialize).");
+  NumberOfForkedProcessesCmd->SetGuidance("Each process simulates 1/N of the acquisition time with its own random stream and output files (suffixed 1..N); ROOT outputs are merged at the end.");
+  NumberOfForkedProcessesCmd->SetParameterName("N",false);
+  NumberOfForkedProcessesCmd->SetRange("N>=1");
+
   StopDAQCmd = new G4UIcmdWithoutParameter("/gate/application/stopDAQ",this);
   StopDAQCmd->SetGuidance("Stop the DAQ");
   //  StopDAQCmd->AvailableForStates(Idle);
@@ -142,6 +148,7 @@ GateApplicationMgrMessenger::~GateApplicationMgrMessenger()
   delete StartCmd;
   delete StartDAQCompleteCmd;
   delete StartDAQClusterCmd;
+  delete NumberOfForkedProcessesCmd;
   delete StopDAQCmd;
   delete PauseDAQCmd;
   delete VerboseCmd;
@@ -195,6 +202,9 @@ void GateApplicationMgrMessenger::SetNewValue(G4UIcommand* command, G4String new
   else  if( command == StartDAQClusterCmd ) {
     appMgr->StartDAQCluster(StartDAQClusterCmd->GetNew3VectorValue(newValue));
   }
+  else  if( command == NumberOfForkedProcessesCmd ) {
+    appMgr->SetNumberOfForkedProcesses(NumberOfForkedProcessesCmd->GetNewIntValue(newValue));
+  }
   else  if( command == StopDAQCmd ) {
     appMgr->StopDAQ();
   }
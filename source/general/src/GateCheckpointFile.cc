@@ -0,0 +1,449 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateCheckpointFile.hh"
+#include "GateMessageManager.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+  const char kMagic[8] = { 'G', 'A', 'T', 'E', 'C', 'K', 'P', 'T' };
+  const uint64_t kVersion = 1;
+  const uint64_t kValueEntry = 0;
+  const uint64_t kArrayEntry = 1;
+
+  //-----------------------------------------------------------------------------
+  // Fast non-cryptographic hash (8 bytes per step), only used to detect changes
+  uint64_t HashBytes(const char * p, size_t n, uint64_t seed)
+  {
+    uint64_t h = (seed + n) * 0x9E3779B97F4A7C15ULL;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      uint64_t w;
+      memcpy(&w, p + i, 8);
+      h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+      h ^= h >> 31;
+    }
+    if (i < n) {
+      uint64_t w = 0;
+      memcpy(&w, p + i, n - i);
+      h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+    }
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+  }
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  std::string SlotFileName(const G4String & prefix, G4int slot, const char * extension)
+  {
+    std::ostringstream s;
+    s << prefix << "." << slot << extension;
+    return s.str();
+  }
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  void AppendU64(std::string & s, uint64_t v)
+  {
+    s.append((const char *)&v, sizeof(v));
+  }
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  bool TakeU64(const std::string & s, size_t & pos, uint64_t & v)
+  {
+    if (pos + sizeof(v) > s.size()) return false;
+    memcpy(&v, s.data() + pos, sizeof(v));
+    pos += sizeof(v);
+    return true;
+  }
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  bool TakeBytes(const std::string & s, size_t & pos, uint64_t n, std::string & v)
+  {
+    if (n > s.size() - pos) return false;
+    v.assign(s, pos, n);
+    pos += n;
+    return true;
+  }
+  //-----------------------------------------------------------------------------
+
+  //-----------------------------------------------------------------------------
+  bool WriteAll(int fd, const char * p, size_t n, off_t offset)
+  {
+    while (n > 0) {
+      ssize_t w = pwrite(fd, p, n, offset);
+      if (w < 0) {
+        if (errno == EINTR) continue;
+        return false;
+      }
+      p += w;
+      n -= w;
+      offset += w;
+    }
+    return true;
+  }
+  //-----------------------------------------------------------------------------
+
+}
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointWriter::GateCheckpointWriter()
+{
+  mFileName = "";
+  mPrefix = "";
+  mBlockSize = 1 << 20;
+  mSequence = 0;
+  mPendingSlot = 0;
+  mDataSize = 0;
+  mNumberOfEntries = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointWriter::~GateCheckpointWriter()
+{
+  Wait();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointWriter::Begin()
+{
+  Wait();
+  if (mFileName == "") GateError("Checkpoint: no file name given.");
+  G4int slot = mSequence % 2;
+  mJob.reset(new Job);
+  mJob->dataFileName = SlotFileName(mFileName, slot, ".dat");
+  mJob->metaFileName = SlotFileName(mFileName, slot, ".chk");
+  mMeta.clear();
+  mNumberOfEntries = 0;
+  mPrefix = "";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointWriter::WriteBytes(const G4String & key, const void * data, size_t size)
+{
+  std::string k = mPrefix + key;
+  AppendU64(mMeta, k.size());
+  mMeta += k;
+  AppendU64(mMeta, kValueEntry);
+  AppendU64(mMeta, size);
+  mMeta.append((const char *)data, size);
+  mNumberOfEntries++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointWriter::WriteArrayBytes(const G4String & key, const void * data, size_t size)
+{
+  std::string k = mPrefix + key;
+  std::map<std::string, size_t>::iterator it = mArrayIndex.find(k);
+  if (it == mArrayIndex.end() || mArrays[it->second].size != size) {
+    // New array (or its size changed): store it after the others
+    Array a;
+    a.key = k;
+    a.size = size;
+    a.offset = mDataSize;
+    mDataSize += size;
+    if (it == mArrayIndex.end()) {
+      mArrayIndex[k] = mArrays.size();
+      mArrays.push_back(a);
+    }
+    else mArrays[it->second] = a;
+  }
+  Array & a = mArrays[mArrayIndex[k]];
+
+  // Only the blocks that changed since this slot was written are copied
+  const char * p = (const char *)data;
+  size_t nbOfBlocks = (size + mBlockSize - 1) / mBlockSize;
+  std::vector<uint64_t> & hashes = a.hashes[mSequence % 2];
+  G4bool known = (hashes.size() == nbOfBlocks);
+  if (!known) hashes.assign(nbOfBlocks, 0);
+  for (size_t b = 0; b < nbOfBlocks; b++) {
+    size_t begin = b * mBlockSize;
+    size_t n = std::min(mBlockSize, size - begin);
+    uint64_t h = HashBytes(p + begin, n, b);
+    if (known && h == hashes[b]) continue;
+    Block block;
+    block.offset = a.offset + begin;
+    block.bytes.assign(p + begin, n);
+    mJob->blocks.push_back(block);
+    hashes[b] = h;
+  }
+
+  AppendU64(mMeta, k.size());
+  mMeta += k;
+  AppendU64(mMeta, kArrayEntry);
+  AppendU64(mMeta, size);
+  AppendU64(mMeta, a.offset);
+  AppendU64(mMeta, HashBytes((const char *)hashes.data(), nbOfBlocks * sizeof(uint64_t), size));
+  mNumberOfEntries++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointWriter::Commit()
+{
+  std::string & meta = mJob->meta;
+  meta.append(kMagic, sizeof(kMagic));
+  AppendU64(meta, kVersion);
+  AppendU64(meta, mSequence);
+  AppendU64(meta, mBlockSize);
+  AppendU64(meta, mNumberOfEntries);
+  meta += mMeta;
+  AppendU64(meta, HashBytes(meta.data(), meta.size(), 0));
+  mMeta.clear();
+
+  GateMessage("Core", 2, "Checkpoint " << mSequence << ": " << mJob->blocks.size()
+              << " modified block(s) to write in " << mJob->dataFileName << Gateendl);
+  mPendingSlot = mSequence % 2;
+  mPendingJob = std::async(std::launch::async, &GateCheckpointWriter::WriteJob, mJob);
+  mJob.reset();
+  mSequence++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointWriter::Wait()
+{
+  if (!mPendingJob.valid()) return;
+  std::string error = mPendingJob.get();
+  if (error != "") {
+    GateWarning("Checkpoint not written: " << error << Gateendl);
+    // The content of the slot is unknown: everything is written next time
+    for (size_t i = 0; i < mArrays.size(); i++) mArrays[i].hashes[mPendingSlot].clear();
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCheckpointWriter::IsWriting()
+{
+  return mPendingJob.valid() &&
+    mPendingJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string GateCheckpointWriter::WriteJob(std::shared_ptr<Job> job)
+{
+  // The slot is invalid while its data file is modified
+  if (unlink(job->metaFileName.c_str()) != 0 && errno != ENOENT)
+    return "cannot remove " + job->metaFileName + " (" + strerror(errno) + ")";
+
+  int fd = open(job->dataFileName.c_str(), O_WRONLY | O_CREAT, 0644);
+  if (fd < 0) return "cannot open " + job->dataFileName + " (" + strerror(errno) + ")";
+  for (size_t i = 0; i < job->blocks.size(); i++) {
+    const Block & b = job->blocks[i];
+    if (!WriteAll(fd, b.bytes.data(), b.bytes.size(), b.offset)) {
+      std::string error = "cannot write " + job->dataFileName + " (" + strerror(errno) + ")";
+      close(fd);
+      return error;
+    }
+  }
+  G4bool synced = (fsync(fd) == 0);
+  close(fd);
+  if (!synced) return "cannot write " + job->dataFileName + " (" + strerror(errno) + ")";
+
+  // The slot becomes valid again when its .chk file appears
+  std::string tmpFileName = job->metaFileName + ".tmp";
+  fd = open(tmpFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return "cannot open " + tmpFileName + " (" + strerror(errno) + ")";
+  synced = WriteAll(fd, job->meta.data(), job->meta.size(), 0) && fsync(fd) == 0;
+  close(fd);
+  if (!synced || rename(tmpFileName.c_str(), job->metaFileName.c_str()) != 0)
+    return "cannot write " + job->metaFileName + " (" + strerror(errno) + ")";
+  return "";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointReader::GateCheckpointReader()
+{
+  Close();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointReader::Close()
+{
+  mPrefix = "";
+  mDataFileName = "";
+  mSequence = -1;
+  mBlockSize = 0;
+  mEntries.clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCheckpointReader::Open(const G4String & prefix)
+{
+  G4long sequence[2];
+  for (G4int slot = 0; slot < 2; slot++)
+    sequence[slot] = ReadSlot(prefix, slot) ? mSequence : -1;
+
+  // Most recent slot first
+  G4int order[2] = { 0, 1 };
+  if (sequence[1] > sequence[0]) std::swap(order[0], order[1]);
+  for (G4int i = 0; i < 2; i++) {
+    G4int slot = order[i];
+    if (sequence[slot] < 0) continue;
+    if (ReadSlot(prefix, slot) && CheckArrays()) {
+      if (i > 0 && sequence[order[0]] >= 0)
+        GateWarning("Checkpoint " << sequence[order[0]] << " of " << prefix
+                    << " is damaged, the previous one is used." << Gateendl);
+      return true;
+    }
+  }
+  Close();
+  return false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCheckpointReader::ReadSlot(const G4String & prefix, G4int slot)
+{
+  Close();
+  std::ifstream is(SlotFileName(prefix, slot, ".chk").c_str(), std::ios::binary);
+  if (!is) return false;
+  std::string meta((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+  // Check the header and the trailing hash (truncated or damaged file)
+  size_t pos = meta.size() - sizeof(uint64_t);
+  uint64_t hash, version, sequence, numberOfEntries;
+  if (meta.size() < sizeof(kMagic) + sizeof(uint64_t) ||
+      memcmp(meta.data(), kMagic, sizeof(kMagic)) != 0 ||
+      !TakeU64(meta, pos, hash) ||
+      hash != HashBytes(meta.data(), meta.size() - sizeof(uint64_t), 0)) return false;
+  meta.resize(meta.size() - sizeof(uint64_t));
+  pos = sizeof(kMagic);
+  if (!TakeU64(meta, pos, version) || version != kVersion ||
+      !TakeU64(meta, pos, sequence) ||
+      !TakeU64(meta, pos, mBlockSize) || mBlockSize == 0 ||
+      !TakeU64(meta, pos, numberOfEntries)) return false;
+
+  for (uint64_t i = 0; i < numberOfEntries; i++) {
+    uint64_t n, kind;
+    std::string key;
+    Entry e;
+    if (!TakeU64(meta, pos, n) || !TakeBytes(meta, pos, n, key) || !TakeU64(meta, pos, kind)) return false;
+    e.isArray = (kind == kArrayEntry);
+    e.offset = 0;
+    e.digest = 0;
+    if (!TakeU64(meta, pos, e.size)) return false;
+    if (e.isArray) {
+      if (!TakeU64(meta, pos, e.offset) || !TakeU64(meta, pos, e.digest)) return false;
+    }
+    else if (!TakeBytes(meta, pos, e.size, e.value)) return false;
+    mEntries[key] = e;
+  }
+  mSequence = sequence;
+  mDataFileName = SlotFileName(prefix, slot, ".dat");
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCheckpointReader::CheckArrays()
+{
+  std::ifstream is(mDataFileName.c_str(), std::ios::binary);
+  std::vector<char> buffer;
+  std::map<std::string, Entry>::const_iterator it;
+  for (it = mEntries.begin(); it != mEntries.end(); ++it) {
+    const Entry & e = it->second;
+    if (!e.isArray) continue;
+    size_t nbOfBlocks = (e.size + mBlockSize - 1) / mBlockSize;
+    std::vector<uint64_t> hashes(nbOfBlocks);
+    buffer.resize(std::min<uint64_t>(mBlockSize, e.size));
+    is.seekg(e.offset);
+    for (size_t b = 0; b < nbOfBlocks; b++) {
+      size_t n = std::min<uint64_t>(mBlockSize, e.size - b * mBlockSize);
+      if (!is.read(buffer.data(), n)) return false;
+      hashes[b] = HashBytes(buffer.data(), n, b);
+    }
+    if (HashBytes((const char *)hashes.data(), nbOfBlocks * sizeof(uint64_t), e.size) != e.digest) return false;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+const GateCheckpointReader::Entry & GateCheckpointReader::GetEntry(const G4String & key, G4bool isArray)
+{
+  std::string k = mPrefix + key;
+  std::map<std::string, Entry>::const_iterator it = mEntries.find(k);
+  if (it == mEntries.end())
+    GateError("Checkpoint: no entry '" << k << "'. The simulation must be resumed with the macro used to write the checkpoint.");
+  if (it->second.isArray != isArray)
+    GateError("Checkpoint: entry '" << k << "' has not the expected type.");
+  return it->second;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointReader::ReadBytes(const G4String & key, void * data, size_t size)
+{
+  const Entry & e = GetEntry(key, false);
+  if (e.value.size() != size)
+    GateError("Checkpoint: entry '" << mPrefix+key << "' has " << e.value.size() << " bytes, " << size << " expected.");
+  memcpy(data, e.value.data(), size);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string GateCheckpointReader::ReadString(const G4String & key)
+{
+  return GetEntry(key, false).value;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointReader::ReadArrayBytes(const G4String & key, void * data, size_t size)
+{
+  const Entry & e = GetEntry(key, true);
+  if (e.size != size)
+    GateError("Checkpoint: array '" << mPrefix+key << "' has " << e.size << " bytes, " << size
+              << " expected (image size changed ?).");
+  std::ifstream is(mDataFileName.c_str(), std::ios::binary);
+  is.seekg(e.offset);
+  if (size > 0 && !is.read((char *)data, size))
+    GateError("Checkpoint: cannot read array '" << mPrefix+key << "' in " << mDataFileName);
+}
+//-----------------------------------------------------------------------------
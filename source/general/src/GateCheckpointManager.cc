@@ -0,0 +1,209 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateCheckpointManager.hh"
+#include "GateCheckpointManagerMessenger.hh"
+#include "GateMessageManager.hh"
+#include "GateRunManager.hh"
+#include "GateRandomEngine.hh"
+#include "GateSourceMgr.hh"
+#include "GateActorManager.hh"
+#include "GateVActor.hh"
+#include "GateMiscFunctions.hh"
+#include "G4Run.hh"
+#include "G4SystemOfUnits.hh"
+
+GateCheckpointManager * GateCheckpointManager::mInstance = 0;
+
+//-----------------------------------------------------------------------------
+GateCheckpointManager * GateCheckpointManager::GetInstance()
+{
+  if (mInstance == 0) mInstance = new GateCheckpointManager();
+  return mInstance;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointManager::GateCheckpointManager()
+{
+  pMessenger = new GateCheckpointManagerMessenger(this);
+  mFileName = "";
+  mRestartFileName = "";
+  mEventInterval = 0;
+  mTimeInterval = 0;
+  mNumberOfEventsSinceLastCheckpoint = 0;
+  mLastCheckpointTime = std::chrono::steady_clock::now();
+  mNumberOfCheckpoints = 0;
+  mRestartRunID = 0;
+  mRestartNumberOfEvents = 0;
+  mRunEventOffset = 0;
+  mIsRestartOpen = false;
+  mResumeSuffix = "";
+  mActorRestorePending = false;
+  mSourceRestorePending = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointManager::~GateCheckpointManager()
+{
+  delete pMessenger;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::AppendSuffixToFileNames(const G4String & suffix)
+{
+  if (mFileName != "") SetFileName(mFileName + suffix);
+  if (mRestartFileName != "") mRestartFileName += suffix;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::OpenRestart()
+{
+  if (!mReader.Open(mRestartFileName))
+    GateError("Checkpoint: no valid checkpoint found with the name " << mRestartFileName);
+  mReader.SetPrefix("application/");
+  mReader.Read("runID", mRestartRunID);
+  mReader.Read("numberOfEvents", mRestartNumberOfEvents);
+  mIsRestartOpen = true;
+  mActorRestorePending = true;
+  mSourceRestorePending = true;
+  // Do not overwrite the checkpoint we start from if the same name is used
+  mWriter.SetSequence(mReader.GetSequence() + 1);
+  GateMessage("Acquisition", 0, "Resuming from checkpoint " << mReader.GetSequence() << " of " << mRestartFileName
+              << ": run " << mRestartRunID << ", " << mRestartNumberOfEvents << " event(s) already simulated\n");
+
+  // The actors that are not in the checkpoint restart from zero: they must not overwrite
+  // the files of the interrupted job. Same naming as the forked processes.
+  std::ostringstream oss;
+  oss << "_resume" << mReader.GetSequence();
+  mResumeSuffix = oss.str();
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i = 0; i < actors.size(); i++) {
+    mReader.SetPrefix("actors/" + actors[i]->GetObjectName() + "/");
+    if (mReader.Has("checkpointed")) {
+      mRestartedActors.insert(actors[i]->GetObjectName());
+      continue;
+    }
+    G4String f = actors[i]->GetSaveFilename();
+    if (f == "FilenameNotGivenForThisActor") continue;
+    if (f.find_last_of(".") == std::string::npos) actors[i]->SetSaveFilename(f + mResumeSuffix);
+    else actors[i]->SetSaveFilename(removeExtension(f) + mResumeSuffix + "." + getExtension(f));
+    GateMessage("Acquisition", 0, "Actor " << actors[i]->GetObjectName() << " is not in the checkpoint, it restarts from zero in "
+                << actors[i]->GetSaveFilename() << Gateendl);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::EndOfEventAction(const G4Event * e)
+{
+  if (!IsEnabled()) return;
+  mNumberOfEventsSinceLastCheckpoint++;
+  G4bool due = (mEventInterval > 0 && mNumberOfEventsSinceLastCheckpoint >= mEventInterval);
+  if (!due && mTimeInterval > 0) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mLastCheckpointTime;
+    due = (elapsed.count()*s >= mTimeInterval);
+  }
+  if (!due) return;
+
+  // The end of run saves the outputs anyway. The event IDs restart at 0 in a
+  // resumed run: compare with the number of events of the whole run.
+  const G4Run * run = GateRunManager::GetRunManager()->GetCurrentRun();
+  if (mRunEventOffset + e->GetEventID()+1 >= mRunEventOffset + run->GetNumberOfEventToBeProcessed()) return;
+  // Low overhead: never wait for the previous checkpoint, try again at the next event
+  if (mWriter.IsWriting()) return;
+
+  Save(e);
+  mNumberOfEventsSinceLastCheckpoint = 0;
+  mLastCheckpointTime = std::chrono::steady_clock::now();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::Save(const G4Event * e)
+{
+  mWriter.Begin();
+  mWriter.SetPrefix("application/");
+  mWriter.Write("runID", GateRunManager::GetRunManager()->GetCurrentRun()->GetRunID());
+  // Events of the run simulated so far, including the ones done before the restart
+  mWriter.Write("numberOfEvents", G4long(mRunEventOffset + e->GetEventID()+1));
+  mWriter.SetPrefix("random/");
+  mWriter.WriteString("status", GateRandomEngine::GetInstance()->GetEngineStatus());
+
+  GateSourceMgr::GetInstance()->SaveCheckpoint(mWriter);
+
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i = 0; i < actors.size(); i++) {
+    mWriter.SetPrefix("actors/" + actors[i]->GetObjectName() + "/");
+    if (actors[i]->SaveCheckpoint(mWriter)) mWriter.Write("checkpointed", G4int(1));
+    else if (mNumberOfCheckpoints == 0)
+      GateWarning("Actor " << actors[i]->GetObjectName() << " does not support checkpoints, "
+                  << "its data restart from zero (in a new file) when the simulation is resumed." << Gateendl);
+  }
+  mWriter.Commit();
+  mNumberOfCheckpoints++;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::BeginOfRunAction(const G4Run *)
+{
+  mRunEventOffset = 0;
+  // Resumed run: actor data are restored after their begin of run actions
+  if (mActorRestorePending) RestoreActors();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::RestoreActors()
+{
+  if (GateRunManager::GetRunManager()->GetCurrentRun()->GetRunID() != mRestartRunID)
+    GateError("Checkpoint: the simulation must be resumed at run " << mRestartRunID);
+  std::vector<GateVActor*> & actors = GateActorManager::GetInstance()->GetTheListOfActors();
+  for (size_t i = 0; i < actors.size(); i++) {
+    if (!IsActorInRestart(actors[i]->GetObjectName())) continue;
+    mReader.SetPrefix("actors/" + actors[i]->GetObjectName() + "/");
+    actors[i]->LoadCheckpoint(mReader);
+  }
+  // The first event of this run is the event mRestartNumberOfEvents of the interrupted one
+  mRunEventOffset = mRestartNumberOfEvents;
+  mActorRestorePending = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::RestoreSources()
+{
+  mReader.SetPrefix("random/");
+  GateRandomEngine::GetInstance()->SetEngineStatus(mReader.ReadString("status"));
+  GateSourceMgr::GetInstance()->LoadCheckpoint(mReader);
+  mReader.Close();
+  mSourceRestorePending = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManager::EndOfAcquisition()
+{
+  mWriter.Wait();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateCheckpointManagerMessenger.hh"
+#include "GateCheckpointManager.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//-----------------------------------------------------------------------------
+GateCheckpointManagerMessenger::GateCheckpointManagerMessenger(GateCheckpointManager * manager)
+{
+  pManager = manager;
+
+  pCheckpointDir = new G4UIdirectory("/gate/checkpoint/");
+  pCheckpointDir->SetGuidance("Periodic checkpoints, and restart of an interrupted simulation.");
+
+  pFileNameCmd = new G4UIcmdWithAString("/gate/checkpoint/setFileName",this);
+  pFileNameCmd->SetGuidance("Set the prefix of the checkpoint files (<prefix>.0.chk/.dat and <prefix>.1.chk/.dat)");
+  pFileNameCmd->SetParameterName("Prefix",false);
+
+  pEventIntervalCmd = new G4UIcmdWithAnInteger("/gate/checkpoint/setEventInterval",this);
+  pEventIntervalCmd->SetGuidance("Write a checkpoint every N events (0: disabled)");
+  pEventIntervalCmd->SetParameterName("N",false);
+  pEventIntervalCmd->SetRange("N>=0");
+
+  pTimeIntervalCmd = new G4UIcmdWithADoubleAndUnit("/gate/checkpoint/setTimeInterval",this);
+  pTimeIntervalCmd->SetGuidance("Write a checkpoint every T of elapsed (wall clock) time (0: disabled)");
+  pTimeIntervalCmd->SetParameterName("Time",false);
+  pTimeIntervalCmd->SetUnitCategory("Time");
+  pTimeIntervalCmd->SetDefaultUnit("s");
+
+  pRestartCmd = new G4UIcmdWithAString("/gate/checkpoint/restartFrom",this);
+  pRestartCmd->SetGuidance("Resume the simulation from the last valid checkpoint with this prefix (same macro as the interrupted simulation, before /gate/run/initialize)");
+  pRestartCmd->SetParameterName("Prefix",false);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCheckpointManagerMessenger::~GateCheckpointManagerMessenger()
+{
+  delete pFileNameCmd;
+  delete pEventIntervalCmd;
+  delete pTimeIntervalCmd;
+  delete pRestartCmd;
+  delete pCheckpointDir;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCheckpointManagerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == pFileNameCmd) pManager->SetFileName(newValue);
+  else if (command == pEventIntervalCmd) pManager->SetEventInterval(pEventIntervalCmd->GetNewIntValue(newValue));
+  else if (command == pTimeIntervalCmd) pManager->SetTimeInterval(pTimeIntervalCmd->GetNewDoubleValue(newValue));
+  else if (command == pRestartCmd) pManager->SetRestartFileName(newValue);
+}
+//-----------------------------------------------------------------------------
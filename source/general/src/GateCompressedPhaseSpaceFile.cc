@@ -0,0 +1,388 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateCompressedPhaseSpaceFile.hh"
+#include "GateMessageManager.hh"
+
+// zlib from ITK, or from the bundled itk-mhd
+#include "itk_zlib.h"
+
+#include <cstring>
+#include <unistd.h>
+
+static const char kGatePhaseSpaceMagic[8] = {'G','A','T','E','P','H','S','P'};
+static const uint32_t kGatePhaseSpaceVersion = 1;
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceBlock::Clear()
+{
+  mPDGCodes.clear();
+  mType.clear();
+  for(int c=0; c<kNumberOfColumns; c++) mColumns[c].clear();
+  mTime.clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4int GateCompressedPhaseSpaceBlock::FindOrAddType(G4int PDGCode)
+{
+  for(size_t i=0; i<mPDGCodes.size(); i++)
+    if (mPDGCodes[i] == PDGCode) return i;
+  if ((G4int)mPDGCodes.size() >= kMaxNumberOfTypes) return -1;
+  mPDGCodes.push_back(PDGCode);
+  return mPDGCodes.size()-1;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceBlock::Push(const GateCompressedPhaseSpaceRecord & r, G4int typeIndex)
+{
+  mType.push_back(typeIndex | (r.newEvent ? kNewEventFlag : 0));
+  mColumns[kX].push_back(r.x);
+  mColumns[kY].push_back(r.y);
+  mColumns[kZ].push_back(r.z);
+  mColumns[kDX].push_back(r.dx);
+  mColumns[kDY].push_back(r.dy);
+  mColumns[kDZ].push_back(r.dz);
+  mColumns[kEnergy].push_back(r.energy);
+  mColumns[kWeight].push_back(r.weight);
+  if (mHasTime) mTime.push_back(r.time);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceBlock::Get(size_t i, GateCompressedPhaseSpaceRecord & r) const
+{
+  r.PDGCode = mPDGCodes[mType[i] & ~kNewEventFlag];
+  r.newEvent = (mType[i] & kNewEventFlag) != 0;
+  r.x = mColumns[kX][i];
+  r.y = mColumns[kY][i];
+  r.z = mColumns[kZ][i];
+  r.dx = mColumns[kDX][i];
+  r.dy = mColumns[kDY][i];
+  r.dz = mColumns[kDZ][i];
+  r.energy = mColumns[kEnergy][i];
+  r.weight = mColumns[kWeight][i];
+  r.time = mHasTime ? mTime[i] : 0.0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// raw block: uint32 nbOfParticles, uint32 hasTime, uint32 nbOfTypes,
+// int32 PDGCodes[nbOfTypes], uint8 type[n], float columns[8][n], double time[n]
+void GateCompressedPhaseSpaceBlock::Serialize(std::vector<char> & raw) const
+{
+  uint32_t header[3] = { (uint32_t)mType.size(), (uint32_t)mHasTime, (uint32_t)mPDGCodes.size() };
+  size_t n = mType.size();
+  raw.resize(sizeof(header) + mPDGCodes.size()*sizeof(int32_t) + n*sizeof(unsigned char)
+             + kNumberOfColumns*n*sizeof(float) + mTime.size()*sizeof(double));
+  char * p = raw.data();
+  memcpy(p, header, sizeof(header)); p += sizeof(header);
+  for(size_t i=0; i<mPDGCodes.size(); i++) {
+    int32_t code = mPDGCodes[i];
+    memcpy(p, &code, sizeof(code)); p += sizeof(code);
+  }
+  memcpy(p, mType.data(), n); p += n;
+  for(int c=0; c<kNumberOfColumns; c++) {
+    memcpy(p, mColumns[c].data(), n*sizeof(float)); p += n*sizeof(float);
+  }
+  if (mHasTime) memcpy(p, mTime.data(), n*sizeof(double));
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCompressedPhaseSpaceBlock::Unserialize(const std::vector<char> & raw)
+{
+  uint32_t header[3];
+  if (raw.size() < sizeof(header)) return false;
+  const char * p = raw.data();
+  memcpy(header, p, sizeof(header)); p += sizeof(header);
+  size_t n = header[0];
+  mHasTime = header[1] != 0;
+  size_t expected = sizeof(header) + header[2]*sizeof(int32_t) + n*sizeof(unsigned char)
+    + kNumberOfColumns*n*sizeof(float) + (mHasTime ? n*sizeof(double) : 0);
+  if (raw.size() != expected) return false;
+
+  mPDGCodes.resize(header[2]);
+  for(size_t i=0; i<mPDGCodes.size(); i++) {
+    int32_t code;
+    memcpy(&code, p, sizeof(code)); p += sizeof(code);
+    mPDGCodes[i] = code;
+  }
+  mType.assign((const unsigned char*)p, (const unsigned char*)p + n); p += n;
+  for(size_t i=0; i<n; i++)
+    if ((size_t)(mType[i] & ~kNewEventFlag) >= mPDGCodes.size()) return false;
+  for(int c=0; c<kNumberOfColumns; c++) {
+    mColumns[c].resize(n);
+    memcpy(mColumns[c].data(), p, n*sizeof(float)); p += n*sizeof(float);
+  }
+  mTime.resize(mHasTime ? n : 0);
+  if (mHasTime) memcpy(mTime.data(), p, n*sizeof(double));
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCompressedPhaseSpaceWriter::GateCompressedPhaseSpaceWriter()
+{
+  mFile = 0;
+  mCompressionLevel = 1;
+  mNumberOfParticlesPerBlock = 65536;
+  mBlock.mHasTime = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCompressedPhaseSpaceWriter::~GateCompressedPhaseSpaceWriter()
+{
+  Close();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::Open(const G4String & filename, G4int compressionLevel, G4bool storeTime)
+{
+  Close();
+  mFile = fopen(filename.c_str(), "wb");
+  if (!mFile) GateError("Cannot open the phase space file " << filename << " for writing.");
+  mCompressionLevel = std::max(0, std::min(9, compressionLevel));
+  mBlock.Clear();
+  mBlock.mHasTime = storeTime;
+  fwrite(kGatePhaseSpaceMagic, sizeof(char), sizeof(kGatePhaseSpaceMagic), mFile);
+  fwrite(&kGatePhaseSpaceVersion, sizeof(uint32_t), 1, mFile);
+  // One serialized block per append: each one is handed over immediately
+  mWriter.start([this](std::vector<char> & raw) { WriteBlock(raw); }, 1, 4);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::Resume(const G4String & filename, long offset,
+                                            G4int compressionLevel, G4bool storeTime)
+{
+  Close();
+  mFile = fopen(filename.c_str(), "r+b");
+  if (!mFile) GateError("Cannot open the phase space file " << filename << " to resume it.");
+  char magic[sizeof(kGatePhaseSpaceMagic)];
+  if (fread(magic, sizeof(char), sizeof(magic), mFile) != sizeof(magic) ||
+      memcmp(magic, kGatePhaseSpaceMagic, sizeof(magic)) != 0 ||
+      fseek(mFile, 0, SEEK_END) != 0 || ftell(mFile) < offset)
+    GateError("The phase space file " << filename << " does not match the checkpoint.");
+  // Drop the blocks written after the checkpoint
+  fflush(mFile);
+  if (ftruncate(fileno(mFile), offset) != 0 || fseek(mFile, offset, SEEK_SET) != 0)
+    GateError("Cannot truncate the phase space file " << filename << " to resume it.");
+  mCompressionLevel = std::max(0, std::min(9, compressionLevel));
+  mBlock.Clear();
+  mBlock.mHasTime = storeTime;
+  mWriter.start([this](std::vector<char> & raw) { WriteBlock(raw); }, 1, 4);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::Fill(const GateCompressedPhaseSpaceRecord & r)
+{
+  G4int type = mBlock.FindOrAddType(r.PDGCode);
+  if (type < 0) {
+    SubmitBlock();
+    type = mBlock.FindOrAddType(r.PDGCode);
+  }
+  mBlock.Push(r, type);
+  if (mBlock.GetNumberOfParticles() >= mNumberOfParticlesPerBlock) SubmitBlock();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::SubmitBlock()
+{
+  if (mBlock.GetNumberOfParticles() == 0) return;
+  std::vector<char> raw;
+  mBlock.Serialize(raw);
+  mWriter.append(raw.data(), raw.size());
+  mBlock.Clear();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::WriteBlock(std::vector<char> & raw)
+{
+  uint32_t header[3];
+  memcpy(&header[0], raw.data(), sizeof(uint32_t)); // number of particles
+  header[1] = raw.size();
+
+  std::vector<char> stored;
+  const char * data = raw.data();
+  header[2] = raw.size();
+  if (mCompressionLevel > 0) {
+    uLongf size = compressBound(raw.size());
+    stored.resize(size);
+    if (compress2((Bytef*)stored.data(), &size, (const Bytef*)raw.data(), raw.size(), mCompressionLevel) == Z_OK
+        && size < raw.size()) {
+      header[2] = size;
+      data = stored.data();
+    }
+  }
+  if (fwrite(header, sizeof(uint32_t), 3, mFile) != 3 ||
+      fwrite(data, sizeof(char), header[2], mFile) != header[2])
+    GateError("Error while writing a phase space block.");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+long GateCompressedPhaseSpaceWriter::Flush()
+{
+  if (!mFile) return 0;
+  SubmitBlock();
+  mWriter.flush();
+  fflush(mFile);
+  return ftell(mFile);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceWriter::Close()
+{
+  if (!mFile) return;
+  SubmitBlock();
+  mWriter.stop();
+  fclose(mFile);
+  mFile = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCompressedPhaseSpaceReader::GateCompressedPhaseSpaceReader()
+{
+  mFile = 0;
+  mFirstBlockPosition = 0;
+  mCurrentIndex = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateCompressedPhaseSpaceReader::~GateCompressedPhaseSpaceReader()
+{
+  Close();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4long GateCompressedPhaseSpaceReader::Open(const G4String & filename)
+{
+  Close();
+  mFilename = filename;
+  mFile = fopen(filename.c_str(), "rb");
+  if (!mFile) GateError("Error file not found: " << filename);
+
+  char magic[sizeof(kGatePhaseSpaceMagic)];
+  uint32_t version = 0;
+  if (fread(magic, sizeof(char), sizeof(magic), mFile) != sizeof(magic) ||
+      memcmp(magic, kGatePhaseSpaceMagic, sizeof(magic)) != 0 ||
+      fread(&version, sizeof(uint32_t), 1, mFile) != 1 || version != kGatePhaseSpaceVersion)
+    GateError("The file " << filename << " is not a Gate compressed phase space (version "
+              << kGatePhaseSpaceVersion << ").");
+  mFirstBlockPosition = ftell(mFile);
+
+  // Count the particles from the block headers only
+  G4long n = 0;
+  uint32_t header[3];
+  while (fread(header, sizeof(uint32_t), 3, mFile) == 3) {
+    n += header[0];
+    if (fseek(mFile, header[2], SEEK_CUR) != 0) break;
+  }
+  Rewind();
+  return n;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceReader::Close()
+{
+  if (!mFile) return;
+  if (mNextBlockReady.valid()) mNextBlockReady.wait();
+  fclose(mFile);
+  mFile = 0;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceReader::Rewind()
+{
+  if (mNextBlockReady.valid()) mNextBlockReady.wait();
+  mNextBlockReady = std::future<G4bool>();
+  fseek(mFile, mFirstBlockPosition, SEEK_SET);
+  mCurrentBlock.Clear();
+  mCurrentIndex = 0;
+  Prefetch();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateCompressedPhaseSpaceReader::Prefetch()
+{
+  mNextBlockReady = std::async(std::launch::async, [this]() { return ReadBlock(mNextBlock); });
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCompressedPhaseSpaceReader::ReadBlock(GateCompressedPhaseSpaceBlock & b)
+{
+  uint32_t header[3];
+  if (fread(header, sizeof(uint32_t), 3, mFile) != 3) return false;
+  mStored.resize(header[2]);
+  if (fread(mStored.data(), sizeof(char), header[2], mFile) != header[2])
+    GateError("The phase space file " << mFilename << " is truncated.");
+
+  if (header[2] == header[1]) mRaw.swap(mStored);
+  else {
+    mRaw.resize(header[1]);
+    uLongf size = header[1];
+    if (uncompress((Bytef*)mRaw.data(), &size, (const Bytef*)mStored.data(), header[2]) != Z_OK || size != header[1])
+      GateError("Cannot decompress a block of the phase space file " << mFilename);
+  }
+  if (!b.Unserialize(mRaw) || b.GetNumberOfParticles() != header[0])
+    GateError("Corrupted block in the phase space file " << mFilename);
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateCompressedPhaseSpaceReader::Next(GateCompressedPhaseSpaceRecord & r)
+{
+  while (mCurrentIndex >= mCurrentBlock.GetNumberOfParticles()) {
+    if (!mNextBlockReady.valid() || !mNextBlockReady.get()) return false;
+    std::swap(mCurrentBlock, mNextBlock);
+    mCurrentIndex = 0;
+    Prefetch();
+  }
+  mCurrentBlock.Get(mCurrentIndex, r);
+  mCurrentIndex++;
+  return true;
+}
+//-----------------------------------------------------------------------------
@@ -22,9 +22,13 @@
 //#if ITK_VERSION_MAJOR >= 4
 //#if ( ( ITK_VERSION_MAJOR == 4 ) && ( ITK_VERSION_MINOR < 6 ) )
 
+std::string GateDICOMImage::mCacheDirectory = "";
+unsigned int GateDICOMImage::mNumberOfThreads = 0;
+
 //-----------------------------------------------------------------------------
 GateDICOMImage::GateDICOMImage()
 {
+  mPixelsInImage = false;
   vResolution.resize(0);
   vSpacing.resize(0);
   vSize.resize(0);
@@ -43,14 +47,22 @@ GateDICOMImage::GateDICOMImage()
 void GateDICOMImage::Read(const std::string fileName)
 {
   std::string path = gdcm::Filename(fileName.c_str()).GetPath();
+  std::string seriesUID = ReadSeriesUID(fileName);
+  GateMessage("Image", 5, "[GateDICOMImage::" << __FUNCTION__ << "] File: " << fileName <<", series UID: "<< seriesUID << Gateendl);
+  ReadSeries(path,seriesUID);
+}
+//-----------------------------------------------------------------------------
 
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(fileName);
-  reader->SetImageIO(ImageIOType::New());
+
+//-----------------------------------------------------------------------------
+std::string GateDICOMImage::ReadSeriesUID(const std::string fileName)
+{
+  ImageIOType::Pointer io = ImageIOType::New();
+  io->SetFileName(fileName);
 
   try
   {
-    reader->Update();
+    io->ReadImageInformation();
   }
   catch (itk::ExceptionObject & e)
   {
@@ -60,21 +72,25 @@ void GateDICOMImage::Read(const std::string fileName)
 
   GateMessage("Image", 5, "[GateDICOMImage::" << __FUNCTION__ << "] Opening " << fileName << Gateendl);
 
-  ReaderType::DictionaryRawPointer dict = (*(reader->GetMetaDataDictionaryArray()))[0];
-  itk::MetaDataObject< std::string >::Pointer entryvalue =
-    dynamic_cast<itk::MetaDataObject< std::string > *>( dict->Find( "0020|000e" )->second.GetPointer() );
-
-  if( entryvalue )
-  {
-    std::string seriesUID(entryvalue->GetMetaDataObjectValue());
-    GateMessage("Image", 5, "[GateDICOMImage::" << __FUNCTION__ << "] File: " << fileName <<", series UID: "<< seriesUID << Gateendl);
-    ReadSeries(path,seriesUID);
-  }
-  else
+  std::string seriesUID;
+  if( !itk::ExposeMetaData<std::string>(io->GetMetaDataDictionary(), "0020|000e", seriesUID) )
   {
     GateError("Can't find the series UID from the file" << Gateendl);
     exit(EXIT_FAILURE);
   }
+  return seriesUID;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string GateDICOMImage::GetCacheFileName(const std::string seriesUID)
+{
+  // DICOM strings may be padded
+  std::string uid = seriesUID;
+  while (!uid.empty() && (uid.back() == ' ' || uid.back() == '\0')) uid.pop_back();
+  if (mCacheDirectory == "" || uid == "") return "";
+  return mCacheDirectory + "/" + uid + ".mhd";
 }
 //-----------------------------------------------------------------------------
 
@@ -120,11 +136,14 @@ void GateDICOMImage::ReadSeries(const std::string seriesDirectory, std::string U
   }
 
   if(UID != "")
-    reader->SetFileNames(nameGenerator->GetFileNames(UID));
+    mFileNames = nameGenerator->GetFileNames(UID);
+  reader->SetFileNames(mFileNames);
 
+  // Only the geometry of the series here (headers), the slices are decoded in
+  // parallel by GetPixels directly into the destination buffer
   try
   {
-    reader->Update();
+    reader->UpdateOutputInformation();
   }
   catch (itk::ExceptionObject &excp)
   {
@@ -132,7 +151,64 @@ void GateDICOMImage::ReadSeries(const std::string seriesDirectory, std::string U
     exit(EXIT_FAILURE);
   }
 
-  image = reader->GetOutput();
+  image = ImageType::New();
+  image->CopyInformation(reader->GetOutput());
+  image->SetRegions(reader->GetOutput()->GetLargestPossibleRegion());
+  mPixelsInImage = false;
+
+  // Multi-frame file(s): one file is not one slice, use the series reader
+  if(mFileNames.size() != image->GetLargestPossibleRegion().GetSize()[2])
+  {
+    try
+    {
+      reader->Update();
+    }
+    catch (itk::ExceptionObject &excp)
+    {
+      GateError( "[GateDICOMImage::" << __FUNCTION__ << "] ERROR:" << seriesDirectory << " does not contain any corresponding DICOM series !" << Gateendl);
+      exit(EXIT_FAILURE);
+    }
+    image = reader->GetOutput();
+    mPixelsInImage = true;
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+std::string GateDICOMImage::ReadSlice(size_t z, std::vector<signed short> & slice)
+{
+  itk::ImageFileReader<ImageType>::Pointer reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetFileName(mFileNames[z]);
+  reader->SetImageIO(ImageIOType::New());
+
+  try
+  {
+    reader->Update();
+  }
+  catch (itk::ExceptionObject &excp)
+  {
+    return "Cannot read the file " + mFileNames[z];
+  }
+
+  ImageType::Pointer s = reader->GetOutput();
+  size_t n = image->GetLargestPossibleRegion().GetSize()[0] * image->GetLargestPossibleRegion().GetSize()[1];
+  if(s->GetLargestPossibleRegion().GetNumberOfPixels() != n)
+    return "The slice " + mFileNames[z] + " does not have the size of the series";
+  slice.assign(s->GetBufferPointer(), s->GetBufferPointer() + n);
+  return "";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+unsigned int GateDICOMImage::GetNumberOfThreads(size_t nbSlices)
+{
+  unsigned int n = mNumberOfThreads;
+  if(n == 0) n = std::thread::hardware_concurrency();
+  if(n == 0) n = 1;
+  if(n > nbSlices) n = nbSlices;
+  return n;
 }
 //-----------------------------------------------------------------------------
 
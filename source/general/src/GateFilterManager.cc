@@ -17,6 +17,10 @@ GateFilterManager::GateFilterManager(G4String name)
 {
   theFilters.clear();
   mFilterName = name;
+  mIsCompiled = false;
+  mCachedTrack = 0;
+  mCachedTrackID = 0;
+  mCachedTrackVerdict = true;
 }
 //---------------------------------------------------------------------------
 
@@ -39,12 +43,57 @@ GateFilterManager::~GateFilterManager()
 //---------------------------------------------------------------------------
 
 
+//---------------------------------------------------------------------------
+void GateFilterManager::Compile()
+{
+  theTrackFilters.clear();
+  theStepFilters.clear();
+  for(unsigned int i = 0;i<theFilters.size();i++) {
+    theFilters[i]->Compile();
+    if (theFilters[i]->IsTrackLevel()) theTrackFilters.push_back(theFilters[i]);
+    else theStepFilters.push_back(theFilters[i]);
+  }
+  mCachedTrack = 0;
+  mCachedTrackID = 0;
+  mIsCompiled = true;
+}
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+void GateFilterManager::BeginOfTrack(const G4Track* aTrack)
+{
+  if (!mIsCompiled) return;
+  mCachedTrack = aTrack;
+  mCachedTrackID = aTrack->GetTrackID();
+  mCachedTrackVerdict = true;
+  for(unsigned int i = 0;i<theTrackFilters.size();i++)
+    if(!theTrackFilters[i]->Accept(aTrack)) {
+      mCachedTrackVerdict = false;
+      break;
+    }
+}
+//---------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------
+G4bool GateFilterManager::AcceptTrackLevel(const G4Track* aTrack) const
+{
+  // Normally filled by BeginOfTrack; the fallback covers managers that are
+  // used outside the actor manager tracking callbacks.
+  if (aTrack != mCachedTrack || aTrack->GetTrackID() != mCachedTrackID)
+    const_cast<GateFilterManager*>(this)->BeginOfTrack(aTrack);
+  return mCachedTrackVerdict;
+}
+//---------------------------------------------------------------------------
+
 //---------------------------------------------------------------------------
 G4bool GateFilterManager::Accept(const G4Step* aStep) const
 {
-//  std::vector<GateVFilter*>::iterator sit;
- // for(sit= theFilters.begin(); sit!=theFilters.end(); ++sit)
-      //if(!(*sit)->Accept(aStep)) return false;
+  if (mIsCompiled) {
+    if (!AcceptTrackLevel(aStep->GetTrack())) return false;
+    for(unsigned int i = 0;i<theStepFilters.size();i++)
+      if(!theStepFilters[i]->Accept(aStep)) return false;
+    return true;
+  }
 
   for(unsigned int i = 0;i<theFilters.size();i++)
      if(!theFilters[i]->Accept(aStep)) return false;
@@ -56,12 +105,15 @@ G4bool GateFilterManager::Accept(const G4Step* aStep) const
 //---------------------------------------------------------------------------
 G4bool GateFilterManager::Accept(const G4Track* aTrack) const
 {
-//  std::vector<GateVFilter*>::iterator sit;
- // for(sit= theFilters.begin(); sit!=theFilters.end(); ++sit)
-      //if(!(*sit)->Accept(aStep)) return false;
+  if (mIsCompiled) {
+    if (!AcceptTrackLevel(aTrack)) return false;
+    for(unsigned int i = 0;i<theStepFilters.size();i++)
+      if(!theStepFilters[i]->Accept(aTrack)) return false;
+    return true;
+  }
 
-    for(unsigned int i = 0;i<theFilters.size();i++)
-      if(!theFilters[i]->Accept(aTrack)) return false;
+  for(unsigned int i = 0;i<theFilters.size();i++)
+    if(!theFilters[i]->Accept(aTrack)) return false;
 
   return true;
 }
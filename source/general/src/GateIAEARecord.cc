@@ -43,6 +43,7 @@
 //#define DEBUG // Comment to avoid printing for every particle write or read
 
 #include <math.h>
+#include <string.h>
 #include "GateIAEARecord.h"
 
 short iaea_record_type::initialize()
@@ -80,26 +81,22 @@ short iaea_record_type::initialize()
   return (OK);
 }
 
-short iaea_record_type::write_particle()
+int iaea_record_type::pack_particle(char *buffer)
 {
+  // Same layout as written by successive fwrite calls: type, floats, longs
   float floatArray[NUM_EXTRA_FLOAT+7];
   IAEA_I32 longArray[NUM_EXTRA_LONG];
 
   char ishort = (char) particle;
   if(w < 0) ishort = -ishort; // Sign of w is stored in particle type
-  
-  if( fwrite(&ishort, sizeof(char),   1, p_file) != 1)
-  {
-    fprintf(stderr, "\n ERROR: write_particle: Failed to write particle type\n");
-    return (FAIL);;
-  }
 
+  memcpy(buffer, &ishort, sizeof(char));
   int reclength = sizeof(char);
 
   if(IsNewHistory > 0) energy *= (-1); // New history is signaled by negative energy
 
   floatArray[0] = energy;
-  
+
   int i = 0;
 
   if(ix > 0) floatArray[++i] = x;
@@ -112,28 +109,34 @@ short iaea_record_type::write_particle()
   int j;
   for(j=0;j<iextrafloat;j++) floatArray[++i] = extrafloat[j];
 
+  memcpy(buffer + reclength, floatArray, (i+1)*sizeof(float));
   reclength += (i+1)*sizeof(float);
 
-  if( fwrite(floatArray, sizeof(float), (size_t)(i+1), p_file) != (size_t) (i+1))
-  {
-     fprintf(stderr, "\n ERROR: write_particle: Failed to write FLOAT phsp data\n");
-     return (FAIL);
-  }
-
-  if(iextralong > 0) 
+  if(iextralong > 0)
   {
      for(j=0;j<iextralong;j++) longArray[j] = extralong[j];
+     memcpy(buffer + reclength, longArray, iextralong*sizeof(IAEA_I32));
      reclength += iextralong*sizeof(IAEA_I32);
-     if( fwrite(longArray, sizeof(IAEA_I32), (size_t)iextralong, p_file) != (size_t)iextralong)
-     {
-        fprintf(stderr, "\n ERROR: write_particle: Failed to write LONG phsp data\n");
-        return (FAIL);
-     }
   }
 
+  return reclength;
+}
+
+short iaea_record_type::write_particle()
+{
+  char buffer[IAEA_MAX_RECORD_LENGTH];
+  int reclength = pack_particle(buffer);
+
   if(reclength == 0) return(FAIL);
 
+  if( fwrite(buffer, sizeof(char), (size_t)reclength, p_file) != (size_t)reclength)
+  {
+     fprintf(stderr, "\n ERROR: write_particle: Failed to write phsp data\n");
+     return (FAIL);
+  }
+
   #ifdef DEBUG
+  int j;
   // charge defined 
   int iaea_charge[MAX_NUM_PARTICLES]={0,-1,+1,0,+1};
   int charge = iaea_charge[particle - 1];
@@ -0,0 +1,133 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+
+#include "GateInterfileFrameCache.hh"
+#include "GateMessageManager.hh"
+
+GateInterfileFrameCache * GateInterfileFrameCache::mInstance = 0;
+
+//-----------------------------------------------------------------------------
+GateInterfileFrameCache * GateInterfileFrameCache::GetInstance()
+{
+  if (mInstance == 0) mInstance = new GateInterfileFrameCache();
+  return mInstance;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateInterfileFrameCache::GateInterfileFrameCache()
+{
+  mMaxNumberOfFrames = 0;
+  mPrefetchEnabled = true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateInterfileFrameCache::FramePointer
+GateInterfileFrameCache::ReadFrame(GateInterfileHeader header, G4String dataFileName)
+{
+  // The header is a private copy: ReadData modifies m_dataFileName
+  std::shared_ptr<FrameType> frame(new FrameType);
+  header.ReadData(dataFileName, *frame);
+  return frame;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateInterfileFrameCache::FramePointer
+GateInterfileFrameCache::GetFrame(const GateInterfileHeader & header, G4String dataFileName)
+{
+  std::shared_future<FramePointer> pending;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::map<G4String, FramePointer>::iterator it = mFrames.find(dataFileName);
+    if (it != mFrames.end()) {
+      mFramesOrder.remove(dataFileName);
+      mFramesOrder.push_back(dataFileName);
+      GateMessage("Geometry", 2, "Frame " << dataFileName << " found in cache" << Gateendl);
+      return it->second;
+    }
+    std::map<G4String, std::shared_future<FramePointer> >::iterator p = mPendingFrames.find(dataFileName);
+    if (p != mPendingFrames.end()) {
+      pending = p->second;
+      mPendingFrames.erase(p);
+    }
+  }
+
+  FramePointer frame;
+  if (pending.valid()) {
+    GateMessage("Geometry", 2, "Frame " << dataFileName << " taken from prefetch" << Gateendl);
+    frame = pending.get();
+  }
+  else frame = ReadFrame(header, dataFileName);
+
+  Store(dataFileName, frame);
+  return frame;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateInterfileFrameCache::Prefetch(const GateInterfileHeader & header, G4String dataFileName)
+{
+  if (!mPrefetchEnabled) return;
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mFrames.count(dataFileName) || mPendingFrames.count(dataFileName)) return;
+  GateMessage("Geometry", 2, "Prefetching frame " << dataFileName << Gateendl);
+  mPendingFrames[dataFileName] =
+    std::async(std::launch::async, &GateInterfileFrameCache::ReadFrame, header, dataFileName).share();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateInterfileFrameCache::Store(const G4String & dataFileName, FramePointer frame)
+{
+  if (mMaxNumberOfFrames <= 0) return;
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mFrames.count(dataFileName) == 0) mFramesOrder.push_back(dataFileName);
+  mFrames[dataFileName] = frame;
+  while ((G4int)mFramesOrder.size() > mMaxNumberOfFrames) {
+    mFrames.erase(mFramesOrder.front());
+    mFramesOrder.pop_front();
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateInterfileFrameCache::SetMaxNumberOfFrames(G4int n)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mMaxNumberOfFrames = n;
+  while ((G4int)mFramesOrder.size() > std::max(mMaxNumberOfFrames, 0)) {
+    mFrames.erase(mFramesOrder.front());
+    mFramesOrder.pop_front();
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateInterfileFrameCache::Clear()
+{
+  std::map<G4String, std::shared_future<FramePointer> > pending;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    pending.swap(mPendingFrames);
+    mFrames.clear();
+    mFramesOrder.clear();
+  }
+  std::map<G4String, std::shared_future<FramePointer> >::iterator it;
+  for (it = pending.begin(); it != pending.end(); ++it) it->second.wait();
+}
+//-----------------------------------------------------------------------------
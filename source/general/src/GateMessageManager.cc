@@ -18,7 +18,7 @@ See LICENSE.md for further details
 
 //-----------------------------------------------------------
 GateMessageManager::GateMessageManager()
-  : mMaxMessageLength(8), mAllLevel(0)
+  : mNumberOfCategories(1), mMaxMessageLength(8), mAllLevel(0)
 {
   std::string key;
 
@@ -154,10 +154,16 @@ GateMessageManager::GateMessageManager()
   mMessageHelp[key] = "G4 messages";
   if (mMaxMessageLength<key.length()) mMaxMessageLength = key.length();
 
+  UpdateCategoryLevels();
+
   pMessenger = new GateMessageMessenger("/gate",this);
 }
 //-----------------------------------------------------------
 
+//-----------------------------------------------------------
+std::atomic<int> GateMessageManager::sCategoryLevel[GateMessageManager::kMaxMessageCategories];
+//-----------------------------------------------------------
+
 //-----------------------------------------------------------
 GateMessageManager* GateMessageManager::GetInstance()
 {
@@ -176,6 +182,8 @@ void GateMessageManager::RegisterMessageType(std::string key,
   GetInstance()->mMessageHelp[key] = help;
   if (GetInstance()->mMaxMessageLength<key.length())
     GetInstance()->mMaxMessageLength = key.length();
+  GetInstance()->InternCategory(key);
+  GetInstance()->UpdateCategoryLevels();
 }
 //-----------------------------------------------------------
 
@@ -203,6 +211,7 @@ void GateMessageManager::SetMessageLevel(std::string key,
 		<<key<<"> unregistered");
     }
   }
+  GetInstance()->UpdateCategoryLevels();
 }
 //-----------------------------------------------------------
 
@@ -219,6 +228,52 @@ int GateMessageManager::GetMessageLevel(std::string key)
 }
 //-----------------------------------------------------------
 
+//-----------------------------------------------------------
+int GateMessageManager::GetMessageCategory(const std::string & key)
+{
+  return GetInstance()->InternCategory(key);
+}
+//-----------------------------------------------------------
+
+//-----------------------------------------------------------
+int GateMessageManager::InternCategory(const std::string & key)
+{
+  std::map<std::string,int>::iterator i = mMessageCategory.find(key);
+  if (i!=mMessageCategory.end()) return (*i).second;
+
+  // Keys used in the code without being registered behave as before:
+  // they follow the "All" level
+  if (mMessageLevel.find(key)==mMessageLevel.end()) {
+    mMessageLevel[key] = 0;
+    mMessageHelp[key] = "Unregistered message type";
+    if (mMaxMessageLength<key.length()) mMaxMessageLength = key.length();
+  }
+
+  UpdateCategoryLevels();
+  i = mMessageCategory.find(key);
+  if (i!=mMessageCategory.end()) return (*i).second;
+  return 0;
+}
+//-----------------------------------------------------------
+
+//-----------------------------------------------------------
+void GateMessageManager::UpdateCategoryLevels()
+{
+  sCategoryLevel[0].store(mAllLevel, std::memory_order_relaxed);
+  std::map<std::string,int>::iterator i;
+  for (i=mMessageLevel.begin(); i!=mMessageLevel.end(); ++i) {
+    std::map<std::string,int>::iterator c = mMessageCategory.find((*i).first);
+    if (c==mMessageCategory.end()) {
+      if (mNumberOfCategories>=kMaxMessageCategories) continue;
+      c = mMessageCategory.insert(std::make_pair((*i).first, mNumberOfCategories++)).first;
+    }
+    int l = mAllLevel;
+    if ( (*i).second > l ) l = (*i).second;
+    sCategoryLevel[(*c).second].store(l, std::memory_order_relaxed);
+  }
+}
+//-----------------------------------------------------------
+
 //-----------------------------------------------------------
 void GateMessageManager::PrintInfo()
 {
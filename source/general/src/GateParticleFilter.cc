@@ -16,6 +16,10 @@ GateParticleFilter::GateParticleFilter(G4String name)
   thePdef.clear();
   pPartMessenger = new GateParticleFilterMessenger(this);
   nFilteredParticles = 0;
+  mIsCompiled = false;
+  mAcceptGenericIon = false;
+  mLastDefinition = 0;
+  mLastVerdict = false;
 }
 //---------------------------------------------------------------------------
 
@@ -30,105 +34,138 @@ GateParticleFilter::~GateParticleFilter()
 
 
 //---------------------------------------------------------------------------
-G4bool GateParticleFilter::Accept(const G4Track *aTrack)
+void GateParticleFilter::Compile()
 {
-  std::vector<bool> acceptTemp;
+  G4ParticleTable * table = G4ParticleTable::GetParticleTable();
+  mDefinitions.clear();
+  mUnresolvedNames.clear();
+  mAcceptGenericIon = false;
+  for (size_t i = 0; i < thePdef.size(); i++) {
+    if (thePdef[i] == "GenericIon") mAcceptGenericIon = true;
+    const G4ParticleDefinition * def = table->FindParticle(thePdef[i]);
+    // Ions are created on the fly, their names are compared when first seen
+    if (def) mDefinitions.insert(def);
+    else mUnresolvedNames.push_back(thePdef[i]);
+  }
+
+  mZMask.clear();
+  for (size_t i = 0; i < thePdefZ.size(); i++) {
+    if (thePdefZ[i] < 0) continue;
+    if (thePdefZ[i] >= (G4int)mZMask.size()) mZMask.resize(thePdefZ[i]+1, false);
+    mZMask[thePdefZ[i]] = true;
+  }
+  mAMask.clear();
+  for (size_t i = 0; i < thePdefA.size(); i++) {
+    if (thePdefA[i] < 0) continue;
+    if (thePdefA[i] >= (G4int)mAMask.size()) mAMask.resize(thePdefA[i]+1, false);
+    mAMask[thePdefA[i]] = true;
+  }
+  mPDGs.clear();
+  mPDGs.insert(thePdefPDG.begin(), thePdefPDG.end());
+
+  mDefinitionVerdicts.clear();
+  mLastDefinition = 0;
+  mIsCompiled = true;
+}
+//---------------------------------------------------------------------------
 
+
+//---------------------------------------------------------------------------
+G4bool GateParticleFilter::EvaluateDefinition(const G4ParticleDefinition * def) const
+{
   // Test the particle name, keep the particle if the name is in the list
-  acceptTemp.push_back(true);
   if (!thePdef.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdef.size(); i++) {
-      if (thePdef[i] == aTrack->GetDefinition()->GetParticleName() ||
-          (aTrack->GetDefinition()->GetParticleSubType() == "generic" && thePdef[i] == "GenericIon") ) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdef !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+    bool found = mDefinitions.count(def) ||
+      (mAcceptGenericIon && def->GetParticleSubType() == "generic");
+    for (size_t i = 0; !found && i < mUnresolvedNames.size(); i++)
+      found = (mUnresolvedNames[i] == def->GetParticleName());
+    if (!found) return false;
+  }
 
   // Test the particle Z, keep the particle if Z is in the list
-  acceptTemp.push_back(true);
   if (!thePdefZ.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefZ.size(); i++) {
-      if (thePdefZ[i] == aTrack->GetDefinition()->GetAtomicNumber()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefZ !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+    G4int Z = def->GetAtomicNumber();
+    if (Z < 0 || Z >= (G4int)mZMask.size() || !mZMask[Z]) return false;
+  }
 
   //// Test the particle A
-  acceptTemp.push_back(true);
   if (!thePdefA.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefA.size(); i++) {
-      if (thePdefA[i] == aTrack->GetDefinition()->GetAtomicMass()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefA !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+    G4int A = def->GetAtomicMass();
+    if (A < 0 || A >= (G4int)mAMask.size() || !mAMask[A]) return false;
+  }
 
   // Test the particle PDG
-  acceptTemp.push_back(true);
-  if (!thePdefPDG.empty()) {
-    acceptTemp.back()=false;
-    for (size_t i = 0; i < thePdefPDG.size(); i++) {
-      if (thePdefPDG[i] == aTrack->GetDefinition()->GetPDGEncoding()) {
-        nFilteredParticles++;
-        acceptTemp.back()=true;
-        break;
-      }
-    }
-  } // end thePdefPFG !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+  if (!thePdefPDG.empty() && !mPDGs.count(def->GetPDGEncoding())) return false;
+
+  return true;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+G4bool GateParticleFilter::AcceptDefinition(const G4ParticleDefinition * def)
+{
+  if (!mIsCompiled) Compile();
+  if (def == mLastDefinition) return mLastVerdict;
+
+  std::unordered_map<const G4ParticleDefinition*, G4bool>::const_iterator it =
+    mDefinitionVerdicts.find(def);
+  if (it != mDefinitionVerdicts.end()) mLastVerdict = it->second;
+  else {
+    mLastVerdict = EvaluateDefinition(def);
+    mDefinitionVerdicts[def] = mLastVerdict;
+  }
+  mLastDefinition = def;
+  return mLastVerdict;
+}
+//---------------------------------------------------------------------------
+
+
+//---------------------------------------------------------------------------
+G4bool GateParticleFilter::Accept(const G4Track *aTrack)
+{
+  // Test the particle definition (name, Z, A and PDG lists)
+  if (!AcceptDefinition(aTrack->GetDefinition())) _FILTER_RETURN_WITH_INVERSION false;
+  if (!thePdef.empty() || !thePdefZ.empty() || !thePdefA.empty() || !thePdefPDG.empty())
+    nFilteredParticles++;
 
   // Test the parent
-  acceptTemp.push_back(true);
+  bool accept = true;
   if (!theParentPdef.empty()) {
-    acceptTemp.back()=false;
+    accept = false;
     GateTrackIDInfo * trackInfo =
       GateUserActions::GetUserActions()->GetTrackIDInfo(aTrack->GetParentID());
     while (trackInfo) {
       for (size_t i = 0; i < theParentPdef.size(); i++) {
         if (theParentPdef[i] == trackInfo->GetParticleName()) {
           nFilteredParticles++;
-          acceptTemp.back()=true;
+          accept = true;
           break;
         }
       }
-      if (acceptTemp.back() == true) break;
+      if (accept) break;
       int id = trackInfo->GetParentID();
       trackInfo = GateUserActions::GetUserActions()->GetTrackIDInfo(id);
     }
   } // end theParentPdef !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+  if (!accept) _FILTER_RETURN_WITH_INVERSION false;
 
   // Test the directParent
-  acceptTemp.push_back(true);
   if (!theDirectParentPdef.empty()) {
-    acceptTemp.back()=false;
+    accept = false;
     GateTrackIDInfo * trackInfo =
       GateUserActions::GetUserActions()->GetTrackIDInfo(aTrack->GetParentID());
     if (trackInfo) {
       for (size_t i = 0; i < theDirectParentPdef.size(); i++) {
         if (theDirectParentPdef[i] == trackInfo->GetParticleName()) {
           nFilteredParticles++;
-          acceptTemp.back()=true;
+          accept = true;
           break;
         }
       }
     }
   } // end theDirectParentPdef !empty
-  if (!acceptTemp.back()) _FILTER_RETURN_WITH_INVERSION false;
+  if (!accept) _FILTER_RETURN_WITH_INVERSION false;
 
   // Keep the track !
   _FILTER_RETURN_WITH_INVERSION true;
@@ -143,6 +180,7 @@ void GateParticleFilter::Add(const G4String &particleName)
     if (thePdef[i] == particleName ) return;
   }
   thePdef.push_back(particleName);
+  mIsCompiled = false;
 }
 //---------------------------------------------------------------------------
 
@@ -154,6 +192,7 @@ void GateParticleFilter::AddZ(const G4int &particleZ)
     if (thePdefZ[i] == particleZ ) return;
   }
   thePdefZ.push_back(particleZ);
+  mIsCompiled = false;
 }
 //---------------------------------------------------------------------------
 
@@ -165,6 +204,7 @@ void GateParticleFilter::AddA(const G4int &particleA)
     if (thePdefA[i] == particleA ) return;
   }
   thePdefA.push_back(particleA);
+  mIsCompiled = false;
 }
 //---------------------------------------------------------------------------
 
@@ -176,6 +216,7 @@ void GateParticleFilter::AddPDG(const G4int &particlePDG)
     if (thePdefPDG[i] == particlePDG ) return;
   }
   thePdefPDG.push_back(particlePDG);
+  mIsCompiled = false;
 }
 //---------------------------------------------------------------------------
 
@@ -23,6 +23,7 @@ See LICENSE.md for further details
 #include "GateApplicationMgr.hh"
 
 #include "GateSourceMgr.hh"
+#include "GateCheckpointManager.hh"
 //#include "GateOutputMgr.hh"
 //#include "GateHitFileReader.hh"
 
@@ -97,6 +98,9 @@ void GatePrimaryGeneratorAction::GenerateSimulationPrimaries(G4Event* event)
     //if( currentRun->GetRunID()==0) sourceMgr->Initialization();
     sourceMgr->PrepareNextRun( currentRun );
     m_nEvents=0;
+    // Resumed run: random engine and sources go on from the checkpoint
+    GateCheckpointManager* checkpoint = GateCheckpointManager::GetInstance();
+    if (checkpoint->IsSourceRestorePending()) checkpoint->RestoreSources();
   }
 
   G4int numVertices = sourceMgr->PrepareNextEvent(event);
@@ -17,6 +17,7 @@
 #include <ctime>
 #include <cstdlib>
 #include <random>
+#include <sstream>
 #include "GateMessageManager.hh"
 
 #ifdef G4ANALYSIS_USE_ROOT
@@ -38,6 +39,7 @@ GateRandomEngine::GateRandomEngine()
   theVerbosity = 0;
   theSeed="default";
   theSeedFile=" ";
+  theStreamIndex=-1;
   // Create the messenger
   theMessenger = new GateRandomEngineMessenger(this);
 
@@ -113,6 +115,24 @@ void GateRandomEngine::ShowStatus() {
   theRandomEngine->showStatus();
 }
 
+/////////////////////
+//  Engine status  //
+/////////////////////
+
+//!< std::string GetEngineStatus
+std::string GateRandomEngine::GetEngineStatus() {
+  std::ostringstream os;
+  CLHEP::HepRandom::saveFullState(os);
+  return os.str();
+}
+
+//!< void SetEngineStatus
+void GateRandomEngine::SetEngineStatus(const std::string& status) {
+  std::istringstream is(status);
+  CLHEP::HepRandom::restoreFullState(is);
+  if (!is) GateError("Cannot restore the random engine status (different engine ?)");
+}
+
 //////////////////
 //  Initialize  //
 //////////////////
@@ -156,6 +176,18 @@ void GateRandomEngine::Initialize() {
     }
   }
 
+  // Independent streams: a new seed is derived from the state set above and the
+  // stream index (splitmix64 mixing), so that streams are distinct and reproducible
+  if (theStreamIndex >= 0) {
+    unsigned long long x = static_cast<unsigned long long>(theRandomEngine->flat()*4294967296.0);
+    x ^= 0x9E3779B97F4A7C15ULL * static_cast<unsigned long long>(theStreamIndex+1);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= (x >> 31);
+    // 900000000 is the largest seed accepted by all CLHEP engines (HepJamesRandom)
+    theRandomEngine->setSeed(static_cast<long>(x % 900000000ULL), 0);
+  }
+
   // use clhep engine to initialize other engine
   std::srand(static_cast<unsigned int>(*theRandomEngine));
   srandom(static_cast<unsigned int>(*theRandomEngine));
@@ -105,6 +105,7 @@ void GateRootHitBuffer::Clear()
   sourceID        = -1;
   eventID         = -1;
   runID           = -1;
+  weight          = 1.;
 
   strcpy (processName, " ");
 
@@ -181,6 +182,7 @@ void GateRootHitBuffer::Fill(GateHit* aHit)
   sourceID        = aHit->GetSourceID();
   eventID         = aHit->GetEventID();
   runID           = aHit->GetRunID();
+  weight          = aHit->GetWeight();
 
 
   // HDS : septal
@@ -257,6 +259,7 @@ GateHit* GateRootHitBuffer::CreateHit()
   aHit->SetTrackLocalTime(    	GetTrackLocalTime() );
   aHit->SetGlobalPos(       	GetPos() );
   aHit->SetLocalPos(        	GetLocalPos() );
+  aHit->SetWeight(          	weight );
 
   aHit->SetMomentumDir(   G4ThreeVector(0., 0., 0. )     );
 
@@ -323,6 +326,7 @@ void GateHitTree::Init(GateRootHitBuffer& buffer)
   Branch("runID",          &buffer.runID,"runID/I");
   Branch("volumeID",       (void *)buffer.volumeID,"volumeID[10]/I");
   Branch("processName",    (void *)buffer.processName,"processName/C");
+  Branch("weight",         &buffer.weight,"weight/F");
 
   if(GateSystemListManager::GetInstance()->GetIsAnySystemDefined())
 	  for (size_t d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
@@ -397,6 +401,9 @@ void GateHitTree::SetBranchAddresses(TTree* hitTree,GateRootHitBuffer& buffer)
 
   hitTree->SetBranchAddress("volumeID",buffer.volumeID);
 
+  // Files written before the weight was recorded: weight 1
+  if (hitTree->GetBranch("weight")) hitTree->SetBranchAddress("weight",&buffer.weight);
+
   if(GateSystemListManager::GetInstance()->GetIsAnySystemDefined())
   		  for (size_t d=0; d<ROOT_OUTPUTIDSIZE ; ++d)
   			  hitTree->SetBranchAddress(outputIDName[d],(void *)(buffer.outputID+d));
@@ -11,6 +11,8 @@
 #include "GateDetectorConstruction.hh"
 #include "GateRunManagerMessenger.hh"
 #include "GateHounsfieldToMaterialsBuilder.hh"
+#include "GateApplicationMgr.hh"
+#include "GateCheckpointManager.hh"
 
 #include "G4StateManager.hh"
 #include "G4UImanager.hh"
@@ -152,6 +154,24 @@ void GateRunManager::InitializeAll() {
     // Take into account the em option set by the user (dedx bin etc)
     GatePhysicsList::GetInstance()->SetEmProcessOptions();
 
+    // Forked mode: the physics tables are built now (empty run) so that they are
+    // shared copy-on-write with the worker processes, with geometry and materials
+    if (GateApplicationMgr::GetInstance()->GetNumberOfForkedProcesses() > 1 &&
+        GateApplicationMgr::GetInstance()->GetForkedProcessIndex() < 0) {
+        GateMessage("Core", 0, "Initialization of physics tables\n");
+        if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_Idle)
+            G4StateManager::GetStateManager()->SetNewState(G4State_Idle);
+        initializedAtLeastOnce = true;
+        mIsGateInitializationCalled = true;
+        BeamOn(0);
+        GateApplicationMgr::GetInstance()->ForkWorkers();
+    }
+
+    // Resume: the checkpoint tells which actors restart from zero in new files,
+    // before they open them
+    GateCheckpointManager* checkpoint = GateCheckpointManager::GetInstance();
+    if (checkpoint->IsRestartRequested() && !checkpoint->IsRestartOpen()) checkpoint->OpenRestart();
+
     // Actors initialization
     GateMessage("Core", 0, "Initialization of actors\n");
     GateActorManager::GetInstance()->CreateListsOfEnabledActors();
@@ -18,6 +18,7 @@ See LICENSE.md for further details
 
 #include "GateVGeometryVoxelReader.hh"
 #include "GateInterfileHeader.hh"
+#include "GateInterfileFrameCache.hh"
 
 class GateGeometryVoxelInterfileReaderMessenger;
 
@@ -55,10 +56,12 @@ public:
   /*PY Descourt 08/09/2009 */
   virtual void ReadRTFile(G4String header_fileName, G4String fileName);
   /*PY Descourt 08/09/2009 */
+  virtual void PrefetchRTFile(G4String header_fileName, G4String fileName);
   
 protected:
   GateGeometryVoxelInterfileReaderMessenger* m_messenger;
   G4bool IsFirstFrame; // for RTPhantom
+  GateInterfileFrameCache::FramePointer m_previousFrame; // last frame read by ReadRTFile
 };
 
 #endif
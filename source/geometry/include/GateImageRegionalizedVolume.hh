@@ -139,6 +139,11 @@ public:
   //====================================================================
   /// Sets the name of the distance map file
   void SetDistanceMapFilename(const G4String& name) { mDistanceMapFilename = name; }
+  /// Sets the directory of the automatically built distance maps
+  /// ("" : next to the image, "none" : no cache)
+  void SetDistanceMapCacheDirectory(const G4String& name) { mDistanceMapCacheDirectory = name; }
+  /// Sets the number of threads used to build the distance map (0 : one per core)
+  void SetDistanceMapNumberOfThreads(G4int n) { mDistanceMapNumberOfThreads = n; }
   //====================================================================
 
 
@@ -202,11 +207,20 @@ private:
   //====================================================================
 
   //====================================================================
-  /// Loads the distance map
+  /// Loads the distance map (built if no file is given)
   void LoadDistanceMap();
+  /// Builds the distance map from the label image, or reads it from the cache
+  void BuildDistanceMap();
+  /// Hash of the label image (resolution, spacing and labels) keying the cache
+  std::string GetDistanceMapHash() const;
+  /// Squared distance transform along the given axis of lines [first,last[
+  void DistanceTransformLines(std::vector<double> & sqDistance, int axis,
+                              int firstLine, int lastLine) const;
   //====================================================================
   /// The name of the distance map file
   G4String mDistanceMapFilename;
+  G4String mDistanceMapCacheDirectory;
+  G4int mDistanceMapNumberOfThreads;
   //====================================================================
 };
 // EO class GateImageRegionalizedVolume
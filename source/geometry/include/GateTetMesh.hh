@@ -0,0 +1,140 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+#ifndef GATE_TET_MESH_HH
+#define GATE_TET_MESH_HH
+
+#include <array>
+#include <vector>
+#include <utility>
+
+#include <G4Types.hh>
+#include <G4ThreeVector.hh>
+#include <geomdefs.hh>
+
+
+// Tetrahedral mesh stored in flat arrays, used by the 'mesh' navigation of
+// GateTetMeshBox instead of one G4Tet/G4LogicalVolume per tetrahedron.
+//
+//  - nodes, the 4 node indices of each tet and the (dense) region index of each tet,
+//  - face adjacency: neighbour of each tet across face f (the face opposite to node f),
+//    -1 on the outer boundary of the mesh,
+//  - a bounding volume hierarchy over the tets, used to locate a point or the entry
+//    of a ray into the mesh when no neighbouring tet is known.
+//
+// Queries follow the G4VSolid interface for the union of the tets of one region
+// (see GateTetMeshRegionSolid): rays are traced from tet to tet through the shared
+// faces, and only stop when the region changes. Points are expressed in the frame
+// of the mesh file. The last located tet and the last traced ray are cached, since
+// Geant4 asks the same question to all region solids in turn (not thread safe).
+class GateTetMesh
+{
+  public:
+    typedef std::array<G4int, 4> Tet;
+
+    GateTetMesh(std::vector<G4ThreeVector>&& nodes,
+                std::vector<Tet>&& tets,
+                const std::vector<G4int>& regionIDs);
+
+    std::size_t GetNumberOfTetrahedra() const { return mTets.size(); }
+    std::size_t GetNumberOfRegions() const { return mRegionIDs.size(); }
+
+    // region marker read from the ELE file, and its dense index in [0, #regions)
+    G4int GetRegionID(std::size_t regionIndex) const { return mRegionIDs[regionIndex]; }
+    G4int GetTetRegionIndex(std::size_t tetIndex) const { return mTetRegions[tetIndex]; }
+    G4int GetTetRegionID(std::size_t tetIndex) const { return mRegionIDs[mTetRegions[tetIndex]]; }
+
+    G4double GetTetVolume(std::size_t tetIndex) const;
+    G4double GetRegionVolume(G4int regionIndex) const;
+
+    // extent of the whole mesh and of the tets of one region
+    void GetExtent(G4ThreeVector& min, G4ThreeVector& max) const { min = mMin; max = mMax; }
+    void GetRegionExtent(G4int regionIndex, G4ThreeVector& min, G4ThreeVector& max) const;
+
+    // Index of a tet containing p (within tolerance), -1 if p is outside the mesh.
+    G4int LocateTet(const G4ThreeVector& p) const;
+
+    // Splits the segment [a, b] between the tets it crosses, as (tet index, fraction
+    // of the length). A zero length segment is given to the tet containing a.
+    void GetSegmentTets(const G4ThreeVector& a, const G4ThreeVector& b,
+                        std::vector<std::pair<G4int, G4double> >& tets) const;
+
+    // G4VSolid-like queries for the union of the tets of one region
+    EInside Inside(const G4ThreeVector& p, G4int regionIndex) const;
+    G4ThreeVector SurfaceNormal(const G4ThreeVector& p, G4int regionIndex) const;
+    G4double DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v, G4int regionIndex) const;
+    G4double DistanceToIn(const G4ThreeVector& p, G4int regionIndex) const;
+    G4double DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v, G4int regionIndex,
+                           G4ThreeVector* n = nullptr) const;
+    G4double DistanceToOut(const G4ThreeVector& p, G4int regionIndex) const;
+
+    // Triangles of the surface of a region (faces shared with another region or on the
+    // outer boundary), oriented outwards, for visualisation.
+    void GetRegionSurface(G4int regionIndex, std::vector<G4ThreeVector>& vertices,
+                          std::vector<std::array<G4int, 3> >& triangles) const;
+
+  private:
+    struct BVHNode
+    {
+      G4ThreeVector min, max;
+      // leaf: tets [first, first+count) of mBVHTets, inner: children at
+      // index+1 and 'first'
+      G4int first;
+      G4int count;
+    };
+
+    void BuildAdjacency();
+    void BuildBVH();
+    G4int BuildBVHNode(std::vector<G4int>::iterator begin, std::vector<G4int>::iterator end,
+                       const std::vector<G4ThreeVector>& centroids,
+                       const std::vector<std::pair<G4ThreeVector, G4ThreeVector> >& boxes);
+
+    // outward normal and a point of face f of a tet
+    void GetFacePlane(G4int tet, G4int f, G4ThreeVector& normal, G4ThreeVector& point) const;
+    // signed distances of p to the 4 face planes (> 0 outside), returns the largest
+    G4double GetFaceDistances(G4int tet, const G4ThreeVector& p, G4double* distances) const;
+    G4int Walk(const G4ThreeVector& p, G4int start) const;
+    G4int LocateWithBVH(const G4ThreeVector& p) const;
+    G4int LocateInRegion(const G4ThreeVector& p, G4int regionIndex) const;
+    // Exit of the ray p + t v from a tet, entered at tIn. Returns the distance along
+    // the ray and sets the exit face.
+    G4double ExitTet(G4int tet, const G4ThreeVector& p, const G4ThreeVector& v,
+                     G4double tIn, G4int& face) const;
+    // First tet entered by the ray beyond tMin, -1 if none
+    G4int EnterMesh(const G4ThreeVector& p, const G4ThreeVector& v, G4double tMin,
+                    G4double& tEnter) const;
+
+  private:
+    std::vector<G4ThreeVector> mNodes;
+    std::vector<Tet> mTets;
+    std::vector<Tet> mNeighbours;
+    std::vector<G4int> mTetRegions;
+    std::vector<G4int> mRegionIDs;
+
+    std::vector<BVHNode> mBVHNodes;
+    std::vector<G4int> mBVHTets;
+
+    G4ThreeVector mMin, mMax;
+    std::vector<G4ThreeVector> mRegionMin, mRegionMax;
+    G4double mHalfTolerance;
+
+    // point location cache
+    mutable G4ThreeVector mLastPoint;
+    mutable G4int mLastTet;
+    mutable G4int mHint;
+
+    // traced ray cache: distance of the first entry in each region along the ray,
+    // filled lazily up to the tet mRayTet
+    mutable G4ThreeVector mRayPoint, mRayDirection;
+    mutable G4int mRayTet;
+    mutable G4double mRayDistance;
+    mutable std::vector<G4double> mRayEntries;
+    mutable std::vector<G4int> mRayRegions;
+};
+
+
+#endif  // GATE_TET_MESH_HH
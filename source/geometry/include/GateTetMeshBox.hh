@@ -21,6 +21,7 @@
 #include <G4AssemblyVolume.hh>
 
 #include "GateTetMeshReader.hh"
+#include "GateTetMesh.hh"
 #include "GateVVolume.hh"
 #include "GateVolumeManager.hh"
 
@@ -40,6 +41,14 @@ typedef std::map<G4int, GateMeshTetAttributes> GateMeshTetAttributeMap;
 
 
 // hosts a tetrahedral-mesh geometry in a box envelope
+//
+// Two ways of building the mesh ('setNavigation'):
+//  - assembly (default): one G4Tet and one G4LogicalVolume per tetrahedron, placed
+//    through a G4AssemblyVolume and navigated by the generic Geant4 navigator,
+//  - mesh: the mesh is kept in flat arrays (GateTetMesh) and one volume is placed per
+//    region (GateTetMeshRegionSolid). Tracks walk from tet to tet through the shared
+//    faces and only stop at region boundaries, which saves the memory and the time
+//    of building millions of volumes. Attached actors get the tet index from the mesh.
 class GateTetMeshBox : public GateVVolume
 {
   public:
@@ -61,14 +70,19 @@ class GateTetMeshBox : public GateVVolume
     void SetPathToELEFile(const G4String& path) { mPath = path; }
     void SetPathToAttributeMap(const G4String& path) { mAttributeMapPath = path; }
     void SetUnitOfLength(G4double unitOfLength) { mUnitOfLength = unitOfLength; }
+    void SetNavigation(const G4String& navigation) { mUseMeshNavigation = (navigation == "mesh"); }
 
     // getters for attached actors (be aware, that there is no bound checking):
     //
     std::size_t GetNumberOfTetrahedra()
     {
-      return mRegionIDs.size();
+      return pMesh ? pMesh->GetNumberOfTetrahedra() : mRegionIDs.size();
     }
 
+    // 'mesh' navigation: the tet index is found with the mesh, not from copy numbers
+    G4bool IsMeshNavigation() const { return mUseMeshNavigation; }
+    const GateTetMesh* GetMesh() const { return pMesh.get(); }
+
     // The tetrahedra are imprinted in order, as physical volumes with consecutive copy numbers.
     // However, these copy numbers may start at values > 0. This is a convenience function
     // to subtract this offset and get the tetrahedron index.
@@ -79,9 +93,13 @@ class GateTetMeshBox : public GateVVolume
 
     G4int GetRegionMarker(std::size_t tetIndex) const
     {
-      return mRegionIDs[tetIndex];
+      return pMesh ? pMesh->GetTetRegionID(tetIndex) : mRegionIDs[tetIndex];
     }
 
+    // both navigation modes
+    G4double GetTetVolume(std::size_t tetIndex) const;
+    const G4Material* GetTetMaterial(std::size_t tetIndex) const;
+
     const G4LogicalVolume* GetTetLogical(std::size_t tetIndex) const
     {
       G4VPhysicalVolume* physVol = *(pTetAssembly->GetVolumesIterator() + tetIndex);
@@ -92,10 +110,13 @@ class GateTetMeshBox : public GateVVolume
     // implementation specifics
     void DescribeMyself(size_t);
     void ReadAttributeMap();
+    GateMeshTetAttributes GetAttributes(G4int regionID);
+    void ConstructMeshRegions(G4Material* material);
 
   private:
     G4String mPath;
     G4double mUnitOfLength;
+    G4bool mUseMeshNavigation;
     G4String mAttributeMapPath;
     GateMeshTetAttributeMap mAttributeMap;
 
@@ -118,6 +139,11 @@ class GateTetMeshBox : public GateVVolume
 
     // copy number of the 0th tetrahedron's physical volume
     G4int mPhysVolCopyNumOffset;
+
+    // 'mesh' navigation: flat mesh and one volume per region (copy number = region index)
+    std::unique_ptr<GateTetMesh> pMesh;
+    std::vector<G4LogicalVolume*> mRegionLogicals;
+    std::vector<G4VPhysicalVolume*> mRegionPhysicals;
 };
 
 
@@ -32,6 +32,7 @@ class GateTetMeshBoxMessenger : public GateVolumeMessenger
     G4UIcmdWithAString* pSetPathToAttributeMapCmd;
     G4UIcmdWithAString* pSetPathToELEFileCmd;
     G4UIcmdWithADoubleAndUnit* pSetUnitOfLengthCmd;
+    G4UIcmdWithAString* pSetNavigationCmd;
 };
 
 #endif  // GATE_TET_MESH_BOX_MESSENGER_HH
@@ -8,6 +8,7 @@
 #ifndef GATE_TET_MESH_READER
 #define GATE_TET_MESH_READER
 
+#include <array>
 #include <vector>
 
 #include <G4String.hh>
@@ -37,12 +38,19 @@ class GateTetMeshReader
     // ELE (TetGen) is the only supported file type so far.
     std::vector<GateMeshTet> Read(const G4String& filePath);
 
+    // Reads the mesh into flat arrays (node coordinates, node indices and region
+    // marker of each tetrahedron), without creating any solid.
+    void Read(const G4String& filePath, std::vector<G4ThreeVector>& nodes,
+              std::vector<std::array<G4int, 4> >& tetrahedra, std::vector<G4int>& regionIDs);
+
     void SetUnitOfLength(G4double unitOfLength) { fUnitOfLength = unitOfLength; }
     G4double GetUnitOfLength() { return fUnitOfLength; }
 
   private:
     // implementation specifics
     std::vector<GateMeshTet> ReadELE(const G4String& filePath);
+    void ReadELE(const G4String& filePath, std::vector<G4ThreeVector>& nodes,
+                 std::vector<std::array<G4int, 4> >& tetrahedra, std::vector<G4int>& regionIDs);
     std::vector<G4ThreeVector> ReadNODE(const G4String& filePath);
     // possible extensions, e.g.:
     // std::vecor<GateMeshTet> ReadVTKLegacy(const G4String& filePath);
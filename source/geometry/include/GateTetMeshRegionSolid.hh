@@ -0,0 +1,58 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+#ifndef GATE_TET_MESH_REGION_SOLID_HH
+#define GATE_TET_MESH_REGION_SOLID_HH
+
+#include <G4Box.hh>
+#include <G4String.hh>
+#include <G4Types.hh>
+#include <G4ThreeVector.hh>
+
+#include "GateTetMesh.hh"
+
+
+// Solid made of all the tetrahedra of one region of a GateTetMesh, used by the 'mesh'
+// navigation of GateTetMeshBox: one volume per region instead of one per tetrahedron.
+// Inherits from G4Box, with the dimensions of the bounding box of the region (used by
+// Geant4 to voxelise the envelope), and forwards the navigation queries to the mesh.
+class GateTetMeshRegionSolid : public G4Box
+{
+  public:
+    GateTetMeshRegionSolid(const G4String& name, const GateTetMesh* mesh, G4int regionIndex);
+
+    G4int GetRegionIndex() const { return mRegionIndex; }
+    // conversion from the frame of the solid (center of the bounding box) to the mesh frame
+    G4ThreeVector ToMesh(const G4ThreeVector& p) const { return p + mCenter; }
+    const G4ThreeVector& GetCenter() const { return mCenter; }
+
+    EInside Inside(const G4ThreeVector& p) const override;
+    G4ThreeVector SurfaceNormal(const G4ThreeVector& p) const override;
+    G4double DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const override;
+    G4double DistanceToIn(const G4ThreeVector& p) const override;
+    G4double DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                           const G4bool calcNorm = false,
+                           G4bool* validNorm = nullptr, G4ThreeVector* n = nullptr) const override;
+    G4double DistanceToOut(const G4ThreeVector& p) const override;
+
+    G4double GetCubicVolume() override;
+    G4GeometryType GetEntityType() const override;
+    std::ostream& StreamInfo(std::ostream& os) const override;
+
+    // drawn as the surface of the region, not as its bounding box
+    void DescribeYourselfTo(G4VGraphicsScene& scene) const override;
+    G4Polyhedron* CreatePolyhedron() const override;
+
+  private:
+    const GateTetMesh* pMesh;
+    G4int mRegionIndex;
+    G4ThreeVector mCenter;
+    G4double mCubicVolume;
+};
+
+
+#endif  // GATE_TET_MESH_REGION_SOLID_HH
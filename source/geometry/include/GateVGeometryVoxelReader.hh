@@ -58,6 +58,10 @@ public:
 
   virtual void             ReadFile(G4String fileName) = 0;
   virtual void             ReadRTFile(G4String header_fileName, G4String fileName) = 0; /* PY Descourt 08/09/2009 */
+  //! Start reading the next frame in the background (readers without frame cache ignore it)
+  virtual void             PrefetchRTFile(G4String /*header_fileName*/, G4String /*fileName*/) {}
+  //! False when the last ReadRTFile did not change any voxel material
+  G4bool                   HasFrameChanged() const { return m_frameChanged; }
   virtual void             Describe(G4int level);
 
   virtual GateVGeometryVoxelTranslator*  GetVoxelTranslator() { return m_voxelTranslator; };
@@ -79,6 +83,8 @@ protected:
 
   G4String                       m_fileName;
 
+  G4bool                         m_frameChanged;
+
   GateMaterialDatabase          mMaterialDatabase;
 };
 
@@ -166,6 +166,10 @@ public:
   void SetMassImageFilename   (G4String filename) {mMassImageFilename = filename;}
   void EnableBoundingBoxOnly(bool b);
   void SetMaxOutOfRangeFraction(double f);
+  /// Merge the voxels of the loaded image by blocks to reach (about) this voxel size
+  void SetResampledVoxelSize(G4ThreeVector v) { mResampledVoxelSize = v; }
+  /// Value of a merged voxel: mean, max or label (majority)
+  void SetResamplingMode(G4String m) { mResamplingMode = m; }
 
 protected:
 
@@ -203,6 +207,9 @@ protected:
   bool mBuildDistanceTransfo;
   //-----------------------------------------------------------------------------
 
+  G4ThreeVector mResampledVoxelSize;
+  G4String mResamplingMode;
+
   bool mWriteHLabelImage;
   G4String mHLabelImageFilename;
   void DumpHLabelImage();
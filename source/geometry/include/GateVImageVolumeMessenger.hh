@@ -27,6 +27,7 @@ class G4UIcmdWithAString;
 class G4UIcmdWith3VectorAndUnit;
 class G4UIcmdWithABool;
 class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
 
 //-----------------------------------------------------------------------------
 /// \brief Messenger of GateVImageVolume
@@ -55,6 +56,10 @@ private:
   G4UIcmdWithAString        * pBuildMassImageCmd;
   G4UIcmdWithABool          * pDoNotBuildVoxelsCmd;
   G4UIcmdWithADouble        * pSetMaxOutOfRangeFractionCmd;
+  G4UIcmdWith3VectorAndUnit * pResampledVoxelSizeCmd;
+  G4UIcmdWithAString        * pResamplingModeCmd;
+  G4UIcmdWithAString        * pDICOMCacheDirectoryCmd;
+  G4UIcmdWithAnInteger      * pDICOMNumberOfThreadsCmd;
 };
 //-----------------------------------------------------------------------------
 
@@ -51,6 +51,7 @@ void GateGeometryVoxelInterfileReader::Describe(G4int level)
 void GateGeometryVoxelInterfileReader::ReadFile(G4String headerFileName)
 {
   m_fileName = headerFileName;
+  m_previousFrame.reset();
   ReadHeader(headerFileName);
 
   std::vector<DefaultPixelType> buffer;
@@ -130,11 +131,9 @@ void GateGeometryVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Str
   // override filename from header
   m_dataFileName = dataFileName;
 
-  std::vector<DefaultPixelType> buffer;
-
-  ReadData(m_dataFileName, buffer);
-
-  EmptyStore();
+  GateInterfileFrameCache::FramePointer frame =
+    GateInterfileFrameCache::GetInstance()->GetFrame(*this, m_dataFileName);
+  const std::vector<DefaultPixelType> & buffer = *frame;
 
   G4String materialName;
   G4int    imageValue;
@@ -148,6 +147,41 @@ void GateGeometryVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Str
   dy = m_pixelSize[1];
   dz = m_planeThickness;
 
+  // Successive frames of a motion usually differ in a small part of the volume:
+  // when the store still holds the previous frame, only the changed voxels are translated.
+  if (m_previousFrame && m_geometryVoxelMaterials &&
+      m_previousFrame->size() == buffer.size() &&
+      m_voxelNx == nx && m_voxelNy == ny && m_voxelNz == nz) {
+    const std::vector<DefaultPixelType> & previous = *m_previousFrame;
+    G4int nbOfChangedVoxels = 0;
+    for (size_t i=0; i<buffer.size(); i++) {
+      if (buffer[i] == previous[i]) continue;
+      nbOfChangedVoxels++;
+      imageValue = buffer[i];
+      materialName = m_voxelTranslator->TranslateToMaterial(imageValue);
+      if ( materialName != G4String("NULL") ) {
+        m_geometryVoxelMaterials[i] = mMaterialDatabase.GetMaterial(materialName);
+      } else {
+        m_geometryVoxelMaterials[i] = m_defaultMaterial;
+        G4cout << "GateGeometryVoxelInterfileReader::ReadFile: WARNING: voxel not added (material translation not found); value: "<< imageValue << Gateendl;
+      }
+    }
+    m_previousFrame = frame;
+    m_frameChanged = (nbOfChangedVoxels > 0);
+    G4cout << "GateGeometryVoxelInterfileReader::ReadRTFile: " << nbOfChangedVoxels
+           << " voxels changed since previous frame" << Gateendl;
+    if (m_frameChanged && m_compressor) {
+      m_compressor->Initialize();
+      Compress();
+    }
+    return;
+  }
+
+  m_previousFrame = frame;
+  m_frameChanged = true;
+
+  EmptyStore();
+
   G4cout << "nx ny nz: " << nx << " " << ny << " " << nz << Gateendl;
   G4cout << "dx dy dz: " << dx << " " << dy << " " << dz << Gateendl;
 
@@ -183,3 +217,13 @@ void GateGeometryVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Str
       G4cout << "-------------------------------------------------------------------\n";
   }
 }
+
+
+void GateGeometryVoxelInterfileReader::PrefetchRTFile(G4String headerFileName, G4String dataFileName)
+{
+  if ( IsFirstFrame == true ) {
+      ReadHeader(headerFileName);
+      IsFirstFrame = false;
+  }
+  GateInterfileFrameCache::GetInstance()->Prefetch(*this, dataFileName);
+}
@@ -24,6 +24,16 @@
 #include "GateImage.hh"
 #include "GatePhantomSD.hh"
 #include "GateDetectorConstruction.hh"
+#include "GateMiscFunctions.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <thread>
 
 //-----------------------------------------------------------------------------
 /// Constructor with :
@@ -42,6 +52,8 @@ GateImageRegionalizedVolume::GateImageRegionalizedVolume(const G4String& name,
   // Retrieves surface tolerance from G4GeometryTolerance instance
   kCarTolerance = G4GeometryTolerance::GetInstance()->GetSurfaceTolerance();
   mDistanceMapFilename = "none";
+  mDistanceMapCacheDirectory = "";
+  mDistanceMapNumberOfThreads = 0;
   pDistanceMap = 0;
   GateMessageDec("Volume",5,"GateImageRegionalizedVolume() - end\n");
 }
@@ -186,18 +198,8 @@ void GateImageRegionalizedVolume::LoadDistanceMap()
   GateMessageInc("Volume",3,"GateImageRegionalizedVolume::LoadDistanceMap("<<mDistanceMapFilename<<") - begin\n");
 
   if (mDistanceMapFilename == "none") {
-    GateError("ImageRegionalized Volume <" << GetObjectName()
-	      << "> : No distance map provided, the navigation could not be optimized."
-	      << Gateendl
-	      << "Please use /gate/" << GetObjectName() << "/geometry/buildAndDumpDistanceTransfo dmap.mhd"
-	      << Gateendl
-	      << "to generate the dmap and then, /gate/patient/geometry/distanceMap dmap.mhd to use it."
-	      << Gateendl);
-    pDistanceMap = new DistanceMapType;
-    pDistanceMap->SetResolutionAndHalfSize(GetImage()->GetResolution(), GetImage()->GetHalfSize());
-    pDistanceMap->Allocate();
-    pDistanceMap->Fill(0.0);
-    pDistanceMap->PrintInfo();
+    BuildDistanceMap();
+    GateMessageDec("Volume",3,"GateImageRegionalizedVolume::LoadDistanceMap("<<mDistanceMapFilename<<") - end\n");
     return;
   }
   if (pDistanceMap) delete pDistanceMap;
@@ -213,6 +215,199 @@ void GateImageRegionalizedVolume::LoadDistanceMap()
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+/// The map stores, for each voxel, a lower bound of the distance (mm)
+/// between any point of the voxel and the nearest interface between two
+/// labels (or the border of the image). It is the Euclidean distance
+/// between the voxel center and the nearest voxel touching an interface,
+/// minus the voxel diagonal.
+void GateImageRegionalizedVolume::BuildDistanceMap()
+{
+  ImageType * image = GetImage();
+  const int nx = (int)lrint(image->GetResolution().x());
+  const int ny = (int)lrint(image->GetResolution().y());
+  const int nz = (int)lrint(image->GetResolution().z());
+
+  if (pDistanceMap) delete pDistanceMap;
+  pDistanceMap = new DistanceMapType;
+  pDistanceMap->SetResolutionAndHalfSize(image->GetResolution(), image->GetHalfSize());
+  pDistanceMap->SetOrigin(image->GetOrigin());
+
+  // Cache : the map only depends on the labels and the voxel size
+  G4String cacheFilename = "";
+  if (mDistanceMapCacheDirectory != "none") {
+    std::string name = removeExtension(mImageFilename);
+    std::string dir = mDistanceMapCacheDirectory;
+    if (dir != "") {
+      size_t slash = name.find_last_of('/');
+      if (slash != std::string::npos) name = name.substr(slash+1);
+      name = dir + "/" + name;
+    }
+    cacheFilename = name + "-dmap-" + GetDistanceMapHash() + ".mhd";
+    std::ifstream is(cacheFilename.c_str());
+    if (is) {
+      is.close();
+      pDistanceMap->Read(cacheFilename);
+      if (pDistanceMap->HasSameResolutionThan(*image)) {
+        GateMessage("Geometry", 1, "Distance map of '" << GetObjectName()
+                    << "' read from the cache " << cacheFilename << Gateendl);
+        return;
+      }
+      GateWarning("The cached distance map " << cacheFilename
+                  << " does not have the size of the image, it is built again." << Gateendl);
+      pDistanceMap->SetResolutionAndHalfSize(image->GetResolution(), image->GetHalfSize());
+      pDistanceMap->SetOrigin(image->GetOrigin());
+    }
+  }
+
+  GateMessage("Geometry", 1, "Building the distance map of '" << GetObjectName()
+              << "' (" << nx << "x" << ny << "x" << nz << ")" << Gateendl);
+  pDistanceMap->Allocate();
+
+  // Voxels touching an interface (6-neighbourhood) or the border are the sources
+  const int lineSize = image->GetLineSize();
+  const int planeSize = image->GetPlaneSize();
+  const double infinity = std::numeric_limits<double>::infinity();
+  std::vector<double> sqDistance(image->GetNumberOfValues(), infinity);
+  for (int k = 0; k < nz; k++)
+    for (int j = 0; j < ny; j++)
+      for (int i = 0; i < nx; i++) {
+        int index = i + j*lineSize + k*planeSize;
+        if (i == 0 || j == 0 || k == 0 || i == nx-1 || j == ny-1 || k == nz-1) {
+          sqDistance[index] = 0;
+          continue;
+        }
+        const float l = image->GetValue(index);
+        if (image->GetValue(index-1) != l || image->GetValue(index+1) != l ||
+            image->GetValue(index-lineSize) != l || image->GetValue(index+lineSize) != l ||
+            image->GetValue(index-planeSize) != l || image->GetValue(index+planeSize) != l)
+          sqDistance[index] = 0;
+      }
+
+  // Separable transform : one pass per axis, the lines of a pass are
+  // independent and shared between the threads
+  unsigned int nbThreads = mDistanceMapNumberOfThreads;
+  if (nbThreads == 0) nbThreads = std::thread::hardware_concurrency();
+  if (nbThreads == 0) nbThreads = 1;
+  const int nbLines[3] = { ny*nz, nx*nz, nx*ny };
+  for (int axis = 0; axis < 3; axis++) {
+    unsigned int n = std::min(nbThreads, (unsigned int)nbLines[axis]);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < n; t++)
+      threads.emplace_back(&GateImageRegionalizedVolume::DistanceTransformLines, this,
+                           std::ref(sqDistance), axis,
+                           (int)(t*nbLines[axis]/n), (int)((t+1)*nbLines[axis]/n));
+    DistanceTransformLines(sqDistance, axis, 0, nbLines[axis]/n);
+    for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+  }
+
+  // Conservative distance from any point of the voxel
+  const double diagonal = image->GetVoxelSize().mag();
+  for (int index = 0; index < image->GetNumberOfValues(); index++)
+    pDistanceMap->GetValue(index) = (float)std::max(0.0, std::sqrt(sqDistance[index]) - diagonal);
+
+  if (cacheFilename != "") {
+    std::ofstream os(cacheFilename.c_str());
+    if (os) {
+      os.close();
+      pDistanceMap->Write(cacheFilename);
+      GateMessage("Geometry", 1, "Distance map of '" << GetObjectName()
+                  << "' cached in " << cacheFilename << Gateendl);
+    }
+    else GateWarning("Cannot write the distance map cache " << cacheFilename << Gateendl);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+/// FNV-1a hash of the resolution, the voxel size and the labels
+std::string GateImageRegionalizedVolume::GetDistanceMapHash() const
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  auto add = [&h](const void * data, size_t size) {
+    const unsigned char * c = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  };
+  // Changed whenever the content of the map changes
+  const int version = 1;
+  add(&version, sizeof(version));
+  const ImageType * image = GetImage();
+  for (int i = 0; i < 3; i++) {
+    double r = image->GetResolution()[i];
+    double s = image->GetVoxelSize()[i];
+    add(&r, sizeof(r));
+    add(&s, sizeof(s));
+  }
+  add(&(*image->begin()), image->GetNumberOfValues()*sizeof(*image->begin()));
+
+  std::ostringstream os;
+  os << std::hex << std::setw(16) << std::setfill('0') << h;
+  return os.str();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+/// 1D squared distance transform (lower envelope of parabolas, Felzenszwalb
+/// and Huttenlocher) of each line, in mm^2 to handle anisotropic voxels
+void GateImageRegionalizedVolume::DistanceTransformLines(std::vector<double> & sqDistance,
+                                                         int axis, int firstLine, int lastLine) const
+{
+  const ImageType * image = GetImage();
+  const int nx = (int)lrint(image->GetResolution().x());
+  const int lineSize = image->GetLineSize();
+  const int planeSize = image->GetPlaneSize();
+  const int n = (int)lrint(image->GetResolution()[axis]);
+  const double spacing = image->GetVoxelSize()[axis];
+  const int stride = (axis == 0 ? 1 : (axis == 1 ? lineSize : planeSize));
+  const double infinity = std::numeric_limits<double>::infinity();
+
+  std::vector<double> f(n);
+  std::vector<int> v(n);
+  std::vector<double> z(n+1);
+  for (int line = firstLine; line < lastLine; line++) {
+    int start;
+    if (axis == 0) start = line*lineSize;
+    else if (axis == 1) start = (line%nx) + (line/nx)*planeSize;
+    else start = line;
+
+    for (int q = 0; q < n; q++) f[q] = sqDistance[start + q*stride];
+
+    // Lower envelope of the parabolas of the finite values
+    int k = -1;
+    for (int q = 0; q < n; q++) {
+      if (f[q] == infinity) continue;
+      const double xq = q*spacing;
+      double s = -infinity;
+      while (k >= 0) {
+        const double xv = v[k]*spacing;
+        s = ((f[q] + xq*xq) - (f[v[k]] + xv*xv))/(2*(xq - xv));
+        if (s > z[k]) break;
+        k--;
+      }
+      k++;
+      v[k] = q;
+      z[k] = (k == 0 ? -infinity : s);
+      z[k+1] = infinity;
+    }
+    if (k < 0) continue;
+
+    int j = 0;
+    for (int q = 0; q < n; q++) {
+      const double xq = q*spacing;
+      while (z[j+1] < xq) j++;
+      const double d = xq - v[j]*spacing;
+      sqDistance[start + q*stride] = d*d + f[v[j]];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+
 //------------------------------------------------
 // Methods used by SubVolumeSolids
 //------------------------------------------------
@@ -520,8 +715,9 @@ G4double GateImageRegionalizedVolume::DistanceToIn(const G4ThreeVector& p, Label
     }
   }
 
-  // point is not on a side
+  // point is not on a side : the map gives a safe isotropic distance
   index = pDistanceMap->GetIndexFromPosition(p); // no side problem
+  if (index == -1) return 0.0;
   G4double d = pDistanceMap->GetValue(index);
   GateDebugMessage("Volume",6,"Is not on a side, index dmap = " << index << Gateendl);
   GateDebugMessage("Volume",6," DISTANCE TO IN (iso)  = " << d << Gateendl);
@@ -1288,7 +1484,9 @@ G4double GateImageRegionalizedVolume::ComputeSafety(const G4ThreeVector& p)
 		   << GetObjectName()
 		   << "]::ComputeSafety(" << p <<")\n");
 
+  // The map is a lower bound of the distance to the nearest interface
   int index = pDistanceMap->GetIndexFromPosition(p); // no side problem
+  if (index == -1) return 0.0;
   G4double d = pDistanceMap->GetValue(index);
 
   GateDebugMessage("Navigation",6," Safety = " << d << Gateendl);
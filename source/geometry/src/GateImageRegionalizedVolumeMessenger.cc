@@ -26,7 +26,17 @@ GateImageRegionalizedVolumeMessenger::GateImageRegionalizedVolumeMessenger(GateI
 
   G4String n = GetDirectoryName() +"geometry/distanceMap";
   pDistanceMapNameCmd = new G4UIcmdWithAString(n,this);
-  pDistanceMapNameCmd->SetGuidance("Sets the name of the distance map file");
+  pDistanceMapNameCmd->SetGuidance("Sets the name of the distance map file (built automatically if not given)");
+
+  n = GetDirectoryName() +"geometry/setDistanceMapCacheDirectory";
+  pDistanceMapCacheDirectoryCmd = new G4UIcmdWithAString(n,this);
+  pDistanceMapCacheDirectoryCmd->SetGuidance("Directory where the built distance maps are cached (default : next to the image, 'none' : no cache)");
+
+  n = GetDirectoryName() +"geometry/setDistanceMapNumberOfThreads";
+  pDistanceMapNumberOfThreadsCmd = new G4UIcmdWithAnInteger(n,this);
+  pDistanceMapNumberOfThreadsCmd->SetGuidance("Number of threads used to build the distance map (default 0 : one per core)");
+  pDistanceMapNumberOfThreadsCmd->SetParameterName("N", false);
+  pDistanceMapNumberOfThreadsCmd->SetRange("N>=0");
 }
 //====================================================================
 
@@ -36,6 +46,8 @@ GateImageRegionalizedVolumeMessenger::~GateImageRegionalizedVolumeMessenger()
 {
   GateMessage("Volume",5,"~GateImageRegionalizedVolumeMessenger()\n");
   delete  pDistanceMapNameCmd;
+  delete  pDistanceMapCacheDirectoryCmd;
+  delete  pDistanceMapNumberOfThreadsCmd;
 }
 //====================================================================
 
@@ -51,6 +63,12 @@ void GateImageRegionalizedVolumeMessenger::SetNewValue(G4UIcommand* command,
   if (command == pDistanceMapNameCmd) {
     pVolume->SetDistanceMapFilename(newValue);
   }
+  else if (command == pDistanceMapCacheDirectoryCmd) {
+    pVolume->SetDistanceMapCacheDirectory(newValue);
+  }
+  else if (command == pDistanceMapNumberOfThreadsCmd) {
+    pVolume->SetDistanceMapNumberOfThreads(pDistanceMapNumberOfThreadsCmd->GetNewIntValue(newValue));
+  }
   else {
     GateVImageVolumeMessenger::SetNewValue(command,newValue);
   }
@@ -0,0 +1,677 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+
+#include <G4GeometryTolerance.hh>
+
+#include "GateMessageManager.hh"
+
+#include "GateTetMesh.hh"
+
+
+namespace
+{
+  // Does the ray p + t v, t in [tMin, tMax], cross the box (enlarged by tol)?
+  G4bool RayCrossesBox(const G4ThreeVector& p, const G4ThreeVector& v,
+                       const G4ThreeVector& min, const G4ThreeVector& max,
+                       G4double tMin, G4double tMax, G4double tol)
+  {
+    G4double tNear = tMin;
+    G4double tFar = tMax;
+    for (G4int i = 0; i < 3; ++i)
+    {
+      if (v[i] == 0)
+      {
+        if (p[i] < min[i] - tol || p[i] > max[i] + tol)
+          return false;
+        continue;
+      }
+      G4double t1 = (min[i] - tol - p[i]) / v[i];
+      G4double t2 = (max[i] + tol - p[i]) / v[i];
+      if (t1 > t2)
+        std::swap(t1, t2);
+      tNear = std::max(tNear, t1);
+      tFar = std::min(tFar, t2);
+      if (tNear > tFar)
+        return false;
+    }
+    return true;
+  }
+
+  G4double DistanceToBox(const G4ThreeVector& p, const G4ThreeVector& min, const G4ThreeVector& max)
+  {
+    G4ThreeVector d;
+    for (G4int i = 0; i < 3; ++i)
+      d[i] = std::max(std::max(min[i] - p[i], p[i] - max[i]), 0.0);
+    return d.mag();
+  }
+
+  struct GateTetMeshFace
+  {
+    std::array<G4int, 3> nodes;
+    G4int tetFace;  // 4 * tet + face
+  };
+}
+
+//----------------------------------------------------------------------------------------
+
+GateTetMesh::GateTetMesh(std::vector<G4ThreeVector>&& nodes,
+                         std::vector<Tet>&& tets,
+                         const std::vector<G4int>& regionIDs)
+  : mNodes(std::move(nodes)), mTets(std::move(tets)), mNeighbours(), mTetRegions(),
+    mRegionIDs(), mBVHNodes(), mBVHTets(), mMin(), mMax(), mRegionMin(), mRegionMax(),
+    mHalfTolerance(0.5 * G4GeometryTolerance::GetInstance()->GetSurfaceTolerance()),
+    mLastPoint(), mLastTet(-2), mHint(-1),
+    mRayPoint(), mRayDirection(), mRayTet(-1), mRayDistance(0), mRayEntries(), mRayRegions()
+{
+  if (mTets.empty())
+    GateError("The tetrahedral mesh is empty.");
+
+  // dense region indices, in increasing order of region markers
+  std::map<G4int, G4int> regionIndices;
+  for (G4int regionID : regionIDs)
+    regionIndices[regionID] = 0;
+  for (auto& pair : regionIndices)
+  {
+    pair.second = mRegionIDs.size();
+    mRegionIDs.push_back(pair.first);
+  }
+  mTetRegions.reserve(mTets.size());
+  for (G4int regionID : regionIDs)
+    mTetRegions.push_back(regionIndices[regionID]);
+
+  // extent of the mesh and of each region
+  mMin = mMax = mNodes[mTets[0][0]];
+  mRegionMin.assign(mRegionIDs.size(), G4ThreeVector(kInfinity, kInfinity, kInfinity));
+  mRegionMax.assign(mRegionIDs.size(), G4ThreeVector(-kInfinity, -kInfinity, -kInfinity));
+  for (std::size_t t = 0; t < mTets.size(); ++t)
+    for (G4int node : mTets[t])
+      for (G4int i = 0; i < 3; ++i)
+      {
+        const G4double x = mNodes[node][i];
+        mMin[i] = std::min(mMin[i], x);
+        mMax[i] = std::max(mMax[i], x);
+        mRegionMin[mTetRegions[t]][i] = std::min(mRegionMin[mTetRegions[t]][i], x);
+        mRegionMax[mTetRegions[t]][i] = std::max(mRegionMax[mTetRegions[t]][i], x);
+      }
+
+  mRayEntries.assign(mRegionIDs.size(), -1.0);
+
+  BuildAdjacency();
+  BuildBVH();
+
+  GateMessage("Geometry", 2, "Tetrahedral mesh: " << mTets.size() << " tetrahedra, "
+              << mNodes.size() << " nodes, " << mRegionIDs.size() << " regions, "
+              << mBVHNodes.size() << " BVH nodes." << Gateendl);
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMesh::BuildAdjacency()
+{
+  // Sorting the faces by their (sorted) nodes brings the two tets sharing a face together.
+  std::vector<GateTetMeshFace> faces(4 * mTets.size());
+  for (std::size_t i = 0; i < mTets.size(); ++i)
+    for (G4int f = 0; f < 4; ++f)
+    {
+      GateTetMeshFace& face = faces[4 * i + f];
+      face.nodes = {{mTets[i][(f + 1) % 4], mTets[i][(f + 2) % 4], mTets[i][(f + 3) % 4]}};
+      std::sort(face.nodes.begin(), face.nodes.end());
+      face.tetFace = 4 * i + f;
+    }
+  std::sort(faces.begin(), faces.end(),
+            [](const GateTetMeshFace& a, const GateTetMeshFace& b) { return a.nodes < b.nodes; });
+
+  mNeighbours.assign(mTets.size(), Tet{{-1, -1, -1, -1}});
+  std::size_t nBoundaryFaces = 0;
+  for (std::size_t i = 0; i < faces.size(); )
+  {
+    if (i + 1 < faces.size() && faces[i].nodes == faces[i + 1].nodes)
+    {
+      G4int a = faces[i].tetFace;
+      G4int b = faces[i + 1].tetFace;
+      mNeighbours[a / 4][a % 4] = b / 4;
+      mNeighbours[b / 4][b % 4] = a / 4;
+      i += 2;
+    }
+    else
+    {
+      ++nBoundaryFaces;
+      ++i;
+    }
+  }
+  GateMessage("Geometry", 3, "Tetrahedral mesh: " << nBoundaryFaces << " boundary faces." << Gateendl);
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMesh::BuildBVH()
+{
+  std::vector<G4ThreeVector> centroids(mTets.size());
+  std::vector<std::pair<G4ThreeVector, G4ThreeVector> > boxes(mTets.size());
+  for (std::size_t i = 0; i < mTets.size(); ++i)
+  {
+    G4ThreeVector min = mNodes[mTets[i][0]];
+    G4ThreeVector max = min;
+    G4ThreeVector sum;
+    for (G4int node : mTets[i])
+    {
+      const G4ThreeVector& x = mNodes[node];
+      sum += x;
+      for (G4int k = 0; k < 3; ++k)
+      {
+        min[k] = std::min(min[k], x[k]);
+        max[k] = std::max(max[k], x[k]);
+      }
+    }
+    centroids[i] = 0.25 * sum;
+    boxes[i] = std::make_pair(min, max);
+  }
+
+  mBVHTets.resize(mTets.size());
+  std::iota(mBVHTets.begin(), mBVHTets.end(), 0);
+  mBVHNodes.clear();
+  mBVHNodes.reserve(mTets.size());  // leaves hold at least 2 tets
+  BuildBVHNode(mBVHTets.begin(), mBVHTets.end(), centroids, boxes);
+  mBVHNodes.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------
+
+G4int GateTetMesh::BuildBVHNode(std::vector<G4int>::iterator begin, std::vector<G4int>::iterator end,
+                                const std::vector<G4ThreeVector>& centroids,
+                                const std::vector<std::pair<G4ThreeVector, G4ThreeVector> >& boxes)
+{
+  static const G4int maxTetsPerLeaf = 4;
+
+  G4int index = mBVHNodes.size();
+  mBVHNodes.push_back(BVHNode());
+
+  BVHNode node;
+  node.min = boxes[*begin].first;
+  node.max = boxes[*begin].second;
+  G4ThreeVector cmin = centroids[*begin];
+  G4ThreeVector cmax = cmin;
+  for (auto it = begin; it != end; ++it)
+    for (G4int k = 0; k < 3; ++k)
+    {
+      node.min[k] = std::min(node.min[k], boxes[*it].first[k]);
+      node.max[k] = std::max(node.max[k], boxes[*it].second[k]);
+      cmin[k] = std::min(cmin[k], centroids[*it][k]);
+      cmax[k] = std::max(cmax[k], centroids[*it][k]);
+    }
+
+  G4int count = end - begin;
+  if (count <= maxTetsPerLeaf)
+  {
+    node.first = begin - mBVHTets.begin();
+    node.count = count;
+    mBVHNodes[index] = node;
+    return index;
+  }
+
+  // median split along the largest extent of the centroids
+  G4ThreeVector extent = cmax - cmin;
+  G4int axis = 0;
+  if (extent.y() > extent[axis]) axis = 1;
+  if (extent.z() > extent[axis]) axis = 2;
+  auto middle = begin + count / 2;
+  std::nth_element(begin, middle, end,
+                   [&centroids, axis](G4int a, G4int b) { return centroids[a][axis] < centroids[b][axis]; });
+
+  BuildBVHNode(begin, middle, centroids, boxes);  // at index + 1
+  node.first = BuildBVHNode(middle, end, centroids, boxes);
+  node.count = 0;
+  mBVHNodes[index] = node;
+  return index;
+}
+
+//----------------------------------------------------------------------------------------
+
+G4double GateTetMesh::GetTetVolume(std::size_t tetIndex) const
+{
+  const Tet& tet = mTets[tetIndex];
+  const G4ThreeVector& a = mNodes[tet[0]];
+  return std::abs((mNodes[tet[1]] - a).dot((mNodes[tet[2]] - a).cross(mNodes[tet[3]] - a))) / 6.0;
+}
+
+G4double GateTetMesh::GetRegionVolume(G4int regionIndex) const
+{
+  G4double volume = 0;
+  for (std::size_t i = 0; i < mTets.size(); ++i)
+    if (mTetRegions[i] == regionIndex)
+      volume += GetTetVolume(i);
+  return volume;
+}
+
+void GateTetMesh::GetRegionExtent(G4int regionIndex, G4ThreeVector& min, G4ThreeVector& max) const
+{
+  min = mRegionMin[regionIndex];
+  max = mRegionMax[regionIndex];
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMesh::GetFacePlane(G4int tet, G4int f, G4ThreeVector& normal, G4ThreeVector& point) const
+{
+  const Tet& t = mTets[tet];
+  point = mNodes[t[(f + 1) % 4]];
+  normal = (mNodes[t[(f + 2) % 4]] - point).cross(mNodes[t[(f + 3) % 4]] - point);
+  if (normal.dot(mNodes[t[f]] - point) > 0)
+    normal = -normal;
+  normal = normal.unit();
+}
+
+G4double GateTetMesh::GetFaceDistances(G4int tet, const G4ThreeVector& p, G4double* distances) const
+{
+  G4double max = -kInfinity;
+  G4ThreeVector normal, point;
+  for (G4int f = 0; f < 4; ++f)
+  {
+    GetFacePlane(tet, f, normal, point);
+    distances[f] = normal.dot(p - point);
+    max = std::max(max, distances[f]);
+  }
+  return max;
+}
+
+//----------------------------------------------------------------------------------------
+
+// Visibility walk: move across the face p is the most outside of.
+G4int GateTetMesh::Walk(const G4ThreeVector& p, G4int start) const
+{
+  static const G4int maxSteps = 256;
+
+  G4int tet = start;
+  G4double distances[4];
+  for (G4int step = 0; step < maxSteps; ++step)
+  {
+    if (GetFaceDistances(tet, p, distances) <= mHalfTolerance)
+      return tet;
+    G4int f = std::max_element(distances, distances + 4) - distances;
+    tet = mNeighbours[tet][f];
+    if (tet < 0)
+      return -1;
+  }
+  return -1;
+}
+
+G4int GateTetMesh::LocateWithBVH(const G4ThreeVector& p) const
+{
+  G4int stack[64];
+  G4int size = 0;
+  stack[size++] = 0;
+  G4double distances[4];
+  while (size > 0)
+  {
+    G4int index = stack[--size];
+    const BVHNode& node = mBVHNodes[index];
+    if (DistanceToBox(p, node.min, node.max) > mHalfTolerance)
+      continue;
+    if (node.count > 0)
+    {
+      for (G4int i = node.first; i < node.first + node.count; ++i)
+        if (GetFaceDistances(mBVHTets[i], p, distances) <= mHalfTolerance)
+          return mBVHTets[i];
+    }
+    else
+    {
+      stack[size++] = index + 1;
+      stack[size++] = node.first;
+    }
+  }
+  return -1;
+}
+
+G4int GateTetMesh::LocateTet(const G4ThreeVector& p) const
+{
+  // The region solids convert their local points back to the mesh frame, so the same
+  // point may differ by rounding errors from one solid to the other.
+  if (mLastTet != -2 && (p - mLastPoint).mag2() <= mHalfTolerance * mHalfTolerance)
+    return mLastTet;
+
+  // Successive points usually are close to each other: walk from the last tet found,
+  // and only search the BVH if the walk leaves the mesh (concave boundary).
+  G4int tet = -1;
+  if (mHint >= 0)
+    tet = Walk(p, mHint);
+  if (tet < 0)
+    tet = LocateWithBVH(p);
+  if (tet >= 0)
+    mHint = tet;
+
+  mLastPoint = p;
+  mLastTet = tet;
+  return tet;
+}
+
+// p may be on a face shared by a tet of the region and a tet of another region:
+// return the former.
+G4int GateTetMesh::LocateInRegion(const G4ThreeVector& p, G4int regionIndex) const
+{
+  G4int tet = LocateTet(p);
+  if (tet < 0 || mTetRegions[tet] == regionIndex)
+    return tet;
+
+  G4double distances[4];
+  GetFaceDistances(tet, p, distances);
+  for (G4int f = 0; f < 4; ++f)
+  {
+    G4int neighbour = mNeighbours[tet][f];
+    if (distances[f] > -mHalfTolerance && neighbour >= 0 && mTetRegions[neighbour] == regionIndex)
+      return neighbour;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------------------
+
+G4double GateTetMesh::ExitTet(G4int tet, const G4ThreeVector& p, const G4ThreeVector& v,
+                              G4double tIn, G4int& face) const
+{
+  G4double tOut = kInfinity;
+  face = -1;
+  G4ThreeVector normal, point;
+  for (G4int f = 0; f < 4; ++f)
+  {
+    GetFacePlane(tet, f, normal, point);
+    G4double dn = normal.dot(v);
+    if (dn <= 0)
+      continue;
+    G4double t = normal.dot(point - p) / dn;
+    if (t < tOut)
+    {
+      tOut = t;
+      face = f;
+    }
+  }
+  return std::max(tOut, tIn);
+}
+
+G4int GateTetMesh::EnterMesh(const G4ThreeVector& p, const G4ThreeVector& v, G4double tMin,
+                             G4double& tEnter) const
+{
+  G4int best = -1;
+  tEnter = kInfinity;
+
+  G4int stack[64];
+  G4int size = 0;
+  stack[size++] = 0;
+  G4ThreeVector normal, point;
+  while (size > 0)
+  {
+    G4int index = stack[--size];
+    const BVHNode& node = mBVHNodes[index];
+    if (!RayCrossesBox(p, v, node.min, node.max, tMin, tEnter, mHalfTolerance))
+      continue;
+    if (node.count == 0)
+    {
+      stack[size++] = index + 1;
+      stack[size++] = node.first;
+      continue;
+    }
+    for (G4int i = node.first; i < node.first + node.count; ++i)
+    {
+      // the tet is the intersection of the inner half-spaces of its faces
+      G4int tet = mBVHTets[i];
+      G4double tNear = -kInfinity;
+      G4double tFar = kInfinity;
+      for (G4int f = 0; f < 4 && tNear <= tFar; ++f)
+      {
+        GetFacePlane(tet, f, normal, point);
+        G4double dn = normal.dot(v);
+        G4double distance = normal.dot(p - point);
+        if (dn < 0)
+          tNear = std::max(tNear, -distance / dn);
+        else if (dn > 0)
+          tFar = std::min(tFar, -distance / dn);
+        else if (distance > mHalfTolerance)
+          tFar = -kInfinity;
+      }
+      if (tNear > tFar || tFar <= tMin + mHalfTolerance)
+        continue;
+      G4double t = std::max(tNear, tMin);
+      if (t < tEnter)
+      {
+        tEnter = t;
+        best = tet;
+      }
+    }
+  }
+  return best;
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMesh::GetSegmentTets(const G4ThreeVector& a, const G4ThreeVector& b,
+                                 std::vector<std::pair<G4int, G4double> >& tets) const
+{
+  tets.clear();
+  G4double length = (b - a).mag();
+  G4int tet = LocateTet(a);
+  if (length <= mHalfTolerance)
+  {
+    if (tet >= 0)
+      tets.push_back(std::make_pair(tet, 1.0));
+    return;
+  }
+  if (tet < 0)
+    tet = LocateTet(0.5 * (a + b));
+  if (tet < 0)
+    return;
+
+  G4ThreeVector v = (b - a) / length;
+  G4double t = 0;
+  G4double total = 0;
+  for (std::size_t step = 0; tet >= 0 && t < length && step < mTets.size(); ++step)
+  {
+    G4int face;
+    G4double tOut = std::min(ExitTet(tet, a, v, t, face), length);
+    if (tOut > t)
+    {
+      tets.push_back(std::make_pair(tet, tOut - t));
+      total += tOut - t;
+    }
+    t = tOut;
+    tet = face < 0 ? -1 : mNeighbours[tet][face];
+  }
+
+  // the part of the segment outside of the mesh (within tolerance) is shared out
+  if (total > 0)
+    for (auto& pair : tets)
+      pair.second /= total;
+}
+
+//----------------------------------------------------------------------------------------
+
+EInside GateTetMesh::Inside(const G4ThreeVector& p, G4int regionIndex) const
+{
+  G4int tet = LocateTet(p);
+  if (tet < 0)
+    return kOutside;
+
+  G4bool inRegion = (mTetRegions[tet] == regionIndex);
+  G4double distances[4];
+  GetFaceDistances(tet, p, distances);
+  for (G4int f = 0; f < 4; ++f)
+  {
+    if (distances[f] <= -mHalfTolerance)
+      continue;
+    G4int neighbour = mNeighbours[tet][f];
+    G4bool neighbourInRegion = (neighbour >= 0 && mTetRegions[neighbour] == regionIndex);
+    if (inRegion != neighbourInRegion)
+      return kSurface;
+  }
+  return inRegion ? kInside : kOutside;
+}
+
+G4ThreeVector GateTetMesh::SurfaceNormal(const G4ThreeVector& p, G4int regionIndex) const
+{
+  G4int tet = LocateInRegion(p, regionIndex);
+  if (tet < 0)
+    tet = LocateTet(p);
+  if (tet < 0)
+    return G4ThreeVector(0, 0, 1);
+
+  G4double distances[4];
+  GetFaceDistances(tet, p, distances);
+  G4int f = std::max_element(distances, distances + 4) - distances;
+  G4ThreeVector normal, point;
+  GetFacePlane(tet, f, normal, point);
+  return mTetRegions[tet] == regionIndex ? normal : -normal;
+}
+
+//----------------------------------------------------------------------------------------
+
+G4double GateTetMesh::DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v, G4int regionIndex) const
+{
+  // Geant4 asks every candidate region for the same ray: the ray is traced once,
+  // as far as needed, and the first entry in each region is remembered.
+  if ((p - mRayPoint).mag2() > mHalfTolerance * mHalfTolerance || v != mRayDirection)
+  {
+    mRayPoint = p;
+    mRayDirection = v;
+    for (G4int region : mRayRegions)
+      mRayEntries[region] = -1.0;
+    mRayRegions.clear();
+
+    mRayDistance = 0;
+    mRayTet = LocateTet(p);
+    if (mRayTet < 0)
+      mRayTet = EnterMesh(p, v, 0, mRayDistance);
+    if (mRayTet >= 0)
+    {
+      mRayEntries[mTetRegions[mRayTet]] = mRayDistance;
+      mRayRegions.push_back(mTetRegions[mRayTet]);
+    }
+  }
+
+  std::size_t step = 0;
+  while (mRayEntries[regionIndex] < 0 && mRayTet >= 0)
+  {
+    G4int face;
+    G4double tOut = ExitTet(mRayTet, p, v, mRayDistance, face);
+    G4int next = face < 0 ? -1 : mNeighbours[mRayTet][face];
+    if (face >= 0 && next < 0)
+      next = EnterMesh(p, v, tOut, tOut);
+    mRayTet = next;
+    mRayDistance = tOut;
+    if (next >= 0 && mRayEntries[mTetRegions[next]] < 0)
+    {
+      mRayEntries[mTetRegions[next]] = tOut;
+      mRayRegions.push_back(mTetRegions[next]);
+    }
+    if (++step > mTets.size())
+      mRayTet = -1;
+  }
+
+  G4double distance = mRayEntries[regionIndex];
+  if (distance < 0)
+    return kInfinity;
+  return distance < mHalfTolerance ? 0.0 : distance;
+}
+
+G4double GateTetMesh::DistanceToIn(const G4ThreeVector& p, G4int regionIndex) const
+{
+  // lower bounds: distance to the bounding box of the region, and to the
+  // boundary of the tet containing p (which is not part of the region)
+  G4double safety = DistanceToBox(p, mRegionMin[regionIndex], mRegionMax[regionIndex]);
+
+  G4int tet = LocateTet(p);
+  if (tet < 0)
+    return safety;
+  if (mTetRegions[tet] == regionIndex)
+    return 0;
+  G4double distances[4];
+  return std::max(safety, -GetFaceDistances(tet, p, distances));
+}
+
+G4double GateTetMesh::DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v, G4int regionIndex,
+                                    G4ThreeVector* n) const
+{
+  G4int tet = LocateInRegion(p, regionIndex);
+  if (tet < 0)
+  {
+    if (n)
+      *n = v;
+    return 0;
+  }
+
+  // follow the ray as long as it stays in the region
+  G4double t = 0;
+  for (std::size_t step = 0; step <= mTets.size(); ++step)
+  {
+    G4int face;
+    t = ExitTet(tet, p, v, t, face);
+    if (face < 0)
+      break;
+    G4int next = mNeighbours[tet][face];
+    if (next < 0 || mTetRegions[next] != regionIndex)
+    {
+      if (n)
+      {
+        G4ThreeVector point;
+        GetFacePlane(tet, face, *n, point);
+      }
+      return t < mHalfTolerance ? 0.0 : t;
+    }
+    tet = next;
+  }
+  if (n)
+    *n = v;
+  return t;
+}
+
+G4double GateTetMesh::DistanceToOut(const G4ThreeVector& p, G4int regionIndex) const
+{
+  G4int tet = LocateInRegion(p, regionIndex);
+  if (tet < 0)
+    return 0;
+  G4double distances[4];
+  return std::max(0.0, -GetFaceDistances(tet, p, distances));
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMesh::GetRegionSurface(G4int regionIndex, std::vector<G4ThreeVector>& vertices,
+                                   std::vector<std::array<G4int, 3> >& triangles) const
+{
+  vertices.clear();
+  triangles.clear();
+  std::unordered_map<G4int, G4int> vertexIndices;
+  auto vertexIndex = [&](G4int node)
+  {
+    auto inserted = vertexIndices.insert(std::make_pair(node, G4int(vertices.size())));
+    if (inserted.second)
+      vertices.push_back(mNodes[node]);
+    return inserted.first->second;
+  };
+
+  G4ThreeVector normal, point;
+  for (std::size_t i = 0; i < mTets.size(); ++i)
+  {
+    if (mTetRegions[i] != regionIndex)
+      continue;
+    for (G4int f = 0; f < 4; ++f)
+    {
+      G4int neighbour = mNeighbours[i][f];
+      if (neighbour >= 0 && mTetRegions[neighbour] == regionIndex)
+        continue;
+      const Tet& tet = mTets[i];
+      G4int a = tet[(f + 1) % 4], b = tet[(f + 2) % 4], c = tet[(f + 3) % 4];
+      GetFacePlane(i, f, normal, point);
+      if ((mNodes[b] - mNodes[a]).cross(mNodes[c] - mNodes[a]).dot(normal) < 0)
+        std::swap(b, c);
+      triangles.push_back({{vertexIndex(a), vertexIndex(b), vertexIndex(c)}});
+    }
+  }
+}
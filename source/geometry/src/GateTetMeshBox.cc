@@ -24,6 +24,7 @@
 #include <G4VSolid.hh>
 #include <G4Colour.hh>
 #include <G4VisAttributes.hh>
+#include <G4PVPlacement.hh>
 
 #include "GateVVolume.hh"
 #include "GateTools.hh"
@@ -32,6 +33,8 @@
 #include "GateDetectorConstruction.hh"  // <-- contains "theMaterialDatabase"
 #include "GateMultiSensitiveDetector.hh"
 #include "GateTetMeshBoxMessenger.hh"
+#include "GateTetMesh.hh"
+#include "GateTetMeshRegionSolid.hh"
 
 #include "GateTetMeshBox.hh"
 
@@ -42,11 +45,11 @@ GateTetMeshBox::GateTetMeshBox(const G4String& itsName,
                                G4bool acceptsChildren,
                                G4int depth)
 : GateVVolume(itsName, false, depth),
-  mPath(""), mUnitOfLength(mm), mAttributeMapPath(""), mAttributeMap(),
+  mPath(""), mUnitOfLength(mm), mUseMeshNavigation(false), mAttributeMapPath(""), mAttributeMap(),
   pMessenger(new GateTetMeshBoxMessenger(this)),
   pEnvelopeSolid(nullptr), pEnvelopeLogical(nullptr), mRegionIDs(),
   mXmin(), mXmax(), mYmin(), mYmax(), mZmin(), mZmax(),
-  pTetAssembly(), mPhysVolCopyNumOffset()
+  pTetAssembly(), mPhysVolCopyNumOffset(), pMesh(), mRegionLogicals(), mRegionPhysicals()
 {
   // for now, don't accept children, to avoid overlaps with the tetrahedra
   if (acceptsChildren == true)
@@ -71,6 +74,13 @@ G4LogicalVolume* GateTetMeshBox::ConstructOwnSolidAndLogicalVolume(G4Material* m
   
   // upon construction or rebuild: read region attributes from file
   ReadAttributeMap();
+
+  if (mUseMeshNavigation)
+    {
+      ConstructMeshRegions(material);
+      GateMessage("Geometry", 1, "... done building tetrahedral mesh." << Gateendl);
+      return pEnvelopeLogical;
+    }
   
   //-----------------------------------------------------
   // MESH CONSTRUCTION
@@ -84,21 +94,11 @@ G4LogicalVolume* GateTetMeshBox::ConstructOwnSolidAndLogicalVolume(G4Material* m
 
   for (const auto& tet : tetrahedra)
     {
-      G4Material* material = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
-      G4Colour colour = G4Colour::White();
-      G4bool isVisible = true;
-    
       // find attributes and set colour and material accordingly
-      if (mAttributeMap.find(tet.regionID) != mAttributeMap.end())
-        {
-          material = mAttributeMap[tet.regionID].material;
-          colour = mAttributeMap[tet.regionID].colour;
-          isVisible = mAttributeMap[tet.regionID].isVisible;
-        }
-      else
-        {
-          GateWarning("Unknown region '" << tet.regionID << "', setting material to 'G4_AIR'.");
-        }
+      const GateMeshTetAttributes attributes = GetAttributes(tet.regionID);
+      G4Material* material = attributes.material;
+      G4Colour colour = attributes.colour;
+      G4bool isVisible = attributes.isVisible;
 
       // create corresponding logical volume
       G4String logicalName = tet.solid->GetName() + "_logical"; 
@@ -179,6 +179,18 @@ G4LogicalVolume* GateTetMeshBox::ConstructOwnSolidAndLogicalVolume(G4Material* m
 
 void GateTetMeshBox::DestroyOwnSolidAndLogicalVolume()
 {  
+  // 'mesh' navigation: region volumes and the mesh itself
+  for (std::size_t i = 0; i < mRegionPhysicals.size(); ++i)
+    {
+      G4VSolid* regionSolid = mRegionLogicals[i]->GetSolid();
+      delete mRegionPhysicals[i];
+      delete mRegionLogicals[i];
+      delete regionSolid;
+    }
+  mRegionPhysicals.clear();
+  mRegionLogicals.clear();
+  pMesh.reset(nullptr);
+
   // delete subtree
   if (pTetAssembly)
     {
@@ -213,6 +225,74 @@ void GateTetMeshBox::DestroyOwnSolidAndLogicalVolume()
 
 //----------------------------------------------------------------------------------------
 
+void GateTetMeshBox::ConstructMeshRegions(G4Material* material)
+{
+  // read the mesh into flat arrays, no solid per tetrahedron
+  GateTetMeshReader fileReader(mUnitOfLength);
+  std::vector<G4ThreeVector> nodes;
+  std::vector<GateTetMesh::Tet> tetrahedra;
+  std::vector<G4int> regionIDs;
+  fileReader.Read(mPath, nodes, tetrahedra, regionIDs);
+  pMesh.reset(new GateTetMesh(std::move(nodes), std::move(tetrahedra), regionIDs));
+
+  G4ThreeVector min, max;
+  pMesh->GetExtent(min, max);
+  mXmin = min.x(); mXmax = max.x();
+  mYmin = min.y(); mYmax = max.y();
+  mZmin = min.z(); mZmax = max.z();
+
+  pEnvelopeSolid = new G4Box(GateVVolume::GetSolidName(),
+                             0.5 * (mXmax - mXmin), 0.5 * (mYmax - mYmin), 0.5 * (mZmax - mZmin));
+  pEnvelopeLogical = new G4LogicalVolume(pEnvelopeSolid, material,
+                                         GateVVolume::GetLogicalVolumeName());
+
+  // one volume per region, placed at the center of the region's bounding box
+  // (relative to the center of the mesh)
+  G4ThreeVector meshCenter = 0.5 * (min + max);
+  for (std::size_t r = 0; r < pMesh->GetNumberOfRegions(); ++r)
+    {
+      G4int regionID = pMesh->GetRegionID(r);
+      const GateMeshTetAttributes attributes = GetAttributes(regionID);
+
+      G4String regionName = GateVVolume::GetObjectName() + "_region" + std::to_string(regionID);
+      GateTetMeshRegionSolid* regionSolid = new GateTetMeshRegionSolid(regionName, pMesh.get(), r);
+      G4LogicalVolume* regionLogical = new G4LogicalVolume(regionSolid, attributes.material,
+                                                           regionName + "_logical");
+      if (attributes.isVisible)
+        {
+          regionLogical->SetVisAttributes(attributes.colour);
+        }
+      else
+        {
+          regionLogical->SetVisAttributes(G4VisAttributes::GetInvisible());
+        }
+
+      G4VPhysicalVolume* regionPhysical =
+        new G4PVPlacement(nullptr, regionSolid->GetCenter() - meshCenter, regionLogical,
+                          regionName + "_phys", pEnvelopeLogical, false, r);
+      mRegionLogicals.push_back(regionLogical);
+      mRegionPhysicals.push_back(regionPhysical);
+    }
+}
+
+//----------------------------------------------------------------------------------------
+
+G4double GateTetMeshBox::GetTetVolume(std::size_t tetIndex) const
+{
+  if (pMesh)
+    return pMesh->GetTetVolume(tetIndex);
+  return GetTetLogical(tetIndex)->GetSolid()->GetCubicVolume();
+}
+
+const G4Material* GateTetMeshBox::GetTetMaterial(std::size_t tetIndex) const
+{
+  if (pMesh)
+    return mRegionLogicals[pMesh->GetTetRegionIndex(tetIndex)]->GetMaterial();
+  return GetTetLogical(tetIndex)->GetMaterial();
+}
+
+//----------------------------------------------------------------------------------------
+
 G4double GateTetMeshBox::GetHalfDimension(size_t axis)
 {
   if (pEnvelopeSolid)
@@ -336,3 +416,16 @@ void GateTetMeshBox::ReadAttributeMap()
     }
   GateMessage("Geometry", 3, Gateendl);  
 }
+
+GateMeshTetAttributes GateTetMeshBox::GetAttributes(G4int regionID)
+{
+  if (mAttributeMap.find(regionID) != mAttributeMap.end())
+    return mAttributeMap[regionID];
+
+  GateWarning("Unknown region '" << regionID << "', setting material to 'G4_AIR'.");
+  GateMeshTetAttributes attributes;
+  attributes.material = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+  attributes.colour = G4Colour::White();
+  attributes.isVisible = true;
+  return attributes;
+}
@@ -25,6 +25,7 @@ GateTetMeshBoxMessenger::GateTetMeshBoxMessenger(GateTetMeshBox* itsCreator)
   G4String pathCmdName = dir + "reader/setPathToELEFile";
   G4String regionAttributeMapCmdName = dir + "setPathToAttributeMap";
   G4String unitOfLengthCmdName = dir + "reader/setUnitOfLength";
+  G4String navigationCmdName = dir + "setNavigation";
 
   pSetPathToELEFileCmd = new G4UIcmdWithAString(pathCmdName, this);
   pSetPathToELEFileCmd->SetGuidance("Set path to ELE file.");
@@ -32,6 +33,10 @@ GateTetMeshBoxMessenger::GateTetMeshBoxMessenger(GateTetMeshBox* itsCreator)
   pSetPathToAttributeMapCmd->SetGuidance("Set path to material map (ASCII file).");
   pSetUnitOfLengthCmd = new G4UIcmdWithADoubleAndUnit(unitOfLengthCmdName, this);
   pSetUnitOfLengthCmd->SetGuidance("Unit of length to interpret the coordinates.");
+  pSetNavigationCmd = new G4UIcmdWithAString(navigationCmdName, this);
+  pSetNavigationCmd->SetGuidance("Build one volume per tetrahedron ('assembly', default) "
+                                 "or navigate the mesh directly with one volume per region ('mesh').");
+  pSetNavigationCmd->SetCandidates("assembly mesh");
 }
 
 
@@ -40,6 +45,7 @@ GateTetMeshBoxMessenger::~GateTetMeshBoxMessenger()
   delete pSetPathToELEFileCmd;
   delete pSetPathToAttributeMapCmd;
   delete pSetUnitOfLengthCmd;
+  delete pSetNavigationCmd;
 }
 
 
@@ -60,6 +66,10 @@ void GateTetMeshBoxMessenger::SetNewValue(G4UIcommand* command, G4String newValu
   {
     creator->SetUnitOfLength(pSetUnitOfLengthCmd->GetNewDoubleValue(newValue));
   }
+  else if (command == pSetNavigationCmd)
+  {
+    creator->SetNavigation(newValue);
+  }
   else
   {
     GateVolumeMessenger::SetNewValue(command, newValue);
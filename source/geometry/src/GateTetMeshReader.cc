@@ -51,12 +51,61 @@ std::vector<GateMeshTet> GateTetMeshReader::Read(const G4String& filePath)
 
 //----------------------------------------------------------------------------------------
 
+void GateTetMeshReader::Read(const G4String& filePath, std::vector<G4ThreeVector>& nodes,
+                             std::vector<std::array<G4int, 4> >& tetrahedra,
+                             std::vector<G4int>& regionIDs)
+{
+  const G4String& extension = GateTools::PathSplitExt(filePath).second;
+  if (extension == ".ele")
+  {
+    ReadELE(filePath, nodes, tetrahedra, regionIDs);
+  }
+  else
+  {
+    GateError("File format not supported: '" << extension << "'. Could not load tetrahedral mesh.");
+  }
+}
+
+//----------------------------------------------------------------------------------------
+
 std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
 {
+  std::vector<G4ThreeVector> nodes;
+  std::vector<std::array<G4int, 4> > indices;
+  std::vector<G4int> regionIDs;
+  ReadELE(filePath, nodes, indices, regionIDs);
+
+  // strings we'll need to name the solids
+  const G4String& fileName = GateTools::PathSplit(filePath).second;
+  const G4String& fileNameRoot = GateTools::PathSplitExt(fileName).first;
+
+  std::vector<GateMeshTet> tetrahedra;
+  tetrahedra.reserve(indices.size());
+  for (std::size_t counter = 0; counter < indices.size(); ++counter)
+  {
+    const std::array<G4int, 4>& tet = indices[counter];
+    G4String tetSolidName = fileNameRoot + "_tet" + std::to_string(counter);
+    G4Tet* tetSolid = new G4Tet(tetSolidName, nodes[tet[0]], nodes[tet[1]],
+                                              nodes[tet[2]], nodes[tet[3]]);
+
+    tetrahedra.push_back(GateMeshTet{tetSolid, regionIDs[counter]});
+  }
+  return tetrahedra;
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMeshReader::ReadELE(const G4String& filePath, std::vector<G4ThreeVector>& nodes,
+                                std::vector<std::array<G4int, 4> >& tetrahedra,
+                                std::vector<G4int>& regionIDs)
+{
+  tetrahedra.clear();
+  regionIDs.clear();
+
   // ELE files are accompanied by seperate NODE files which define all mesh nodes.
   // E.g. for "<filePath>.ele" there should be "<filePath>.node".
   G4String nodeFilePath = GateTools::PathSplitExt(filePath).first + ".node";
-  std::vector<G4ThreeVector> nodes = ReadNODE(nodeFilePath);
+  nodes = ReadNODE(nodeFilePath);
 
   // Only after successfully reading the nodes, the ELE file is looked into.
   GateMessage("Geometry", 2, "Reading tetrahedra from '" << filePath << "'." << Gateendl);
@@ -64,7 +113,7 @@ std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
   if (eleFileStream.is_open() == false)
   {
     GateError("Cannot open file: '" << filePath << "'.");
-    return std::vector<GateMeshTet>();
+    return;
   }
 
   // The first non-comment line should be the header, containing:
@@ -91,7 +140,7 @@ std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
     if (lineParser.fail())
     {
       GateError("Failed to parse ELE section header: '" << line << "'.");
-      return std::vector<GateMeshTet>();
+      return;
     }
 
     break;
@@ -103,21 +152,17 @@ std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
   if (nNodesPerTet != 4)
   {
     GateError("Cannot read tetrahedral mesh generated with '-o2' flag.");
-    return std::vector<GateMeshTet>();
+    return;
   }
 
-  // strings we'll need to name the solids later on
-  const G4String& fileName = GateTools::PathSplit(filePath).second;
-  const G4String& fileNameRoot = GateTools::PathSplitExt(fileName).first;
-
   // After the header, each row of the ELE file defines one tetrahedron, 
   // via the indices of specific nodes: 
   //    ...
   //    <tetrahedron #> <node> <node> ... <node> [attribute]
   //    ...
-  std::vector<GateMeshTet> tetrahedra;
-  std::size_t counter = 0;
-  while (std::getline(eleFileStream, line) && counter < nTetrahedra)
+  tetrahedra.reserve(nTetrahedra);
+  regionIDs.reserve(nTetrahedra);
+  while (tetrahedra.size() < nTetrahedra && std::getline(eleFileStream, line))
   {
     // skip comments & emtpy lines
     if (line.front() == '#' || line.empty())
@@ -130,12 +175,10 @@ std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
     lineParser >> tetNumber;
 
     // <node> <node> ... <node>
-    std::array<G4ThreeVector, 4> cornerNodes;
+    std::array<G4int, 4> cornerNodes;
     for (auto& cornerNode : cornerNodes)
     {
-      G4int index;
-      lineParser >> index;
-      cornerNode = nodes[index];
+      lineParser >> cornerNode;
     }
 
     // [attribute] aka. regionID
@@ -147,21 +190,24 @@ std::vector<GateMeshTet> GateTetMeshReader::ReadELE(const G4String& filePath)
     if (lineParser.fail())
     {
       GateError("Failed to read tetrahedron: '" << line << "'.");
-      return std::vector<GateMeshTet>();
+      return;
+    }
+    for (G4int cornerNode : cornerNodes)
+    {
+      if (cornerNode < 0 || std::size_t(cornerNode) >= nodes.size())
+      {
+        GateError("Node index out of range in tetrahedron: '" << line << "'.");
+        return;
+      }
     }
 
-    G4String tetSolidName = fileNameRoot + "_tet" + std::to_string(counter);
-    G4Tet* tetSolid = new G4Tet(tetSolidName, cornerNodes[0], cornerNodes[1],
-                                              cornerNodes[2], cornerNodes[3]);
-
-    tetrahedra.push_back(GateMeshTet{tetSolid, regionID});
-    ++counter;
+    tetrahedra.push_back(cornerNodes);
+    regionIDs.push_back(regionID);
   }
 
   GateMessage("Geometry", 2, "Obtained mesh containting "
                              << tetrahedra.size() <<
                              " tetrahedra." << Gateendl);
-  return tetrahedra;
 }
 
 //----------------------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+#include <array>
+#include <vector>
+
+#include <G4Box.hh>
+#include <G4VGraphicsScene.hh>
+#include <G4PolyhedronArbitrary.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "GateTetMesh.hh"
+
+#include "GateTetMeshRegionSolid.hh"
+
+
+namespace
+{
+  G4ThreeVector GetRegionHalfSize(const GateTetMesh* mesh, G4int regionIndex)
+  {
+    G4ThreeVector min, max;
+    mesh->GetRegionExtent(regionIndex, min, max);
+    return 0.5 * (max - min);
+  }
+
+  G4ThreeVector GetRegionCenter(const GateTetMesh* mesh, G4int regionIndex)
+  {
+    G4ThreeVector min, max;
+    mesh->GetRegionExtent(regionIndex, min, max);
+    return 0.5 * (max + min);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+
+GateTetMeshRegionSolid::GateTetMeshRegionSolid(const G4String& name, const GateTetMesh* mesh,
+                                               G4int regionIndex)
+  : G4Box(name,
+          GetRegionHalfSize(mesh, regionIndex).x(),
+          GetRegionHalfSize(mesh, regionIndex).y(),
+          GetRegionHalfSize(mesh, regionIndex).z()),
+    pMesh(mesh), mRegionIndex(regionIndex),
+    mCenter(GetRegionCenter(mesh, regionIndex)),
+    mCubicVolume(mesh->GetRegionVolume(regionIndex))
+{
+}
+
+//----------------------------------------------------------------------------------------
+
+EInside GateTetMeshRegionSolid::Inside(const G4ThreeVector& p) const
+{
+  if (G4Box::Inside(p) == kOutside)
+    return kOutside;
+  return pMesh->Inside(ToMesh(p), mRegionIndex);
+}
+
+G4ThreeVector GateTetMeshRegionSolid::SurfaceNormal(const G4ThreeVector& p) const
+{
+  return pMesh->SurfaceNormal(ToMesh(p), mRegionIndex);
+}
+
+G4double GateTetMeshRegionSolid::DistanceToIn(const G4ThreeVector& p, const G4ThreeVector& v) const
+{
+  // rays missing the bounding box are not traced through the mesh
+  if (G4Box::DistanceToIn(p, v) == kInfinity)
+    return kInfinity;
+  return pMesh->DistanceToIn(ToMesh(p), v, mRegionIndex);
+}
+
+G4double GateTetMeshRegionSolid::DistanceToIn(const G4ThreeVector& p) const
+{
+  return pMesh->DistanceToIn(ToMesh(p), mRegionIndex);
+}
+
+G4double GateTetMeshRegionSolid::DistanceToOut(const G4ThreeVector& p, const G4ThreeVector& v,
+                                               const G4bool calcNorm,
+                                               G4bool* validNorm, G4ThreeVector* n) const
+{
+  // the region is not convex in general
+  if (calcNorm)
+    *validNorm = false;
+  return pMesh->DistanceToOut(ToMesh(p), v, mRegionIndex, calcNorm ? n : nullptr);
+}
+
+G4double GateTetMeshRegionSolid::DistanceToOut(const G4ThreeVector& p) const
+{
+  return pMesh->DistanceToOut(ToMesh(p), mRegionIndex);
+}
+
+//----------------------------------------------------------------------------------------
+
+G4double GateTetMeshRegionSolid::GetCubicVolume()
+{
+  return mCubicVolume;
+}
+
+G4GeometryType GateTetMeshRegionSolid::GetEntityType() const
+{
+  return G4String("GateTetMeshRegionSolid");
+}
+
+std::ostream& GateTetMeshRegionSolid::StreamInfo(std::ostream& os) const
+{
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: GateTetMeshRegionSolid\n"
+     << " Parameters: \n"
+     << "    half length X: " << GetXHalfLength()/mm << " mm \n"
+     << "    half length Y: " << GetYHalfLength()/mm << " mm \n"
+     << "    half length Z: " << GetZHalfLength()/mm << " mm \n"
+     << "    region       : " << pMesh->GetRegionID(mRegionIndex) << "\n"
+     << "-----------------------------------------------------------\n";
+  return os;
+}
+
+//----------------------------------------------------------------------------------------
+
+void GateTetMeshRegionSolid::DescribeYourselfTo(G4VGraphicsScene& scene) const
+{
+  // as a generic solid (i.e. through CreatePolyhedron), not as a G4Box
+  scene.AddSolid(static_cast<const G4VSolid&>(*this));
+}
+
+G4Polyhedron* GateTetMeshRegionSolid::CreatePolyhedron() const
+{
+  std::vector<G4ThreeVector> vertices;
+  std::vector<std::array<G4int, 3> > triangles;
+  pMesh->GetRegionSurface(mRegionIndex, vertices, triangles);
+
+  G4PolyhedronArbitrary* polyhedron = new G4PolyhedronArbitrary(vertices.size(), triangles.size());
+  for (const G4ThreeVector& vertex : vertices)
+    polyhedron->AddVertex(vertex - mCenter);
+  for (const auto& triangle : triangles)
+    polyhedron->AddFacet(triangle[0] + 1, triangle[1] + 1, triangle[2] + 1);
+  polyhedron->SetReferences();
+  return polyhedron;
+}
@@ -21,6 +21,7 @@ GateVGeometryVoxelReader::GateVGeometryVoxelReader(GateVVolume* inserter)
   : GateGeometryVoxelArrayStore(inserter)
   , m_voxelTranslator(0)
   , m_fileName(G4String("NULL"))
+  , m_frameChanged(true)
 {
   mMaterialDatabase = theMaterialDatabase;
 }
@@ -44,6 +44,8 @@ GateVImageVolume::GateVImageVolume( const G4String& name,G4bool acceptsChildren,
   mIsoCenterRotationFlag = false;
   pOwnMaterial = theMaterialDatabase.GetMaterial("G4_AIR");
   mBuildDistanceTransfo = false;
+  mResampledVoxelSize = G4ThreeVector(0,0,0);
+  mResamplingMode = "mean";
   mLoadImageMaterialsFromHounsfieldTable = false;
   mLoadImageMaterialsFromLabelTable = false;
   mLabelToImageMaterialTableFilename = "none";
@@ -252,6 +254,7 @@ void GateVImageVolume::LoadImage(bool add1VoxelMargin)
   else {
     tmp->Read(mImageFilename);
     //G4cout << mImageFilename << Gateendl;
+    if (mResampledVoxelSize.x() > 0) tmp->Downsample(mResampledVoxelSize, mResamplingMode);
   }
   //tmp->PrintInfo();
 
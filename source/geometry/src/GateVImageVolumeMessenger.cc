@@ -12,12 +12,14 @@
 */
 #include "GateVImageVolumeMessenger.hh"
 #include "GateVImageVolume.hh"
+#include "GateDICOMImage.hh"
 
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWith3VectorAndUnit.hh"
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
 
 //---------------------------------------------------------------------------
 GateVImageVolumeMessenger::GateVImageVolumeMessenger(GateVImageVolume* volume)
@@ -103,6 +105,26 @@ GateVImageVolumeMessenger::GateVImageVolumeMessenger(GateVImageVolume* volume)
   n = dir +"/setMaxOutOfRangeFraction";
   pSetMaxOutOfRangeFractionCmd = new G4UIcmdWithADouble(n,this);
   pSetMaxOutOfRangeFractionCmd->SetGuidance("Maximum fraction (number between 0.0 and 1.0) of voxels that have a HU value out of the range of the materials table.");
+
+  n = dir +"/setResampledVoxelSize";
+  pResampledVoxelSizeCmd = new G4UIcmdWith3VectorAndUnit(n,this);
+  pResampledVoxelSizeCmd->SetGuidance("Merge the voxels of the image by blocks when loading it, to reach (the nearest integer multiple of the voxel size to) this voxel size.");
+  pResampledVoxelSizeCmd->SetDefaultUnit("mm");
+
+  n = dir +"/setResamplingMode";
+  pResamplingModeCmd = new G4UIcmdWithAString(n,this);
+  pResamplingModeCmd->SetGuidance("Value of the merged voxels: mean (default), max or label (majority).");
+  pResamplingModeCmd->SetCandidates("mean max label");
+
+  n = dir +"/setDICOMCacheDirectory";
+  pDICOMCacheDirectoryCmd = new G4UIcmdWithAString(n,this);
+  pDICOMCacheDirectoryCmd->SetGuidance("Cache the decoded DICOM series in this directory (as <seriesUID>.mhd) and read them from it next time.");
+
+  n = dir +"/setDICOMNumberOfThreads";
+  pDICOMNumberOfThreadsCmd = new G4UIcmdWithAnInteger(n,this);
+  pDICOMNumberOfThreadsCmd->SetGuidance("Number of threads decoding the slices of a DICOM series (0 = number of cores, default).");
+  pDICOMNumberOfThreadsCmd->SetParameterName("N",false);
+  pDICOMNumberOfThreadsCmd->SetRange("N>=0");
 }
 //---------------------------------------------------------------------------
 
@@ -125,6 +147,10 @@ GateVImageVolumeMessenger::~GateVImageVolumeMessenger()
   delete pDoNotBuildVoxelsCmd;
   delete pIsoCenterRotationFlagCmd;
   delete pSetMaxOutOfRangeFractionCmd;
+  delete pResampledVoxelSizeCmd;
+  delete pResamplingModeCmd;
+  delete pDICOMCacheDirectoryCmd;
+  delete pDICOMNumberOfThreadsCmd;
 }
 //---------------------------------------------------------------------------
 
@@ -174,6 +200,26 @@ void GateVImageVolumeMessenger::SetNewValue(G4UIcommand* command,
   else if ( command == pSetMaxOutOfRangeFractionCmd) {
     pVImageVolume->SetMaxOutOfRangeFraction(pSetMaxOutOfRangeFractionCmd->GetNewDoubleValue(newValue));
   }
+  else if (command == pResampledVoxelSizeCmd) {
+    pVImageVolume->SetResampledVoxelSize(pResampledVoxelSizeCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == pResamplingModeCmd) {
+    pVImageVolume->SetResamplingMode(newValue);
+  }
+  else if (command == pDICOMCacheDirectoryCmd) {
+#ifdef GATE_USE_ITK
+    GateDICOMImage::SetCacheDirectory(newValue);
+#else
+    GateWarning("GATE was not compiled with ITK support, " << command->GetCommandPath() << " is ignored." << Gateendl);
+#endif
+  }
+  else if (command == pDICOMNumberOfThreadsCmd) {
+#ifdef GATE_USE_ITK
+    GateDICOMImage::SetNumberOfThreads(pDICOMNumberOfThreadsCmd->GetNewIntValue(newValue));
+#else
+    GateWarning("GATE was not compiled with ITK support, " << command->GetCommandPath() << " is ignored." << Gateendl);
+#endif
+  }
   // It is necessary to call GateVolumeMessenger::SetNewValue if the command
   // is not recognized
   else {
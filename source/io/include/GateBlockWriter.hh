@@ -0,0 +1,64 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Accumulates bytes into blocks and hands each full block to a sink run on a
+ * background thread (write to disk, compress...), so that the caller only
+ * pays a memcpy per record. At most max_pending_blocks are queued, the
+ * caller waits when the sink is slower than the producer.
+ */
+class GateBlockWriter
+{
+public:
+  typedef std::function<void(std::vector<char> &)> TSink;
+
+  GateBlockWriter();
+  ~GateBlockWriter();
+
+  void start(TSink sink, size_t block_size = 4 << 20, size_t max_pending_blocks = 4);
+  bool is_started() const { return m_started; }
+
+  void append(const void *data, size_t size)
+  {
+    m_current.insert(m_current.end(), (const char *)data, (const char *)data + size);
+    if(m_current.size() >= m_block_size)
+      submit();
+  }
+
+  // hands the current block to the sink now, even if not full
+  void submit();
+  // submits the current block and waits until the sink processed everything
+  void flush();
+  // flush, then stop the background thread
+  void stop();
+
+private:
+  void run();
+
+  TSink m_sink;
+  size_t m_block_size;
+  size_t m_max_pending_blocks;
+  bool m_started;
+  bool m_stopping;
+  bool m_busy;
+  std::vector<char> m_current;
+  std::deque<std::vector<char>> m_pending;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::thread m_thread;
+};
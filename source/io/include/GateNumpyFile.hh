@@ -17,6 +17,7 @@
 
 
 #include "GateTreeFile.hh"
+#include "GateBlockWriter.hh"
 
 
 
@@ -127,6 +128,8 @@ public:
 private:
   bool m_write_header_called;
   static bool s_registered;
+  // rows are written to m_file by a background thread
+  GateBlockWriter m_writer;
 };
 
 
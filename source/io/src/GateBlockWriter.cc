@@ -0,0 +1,93 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateBlockWriter.hh"
+
+GateBlockWriter::GateBlockWriter():
+  m_block_size(0),
+  m_max_pending_blocks(0),
+  m_started(false),
+  m_stopping(false),
+  m_busy(false)
+{
+}
+
+GateBlockWriter::~GateBlockWriter()
+{
+  stop();
+}
+
+void GateBlockWriter::start(TSink sink, size_t block_size, size_t max_pending_blocks)
+{
+  stop();
+  m_sink = sink;
+  m_block_size = block_size;
+  m_max_pending_blocks = max_pending_blocks > 0 ? max_pending_blocks : 1;
+  m_current.clear();
+  m_current.reserve(m_block_size);
+  m_stopping = false;
+  m_started = true;
+  m_thread = std::thread(&GateBlockWriter::run, this);
+}
+
+void GateBlockWriter::submit()
+{
+  if(m_current.empty())
+    return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this] { return m_pending.size() < m_max_pending_blocks; });
+  m_pending.push_back(std::vector<char>());
+  m_pending.back().swap(m_current);
+  lock.unlock();
+  m_cond.notify_all();
+  m_current.reserve(m_block_size);
+}
+
+void GateBlockWriter::flush()
+{
+  if(!m_started)
+    return;
+  submit();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this] { return m_pending.empty() && !m_busy; });
+}
+
+void GateBlockWriter::stop()
+{
+  if(!m_started)
+    return;
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+  m_started = false;
+}
+
+void GateBlockWriter::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true)
+    {
+      m_cond.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+      if(m_pending.empty())
+        return;
+      std::vector<char> block;
+      block.swap(m_pending.front());
+      m_pending.pop_front();
+      m_busy = true;
+      lock.unlock();
+      m_cond.notify_all();
+      m_sink(block);
+      lock.lock();
+      m_busy = false;
+      m_cond.notify_all();
+    }
+}
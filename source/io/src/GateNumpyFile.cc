@@ -203,6 +203,8 @@ void GateOutputNumpyTreeFile::write_header()
   m_position_after_shape = m_file.tellp();
   m_file << dico_after_shape.c_str();
   m_write_header_called = true;
+
+  m_writer.start([this](std::vector<char> &block) { m_file.write(block.data(), block.size()); });
 }
 
 
@@ -222,7 +224,7 @@ void GateOutputNumpyTreeFile::fill()
   for (auto&& d : m_vector_of_pointer_to_data) // access by const reference
     {
       if(d.m_nb_characters == 0)
-        m_file.write((const char*)d.m_pointer_to_data, d.m_size_of_data);
+        m_writer.append(d.m_pointer_to_data, d.m_size_of_data);
       else
         {
           if(d.m_type_index == typeid(char*))
@@ -235,7 +237,7 @@ void GateOutputNumpyTreeFile::fill()
                 p_data[i] = '\0';
 
 
-              m_file.write(p_data, d.m_size_of_data);
+              m_writer.append(p_data, d.m_size_of_data);
           } else if (d.m_type_index == typeid(string))
           {
               const auto *p_s = (const string*) d.m_pointer_to_data;
@@ -250,7 +252,7 @@ void GateOutputNumpyTreeFile::fill()
               s.resize(d.m_nb_characters, '\0');
 
 
-              m_file.write(s.c_str(), d.m_size_of_data);
+              m_writer.append(s.c_str(), d.m_size_of_data);
           }
           /*
            *Thinking about how to write in npy file an array of int corresponding to volumeID information. Work in progres. It is not working
@@ -278,12 +280,15 @@ void GateOutputNumpyTreeFile::write()
 
   if( (m_mode & ios_base::out) == ios_base::out )
     {
+      m_writer.flush();
+      auto end_position = m_file.tellp();
       m_file.seekp(m_position_before_shape);
       //    cout << "current position = " << m_file.tellp() << "\n";
       stringstream ss_shape;
       ss_shape << std::setw(20) << std::setfill(' ') << m_nb_elements;
       string shape = ss_shape.str();
       m_file.write(shape.c_str(), shape.size());
+      m_file.seekp(end_position);
     } else {
     for (auto&& d : m_vector_of_pointer_to_data) // access by const reference
       {
@@ -301,6 +306,7 @@ void GateOutputNumpyTreeFile::close()
     return;
 
   GateOutputNumpyTreeFile::write();
+  m_writer.stop();
 
   m_file.close();
 }
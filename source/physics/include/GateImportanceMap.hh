@@ -0,0 +1,90 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateImportanceMap
+  \brief  Voxelized importance map and weight windows of the WeightWindow process.
+
+  The importance image is read from a file (voxels in the world frame, as
+  given by the image origin) or generated from the fluence image of a
+  coarse forward run: I = max(fluence)/fluence, bounded by the maximum
+  importance. A particle of weight 1 is in the window of importance 1;
+  the survival weight of importance I is 1/I, the window is
+  [2/(1+r), 2r/(1+r)]/I with r the window ratio.
+*/
+
+#ifndef GATEIMPORTANCEMAP_HH
+#define GATEIMPORTANCEMAP_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+
+#include "GateImage.hh"
+
+class GateImportanceMap
+{
+public:
+  GateImportanceMap();
+  ~GateImportanceMap() {}
+
+  void SetImportanceFilename(const G4String & f) { mImportanceFilename = f; }
+  void SetFluenceFilename(const G4String & f) { mFluenceFilename = f; }
+  void SetOutputFilename(const G4String & f) { mOutputFilename = f; }
+  void SetMaximumImportance(G4double m) { mMaximumImportance = m; }
+  void SetWindowRatio(G4double r) { mWindowRatio = r; }
+  void SetMaximumSplitting(G4int n) { mMaximumSplitting = n; }
+  G4int GetMaximumSplitting() const { return mMaximumSplitting; }
+
+  // Reads (or generates) the map, once
+  void Initialize();
+
+  // Importance at a position of the world, -1 outside the map
+  inline G4double GetImportance(const G4ThreeVector & position) const;
+
+  // Lower bound, survival weight and upper bound of the window of an importance
+  inline void GetWeightWindow(G4double importance, G4double & lower,
+                              G4double & survival, G4double & upper) const;
+
+protected:
+  void GenerateFromFluence();
+
+  G4String mImportanceFilename;
+  G4String mFluenceFilename;
+  G4String mOutputFilename;
+  G4double mMaximumImportance;
+  G4double mWindowRatio;
+  G4int mMaximumSplitting;
+  G4bool mIsInitialized;
+
+  GateImage mImage;
+  G4ThreeVector mCenter;
+  G4RotationMatrix mInverseRotation;
+};
+
+//-----------------------------------------------------------------------------
+inline G4double GateImportanceMap::GetImportance(const G4ThreeVector & position) const
+{
+  const int index = mImage.GetIndexFromPosition(mInverseRotation*(position - mCenter));
+  if (index < 0) return -1;
+  return mImage.GetValue(index);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+inline void GateImportanceMap::GetWeightWindow(G4double importance, G4double & lower,
+                                               G4double & survival, G4double & upper) const
+{
+  survival = 1.0/importance;
+  lower = 2.0*survival/(1.0 + mWindowRatio);
+  upper = mWindowRatio*lower;
+}
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATEIMPORTANCEMAP_HH */
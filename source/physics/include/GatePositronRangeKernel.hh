@@ -0,0 +1,71 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GatePositronRangeKernel
+  \brief  Distance between the emission and the annihilation of a positron,
+          tabulated as a radial inverse CDF in water (O(1) sampling).
+
+  The kernel of an isotope is the sum over its beta+ spectrum of the kernels
+  of monoenergetic positrons: 3D density exp(-r/lambda), lambda = R/4,
+  truncated at the CSDA range R (Katz-Penfold). The legacy Fluor18, Carbon11
+  and Oxygen15 kernels (exponential fits in water) are kept as they were.
+  Distances are water-equivalent: in another material they scale with
+  1/density.
+*/
+
+#ifndef GATEPOSITRONRANGEKERNEL_HH
+#define GATEPOSITRONRANGEKERNEL_HH
+
+#include "globals.hh"
+#include <vector>
+
+class GatePositronRangeKernel
+{
+public:
+  // Builds the kernel of the isotope (F18, C11, N13, O15, Cu64, Ga68, Rb82,
+  // Zr89, I124 or the legacy Fluor18, Carbon11, Oxygen15), error if unknown
+  GatePositronRangeKernel(const G4String & isotope);
+
+  const G4String & GetIsotope() const { return mIsotope; }
+  G4double GetMaximumDistance() const { return mInverseCDF.back(); }
+  G4double GetMeanDistance() const { return mMeanDistance; }
+
+  // Water-equivalent distance (mm), u uniform in [0,1)
+  inline G4double SampleDistance(G4double u) const;
+
+  static G4String GetIsotopeNames();
+
+protected:
+  // Monoenergetic (or legacy) components: weight, maximum distance, decay length
+  struct Component {
+    G4double weight;
+    G4double range;
+    G4double lambda;
+  };
+  void AddSpectrum(G4double endpoint, G4double intensity, G4int daughterZ);
+  void BuildTable();
+  static G4double GetCSDARange(G4double energy);
+
+  G4String mIsotope;
+  std::vector<Component> mComponents;
+  std::vector<G4double> mInverseCDF;
+  G4double mMeanDistance;
+};
+
+//-----------------------------------------------------------------------------
+inline G4double GatePositronRangeKernel::SampleDistance(G4double u) const
+{
+  const G4double x = u * (mInverseCDF.size() - 1);
+  size_t i = static_cast<size_t>(x);
+  if (i >= mInverseCDF.size() - 1) return mInverseCDF.back();
+  return mInverseCDF[i] + (x - i)*(mInverseCDF[i+1] - mInverseCDF[i]);
+}
+//-----------------------------------------------------------------------------
+
+#endif /* end #define GATEPOSITRONRANGEKERNEL_HH */
@@ -11,6 +11,8 @@
 #include "G4GeneralPhaseSpaceDecay.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include "GateAliasTable.hh"
+#include <vector>
 
 /** Author: Mateusz Bała
  *  Email: bala.mateusz@gmail.com
@@ -50,6 +52,18 @@ class GatePositroniumDecayChannel : public G4GeneralPhaseSpaceDecay
   /** Generate perpendiculator vector ( to calculate orthogonal polarization )
    **/
   G4ThreeVector GetPerpendicularVector(const G4ThreeVector& v) const;
+  /** Build the (w1,w2) Dalitz grid used to sample oPs gamma energies directly:
+    * each cell is weighted by an upper bound of GetOrthoPsM() times its area
+  **/
+  void BuildOrthoPsTable();
+  /** Upper bound of GetOrthoPsM() over the physical points of a cell, from the
+    * largest energies (at most m) reached in the cell
+  **/
+  G4double GetOrthoPsMUpperBound( const G4double w1_max, const G4double w2_max, const G4double w3_max ) const;
+  /** Sample gamma energies (w1,w2,w3) from the oPs matrix element: cell from
+    * alias table, uniform point in cell, local rejection against the cell bound
+  **/
+  void SampleOrthoPsEnergies( G4double& w1, G4double& w2, G4double& w3 ) const;
 
  protected:
   //Decay constants
@@ -63,6 +77,10 @@ class GatePositroniumDecayChannel : public G4GeneralPhaseSpaceDecay
   ///This is maxiaml number which can be calculated by function GetOrthoPsM() - based on 10^7 iterations
   const G4double kOrthoPsMMax = 7.65928;
   const G4double kElectronMass = electron_mass_c2; //[MeV]
+  ///Dalitz grid (per axis)
+  static const G4int kOrthoPsGridSize = 64;
+  GateAliasTable fOrthoPsTable;
+  std::vector<G4double> fOrthoPsCellMax;
 };
 
 #endif
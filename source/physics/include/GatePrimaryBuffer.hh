@@ -0,0 +1,63 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GatePrimaryBuffer
+  \brief  Struct-of-arrays block of pre-sampled primaries (position,
+          direction, kinetic energy, weight) filled by a source with
+          GateVSource::GeneratePrimaryBlock and consumed one event at a time.
+          The emission time is not stored: it is chosen per event by the
+          source manager.
+*/
+
+#ifndef GATEPRIMARYBUFFER_HH
+#define GATEPRIMARYBUFFER_HH
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class GatePrimaryBuffer
+{
+public:
+  GatePrimaryBuffer() : mCurrent(0) {}
+
+  void Resize(size_t n) {
+    mPositionX.resize(n); mPositionY.resize(n); mPositionZ.resize(n);
+    mDirectionX.resize(n); mDirectionY.resize(n); mDirectionZ.resize(n);
+    mEnergy.resize(n); mWeight.resize(n);
+    mCurrent = 0;
+  }
+  void Clear() { Resize(0); }
+
+  size_t GetSize() const { return mEnergy.size(); }
+  G4bool IsEmpty() const { return mCurrent >= mEnergy.size(); }
+  // Index of the next primary to consume
+  size_t Next() { return mCurrent++; }
+  size_t GetCurrent() const { return mCurrent; }
+  void SetCurrent(size_t i) { mCurrent = i; }
+
+  void SetPosition(size_t i, const G4ThreeVector & p) { mPositionX[i] = p.x(); mPositionY[i] = p.y(); mPositionZ[i] = p.z(); }
+  void SetDirection(size_t i, const G4ThreeVector & d) { mDirectionX[i] = d.x(); mDirectionY[i] = d.y(); mDirectionZ[i] = d.z(); }
+  G4ThreeVector GetPosition(size_t i) const { return G4ThreeVector(mPositionX[i], mPositionY[i], mPositionZ[i]); }
+  G4ThreeVector GetDirection(size_t i) const { return G4ThreeVector(mDirectionX[i], mDirectionY[i], mDirectionZ[i]); }
+
+  std::vector<G4double> mPositionX;
+  std::vector<G4double> mPositionY;
+  std::vector<G4double> mPositionZ;
+  std::vector<G4double> mDirectionX;
+  std::vector<G4double> mDirectionY;
+  std::vector<G4double> mDirectionZ;
+  std::vector<G4double> mEnergy;
+  std::vector<G4double> mWeight;
+
+protected:
+  size_t mCurrent;
+};
+
+#endif /* end #define GATEPRIMARYBUFFER_HH */
@@ -40,6 +40,9 @@ void   SetBaseFileName( G4String aFN );
 void   SetHeaderFileName( G4String aFN );
 void   SetActAsAtt(){ set_ActAsAtt = 1;}
 void   SetAttAsAct(){ set_AttAsAct = 1;}
+void   SetFrameCacheSize( G4int n ); // number of decoded frames kept in memory
+void   SetFramePrefetch( G4bool b ); // read frame k+1 in background while frame k is used
+G4int  GetFrameIndex( G4double aTime );
 
 void SetTPF( G4double aTPF);
 G4double GetTPF();
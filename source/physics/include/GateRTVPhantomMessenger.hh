@@ -8,6 +8,7 @@ class G4UIcmdWithAString;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithoutParameter;
+class G4UIcmdWithABool;
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 class GateRTVPhantomMessenger: public GateMessenger
@@ -31,6 +32,8 @@ private:
 
     G4UIcmdWithoutParameter* SetAttAsActCmd;
     G4UIcmdWithoutParameter* SetActAsAttCmd;
+    G4UIcmdWithAnInteger*    SetFrameCacheSizeCmd;
+    G4UIcmdWithABool*        SetFramePrefetchCmd;
 };
 
 #endif
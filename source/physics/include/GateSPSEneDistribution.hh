@@ -30,6 +30,8 @@
 #include <G4ParticleDefinition.hh>
 #include <G4SPSEneDistribution.hh>
 
+#include "GateAliasTable.hh"
+
 
 class GateSPSEneDistribution : public G4SPSEneDistribution
 {
@@ -43,6 +45,8 @@ public:
 
   // Shoot an energy in previously created probability tables
   void GenerateFromUserSpectrum();
+  // Shoot n energies in previously created probability tables
+  void GenerateFromUserSpectrum(G4int n, std::vector<G4double> & energies);
 
   // Create probability tables
   void BuildUserSpectrum(G4String fileName);
@@ -62,6 +66,11 @@ private:
   std::vector<G4double> mTabProba;
   std::vector<G4double> mTabSumProba;
   std::vector<G4double> mTabEnergy;
+
+  // O(1) choice of the spectrum bin (line, histogram bin or interpolation interval)
+  GateAliasTable mUserSpectrumTable;
+  // Energy inside the chosen bin
+  G4double SampleUserSpectrumBin(size_t i) const;
 };
 
 #endif  // GateSPSEneDistribution_h
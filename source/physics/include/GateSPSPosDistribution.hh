@@ -22,6 +22,8 @@ See LICENSE.md for further details
 #include "G4VPhysicalVolume.hh"
 #include <vector>
 #include "GateConfiguration.h"
+#include "GateAliasTable.hh"
+#include "GatePositronRangeKernel.hh"
 
 //-------------------------------------------------------------------------------------------------
 class GateSPSPosDistribution : public G4SPSPosDistribution
@@ -34,8 +36,23 @@ class GateSPSPosDistribution : public G4SPSPosDistribution
   
   void GeneratePositronRange() ;
   void SetPositronRange( G4String ) ;
+  // water (default), local (density at the emission point) or transport
+  // (density along the path when it crosses another material)
+  void SetPositronRangeMaterial( G4String ) ;
   
   void ForbidSourceToVolume(const G4String&);
+  // Hides the G4SPSPosDistribution confinement, done here instead
+  void ConfineSourceToVolume(const G4String&);
+
+  // Recorded to test if a point is inside the shape (acceptance grid)
+  void SetPosRot1(G4ThreeVector);
+  void SetPosRot2(G4ThreeVector);
+  void SetParAlpha(G4double);
+  void SetParTheta(G4double);
+  void SetParPhi(G4double);
+
+  // Number of cells per axis of the acceptance grid (0 : no grid)
+  void SetAcceptanceGridResolution(G4int n) { mAcceptanceGridResolution = n; mAcceptanceGridParameters.clear(); }
   
   virtual G4ThreeVector GenerateOne() ;
   
@@ -48,10 +65,46 @@ class GateSPSPosDistribution : public G4SPSPosDistribution
   
   G4String positronrange ;
   G4ThreeVector particle_position ;
+  GatePositronRangeKernel * pPositronRangeKernel;
+  enum PositronRangeMaterialType { kWater, kLocal, kTransport };
+  PositronRangeMaterialType mPositronRangeMaterial;
+  G4Material * GetMaterial(const G4ThreeVector &, const G4ThreeVector & direction);
+  G4bool DisplacePositron(G4Material * material, const G4ThreeVector & direction, G4double distance);
   
-  G4bool IsSourceForbidden();
+  G4bool IsPositionAllowed(const G4ThreeVector &, G4bool confinement, G4bool forbidden);
   G4bool Forbid;
   std::vector<G4VPhysicalVolume*> ForbidVector;
+  G4bool mConfine;
+  G4String mConfineVolumeName;
+
+  // Acceptance grid: cells of the bounding box of a volume shape that
+  // are fully allowed (no test) or on a boundary (exact test). Boundary
+  // cells are refined once.
+  G4bool CanUseAcceptanceGrid();
+  std::vector<G4double> GetAcceptanceGridParameters();
+  G4bool IsInsideShape(const G4ThreeVector &);
+  G4double GetShapeBoundingRadius();
+  G4double GetShapeDistanceLowerBound(const G4ThreeVector &);
+  void ClassifyAcceptanceGridCells(const G4ThreeVector & origin, G4int n, G4double size,
+                                   std::vector<char> & type);
+  void UpdateAcceptanceGrid();
+  void BuildAcceptanceGrid();
+  G4ThreeVector GenerateOneFromAcceptanceGrid();
+  G4int mAcceptanceGridResolution;
+  std::vector<G4double> mAcceptanceGridParameters;
+  G4int mAcceptanceGridRunID;
+  G4ThreeVector mAcceptanceGridCentre;
+  G4ThreeVector mAcceptanceGridHalfSize;
+  G4double mAcceptanceGridRadius;
+  std::vector<G4ThreeVector> mAcceptanceGridCellOrigins;
+  std::vector<G4double> mAcceptanceGridCellSizes;
+  std::vector<char> mAcceptanceGridCellIsBoundary;
+  GateAliasTable mAcceptanceGridTable;
+  G4ThreeVector mPosRot1;
+  G4ThreeVector mPosRot2;
+  G4double mParAlpha;
+  G4double mParTheta;
+  G4double mParPhi;
   G4int verbosityLevel;
   
   G4Navigator* gNavigator;
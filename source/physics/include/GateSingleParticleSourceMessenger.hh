@@ -156,12 +156,14 @@ class GateSingleParticleSourceMessenger : public GateMessenger
   G4UIcmdWithADoubleAndUnit  *partheCmd1;
   G4UIcmdWithADoubleAndUnit  *parphiCmd1;  
   G4UIcmdWithAString         *confineCmd1;  
+  G4UIcmdWithAnInteger       *acceptanceGridCmd1;
   
   G4UIcmdWithAString*         relativePlacementCmd;
   G4UIcmdWithAString*         typeCmd ;
   G4UIcmdWithAString*         shapeCmd ;
   G4UIcmdWith3VectorAndUnit*  centreCmd ;
   G4UIcmdWithAString*         positronRangeCmd ;
+  G4UIcmdWithAString*         positronRangeMaterialCmd ;
   G4UIcmdWith3Vector*         posrot1Cmd ;
   G4UIcmdWith3Vector*         posrot2Cmd ;
   G4UIcmdWithADoubleAndUnit*  halfxCmd ;
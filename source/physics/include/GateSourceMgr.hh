@@ -108,6 +108,12 @@ public:
 
   void Initialization();
 
+  /** Checkpoint/restart (see GateCheckpointManager): internal time, counters and
+   * state of each source, restored after PrepareNextRun of the resumed run.
+   */
+  void SaveCheckpoint(GateCheckpointWriter & w);
+  void LoadCheckpoint(GateCheckpointReader & r);
+
   //void SetIsSuccessiveSources(G4bool t){GateApplicationMgr::GetInstance()->EnableSuccessiveSourceMode(t);}
   //bool IsSuccessiveSourceModeIsEnabled() { return GateApplicationMgr::GetInstance()->IsSuccessiveSourceModeIsEnabled(); }
   bool IsTotalAmountOfPrimariesModeEnabled() { return GateApplicationMgr::GetInstance()->IsTotalAmountOfPrimariesModeEnabled(); }
@@ -39,6 +39,7 @@
 #include "GateSourcePhaseSpaceMessenger.hh"
 #include "GateUserActions.hh"
 #include "GateTreeFileManager.hh"
+#include "GateCompressedPhaseSpaceFile.hh"
 #include <typeindex>
 #include "json.hpp"
 
@@ -62,6 +63,8 @@ public:
 
     void GenerateIAEAVertex(G4Event *);
 
+    void GenerateCompressedVertex(G4Event *);
+
     void GeneratePyTorchVertex(G4Event *);
 
     void GeneratePyTorchVertexSingle(G4Event *);
@@ -76,6 +79,10 @@ public:
 
     G4int GeneratePrimaries(G4Event *event);
 
+    void SaveCheckpoint(GateCheckpointWriter &w);
+
+    void LoadCheckpoint(GateCheckpointReader &r);
+
     void GeneratePrimariesSingle(G4Event *event);
 
     void GeneratePrimariesPairs(G4Event *event);
@@ -133,6 +140,14 @@ public:
 
     void InitializeIAEA();
 
+    void InitializeCompressed();
+
+    // Reads the next particle of the .gphsp files, going to the next file at the end of one
+    void ReadCompressedRecord(GateCompressedPhaseSpaceRecord &r);
+
+    // Next particle of the .gphsp files is the given one (index in all files)
+    void SeekCompressed(G4long index);
+
     void InitializeROOT();
 
     void InitializeROOTSingle();
@@ -243,6 +258,10 @@ protected:
     bool mUseNbOfParticleAsIntensity;
     GateInputTreeFileChain mChain;
 
+    GateCompressedPhaseSpaceReader mCompressedFile;
+    size_t mCompressedFileIndex;
+    G4long mCompressedParticleIndex;
+
     bool mIgnoreWeight;
 
     int mPTCurrentIndex;
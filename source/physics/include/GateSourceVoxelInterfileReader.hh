@@ -12,6 +12,7 @@ See LICENSE.md for further details
 
 #include "GateVSourceVoxelReader.hh"
 #include "GateInterfileHeader.hh"
+#include "GateInterfileFrameCache.hh"
 class GateSourceVoxelInterfileReaderMessenger;
 
 class GateSourceVoxelInterfileReader : public GateVSourceVoxelReader, public GateInterfileHeader
@@ -26,10 +27,12 @@ public:
   /* PY Descourt 08/09/2009 */
   void ReadRTFile(G4String, G4String);
   /* PY Descourt 08/09/2009 */
+  void PrefetchRTFile(G4String, G4String);
   
 protected:
   GateSourceVoxelInterfileReaderMessenger* m_messenger;
   G4bool IsFirstFrame; // for RTPhantom/* PY Descourt 08/09/2009 */
+  GateInterfileFrameCache::FramePointer m_previousFrame; // last frame read by ReadRTFile
 };
 
 #endif
@@ -33,6 +33,8 @@ public:
 
   virtual G4int GeneratePrimaries(G4Event* event);
 
+  virtual G4int GeneratePrimaryBlock(GatePrimaryBuffer & buffer, G4int n);
+
   void ReaderInsert(G4String readerType);
 
   void ReaderRemove();
@@ -47,6 +49,10 @@ public:
 
 protected:
 
+  // Set the GPS shape to the voxel box and return the centre of the next active voxel
+  void SetVoxelPosDistribution();
+  G4ThreeVector GetNextVoxelCentre();
+
   GateSourceVoxellizedMessenger* m_sourceVoxellizedMessenger;
 
   // Even if for a standard source the position is controlled by its GPS,
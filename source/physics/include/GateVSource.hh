@@ -21,6 +21,7 @@
 #include "GateSPSPosDistribution.hh"
 #include "GateSPSEneDistribution.hh"
 #include "GateSPSAngDistribution.hh"
+#include "GatePrimaryBuffer.hh"
 #include "GateVSourceMessenger.hh"
 #include "GateSingleParticleSourceMessenger.hh"
 #include "GateVVolume.hh"
@@ -28,6 +29,7 @@
 
 #include "G4Colour.hh"
 #include "GateMaps.hh"
+#include "GateCheckpointFile.hh"
 //-------------------------------------------------------------------------------------------------
 class GateVSource : public G4SingleParticleSource
 {
@@ -86,6 +88,16 @@ public:
   virtual G4int GeneratePrimaries(G4Event* event);
   virtual void GeneratePrimaryVertex(G4Event* event);
 
+  // Block generation: fill 'buffer' with n primaries (world frame), return the
+  // number generated (0 if the source cannot generate blocks)
+  virtual G4int GeneratePrimaryBlock(GatePrimaryBuffer & buffer, G4int n);
+  void SetPrimaryBlockSize(G4int n) { mPrimaryBlockSize = n; mPrimaryBuffer.Clear(); }
+  G4int GetPrimaryBlockSize() const { return mPrimaryBlockSize; }
+
+  // Checkpoint/restart (see GateCheckpointManager): state needed to go on with the current run
+  virtual void SaveCheckpoint(GateCheckpointWriter & w);
+  virtual void LoadCheckpoint(GateCheckpointReader & r);
+
   void GeneratePrimariesForBackToBackSource(G4Event* event);
   void GeneratePrimariesForFastI124Source(G4Event* event);
 
@@ -153,6 +165,18 @@ protected:
 
   void ChangeParticlePositionRelativeToAttachedVolume(G4ThreeVector & position);
   void ChangeParticleMomentumRelativeToAttachedVolume(G4ParticleMomentum & momentum);
+  // Composed rotation/translation from the attached volume to the world
+  void GetRelativePlacementTransform(G4RotationMatrix & rotation, G4ThreeVector & translation);
+  // True if this event can be taken from the primary block
+  virtual G4bool UsePrimaryBlock();
+  // Energies of the whole block drawn at once when the distribution allows it
+  // (user spectrum), false if they must be drawn per primary
+  G4bool GeneratePrimaryBlockEnergies(GatePrimaryBuffer & buffer, G4int n);
+  // Direction, energy (unless already drawn) and weight of primary i of a block,
+  // position already set
+  void FillPrimaryBlockMomentum(GatePrimaryBuffer & buffer, size_t i, const G4RotationMatrix & rotation,
+                                G4bool sampleEnergy = true);
+  G4bool GeneratePrimaryVertexFromBlock(G4Event* event);
 
   G4String   m_name;         // source name
   G4String   m_type;         // source type
@@ -180,6 +204,10 @@ protected:
 
 
   G4double mSourceTime;
+
+  // Block generation of primaries (0 = one primary sampled per event)
+  G4int mPrimaryBlockSize;
+  GatePrimaryBuffer mPrimaryBuffer;
   //std::vector<double> mTimePerSlice;
   //std::vector<int> mNumberOfParticlesPerSlice;
 
@@ -54,6 +54,7 @@ protected:
   G4UIcmdWithADoubleAndUnit*           AccoValueCmd;
   G4UIcmdWithADoubleAndUnit*           ForcedHalfLifeCmd;
   G4UIcmdWithAnInteger*                VerboseCmd;
+  G4UIcmdWithAnInteger*                PrimaryBlockSizeCmd;
   //G4UIcmdWithADoubleAndUnit*           BeamTimeCmd;
   //G4UIcmdWithADouble*                  WeightCmd;
   G4UIcmdWithADouble*                  IntensityCmd;
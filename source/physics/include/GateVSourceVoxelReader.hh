@@ -56,6 +56,9 @@ public:
 
   virtual void ReadRTFile(G4String header_fileName, G4String fileName) = 0;
 
+  //! Start reading the next frame in the background (readers without frame cache ignore it)
+  virtual void PrefetchRTFile(G4String /*header_fileName*/, G4String /*fileName*/) {}
+
   void UpdateActivities();
 
   virtual void Initialize();
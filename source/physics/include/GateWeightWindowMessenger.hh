@@ -0,0 +1,40 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#ifndef GATEWEIGHTWINDOWMESSENGER_HH
+#define GATEWEIGHTWINDOWMESSENGER_HH
+
+#include "GateVProcessMessenger.hh"
+#include "GateImportanceMap.hh"
+
+class GateVProcess;
+
+class GateWeightWindowMessenger: public GateVProcessMessenger
+{
+public:
+  GateWeightWindowMessenger(GateVProcess* pb);
+  virtual ~GateWeightWindowMessenger();
+
+  virtual void BuildCommands(G4String base);
+  virtual void SetNewValue(G4UIcommand*, G4String);
+
+  // Shared by the processes of all the particles
+  GateImportanceMap * GetImportanceMap() { return &mImportanceMap; }
+
+protected:
+  G4UIcmdWithAString * pSetImportanceMapCmd;
+  G4UIcmdWithAString * pSetImportanceFromFluenceCmd;
+  G4UIcmdWithAString * pSaveImportanceMapCmd;
+  G4UIcmdWithADouble * pSetMaximumImportanceCmd;
+  G4UIcmdWithADouble * pSetWindowRatioCmd;
+  G4UIcmdWithAnInteger * pSetMaximumSplittingCmd;
+
+  GateImportanceMap mImportanceMap;
+};
+
+#endif /* end #define GATEWEIGHTWINDOWMESSENGER_HH */
@@ -0,0 +1,16 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#ifndef GATEWEIGHTWINDOWPB_HH
+#define GATEWEIGHTWINDOWPB_HH
+
+#include "GateVProcess.hh"
+
+MAKE_PROCESS_AUTO_CREATOR(GateWeightWindowPB)
+
+#endif
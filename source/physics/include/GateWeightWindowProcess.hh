@@ -0,0 +1,56 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+/*
+  \class  GateWeightWindowProcess
+  \brief  Splitting and Russian roulette of the tracks against the weight
+          window of the importance map, at the end of every step.
+
+  Strongly forced: it never limits the step. It is ordered last among the
+  post step processes (GateWeightWindowPB), so that it is invoked after the
+  physics process of the step: the secondaries of the interaction keep the
+  weight of the step, and the copies start from the state after it. A track heavier than the upper bound is
+  split into copies of equal weight (the copies are secondaries starting
+  at the post step point); a track lighter than the lower bound survives
+  with the survival weight, or is killed. Both keep the expected weight.
+*/
+
+#ifndef GATEWEIGHTWINDOWPROCESS_HH
+#define GATEWEIGHTWINDOWPROCESS_HH
+
+#include "G4VDiscreteProcess.hh"
+
+class GateImportanceMap;
+
+class GateWeightWindowProcess : public G4VDiscreteProcess
+{
+public:
+  GateWeightWindowProcess(const G4String & name, GateImportanceMap * map);
+  virtual ~GateWeightWindowProcess() {}
+
+  virtual G4bool IsApplicable(const G4ParticleDefinition &) { return true; }
+  virtual void BuildPhysicsTable(const G4ParticleDefinition &);
+
+  virtual G4double PostStepGetPhysicalInteractionLength(const G4Track & track,
+                                                        G4double previousStepSize,
+                                                        G4ForceCondition * condition);
+  virtual G4VParticleChange * PostStepDoIt(const G4Track & track, const G4Step & step);
+
+  // Outcome of the window for a track of the given weight: n tracks (n=0:
+  // killed, n=1: kept) of weight w. u is a uniform random number used by the
+  // roulette. The weight is kept exactly by a split, on average by the roulette.
+  static void ApplyWindow(G4double weight, G4double lower, G4double survival, G4double upper,
+                          G4int maximumSplitting, G4double u, G4int & n, G4double & w);
+
+protected:
+  virtual G4double GetMeanFreePath(const G4Track &, G4double, G4ForceCondition * condition);
+
+  GateImportanceMap * pImportanceMap;
+};
+
+#endif /* end #define GATEWEIGHTWINDOWPROCESS_HH */
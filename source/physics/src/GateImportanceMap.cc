@@ -0,0 +1,66 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include <algorithm>
+
+#include "GateImportanceMap.hh"
+#include "GateMessageManager.hh"
+
+//-----------------------------------------------------------------------------
+GateImportanceMap::GateImportanceMap()
+{
+  mImportanceFilename = "";
+  mFluenceFilename = "";
+  mOutputFilename = "";
+  mMaximumImportance = 1e4;
+  mWindowRatio = 5.0;
+  mMaximumSplitting = 100;
+  mIsInitialized = false;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateImportanceMap::Initialize()
+{
+  if (mIsInitialized) return;
+
+  if (mImportanceFilename != "" && mFluenceFilename != "")
+    GateError("WeightWindow: give either an importance map or a fluence image, not both" << Gateendl);
+  if (mImportanceFilename != "") mImage.Read(mImportanceFilename);
+  else if (mFluenceFilename != "") GenerateFromFluence();
+  else GateError("WeightWindow: no importance map, use setImportanceMap or setImportanceFromFluence" << Gateendl);
+
+  // GateImage positions are relative to the center of the image
+  mCenter = mImage.GetOrigin() + mImage.GetTransformMatrix()*mImage.GetHalfSize();
+  mInverseRotation = mImage.GetTransformMatrix().inverse();
+
+  if (mOutputFilename != "") mImage.Write(mOutputFilename);
+
+  GateMessage("Physic", 1, "WeightWindow: importance map " << mImage.GetResolution()
+              << " voxels, importance in [" << mImage.GetMinValue() << ", " << mImage.GetMaxValue()
+              << "], window ratio " << mWindowRatio << Gateendl);
+  mIsInitialized = true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Importance inversely proportional to the forward fluence: the population
+// of particles is then roughly uniform over the map.
+void GateImportanceMap::GenerateFromFluence()
+{
+  mImage.Read(mFluenceFilename);
+  const G4double max = mImage.GetMaxValue();
+  if (max <= 0) GateError("WeightWindow: the fluence image " << mFluenceFilename << " is empty" << Gateendl);
+  for (GateImage::iterator it = mImage.begin(); it != mImage.end(); ++it) {
+    if (*it <= 0) *it = mMaximumImportance;
+    else *it = std::min(max/(*it), mMaximumImportance);
+  }
+}
+//-----------------------------------------------------------------------------
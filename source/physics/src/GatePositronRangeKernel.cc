@@ -0,0 +1,176 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4UnitsTable.hh>
+
+#include "GatePositronRangeKernel.hh"
+#include "GateMessageManager.hh"
+
+//-----------------------------------------------------------------------------
+namespace {
+  // Beta+ branches (endpoint energy, intensity) and atomic number of the daughter
+  struct Branch {
+    G4double endpoint;
+    G4double intensity;
+  };
+  struct Isotope {
+    const char * name;
+    G4int daughterZ;
+    std::vector<Branch> branches;
+  };
+  const std::vector<Isotope> & GetIsotopes()
+  {
+    static const std::vector<Isotope> isotopes = {
+      { "F18",   8, { {0.6335*MeV, 0.9686} } },
+      { "C11",   5, { {0.9601*MeV, 0.9976} } },
+      { "N13",   6, { {1.1985*MeV, 0.9980} } },
+      { "O15",   7, { {1.7320*MeV, 0.9990} } },
+      { "Cu64", 28, { {0.6531*MeV, 0.1752} } },
+      { "Ga68", 30, { {1.8991*MeV, 0.8794}, {0.8222*MeV, 0.0119} } },
+      { "Rb82", 36, { {3.3780*MeV, 0.8176}, {2.6010*MeV, 0.1306} } },
+      { "Zr89", 39, { {0.9017*MeV, 0.2274} } },
+      { "I124", 52, { {2.1376*MeV, 0.1070}, {1.5348*MeV, 0.1170} } }
+    };
+    return isotopes;
+  }
+
+  // CDF of the 3D density exp(-r/lambda) truncated at range
+  G4double TruncatedExponentialCDF(G4double r, G4double range, G4double lambda)
+  {
+    auto g = [](G4double t) { return 2.0 - std::exp(-t)*(t*t + 2*t + 2); };
+    if (r >= range) return 1.0;
+    return g(r/lambda)/g(range/lambda);
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GatePositronRangeKernel::GatePositronRangeKernel(const G4String & isotope)
+{
+  mIsotope = isotope;
+  mMeanDistance = 0;
+
+  // Exponential fits in water of the former implementation
+  if (isotope == "Fluor18") mComponents.push_back({1.0, 2.0*mm, 0.7*mm});
+  else if (isotope == "Carbon11") mComponents.push_back({1.0, 4.0*mm, 1.4*mm});
+  else if (isotope == "Oxygen15") mComponents.push_back({1.0, 8.0*mm, 2.4*mm});
+  else {
+    const Isotope * iso = 0;
+    for (size_t i = 0; i < GetIsotopes().size(); i++)
+      if (isotope == GetIsotopes()[i].name) iso = &GetIsotopes()[i];
+    if (!iso)
+      GateError("Positron range: unknown isotope '" << isotope << "', use one of: "
+                << GetIsotopeNames() << Gateendl);
+    for (size_t b = 0; b < iso->branches.size(); b++)
+      AddSpectrum(iso->branches[b].endpoint, iso->branches[b].intensity, iso->daughterZ);
+  }
+  BuildTable();
+
+  GateMessage("Beam", 1, "Positron range kernel of " << isotope << " in water: mean "
+              << G4BestUnit(mMeanDistance, "Length") << ", max "
+              << G4BestUnit(GetMaximumDistance(), "Length") << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4String GatePositronRangeKernel::GetIsotopeNames()
+{
+  G4String names = "Fluor18 Carbon11 Oxygen15";
+  for (size_t i = 0; i < GetIsotopes().size(); i++)
+    names += G4String(" ") + GetIsotopes()[i].name;
+  return names;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Katz-Penfold CSDA range of electrons, in water
+G4double GatePositronRangeKernel::GetCSDARange(G4double energy)
+{
+  G4double T = energy/MeV;
+  if (T <= 0) return 0;
+  G4double r; // g/cm2
+  if (T < 2.5) r = 0.412*std::pow(T, 1.265 - 0.0954*std::log(T));
+  else r = 0.530*T - 0.106;
+  return r*cm;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Allowed beta+ spectrum p W (W0-W)^2 F(-Z,W), with the non relativistic
+// Fermi function, split into monoenergetic components
+void GatePositronRangeKernel::AddSpectrum(G4double endpoint, G4double intensity, G4int daughterZ)
+{
+  const int nbBins = 200;
+  const G4double W0 = endpoint/electron_mass_c2 + 1;
+  std::vector<G4double> n(nbBins);
+  G4double sum = 0;
+  for (int i = 0; i < nbBins; i++) {
+    G4double T = (i + 0.5)*endpoint/nbBins;
+    G4double W = T/electron_mass_c2 + 1;
+    G4double p = std::sqrt(W*W - 1);
+    G4double eta = -daughterZ*fine_structure_const*W/p;
+    G4double F = 2*pi*eta/(1 - std::exp(-2*pi*eta));
+    n[i] = p*W*(W0 - W)*(W0 - W)*F;
+    sum += n[i];
+  }
+  for (int i = 0; i < nbBins; i++) {
+    G4double range = GetCSDARange((i + 0.5)*endpoint/nbBins);
+    mComponents.push_back({intensity*n[i]/sum, range, range/4.0});
+  }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GatePositronRangeKernel::BuildTable()
+{
+  G4double max = 0;
+  G4double total = 0;
+  for (size_t c = 0; c < mComponents.size(); c++) {
+    max = std::max(max, mComponents[c].range);
+    total += mComponents[c].weight;
+  }
+
+  // CDF on a fine radial grid
+  const int nbR = 4096;
+  std::vector<G4double> cdf(nbR+1);
+  for (int i = 0; i <= nbR; i++) {
+    G4double r = i*max/nbR;
+    G4double v = 0;
+    for (size_t c = 0; c < mComponents.size(); c++)
+      v += mComponents[c].weight*TruncatedExponentialCDF(r, mComponents[c].range, mComponents[c].lambda);
+    cdf[i] = v/total;
+  }
+  cdf[nbR] = 1.0;
+
+  mMeanDistance = 0;
+  for (int i = 0; i < nbR; i++) mMeanDistance += (i + 0.5)*max/nbR*(cdf[i+1] - cdf[i]);
+
+  // Inverse CDF, linear between the grid points
+  const int nbU = 1024;
+  mInverseCDF.resize(nbU+1);
+  int i = 0;
+  for (int k = 0; k <= nbU; k++) {
+    G4double u = (G4double)k/nbU;
+    while (i < nbR-1 && cdf[i+1] < u) i++;
+    G4double d = cdf[i+1] - cdf[i];
+    G4double f = (d > 0 ? (u - cdf[i])/d : 0);
+    mInverseCDF[k] = (i + std::min(1.0, std::max(0.0, f)))*max/nbR;
+  }
+  mComponents.clear();
+}
+//-----------------------------------------------------------------------------
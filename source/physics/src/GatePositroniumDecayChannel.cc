@@ -9,6 +9,9 @@
 #include "G4DecayProducts.hh"
 #include "Randomize.hh"
 #include "G4LorentzVector.hh"
+#include "G4RandomDirection.hh"
+#include <algorithm>
+#include <cmath>
 
 GatePositroniumDecayChannel::GatePositroniumDecayChannel(const G4String& theParentName, G4double theBR)
 {
@@ -41,6 +44,8 @@ GatePositroniumDecayChannel::GatePositroniumDecayChannel(const G4String& thePare
  SetParent( theParentName );
  SetNumberOfDaughters( daughters_number );
  for ( G4int daughter_index = 0; daughter_index < daughters_number; ++daughter_index ) { SetDaughter( daughter_index, kDaughterName ); }
+
+ if ( fPositroniumKind == GatePositroniumDecayChannel::PositroniumKind::OrthoPositronium ) { BuildOrthoPsTable(); }
 }
 
 GatePositroniumDecayChannel::~GatePositroniumDecayChannel() {}
@@ -80,31 +85,28 @@ G4DecayProducts* GatePositroniumDecayChannel::DecayParaPositronium()
 
 G4DecayProducts* GatePositroniumDecayChannel::DecayOrthoPositronium()
 {
- G4LorentzVector lv_gamma_1, lv_gamma_2, lv_gamma_3;
- G4double weight = 0.0, random_weight = 0.0;
- G4DecayProducts* decay_products = nullptr;
- G4DynamicParticle* gamma_1 = nullptr;
- G4DynamicParticle* gamma_2 = nullptr;
- G4DynamicParticle* gamma_3 = nullptr;
-
- do
- {
-  if ( decay_products != nullptr ) {  delete decay_products; }
-
-  decay_products = G4GeneralPhaseSpaceDecay::DecayIt();
-
-  gamma_1 = (*decay_products)[0];
-  gamma_2 = (*decay_products)[1];
-  gamma_3 = (*decay_products)[2];
-
-  lv_gamma_1 = gamma_1->Get4Momentum();
-  lv_gamma_2 = gamma_2->Get4Momentum();
-  lv_gamma_3 = gamma_3->Get4Momentum();
-
-  weight = GetOrthoPsM( lv_gamma_1.e(), lv_gamma_2.e(), lv_gamma_3.e() );
-  random_weight = kOrthoPsMMax * G4UniformRand();
- }
- while( random_weight > weight );
+ ///Gammas energies sampled directly from the matrix element (no trial decays)
+ G4double w1 = 0.0, w2 = 0.0, w3 = 0.0;
+ SampleOrthoPsEnergies( w1, w2, w3 );
+
+ ///Momenta: p1 isotropic, p2 at angle theta12 around p1, p3 = -(p1 + p2)
+ G4ThreeVector direction_gamma_1 = G4RandomDirection();
+ G4double cos_theta_12 = ( w3 * w3 - w1 * w1 - w2 * w2 ) / ( 2.0 * w1 * w2 );
+ cos_theta_12 = std::min( 1.0, std::max( -1.0, cos_theta_12 ) );
+ G4double sin_theta_12 = std::sqrt( 1.0 - cos_theta_12 * cos_theta_12 );
+ G4double phi = twopi * G4UniformRand();
+ G4ThreeVector a0 = GetPerpendicularVector( direction_gamma_1 ).unit();
+ G4ThreeVector b0 = direction_gamma_1.cross( a0 );
+ G4ThreeVector direction_gamma_2 = cos_theta_12 * direction_gamma_1 + sin_theta_12 * ( std::cos( phi ) * a0 + std::sin( phi ) * b0 );
+ G4ThreeVector direction_gamma_3 = -( w1 * direction_gamma_1 + w2 * direction_gamma_2 ).unit();
+
+ CheckAndFillParent();
+ CheckAndFillDaughters();
+ G4DecayProducts* decay_products = new G4DecayProducts( G4DynamicParticle( G4MT_parent, G4ThreeVector( 0.0, 0.0, 0.0 ), 0.0 ) );
+
+ G4DynamicParticle* gamma_1 = new G4DynamicParticle( G4MT_daughters[0], direction_gamma_1, w1 );
+ G4DynamicParticle* gamma_2 = new G4DynamicParticle( G4MT_daughters[1], direction_gamma_2, w2 );
+ G4DynamicParticle* gamma_3 = new G4DynamicParticle( G4MT_daughters[2], direction_gamma_3, w3 );
 
  ///Polarization
  G4ThreeVector polarization_gamma_1 = GetPolarization( gamma_1->GetMomentumDirection() );
@@ -115,9 +117,68 @@ G4DecayProducts* GatePositroniumDecayChannel::DecayOrthoPositronium()
  gamma_2->SetPolarization( polarization_gamma_2.x(), polarization_gamma_2.y(), polarization_gamma_2.z() );
  gamma_3->SetPolarization( polarization_gamma_3.x(), polarization_gamma_3.y(), polarization_gamma_3.z() ); 
 
+ decay_products->PushProducts( gamma_1 );
+ decay_products->PushProducts( gamma_2 );
+ decay_products->PushProducts( gamma_3 );
+
  return decay_products; 
 }
 
+void GatePositroniumDecayChannel::BuildOrthoPsTable()
+{
+ ///Physical region: w1, w2, w3 <= m and w1 + w2 + w3 = 2m, i.e. w1,w2 in [0,m] with w1 + w2 >= m
+ const G4int n = kOrthoPsGridSize;
+ const G4double cell_width = kElectronMass / n;
+ std::vector<G4double> weights( n * n, 0.0 );
+ fOrthoPsCellMax.assign( n * n, 0.0 );
+
+ for ( G4int i = 0; i < n; ++i )
+ {
+  for ( G4int j = 0; j < n; ++j )
+  {
+   ///Cell entirely outside the physical region
+   if ( i + j + 2 <= n ) { continue; }
+
+   ///Largest energies reached in the cell (w3 is largest at the lowest w1, w2)
+   G4double w1 = ( i + 1 ) * cell_width;
+   G4double w2 = ( j + 1 ) * cell_width;
+   G4double w3 = std::min( kElectronMass, 2.0 * kElectronMass - i * cell_width - j * cell_width );
+   G4double cell_max = GetOrthoPsMUpperBound( w1, w2, w3 );
+   fOrthoPsCellMax[i * n + j] = cell_max;
+   weights[i * n + j] = cell_max * cell_width * cell_width;
+  }
+ }
+
+ fOrthoPsTable.Build( weights );
+}
+
+G4double GatePositroniumDecayChannel::GetOrthoPsMUpperBound( const G4double w1_max, const G4double w2_max, const G4double w3_max ) const
+{
+ ///With w1 + w2 + w3 = 2m, each term of GetOrthoPsM() is f(wj,wk)^2 with
+ ///f(u,v) = (u + v - m)/(u v) = (1 - (m/u - 1)(m/v - 1))/m, which lies in [0,1/m]
+ ///and increases with u and v on the physical region: the bound is exact at the corners
+ auto f = [this]( G4double u, G4double v ) { return ( 1.0 - ( kElectronMass / u - 1.0 ) * ( kElectronMass / v - 1.0 ) ) / kElectronMass; };
+ return pow( f( w2_max, w3_max ), 2 ) + pow( f( w1_max, w3_max ), 2 ) + pow( f( w1_max, w2_max ), 2 );
+}
+
+void GatePositroniumDecayChannel::SampleOrthoPsEnergies( G4double& w1, G4double& w2, G4double& w3 ) const
+{
+ const G4int n = kOrthoPsGridSize;
+ const G4double cell_width = kElectronMass / n;
+
+ while ( true )
+ {
+  size_t cell = fOrthoPsTable.Sample();
+  G4int i = cell / n;
+  G4int j = cell % n;
+  w1 = ( i + G4UniformRand() ) * cell_width;
+  w2 = ( j + G4UniformRand() ) * cell_width;
+  if ( w1 + w2 < kElectronMass ) { continue; }
+  w3 = 2.0 * kElectronMass - w1 - w2;
+  if ( fOrthoPsCellMax[cell] * G4UniformRand() <= GetOrthoPsM( w1, w2, w3 ) ) { return; }
+ }
+}
+
 G4double GatePositroniumDecayChannel::GetOrthoPsM( const G4double w1, const G4double w2, const G4double w3 ) const
 {
  return pow( ( kElectronMass - w1 ) / ( w2 * w3 ), 2 ) + pow( ( kElectronMass - w2 ) / ( w1 * w3 ), 2 ) + pow( ( kElectronMass - w3 ) / ( w1 * w2 ), 2 );
@@ -12,6 +12,7 @@
 #include "GateVSourceVoxelReader.hh"
 
 #include "GateVoxelCompressor.hh"
+#include "GateInterfileFrameCache.hh"
 
 #include "GateVVolume.hh"
 #include "GateCompressedVoxelParam.hh"
@@ -62,6 +63,24 @@ G4int GateRTVPhantom::GetNbOfFrames()
 void   GateRTVPhantom::SetNbOfFrames( G4int aNb )
 { NbOfFrames = aNb;}
 
+void   GateRTVPhantom::SetFrameCacheSize( G4int n )
+{ GateInterfileFrameCache::GetInstance()->SetMaxNumberOfFrames( n );}
+
+void   GateRTVPhantom::SetFramePrefetch( G4bool b )
+{ GateInterfileFrameCache::GetInstance()->SetPrefetchEnabled( b );}
+
+G4int GateRTVPhantom::GetFrameIndex( G4double aTime )
+{
+  G4int k = 1;
+  if ( GetNbOfFrames() > 1 )
+  {
+    k = (G4int)( floor( aTime / GetTPF() ) ) + 1;
+    k = k % GetNbOfFrames(); // get k modulo the number of frames
+  }
+  if ( k == 0 ) { k = 1; }
+  return k;
+}
+
 void   GateRTVPhantom::SetBaseFileName( G4String aFN ) 
 { base_FN = aFN;
   if ( header_FN == G4String("NotDefined") )
@@ -96,20 +115,12 @@ void GateRTVPhantom::Compute(G4double aTime)
 
      G4double time_s = aTime/s;
 
-cK = 1;
-
-
-if ( GetNbOfFrames() > 1 )
-{
-  cK = (G4int)( floor( aTime / GetTPF() ) ) + 1;
-  cK = cK % GetNbOfFrames(); // get cK modulo the number of frames
-}
-
-if ( cK == 0 ) { cK = 1; }
+cK = GetFrameIndex( aTime );
+G4bool frameHasChanged = ( cK != p_cK && cK <= GetNbOfFrames() );
 std::stringstream st;
 st << cK;
 
-if (  cK != p_cK  && cK <= GetNbOfFrames()  ) 
+if ( frameHasChanged ) 
 {
 
        if ( IsFirstTime == true )
@@ -149,6 +160,10 @@ pixel_width = itsGReader->GetVoxelSize();
 
 //G4cout << " GateRTVPhantom::Compute  AFTER GReader->ReadFile( header_FN, current_FN ) " << XDIM<<" "<<YDIM<<" "<<ZDIM_OUTPUT<< Gateendl;
 
+// the voxel headers only have to be rebuilt if some voxel material changed
+if ( itsGReader->HasFrameChanged() )
+{
+
 // Destroy and reconstruct physical volumes of enclosing box
 //
 // rebuild all the G4VoxelsHeaders for the physical volume  enclosing the NCAT phantom : this is COMPULSORY for G4 NAVIGATION
@@ -169,6 +184,7 @@ if ( G4GeometryManager::GetInstance()->IsGeometryClosed() == false )
 	  m_inserter->Construct(false);
       G4GeometryManager::GetInstance()->CloseGeometry( true, true );
      }
+}
 
 
 /*
@@ -190,7 +206,7 @@ G4cout << " #################### REBUILT Geometry of " << m_inserter->GetPhysica
 
 }
 
-if ( IsFirstTime == true || (  cK != p_cK  && cK <= GetNbOfFrames()  ) )
+if ( IsFirstTime == true || frameHasChanged )
 {
 if ( set_ActAsAtt == 1 ) current_FN = base_FN+"_atn_"+st.str()+".bin";
 else current_FN = base_FN+"_act_"+st.str()+".bin";                     
@@ -199,6 +215,17 @@ itsSReader->Dump(0);
 IsFirstTime = false;
 }
 
+// start reading the files of the next frame while the current one is simulated
+if ( frameHasChanged && GetNbOfFrames() > 1 )
+{
+  std::stringstream nst;
+  nst << GetFrameIndex( aTime + GetTPF() );
+  if ( set_AttAsAct == 1 ) itsGReader->PrefetchRTFile( header_FN, base_FN+"_act_"+nst.str()+".bin" );
+  else itsGReader->PrefetchRTFile( header_FN, base_FN+"_atn_"+nst.str()+".bin" );
+  if ( set_ActAsAtt == 1 ) itsSReader->PrefetchRTFile( header_FN, base_FN+"_atn_"+nst.str()+".bin" );
+  else itsSReader->PrefetchRTFile( header_FN, base_FN+"_act_"+nst.str()+".bin" );
+}
+
 p_cK = cK;
 
 //G4cout << " GateRTVPhantom  :::: UPDATING ACTIVITIES \n";
@@ -15,6 +15,7 @@
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWithABool.hh"
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
 
 GateRTVPhantomMessenger::GateRTVPhantomMessenger(GateRTVPhantom* RTVPhantom)
@@ -60,6 +61,20 @@ GateRTVPhantomMessenger::GateRTVPhantomMessenger(GateRTVPhantom* RTVPhantom)
 
   SetActAsAttCmd = new G4UIcmdWithoutParameter(cmdName,this);
   SetActAsAttCmd->SetGuidance("Sets the Activity Map to be the same as the Attenuation Map for each frame");
+
+  cmdName = GetDirectoryName() + "setFrameCacheSize";
+
+
+  SetFrameCacheSizeCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  SetFrameCacheSizeCmd->SetGuidance("Sets the number of frames kept in memory (0 = no cache). Use the number of frames of a cyclic motion to read each file once.");
+  SetFrameCacheSizeCmd->SetParameterName("Size",false);
+  SetFrameCacheSizeCmd->SetRange("Size>=0");
+
+  cmdName = GetDirectoryName() + "enableFramePrefetch";
+
+
+  SetFramePrefetchCmd = new G4UIcmdWithABool(cmdName,this);
+  SetFramePrefetchCmd->SetGuidance("Reads the files of the next frame in background while the current frame is simulated (default true)");
 }
 
 
@@ -73,6 +88,8 @@ GateRTVPhantomMessenger::~GateRTVPhantomMessenger()
     delete SetTPFCmd;
     delete SetActAsAttCmd;
     delete SetAttAsActCmd;
+    delete SetFrameCacheSizeCmd;
+    delete SetFramePrefetchCmd;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -111,6 +128,12 @@ return;  }
 if( command == SetAttAsActCmd )
 {      m_RTVPhantom->SetAttAsAct();
 return;  }  
+if( command == SetFrameCacheSizeCmd )
+{      m_RTVPhantom->SetFrameCacheSize( SetFrameCacheSizeCmd->GetNewIntValue(newValue) );
+return;  }
+if( command == SetFramePrefetchCmd )
+{      m_RTVPhantom->SetFramePrefetch( SetFramePrefetchCmd->GetNewBoolValue(newValue) );
+return;  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
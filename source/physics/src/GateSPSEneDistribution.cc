@@ -28,7 +28,7 @@ using namespace std;
 GateSPSEneDistribution::GateSPSEneDistribution()
   : G4SPSEneDistribution(), mParticleEnergy(),
     mEnergyRange(), mMode(), mDimSpectrum(),
-    mSumProba(), mTabProba(), mTabSumProba(), mTabEnergy()
+    mSumProba(), mTabProba(), mTabSumProba(), mTabEnergy(), mUserSpectrumTable()
 {
     // Contrary to G4's G4SPSEneDistribution, we decided to initialize
     // the default energy to 0.0 not to 1.0
@@ -230,6 +230,12 @@ void GateSPSEneDistribution::BuildUserSpectrum(G4String fileName)
       G4Exception("GateSPSEneDistribution::BuildUserSpectrum", "BuildUserSpectrum", FatalException, "Spectrum mode is not recognized, check your spectrum file. Use 1,2 or 3 (Discrete/Histogram/Interpolated).");
       break;
     }
+
+    // Alias table of the bin probabilities (differences of the cumulative table)
+    std::vector<G4double> binProba(mTabSumProba.size());
+    for(size_t i = 0; i < mTabSumProba.size(); i++)
+      binProba[i] = mTabSumProba[i] - (i == 0 ? 0. : mTabSumProba[i - 1]);
+    mUserSpectrumTable.Build(binProba);
   } else {
     std::string s = "The User Spectrum file '" + fileName + "' is not found.";
     G4Exception("GateSPSEneDistribution::BuildUserSpectrum", "BuildUserSpectrum", FatalException, s.c_str());
@@ -239,18 +245,31 @@ void GateSPSEneDistribution::BuildUserSpectrum(G4String fileName)
 
 
 //-----------------------------------------------------------------------------
-// Inverse transform sampling
+// Alias sampling of the bin, then inverse transform sampling inside the bin
 void GateSPSEneDistribution::GenerateFromUserSpectrum()
 {
-  G4double pEnergy = 0;
+  mParticleEnergy = SampleUserSpectrumBin(mUserSpectrumTable.Sample());
+}
+//-----------------------------------------------------------------------------
+
 
-  // random cumulative probabability in ]0...1[
-  G4double U = G4UniformRand();
+//-----------------------------------------------------------------------------
+void GateSPSEneDistribution::GenerateFromUserSpectrum(G4int n, std::vector<G4double> & energies)
+{
+  std::vector<size_t> bins;
+  mUserSpectrumTable.Sample(n, bins);
+  energies.resize(n);
+  for(G4int k = 0; k < n; k++) energies[k] = SampleUserSpectrumBin(bins[k]);
+  if (n > 0) mParticleEnergy = energies[n - 1];
+}
+//-----------------------------------------------------------------------------
 
-  // identify corresponding interval of the tabulated cumulative distribution
-  G4int i = 0;
-  while( U >= (mTabSumProba[i] / mSumProba) ) i++;
 
+//-----------------------------------------------------------------------------
+G4double GateSPSEneDistribution::SampleUserSpectrumBin(size_t i) const
+{
+  G4double pEnergy = 0;
+  G4double U;
   G4double delta;
   G4double a, b;
   G4double alpha, beta;
@@ -304,6 +323,6 @@ void GateSPSEneDistribution::GenerateFromUserSpectrum()
 
   }
 
-  mParticleEnergy = pEnergy;
+  return pEnergy;
 }
 //-----------------------------------------------------------------------------
@@ -9,10 +9,17 @@
 
 #include <CLHEP/Vector/ThreeVector.h>
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 #include "Randomize.hh"
 #include "G4TransportationManager.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4PhysicalVolumeStore.hh"
+#include "G4RunManager.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Run.hh"
 
 #include "GateSPSPosDistribution.hh"
 #include "GateMessageManager.hh"
@@ -21,6 +28,19 @@
 GateSPSPosDistribution::GateSPSPosDistribution()
 {
   Forbid = false;
+  mConfine = false;
+  mConfineVolumeName = "NULL";
+  verbosityLevel = 0;
+  mAcceptanceGridResolution = 0;
+  mAcceptanceGridRunID = -1;
+  mAcceptanceGridRadius = 0;
+  mPosRot1 = G4ThreeVector(1.,0.,0.);
+  mPosRot2 = G4ThreeVector(0.,1.,0.);
+  mParAlpha = 0;
+  mParTheta = 0;
+  mParPhi = 0;
+  pPositronRangeKernel = 0;
+  mPositronRangeMaterial = kWater;
 //  VolName = "NULL";
   gNavigator = G4TransportationManager::GetTransportationManager()
     ->GetNavigatorForTracking();
@@ -31,6 +51,7 @@ GateSPSPosDistribution::GateSPSPosDistribution()
 //-----------------------------------------------------------------------------
 GateSPSPosDistribution::~GateSPSPosDistribution()
 { 
+  delete pPositronRangeKernel;
 }
 //-----------------------------------------------------------------------------
 
@@ -47,101 +68,108 @@ void GateSPSPosDistribution::setVerbosity(G4int vL)
 void GateSPSPosDistribution::SetPositronRange( G4String positronType )
 {
   positronrange = positronType ;
+  delete pPositronRangeKernel;
+  pPositronRangeKernel = 0;
+  if (positronrange != "NULL" && positronrange != "")
+    pPositronRangeKernel = new GatePositronRangeKernel(positronrange);
 }
 //-----------------------------------------------------------------------------
 
 
 //-----------------------------------------------------------------------------
-void GateSPSPosDistribution::GeneratePositronRange()
+void GateSPSPosDistribution::SetPositronRangeMaterial( G4String type )
 {
-  G4ThreeVector IsotopeRange;
-
-  G4double rangex = 0. ;
-  G4double rangey = 0. ;
-  G4double rangez = 0. ;
-
-  G4double Z = 0. ;
-  G4double Y = 0. ;
-  G4double X = 0. ;
-
-  G4double R = 1 ;
-  G4double Fit = 0 ;
-
-  if( positronrange == "Fluor18" )
-    {   
-      while( R >= Fit || R > 2.0 )
-        {
-          X = CLHEP::RandFlat::shoot( -2.0, 2.0 ) ; // Rangemin ; Rangemax	 
-          Y = CLHEP::RandFlat::shoot( -2.0, 2.0 ) ; // Rangemin ; Rangemax	 
-          Z = CLHEP::RandFlat::shoot( -2.0, 2.0 ) ; // Rangemin ; Rangemax
-     	 
-          Fit = CLHEP::RandExponential::shoot( 0.7 ) ;
-	 
-          R = sqrt( X*X + Y*Y + Z*Z ) ;
-	 
-          rangex = X ;
-          rangey = Y ;
-          rangez = Z ;
-        }
-	  
-      IsotopeRange.setX( rangex ) ;
-      IsotopeRange.setY( rangey ) ;
-      IsotopeRange.setZ( rangez ) ;
-  
-      particle_position += IsotopeRange ;
+  if (type == "water") mPositronRangeMaterial = kWater;
+  else if (type == "local") mPositronRangeMaterial = kLocal;
+  else if (type == "transport") mPositronRangeMaterial = kTransport;
+  else GateError("Positron range material must be water, local or transport, not '" << type << "'" << Gateendl);
+}
+//-----------------------------------------------------------------------------
 
-    }
 
-  if( positronrange == "Carbon11" )
-    {  
-      while( R >= Fit || R > 4.0 )
-        {
-          X = CLHEP::RandFlat::shoot(-4.0, 4.0 ) ; // Rangemin ; Rangemax	 
-          Y = CLHEP::RandFlat::shoot(-4.0, 4.0 ) ; // Rangemin ; Rangemax	 
-          Z = CLHEP::RandFlat::shoot(-4.0, 4.0 ) ; // Rangemin ; Rangemax	 
-	 
-          Fit = CLHEP::RandExponential::shoot(1.4) ;
-	 
-          R = sqrt( X*X + Y*Y + Z*Z ) ;
-	 
-          rangex = X ;
-          rangey = Y ;
-          rangez = Z ;
-        }
-	  
-      IsotopeRange.setX( rangex ) ;
-      IsotopeRange.setY( rangey ) ;
-      IsotopeRange.setZ( rangez ) ;
-  
-      particle_position += IsotopeRange ;
- 
+//-----------------------------------------------------------------------------
+G4Material * GateSPSPosDistribution::GetMaterial(const G4ThreeVector & position,
+                                                 const G4ThreeVector & direction)
+{
+  // Parameterised volumes update the material of their logical volume
+  G4VPhysicalVolume * volume = gNavigator->LocateGlobalPointAndSetup(position, &direction, true);
+  if (!volume) return 0;
+  return volume->GetLogicalVolume()->GetMaterial();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Isotropic displacement with a tabulated water-equivalent distance, scaled
+// by the density of the material at the emission point (local) or of the
+// materials crossed by the path (transport). In these two modes, a position
+// displaced out of the world is drawn again from the same emission point.
+void GateSPSPosDistribution::GeneratePositronRange()
+{
+  const G4ThreeVector start = particle_position;
+  G4Material * material = 0;
+  for (G4int nbShoot = 0; nbShoot < 1000; nbShoot++) {
+    const G4double cosTheta = 2*G4UniformRand() - 1;
+    const G4double sinTheta = std::sqrt(1 - cosTheta*cosTheta);
+    const G4double phi = twopi*G4UniformRand();
+    const G4ThreeVector direction(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+    G4double distance = pPositronRangeKernel->SampleDistance(G4UniformRand());
+
+    if (mPositronRangeMaterial == kWater) {
+      particle_position = start + distance*direction;
+      return;
     }
- 
-  if( positronrange == "Oxygen15" )
-    {  
-      while( R >= Fit || R > 8.0 )
-        {
-          X = CLHEP::RandFlat::shoot(-8.0,8.0) ; // Rangemin ; Rangemax	 
-          Y = CLHEP::RandFlat::shoot(-8.0,8.0) ; // Rangemin ; Rangemax	 
-          Z = CLHEP::RandFlat::shoot(-8.0,8.0) ; // Rangemin ; Rangemax	 
-	 
-          Fit = CLHEP::RandExponential::shoot( 2.4 ) ;
-	 
-          R = sqrt( X*X + Y*Y + Z*Z ) ;
-	 
-          rangex = X ;
-          rangey = Y ;
-          rangez = Z ;
-        }
-	  
-      IsotopeRange.setX( rangex ) ;
-      IsotopeRange.setY( rangey ) ;
-      IsotopeRange.setZ( rangez ) ;
- 
-      particle_position += IsotopeRange ;
-  
+    if (nbShoot == 0) material = GetMaterial(start, direction);
+    // Emission point out of the world
+    if (!material) {
+      particle_position = start + distance*direction;
+      return;
     }
+    particle_position = start;
+    if (DisplacePositron(material, direction, distance)) return;
+  }
+  // The emission point is at the edge of the world: no displacement
+  particle_position = start;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Moves particle_position by a water-equivalent distance, starting in the
+// given material. Returns false if the position ends out of the world.
+G4bool GateSPSPosDistribution::DisplacePositron(G4Material * material,
+                                                const G4ThreeVector & direction,
+                                                G4double distance)
+{
+  const G4double water = 1.0*g/cm3;
+  G4ThreeVector end = particle_position + distance*water/material->GetDensity()*direction;
+  if (mPositronRangeMaterial == kLocal) {
+    particle_position = end;
+    return GetMaterial(end, direction) != 0;
+  }
+  if (GetMaterial(end, direction) == material) {
+    particle_position = end;
+    return true;
+  }
 
+  // Another material is crossed: small steps, each one scaled by the
+  // density of its starting point
+  const G4double step = 0.1*mm;
+  G4int nbSteps = 0;
+  while (distance > 0 && material && nbSteps < 100000) {
+    G4double length = std::min(step, distance*water/material->GetDensity());
+    particle_position += length*direction;
+    distance -= length*material->GetDensity()/water;
+    material = GetMaterial(particle_position, direction);
+    nbSteps++;
+  }
+  if (!material) return false;
+  // Too many steps (gas): the end is done in water
+  if (distance > 0) {
+    particle_position += distance*direction;
+    return GetMaterial(particle_position, direction) != 0;
+  }
+  return true;
 }
 //-----------------------------------------------------------------------------
 
@@ -163,6 +191,8 @@ G4ThreeVector GateSPSPosDistribution::GenerateOne()
     srcconf = true;
 */
 
+  if (CanUseAcceptanceGrid()) return GenerateOneFromAcceptanceGrid();
+
   G4bool shootAgain = true;
   G4int nbShoot = 0;
   G4int limitShoot = 1000000;
@@ -177,13 +207,19 @@ G4ThreeVector GateSPSPosDistribution::GenerateOne()
         SetPosDisType("Point");
         particle_position = G4SPSPosDistribution::GenerateOne() ;
       }      
-    if( positronrange != "NULL" )
+    // The confinement applies before the positron range
+    if (mConfine && !IsPositionAllowed(particle_position, true, false))
+      {
+        nbShoot++;
+        continue;
+      }
+    if( pPositronRangeKernel )
       {
         GeneratePositronRange() ;
       }
     if (Forbid)
       {
-        shootAgain = IsSourceForbidden();
+        shootAgain = !IsPositionAllowed(particle_position, false, true);
       }
     else
       {
@@ -246,28 +282,384 @@ void GateSPSPosDistribution::ForbidSourceToVolume( const G4String& Vname )
 
 
 //-----------------------------------------------------------------------------
-G4bool GateSPSPosDistribution::IsSourceForbidden()
+void GateSPSPosDistribution::ConfineSourceToVolume( const G4String& Vname )
+{
+  mConfine = false;
+  mConfineVolumeName = "NULL";
+  if (Vname == "NULL") {
+    G4cout << " Ignoring confinement\n";
+    return;
+  }
+  G4PhysicalVolumeStore *PVStore = G4PhysicalVolumeStore::GetInstance();
+  for (size_t i = 0; i < PVStore->size(); i++)
+    if ((*PVStore)[i]->GetName() == Vname) {
+      mConfine = true;
+      mConfineVolumeName = Vname;
+      G4cout << " Source confined to volume '" << Vname << "'\n";
+      return;
+    }
+  G4cout << " **** Error: Volume does not exist **** \n";
+  G4cout << " Ignoring confine condition for volume '" << Vname << "'\n";
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::SetPosRot1(G4ThreeVector v)
+{
+  mPosRot1 = v;
+  mAcceptanceGridParameters.clear();
+  G4SPSPosDistribution::SetPosRot1(v);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::SetPosRot2(G4ThreeVector v)
+{
+  mPosRot2 = v;
+  mAcceptanceGridParameters.clear();
+  G4SPSPosDistribution::SetPosRot2(v);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::SetParAlpha(G4double a)
+{
+  mParAlpha = a;
+  mAcceptanceGridParameters.clear();
+  G4SPSPosDistribution::SetParAlpha(a);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::SetParTheta(G4double a)
+{
+  mParTheta = a;
+  mAcceptanceGridParameters.clear();
+  G4SPSPosDistribution::SetParTheta(a);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::SetParPhi(G4double a)
+{
+  mParPhi = a;
+  mAcceptanceGridParameters.clear();
+  G4SPSPosDistribution::SetParPhi(a);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateSPSPosDistribution::IsPositionAllowed(const G4ThreeVector & position,
+                                                  G4bool confinement, G4bool forbidden)
 {
-  // Method to check point is within the volume specified
-  if(Forbid == false)
-    G4cout << "Error: Forbid is false\n";
+  // Same test as G4SPSPosDistribution::IsSourceConfined: the point must be
+  // in the confinement volume itself. And not in a forbidden volume.
   G4ThreeVector null(0.,0.,0.);
   G4ThreeVector *ptr = &null;
+  G4VPhysicalVolume *currentVolume = gNavigator->LocateGlobalPointAndSetup(position,ptr,true);
 
-  // Check particle_position is within VolName, if so true, 
-  // else false
-  G4VPhysicalVolume *currentVolume = gNavigator->LocateGlobalPointAndSetup(particle_position,ptr,true);
-
-  G4bool isForbidden = false;
-  for (std::vector<G4VPhysicalVolume*>::iterator itr=ForbidVector.begin(); itr!=ForbidVector.end(); itr++)
-  {
-    if (currentVolume==*itr)
+  if (confinement && mConfine && (!currentVolume || currentVolume->GetName() != mConfineVolumeName))
+    return false;
+  if (forbidden)
+    for (std::vector<G4VPhysicalVolume*>::iterator itr=ForbidVector.begin(); itr!=ForbidVector.end(); itr++)
     {
-      isForbidden = true;
-      break;
+      if (currentVolume==*itr) return false;
     }
+  return true;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// The grid needs a uniform density in a convex shape: volume shapes only,
+// without positron range
+G4bool GateSPSPosDistribution::CanUseAcceptanceGrid()
+{
+  if (mAcceptanceGridResolution <= 0 || (!Forbid && !mConfine)) return false;
+  if (pPositronRangeKernel) return false;
+  if (GetPosDisType() != "Volume") return false;
+  G4String shape = GetPosDisShape();
+  return (shape == "Sphere" || shape == "Ellipsoid" || shape == "Cylinder" ||
+          shape == "EllipticCylinder" || shape == "Para");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Everything the grid depends on. The run ID is included because volumes
+// may move between runs.
+std::vector<G4double> GateSPSPosDistribution::GetAcceptanceGridParameters()
+{
+  std::vector<G4double> p;
+  const G4Run * run = G4RunManager::GetRunManager()->GetCurrentRun();
+  p.push_back(run ? run->GetRunID() : -1);
+  p.push_back(mAcceptanceGridResolution);
+  G4String shape = GetPosDisShape();
+  for (size_t i = 0; i < shape.size(); i++) p.push_back(shape[i]);
+  for (int i = 0; i < 3; i++) {
+    p.push_back(GetCentreCoords()[i]);
+    p.push_back(mPosRot1[i]);
+    p.push_back(mPosRot2[i]);
+  }
+  p.push_back(GetHalfX());
+  p.push_back(GetHalfY());
+  p.push_back(GetHalfZ());
+  p.push_back(GetRadius());
+  p.push_back(mParAlpha);
+  p.push_back(mParTheta);
+  p.push_back(mParPhi);
+  p.push_back(mConfine);
+  p.push_back(ForbidVector.size());
+  return p;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// The full parameters are only compared when the run, the centre (moved at
+// each event by some sources) or the size changed, or after a setter
+// recorded here was called (cleared parameters)
+void GateSPSPosDistribution::UpdateAcceptanceGrid()
+{
+  const G4Run * run = G4RunManager::GetRunManager()->GetCurrentRun();
+  const G4int runID = run ? run->GetRunID() : -1;
+  const G4ThreeVector size(GetHalfX(), GetHalfY(), GetHalfZ());
+  if (!mAcceptanceGridParameters.empty() && runID == mAcceptanceGridRunID &&
+      GetCentreCoords() == mAcceptanceGridCentre && size == mAcceptanceGridHalfSize &&
+      GetRadius() == mAcceptanceGridRadius) return;
+
+  std::vector<G4double> p = GetAcceptanceGridParameters();
+  if (p != mAcceptanceGridParameters) {
+    mAcceptanceGridParameters = p;
+    BuildAcceptanceGrid();
   }
-  return isForbidden;
+  mAcceptanceGridRunID = runID;
+  mAcceptanceGridCentre = GetCentreCoords();
+  mAcceptanceGridHalfSize = size;
+  mAcceptanceGridRadius = GetRadius();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4bool GateSPSPosDistribution::IsInsideShape(const G4ThreeVector & position)
+{
+  // Local coordinates, same rotation as G4SPSPosDistribution
+  G4ThreeVector rx = mPosRot1.unit();
+  G4ThreeVector rz = mPosRot1.cross(mPosRot2).unit();
+  G4ThreeVector ry = rz.cross(rx).unit();
+  G4ThreeVector l = position - GetCentreCoords();
+  G4double x = l.dot(rx);
+  G4double y = l.dot(ry);
+  G4double z = l.dot(rz);
+
+  G4String shape = GetPosDisShape();
+  G4double hx = GetHalfX();
+  G4double hy = GetHalfY();
+  G4double hz = GetHalfZ();
+  G4double r = GetRadius();
+  if (shape == "Sphere") return x*x + y*y + z*z <= r*r;
+  if (shape == "Ellipsoid") return (x*x)/(hx*hx) + (y*y)/(hy*hy) + (z*z)/(hz*hz) <= 1.0;
+  if (shape == "Cylinder") return x*x + y*y <= r*r && std::fabs(z) <= hz;
+  if (shape == "EllipticCylinder") return (x*x)/(hx*hx) + (y*y)/(hy*hy) <= 1.0 && std::fabs(z) <= hz;
+  // Para: inverse of the shear applied by G4SPSPosDistribution
+  y -= z*std::tan(mParTheta)*std::sin(mParPhi);
+  x -= z*std::tan(mParTheta)*std::cos(mParPhi) + y*std::tan(mParAlpha);
+  return std::fabs(x) <= hx && std::fabs(y) <= hy && std::fabs(z) <= hz;
 }
 //-----------------------------------------------------------------------------
 
+
+//-----------------------------------------------------------------------------
+G4double GateSPSPosDistribution::GetShapeBoundingRadius()
+{
+  G4String shape = GetPosDisShape();
+  G4double hx = GetHalfX();
+  G4double hy = GetHalfY();
+  G4double hz = GetHalfZ();
+  G4double r = GetRadius();
+  if (shape == "Sphere") return r;
+  if (shape == "Ellipsoid") return std::max(hx, std::max(hy, hz));
+  if (shape == "Cylinder") return std::sqrt(r*r + hz*hz);
+  if (shape == "EllipticCylinder") return std::sqrt(std::max(hx, hy)*std::max(hx, hy) + hz*hz);
+  // Para: farthest corner
+  G4double max = 0;
+  for (int i = -1; i <= 1; i += 2)
+    for (int j = -1; j <= 1; j += 2)
+      for (int k = -1; k <= 1; k += 2) {
+        G4double z = k*hz;
+        G4double y = j*hy + z*std::tan(mParTheta)*std::sin(mParPhi);
+        G4double x = i*hx + z*std::tan(mParTheta)*std::cos(mParPhi) + j*hy*std::tan(mParAlpha);
+        max = std::max(max, std::sqrt(x*x + y*y + z*z));
+      }
+  return max;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Lower bound of the distance from a point to the shape (0 inside)
+G4double GateSPSPosDistribution::GetShapeDistanceLowerBound(const G4ThreeVector & position)
+{
+  G4ThreeVector rx = mPosRot1.unit();
+  G4ThreeVector rz = mPosRot1.cross(mPosRot2).unit();
+  G4ThreeVector ry = rz.cross(rx).unit();
+  G4ThreeVector l = position - GetCentreCoords();
+  G4double x = l.dot(rx);
+  G4double y = l.dot(ry);
+  G4double z = l.dot(rz);
+
+  G4String shape = GetPosDisShape();
+  G4double hx = GetHalfX();
+  G4double hy = GetHalfY();
+  G4double hz = GetHalfZ();
+  G4double r = GetRadius();
+  G4double dz = std::max(std::fabs(z) - hz, 0.);
+  if (shape == "Sphere") return std::max(std::sqrt(x*x + y*y + z*z) - r, 0.);
+  if (shape == "Cylinder") {
+    G4double dr = std::max(std::sqrt(x*x + y*y) - r, 0.);
+    return std::sqrt(dr*dr + dz*dz);
+  }
+  // Ellipses: the scaled norm q exceeds 1 by at most distance/smallest axis
+  if (shape == "Ellipsoid") {
+    G4double q = std::sqrt((x*x)/(hx*hx) + (y*y)/(hy*hy) + (z*z)/(hz*hz));
+    return std::max(q - 1., 0.) * std::min(hx, std::min(hy, hz));
+  }
+  if (shape == "EllipticCylinder") {
+    G4double q = std::sqrt((x*x)/(hx*hx) + (y*y)/(hy*hy));
+    G4double dr = std::max(q - 1., 0.) * std::min(hx, hy);
+    return std::sqrt(dr*dr + dz*dz);
+  }
+  // Para: distance to the box in the unsheared frame, divided by the norm
+  // of the inverse shear (Frobenius norm, an upper bound of it)
+  G4double ta = std::tan(mParAlpha);
+  G4double tc = std::tan(mParTheta)*std::cos(mParPhi);
+  G4double ts = std::tan(mParTheta)*std::sin(mParPhi);
+  y -= z*ts;
+  x -= z*tc + y*ta;
+  G4double dx = std::max(std::fabs(x) - hx, 0.);
+  G4double dy = std::max(std::fabs(y) - hy, 0.);
+  G4double norm = std::sqrt(3. + ta*ta + ts*ts + (tc - ts*ta)*(tc - ts*ta));
+  return std::sqrt(dx*dx + dy*dy + dz*dz) / norm;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// 0: outside, 1: inside, 2: boundary. The shape is convex: a cell is inside
+// it when its 8 corners are, and outside when the distance to the shape
+// exceeds the half diagonal. For the volumes, the navigator safety at the
+// centre tells whether a boundary may cross the cell, whatever the size of
+// the volumes; if not, the whole cell is allowed or forbidden like its centre.
+void GateSPSPosDistribution::ClassifyAcceptanceGridCells(const G4ThreeVector & origin, G4int n,
+                                                         G4double size, std::vector<char> & type)
+{
+  const int m = n+1;
+  std::vector<char> corner(m*m*m);
+  for (int k = 0; k < m; k++)
+    for (int j = 0; j < m; j++)
+      for (int i = 0; i < m; i++)
+        corner[i + j*m + k*m*m] = IsInsideShape(origin + G4ThreeVector(i, j, k)*size);
+
+  const G4double halfDiagonal = 0.5*std::sqrt(3.)*size;
+  type.resize(n*n*n);
+  for (int k = 0; k < n; k++)
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < n; i++) {
+        char & t = type[i + j*n + k*n*n];
+        G4ThreeVector centre = origin + G4ThreeVector(i+0.5, j+0.5, k+0.5)*size;
+        if (GetShapeDistanceLowerBound(centre) > halfDiagonal) {
+          t = 0;
+          continue;
+        }
+        int nb = 0;
+        for (int c = 0; c < 8; c++)
+          nb += corner[(i+(c&1)) + (j+((c>>1)&1))*m + (k+((c>>2)&1))*m*m];
+        // IsPositionAllowed leaves the navigator located at the centre
+        G4bool allowed = IsPositionAllowed(centre, true, true);
+        if (gNavigator->ComputeSafety(centre) < halfDiagonal) t = 2;
+        else if (!allowed) t = 0;
+        else t = (nb == 8 ? 1 : 2);
+      }
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateSPSPosDistribution::BuildAcceptanceGrid()
+{
+  const int n = mAcceptanceGridResolution;
+  const int refinement = 4;
+  const G4double r = GetShapeBoundingRadius();
+  const G4ThreeVector origin = GetCentreCoords() - G4ThreeVector(r, r, r);
+  const G4double size = 2*r/n;
+
+  mAcceptanceGridCellOrigins.clear();
+  mAcceptanceGridCellSizes.clear();
+  mAcceptanceGridCellIsBoundary.clear();
+  std::vector<char> type, subType;
+  ClassifyAcceptanceGridCells(origin, n, size, type);
+  for (int c = 0; c < n*n*n; c++) {
+    if (type[c] == 0) continue;
+    G4ThreeVector o = origin + G4ThreeVector(c % n, (c / n) % n, c / (n*n))*size;
+    if (type[c] == 1) {
+      mAcceptanceGridCellOrigins.push_back(o);
+      mAcceptanceGridCellSizes.push_back(size);
+      mAcceptanceGridCellIsBoundary.push_back(false);
+      continue;
+    }
+    ClassifyAcceptanceGridCells(o, refinement, size/refinement, subType);
+    for (int s = 0; s < refinement*refinement*refinement; s++) {
+      if (subType[s] == 0) continue;
+      mAcceptanceGridCellOrigins.push_back(o + G4ThreeVector(s % refinement, (s / refinement) % refinement,
+                                                             s / (refinement*refinement))*size/refinement);
+      mAcceptanceGridCellSizes.push_back(size/refinement);
+      mAcceptanceGridCellIsBoundary.push_back(subType[s] == 2);
+    }
+  }
+  if (mAcceptanceGridCellOrigins.empty())
+    G4Exception("GateSPSPosDistribution::BuildAcceptanceGrid", "BuildAcceptanceGrid", FatalException,
+                "No allowed cell in the acceptance grid: the source shape does not intersect the allowed volumes (or the grid is too coarse).");
+
+  // Cells are chosen according to their volume
+  std::vector<G4double> volumes(mAcceptanceGridCellSizes.size());
+  size_t nbBoundary = 0;
+  for (size_t c = 0; c < volumes.size(); c++) {
+    volumes[c] = std::pow(mAcceptanceGridCellSizes[c], 3);
+    nbBoundary += mAcceptanceGridCellIsBoundary[c];
+  }
+  mAcceptanceGridTable.Build(volumes);
+
+  GateMessage("Beam", 1, "Acceptance grid " << n << "^3 : " << volumes.size() - nbBoundary << " inside and "
+              << nbBoundary << " boundary cells" << Gateendl);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+// Uniform point in a cell chosen according to its volume. Points of inside
+// cells are accepted directly, points of boundary cells are checked exactly
+// and drawn again (cell included) if rejected.
+G4ThreeVector GateSPSPosDistribution::GenerateOneFromAcceptanceGrid()
+{
+  UpdateAcceptanceGrid();
+
+  G4int limitShoot = 1000000;
+  for (G4int nbShoot = 0; nbShoot < limitShoot; nbShoot++) {
+    const size_t c = mAcceptanceGridTable.Sample();
+    particle_position = mAcceptanceGridCellOrigins[c] +
+      G4ThreeVector(G4UniformRand(), G4UniformRand(), G4UniformRand())*mAcceptanceGridCellSizes[c];
+    if (!mAcceptanceGridCellIsBoundary[c]) return particle_position;
+    if (IsInsideShape(particle_position) && IsPositionAllowed(particle_position, true, true)) return particle_position;
+  }
+  G4Exception("GateSPSPosDistribution::GenerateOne", "GenerateOne", FatalException,
+              "No allowed position found in the boundary cells of the acceptance grid.");
+  return particle_position;
+}
+//-----------------------------------------------------------------------------
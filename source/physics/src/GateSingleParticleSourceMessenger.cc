@@ -26,6 +26,7 @@
 #include "G4ios.hh"
 #include "G4Tokenizer.hh"
 #include "GateSPSEneDistribution.hh"
+#include "GatePositronRangeKernel.hh"
 
 #include "GateSingleParticleSourceMessenger.hh"
 #include "GateVSource.hh"
@@ -273,6 +274,12 @@ GateSingleParticleSourceMessenger::GateSingleParticleSourceMessenger
   confineCmd1->SetParameterName("VolName",true,true);
   confineCmd1->SetDefaultValue("NULL");
 
+  cmdName = GetDirectoryName() + "pos/setAcceptanceGrid";
+  acceptanceGridCmd1 = new G4UIcmdWithAnInteger(cmdName,this);
+  acceptanceGridCmd1->SetGuidance("Number of cells per axis of the grid used to sample confined/forbidden volume sources without rejection (0 to unset).");
+  acceptanceGridCmd1->SetParameterName("N",false);
+  acceptanceGridCmd1->SetRange("N>=0");
+
   cmdName = GetDirectoryName() + "pos/setImage";
   setImageCmd1 = new G4UIcmdWithAString(cmdName,this);
   setImageCmd1->SetGuidance("Biased X and Y positions according to an image (UserFluenceImage source type only)");
@@ -301,7 +308,13 @@ GateSingleParticleSourceMessenger::GateSingleParticleSourceMessenger
   positronRangeCmd->SetGuidance("Sets positron range.");
   positronRangeCmd->SetParameterName("positronrange",true,true);
   positronRangeCmd->SetDefaultValue("NULL");
-  positronRangeCmd->SetCandidates("Fluor18 Carbon11 Oxygen15");
+  positronRangeCmd->SetCandidates((GatePositronRangeKernel::GetIsotopeNames() + " NULL").c_str());
+
+  cmdName = GetDirectoryName() + "positronRangeMaterial";
+  positronRangeMaterialCmd = new G4UIcmdWithAString(cmdName,this);
+  positronRangeMaterialCmd->SetGuidance("Material of the positron range: water, local (density at the emission point) or transport (densities along the path).");
+  positronRangeMaterialCmd->SetParameterName("material",false);
+  positronRangeMaterialCmd->SetCandidates("water local transport");
 
   // old implementation
   cmdName = GetDirectoryName() + "centre";
@@ -878,6 +891,7 @@ GateSingleParticleSourceMessenger::~GateSingleParticleSourceMessenger()
   delete partheCmd1;
   delete parphiCmd1;
   delete confineCmd1;
+  delete acceptanceGridCmd1;
   delete setImageCmd1;
 
   delete angtypeCmd;
@@ -964,6 +978,7 @@ GateSingleParticleSourceMessenger::~GateSingleParticleSourceMessenger()
   delete listCmd;
 
   delete positronRangeCmd;
+  delete positronRangeMaterialCmd;
   delete setUserSpectrumCmd;
 
   //delete particleTable;
@@ -991,6 +1006,9 @@ void GateSingleParticleSourceMessenger::SetNewValue( G4UIcommand* command, G4Str
     // this command actually does no seem to have a 'modern' replacement. No other "SetPositronRange" calls anywhere.
     fParticleGun->GetPosDist()->SetPositronRange(newValues) ;
   }
+  else if (command == positronRangeMaterialCmd) {
+    fParticleGun->GetPosDist()->SetPositronRangeMaterial(newValues) ;
+  }
   else if (command == centreCmd) {
     GateWarning("The 'centre' option is DEPRECATED, use 'pos/centre' instead!");
     fParticleGun->GetPosDist()->SetCentreCoords( centreCmd->GetNew3VectorValue(newValues)) ;
@@ -1341,6 +1359,9 @@ void GateSingleParticleSourceMessenger::SetNewValue( G4UIcommand* command, G4Str
       }
     fParticleGun->GetPosDist()->ConfineSourceToVolume(newValues);
   }
+  else if(command == acceptanceGridCmd1) {
+    fParticleGun->GetPosDist()->SetAcceptanceGridResolution(acceptanceGridCmd1->GetNewIntValue(newValues));
+  }
   else if(command == setImageCmd1) {
     fParticleGun->SetUserFluenceFilename(newValues);
   }
@@ -440,6 +440,47 @@ void GateSourceMgr::Initialization()//std::vector<G4double> * time, std::vector<
 //----------------------------------------------------------------------------------------
 
 
+//----------------------------------------------------------------------------------------
+void GateSourceMgr::SaveCheckpoint(GateCheckpointWriter & w)
+{
+  w.SetPrefix("sources/");
+  w.Write("time", m_time);
+  w.Write("numberOfParticlesInTheCurrentRun", mNbOfParticleInTheCurrentRun);
+  w.Write("currentSourceNumber", m_currentSourceNumber);
+  std::ostringstream events;
+  for(std::map<G4int,G4int>::iterator it = mNumberOfEventBySource.begin(); it != mNumberOfEventBySource.end(); ++it)
+    events << it->first << " " << it->second << "\n";
+  w.WriteString("numberOfEventBySource", events.str());
+
+  for(GateVSourceVector::iterator itr = mSources.begin(); itr != mSources.end(); ++itr ) {
+    w.SetPrefix("sources/" + (*itr)->GetName() + "/");
+    (*itr)->SaveCheckpoint(w);
+  }
+}
+//----------------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------------
+void GateSourceMgr::LoadCheckpoint(GateCheckpointReader & r)
+{
+  r.SetPrefix("sources/");
+  r.Read("time", m_time);
+  r.Read("numberOfParticlesInTheCurrentRun", mNbOfParticleInTheCurrentRun);
+  r.Read("currentSourceNumber", m_currentSourceNumber);
+  mNumberOfEventBySource.clear();
+  std::istringstream events(r.ReadString("numberOfEventBySource"));
+  G4int id, n;
+  while (events >> id >> n) mNumberOfEventBySource[id] = n;
+  GateApplicationMgr::GetInstance()->SetCurrentTime(m_time);
+
+  for(GateVSourceVector::iterator itr = mSources.begin(); itr != mSources.end(); ++itr ) {
+    r.SetPrefix("sources/" + (*itr)->GetName() + "/");
+    (*itr)->LoadCheckpoint(r);
+  }
+}
+//----------------------------------------------------------------------------------------
+
+
 //----------------------------------------------------------------------------------------
 G4int GateSourceMgr::PrepareNextRun( const G4Run* r)
 {
@@ -95,6 +95,8 @@ GateSourcePhaseSpace::GateSourcePhaseSpace(G4String name) : GateVSource(name)
     mTimeIsUsed = true;
     mPDGCode = 0; // 0 is generic ion
     mPDGCodeGivenByUser = 0;
+    mCompressedFileIndex = 0;
+    mCompressedParticleIndex = 0;
 }
 // ----------------------------------------------------------------------------------
 
@@ -126,6 +128,8 @@ void GateSourcePhaseSpace::Initialize()
         InitializePyTorch();
     if (mFileType == "root")
         InitializeROOT();
+    if (mFileType == "gphsp")
+        InitializeCompressed();
 
     if (!mInitialized)
     {
@@ -156,6 +160,142 @@ void GateSourcePhaseSpace::InitializeIAEA()
 }
 // ----------------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::InitializeCompressed()
+{
+    mTotalNumberOfParticles = 0;
+    for (const auto &file : listOfPhaseSpaceFile)
+    {
+        GateMessage("Beam", 1, "Phase Space Source. Read file " << file << Gateendl);
+        mTotalNumberOfParticles += mCompressedFile.Open(file);
+    }
+    mNumberOfParticlesInFile = mTotalNumberOfParticles;
+    if (mTotalNumberOfParticles == 0)
+        GateError("Source phase space: no particle in the phase space files of source '" << GetName() << "'.");
+
+    mCompressedFileIndex = 0;
+    mCompressedFile.Open(listOfPhaseSpaceFile[0]);
+    mCompressedParticleIndex = 0;
+    mInitialized = true;
+}
+// ----------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::ReadCompressedRecord(GateCompressedPhaseSpaceRecord &r)
+{
+    // Files are used in turn; a whole pass without any particle means they are all empty
+    size_t nbOpened = 0;
+    while (!mCompressedFile.Next(r))
+    {
+        if (++nbOpened > listOfPhaseSpaceFile.size())
+            GateError("Source phase space: no particle in the phase space files of source '" << GetName() << "'.");
+        mCompressedFileIndex = (mCompressedFileIndex + 1) % listOfPhaseSpaceFile.size();
+        mCompressedFile.Open(listOfPhaseSpaceFile[mCompressedFileIndex]);
+    }
+    mCompressedParticleIndex++;
+}
+// ----------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::SeekCompressed(G4long index)
+{
+    // Files are read sequentially: only restart from the beginning if needed
+    if (index < mCompressedParticleIndex)
+    {
+        mCompressedFileIndex = 0;
+        mCompressedFile.Open(listOfPhaseSpaceFile[0]);
+        mCompressedParticleIndex = 0;
+    }
+    GateCompressedPhaseSpaceRecord r;
+    while (mCompressedParticleIndex < index)
+    {
+        ReadCompressedRecord(r);
+    }
+}
+// ----------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::SaveCheckpoint(GateCheckpointWriter &w)
+{
+    GateVSource::SaveCheckpoint(w);
+    if (mFileType == "IAEAFile" || mFileType == "pytorch")
+    {
+        static bool warned = false;
+        if (!warned)
+            GateWarning("Source phase space: " << mFileType << " sources are not restored exactly from a checkpoint." << Gateendl);
+        warned = true;
+    }
+    G4long counters[10] = {mCurrentParticleNumber, mCurrentParticleNumberInFile, mNumberOfParticlesInFile,
+                           mCurrentRunNumber, mLoop, mLoopFile, mCurrentUse, mResidu, mLastPartIndex,
+                           mCurrentUsedParticleInIAEAFiles};
+    double values[3] = {mRequestedNumberOfParticlesPerRun, mResiduRun, mAngle};
+    w.Write("counters", counters);
+    w.Write("values", values);
+
+    // The current particle is used again (with a rotation) while mCurrentUse != 0
+    const G4ThreeVector *vectors[6] = {&mParticlePosition, &mParticleMomentum,
+                                       &mParticlePositionPair1, &mParticleMomentumPair1,
+                                       &mParticlePositionPair2, &mParticleMomentumPair2};
+    double particle[24];
+    for (auto i = 0; i < 6; i++)
+        for (auto j = 0; j < 3; j++)
+            particle[3 * i + j] = (*vectors[i])[j];
+    double times[6] = {mParticleTime, weight, t1, t2, w1, w2};
+    for (auto i = 0; i < 6; i++)
+        particle[18 + i] = times[i];
+    G4int code = pParticleDefinition ? pParticleDefinition->GetPDGEncoding() : 0;
+    w.Write("particle", particle);
+    w.Write("particleCode", code);
+}
+// ----------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::LoadCheckpoint(GateCheckpointReader &r)
+{
+    GateVSource::LoadCheckpoint(r);
+    G4long counters[10];
+    double values[3];
+    r.Read("counters", counters);
+    r.Read("values", values);
+    mCurrentParticleNumber = counters[0];
+    mCurrentParticleNumberInFile = counters[1];
+    mNumberOfParticlesInFile = counters[2];
+    mCurrentRunNumber = counters[3];
+    mLoop = counters[4];
+    mLoopFile = counters[5];
+    mCurrentUse = counters[6];
+    mResidu = counters[7];
+    mLastPartIndex = counters[8];
+    mCurrentUsedParticleInIAEAFiles = counters[9];
+    mRequestedNumberOfParticlesPerRun = values[0];
+    mResiduRun = values[1];
+    mAngle = values[2];
+
+    double particle[24];
+    G4int code;
+    r.Read("particle", particle);
+    r.Read("particleCode", code);
+    G4ThreeVector *vectors[6] = {&mParticlePosition, &mParticleMomentum,
+                                 &mParticlePositionPair1, &mParticleMomentumPair1,
+                                 &mParticlePositionPair2, &mParticleMomentumPair2};
+    for (auto i = 0; i < 6; i++)
+        vectors[i]->set(particle[3 * i], particle[3 * i + 1], particle[3 * i + 2]);
+    mParticleTime = particle[18];
+    weight = particle[19];
+    t1 = particle[20];
+    t2 = particle[21];
+    w1 = particle[22];
+    w2 = particle[23];
+    pParticleDefinition = 0;
+    if (code != 0)
+    {
+        pParticleDefinition = G4ParticleTable::GetParticleTable()->FindParticle(code);
+        if (pParticleDefinition == 0)
+            pParticleDefinition = G4IonTable::GetIonTable()->GetIon(code);
+    }
+}
+// ----------------------------------------------------------------------------------
+
 // ----------------------------------------------------------------------------------
 void GateSourcePhaseSpace::InitializeROOT()
 {
@@ -734,6 +874,37 @@ void GateSourcePhaseSpace::GenerateIAEAVertex(G4Event * /*aEvent*/)
 }
 // ----------------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------------
+void GateSourcePhaseSpace::GenerateCompressedVertex(G4Event * /*aEvent*/)
+{
+    if (mCurrentParticleNumberInFile != mCompressedParticleIndex)
+        SeekCompressed(mCurrentParticleNumberInFile);
+
+    GateCompressedPhaseSpaceRecord r;
+    ReadCompressedRecord(r);
+
+    pParticleDefinition = G4ParticleTable::GetParticleTable()->FindParticle(r.PDGCode);
+    if (pParticleDefinition == 0)
+        pParticleDefinition = G4IonTable::GetIonTable()->GetIon(r.PDGCode);
+    if (pParticleDefinition == 0)
+        GateError("Source phase space: unknown PDG code " << r.PDGCode << " in phase space file.");
+
+    x = r.x;
+    y = r.y;
+    z = r.z;
+    dx = r.dx;
+    dy = r.dy;
+    dz = r.dz;
+    energy = r.energy;
+    if (!mIgnoreWeight)
+        weight = r.weight;
+    time_type = typeid(double);
+    dtime = r.time;
+
+    GenerateROOTVertexSingle();
+}
+// ----------------------------------------------------------------------------------
+
 // ----------------------------------------------------------------------------------
 G4int GateSourcePhaseSpace::GeneratePrimaries(G4Event *event)
 {
@@ -819,7 +990,10 @@ G4int GateSourcePhaseSpace::GeneratePrimaries(G4Event *event)
             {
                 mCurrentParticleNumberInFile = 0;
             }
-            GenerateROOTVertex(event);
+            if (mFileType == "gphsp")
+                GenerateCompressedVertex(event);
+            else
+                GenerateROOTVertex(event);
             mCurrentParticleNumberInFile++;
         }
         mResidu = mRequestedNumberOfParticlesPerRun - mTotalNumberOfParticles * mLoop;
@@ -979,6 +1153,8 @@ void GateSourcePhaseSpace::AddFile(G4String file)
             mFileType = "root";
         if (extension == "npy")
             mFileType = "root";
+        if (extension == "gphsp")
+            mFileType = "gphsp";
     }
 
     if ((extension == "IAEAphsp" || extension == "IAEAheader"))
@@ -993,11 +1169,14 @@ void GateSourcePhaseSpace::AddFile(G4String file)
         GateError("Please, use only one pytorch file.");
     }
 
+    if ((extension == "gphsp") != (mFileType == "gphsp"))
+        GateError("Cannot mix .gphsp phase space files with others types");
+
     if (extension != "IAEAphsp" && extension != "IAEAheader" &&
-        extension != "npy" && extension != "root" && extension != "pt")
+        extension != "npy" && extension != "root" && extension != "pt" && extension != "gphsp")
         GateError("Unknow phase space file extension. Knowns extensions are : "
                   << Gateendl
-                  << ".IAEAphsp (or IAEAheader) .root .npy .pt (pytorch) \n");
+                  << ".IAEAphsp (or IAEAheader) .root .npy .pt (pytorch) .gphsp \n");
 
     listOfPhaseSpaceFile.push_back(file);
 }
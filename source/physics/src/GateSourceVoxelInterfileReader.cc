@@ -53,6 +53,7 @@ void GateSourceVoxelInterfileReader::ReadFile(G4String headerFileName)
 
   G4cout << "GateSourceVoxelInterfileReader::ReadFile : fileName: " <<  headerFileName << Gateendl;
 
+  m_previousFrame.reset();
   ReadHeader(headerFileName);
 
   std::vector<DefaultPixelType> buffer;
@@ -92,7 +93,6 @@ void GateSourceVoxelInterfileReader::ReadFile(G4String headerFileName)
 
 void GateSourceVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4String dataFileName)
 {
-  Initialize();
   // Check if there is a GatePhantom attached
   GateRTPhantom *Ph = GateRTPhantomMgr::GetInstance()->CheckSourceAttached( m_name );
 
@@ -115,8 +115,9 @@ void GateSourceVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Strin
   // override filename from header
   m_dataFileName = dataFileName;
 
-  std::vector<DefaultPixelType> buffer;
-  ReadData(m_dataFileName, buffer);
+  GateInterfileFrameCache::FramePointer frame =
+    GateInterfileFrameCache::GetInstance()->GetFrame(*this, m_dataFileName);
+  const std::vector<DefaultPixelType> & buffer = *frame;
 
   G4double activity;
   G4double imageValue;
@@ -130,6 +131,26 @@ void GateSourceVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Strin
   dy = m_pixelSize[1];
   dz = m_planeThickness;
 
+  // The activities of the previous frame are still there (they are cleared by
+  // UpdateActivities when the translator changes): only update the changed voxels
+  if (m_previousFrame && m_previousFrame->size() == buffer.size() &&
+      m_sourceVoxelActivities.size() == buffer.size()) {
+    const std::vector<DefaultPixelType> & previous = *m_previousFrame;
+    G4int nbOfChangedVoxels = 0;
+    for (size_t i=0; i<buffer.size(); i++) {
+      if (buffer[i] == previous[i]) continue;
+      nbOfChangedVoxels++;
+      activity = m_voxelTranslator->TranslateToActivity(buffer[i]);
+      m_sourceVoxelActivities[i] = (activity > 0.) ? activity : 0.;
+    }
+    m_previousFrame = frame;
+    if (nbOfChangedVoxels > 0) PrepareIntegratedActivityMap();
+    return;
+  }
+
+  m_previousFrame = frame;
+  Initialize();
+
   SetVoxelSize( G4ThreeVector(dx, dy, dz) * mm );
   SetArraySize(G4ThreeVector(nx, ny, nz));
 
@@ -145,3 +166,13 @@ void GateSourceVoxelInterfileReader::ReadRTFile(G4String headerFileName, G4Strin
   }
   PrepareIntegratedActivityMap();
 }
+
+
+void GateSourceVoxelInterfileReader::PrefetchRTFile(G4String headerFileName, G4String dataFileName)
+{
+  if ( IsFirstFrame == true ) {
+      ReadHeader(headerFileName);
+      IsFirstFrame = false;
+  }
+  GateInterfileFrameCache::GetInstance()->Prefetch(*this, dataFileName);
+}
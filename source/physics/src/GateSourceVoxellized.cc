@@ -91,6 +91,63 @@ G4int GateSourceVoxellized::GeneratePrimaries(G4Event* event)
     G4cout << "GateSourceVoxellized::GeneratePrimaries: insert a voxel reader first\n";
     return 0;
   }
+  // the voxels of block-generated primaries are chosen in GeneratePrimaryBlock
+  if (UsePrimaryBlock()) return GateVSource::GeneratePrimaries(event);
+
+  SetVoxelPosDistribution();
+  GetPosDist()->SetCentreCoords(GetNextVoxelCentre());
+
+  // shoot the primary
+  G4int numVertices = GateVSource::GeneratePrimaries(event);
+
+  return numVertices;
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+G4int GateSourceVoxellized::GeneratePrimaryBlock(GatePrimaryBuffer & buffer, G4int n)
+{
+  if (!m_voxelReader || n <= 0) return 0;
+
+  G4RotationMatrix rotation;
+  G4ThreeVector translation;
+  GetRelativePlacementTransform(rotation, translation);
+
+  SetVoxelPosDistribution();
+  buffer.Resize(n);
+  G4bool sampleEnergy = !GeneratePrimaryBlockEnergies(buffer, n);
+  for(G4int i=0; i<n; i++) {
+    GetPosDist()->SetCentreCoords(GetNextVoxelCentre());
+    buffer.SetPosition(i, rotation*GetPosDist()->GenerateOne() + translation);
+    FillPrimaryBlockMomentum(buffer, i, rotation, sampleEnergy);
+  }
+  return n;
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+void GateSourceVoxellized::SetVoxelPosDistribution()
+{
+  G4ThreeVector voxelSize = m_voxelReader->GetVoxelSize();
+
+  // rotation of the Para shape according to the rotation of the voxel matrix
+  GetPosDist()->SetPosRot1(m_sourceRotation(G4ThreeVector(1.,0.,0.))); // x'
+  GetPosDist()->SetPosRot2(m_sourceRotation(G4ThreeVector(0.,1.,0.))); // y'
+
+  GetPosDist()->SetPosDisType("Volume");
+  GetPosDist()->SetPosDisShape("Para");
+  GetPosDist()->SetHalfX(voxelSize.x()/2.);
+  GetPosDist()->SetHalfY(voxelSize.y()/2.);
+  GetPosDist()->SetHalfZ(voxelSize.z()/2.);
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+G4ThreeVector GateSourceVoxellized::GetNextVoxelCentre()
+{
   // ask to the voxel reader to provide the active voxel for this event
   G4int nextSource = m_voxelReader->GetNextSource();
   G4ThreeVector firstSource = m_voxelReader->GetVoxelIndices(nextSource);
@@ -108,25 +165,10 @@ G4int GateSourceVoxellized::GeneratePrimaries(G4Event* event)
   // GPS position and "position rotation" (for the moment not the "direction rotation")
   G4ThreeVector centre = m_sourcePosition + m_sourceRotation(relativeVoxelOffset);
 
-  // rotation of the Para shape according to the rotation of the voxel matrix
-  GetPosDist()->SetPosRot1(m_sourceRotation(G4ThreeVector(1.,0.,0.))); // x'
-  GetPosDist()->SetPosRot2(m_sourceRotation(G4ThreeVector(0.,1.,0.))); // y'
-
   if (nVerboseLevel > 1)
     G4cout << "[GateSourceVoxellized::GeneratePrimaries] Centre: " << G4BestUnit(centre,"Length") << Gateendl;
 
-
-  GetPosDist()->SetCentreCoords(centre);
-  GetPosDist()->SetPosDisType("Volume");
-  GetPosDist()->SetPosDisShape("Para");
-  GetPosDist()->SetHalfX(voxelSize.x()/2.);
-  GetPosDist()->SetHalfY(voxelSize.y()/2.);
-  GetPosDist()->SetHalfZ(voxelSize.z()/2.);
-
-  // shoot the primary
-  G4int numVertices = GateVSource::GeneratePrimaries(event);
-
-  return numVertices;
+  return centre;
 }
 //-------------------------------------------------------------------------------------------------
 
@@ -74,6 +74,7 @@ GateVSource::GateVSource(G4String name): m_name( name ) {
   mEnableRegularActivity = false;
 
   mSourceTime = 0.*s;
+  mPrimaryBlockSize = 0;
 
   mIsUserFluenceActive = false;
   mUserFluenceFilename = "";
@@ -646,6 +647,8 @@ G4int GateVSource::GeneratePrimaries( G4Event* event )
 void GateVSource::Update(double t)
 {
   m_time = t;
+  // Pre-sampled primaries may refer to the previous geometry or distributions
+  mPrimaryBuffer.Clear();
   if( nVerboseLevel > 0 )
     G4cout << "[GateVSource::Update] Source name: " << m_name << Gateendl;
   // called by the sourceMgr at the beginning of the run.
@@ -676,6 +679,8 @@ void GateVSource::GeneratePrimaryVertex( G4Event* aEvent )
 
   /* PY Descourt 08/09/2009 */
   TrackingMode theMode =( (GateSteppingAction *)(GateRunManager::GetRunManager()->GetUserSteppingAction() ) )->GetMode();
+  if ( UsePrimaryBlock() && GeneratePrimaryVertexFromBlock(aEvent) ) return;
+
   if (  theMode == TrackingMode::kBoth || theMode == TrackingMode::kTracker )
     {
       G4ThreeVector particle_position;
@@ -773,6 +778,169 @@ G4String nameMaterial = material->GetName();*/
 //-------------------------------------------------------------------------------------------------
 
 
+//-------------------------------------------------------------------------------------------------
+G4bool GateVSource::UsePrimaryBlock()
+{
+  if (mPrimaryBlockSize <= 0) return false;
+  // Only plain gps sources with one particle per vertex, in standard/tracker
+  // mode, and without per-event verbose
+  if (GetNumberOfParticles() != 1 || nVerboseLevel > 1) return false;
+  if ((GetType() != G4String("")) && (GetType() != G4String("gps"))) return false;
+  TrackingMode theMode =( (GateSteppingAction *)(GateRunManager::GetRunManager()->GetUserSteppingAction() ) )->GetMode();
+  return (theMode == TrackingMode::kBoth || theMode == TrackingMode::kTracker);
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+G4int GateVSource::GeneratePrimaryBlock(GatePrimaryBuffer & buffer, G4int n)
+{
+  if (n <= 0) return 0;
+  if( GetPosDist()->GetPosDisType() == "UserFluenceImage" ) InitializeUserFluence();
+  if( mUserFocalShapeInitialisation ) InitializeUserFocalShape();
+
+  // The transform to the world is computed once for the whole block
+  G4RotationMatrix rotation;
+  G4ThreeVector translation;
+  GetRelativePlacementTransform(rotation, translation);
+
+  buffer.Resize(n);
+  G4bool sampleEnergy = !GeneratePrimaryBlockEnergies(buffer, n);
+  for(G4int i=0; i<n; i++) {
+    G4ThreeVector position;
+    if(mIsUserFluenceActive) { position = UserFluencePosGenerateOne(); }
+    else { position = m_posSPS->GenerateOne(); }
+    buffer.SetPosition(i, rotation*position + translation);
+    FillPrimaryBlockMomentum(buffer, i, rotation, sampleEnergy);
+  }
+  return n;
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+G4bool GateVSource::GeneratePrimaryBlockEnergies(GatePrimaryBuffer & buffer, G4int n)
+{
+  // The alias table of a user spectrum draws the bins of the block in one pass
+  if (m_eneSPS->GetEnergyDisType() != "UserSpectrum") return false;
+  m_eneSPS->GenerateFromUserSpectrum(n, buffer.mEnergy);
+  return true;
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+void GateVSource::FillPrimaryBlockMomentum(GatePrimaryBuffer & buffer, size_t i,
+                                           const G4RotationMatrix & rotation,
+                                           G4bool sampleEnergy)
+{
+  // Same sampling order as GeneratePrimaryVertex: direction, energy, bias weight
+  G4ParticleMomentum direction;
+  if(mIsUserFocalShapeActive) { direction = UserFocalShapeGenerateOne(); }
+  else { direction = m_angSPS->GenerateOne(); }
+  buffer.SetDirection(i, rotation*direction);
+  if (sampleEnergy) buffer.mEnergy[i] = m_eneSPS->GenerateOne( GetParticleDefinition() );
+  buffer.mWeight[i] = GetBiasRndm()->GetBiasWeight();
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+G4bool GateVSource::GeneratePrimaryVertexFromBlock(G4Event* aEvent)
+{
+  if (mPrimaryBuffer.IsEmpty()) {
+    if (GeneratePrimaryBlock(mPrimaryBuffer, mPrimaryBlockSize) <= 0) {
+      mPrimaryBuffer.Clear();
+      return false;
+    }
+  }
+  size_t i = mPrimaryBuffer.Next();
+
+  G4ParticleDefinition * pd = GetParticleDefinition();
+  G4double mass = pd->GetPDGMass();
+  mEnergy = mPrimaryBuffer.mEnergy[i];
+  G4double energy = mEnergy + mass;
+  G4double pmom = std::sqrt( energy * energy - mass * mass );
+
+  G4PrimaryVertex* vertex = new G4PrimaryVertex(mPrimaryBuffer.GetPosition(i), GetParticleTime());
+  G4PrimaryParticle* particle = new G4PrimaryParticle(pd,
+                                                      pmom * mPrimaryBuffer.mDirectionX[i],
+                                                      pmom * mPrimaryBuffer.mDirectionY[i],
+                                                      pmom * mPrimaryBuffer.mDirectionZ[i]);
+  particle->SetMass( mass );
+  particle->SetCharge( pd->GetPDGCharge() );
+  particle->SetPolarization( GetParticlePolarization().x(),
+                             GetParticlePolarization().y(),
+                             GetParticlePolarization().z() );
+  particle->SetWeight( mPrimaryBuffer.mWeight[i] );
+  vertex->SetPrimary( particle );
+  aEvent->AddPrimaryVertex( vertex );
+  return true;
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+void GateVSource::SaveCheckpoint(GateCheckpointWriter & w)
+{
+  // Pre-sampled primaries not used yet (block generation)
+  size_t n = mPrimaryBuffer.GetSize();
+  size_t current = mPrimaryBuffer.GetCurrent();
+  w.Write("primaryBuffer/size", n);
+  w.Write("primaryBuffer/current", current);
+  w.WriteArray("primaryBuffer/x", mPrimaryBuffer.mPositionX.data(), n);
+  w.WriteArray("primaryBuffer/y", mPrimaryBuffer.mPositionY.data(), n);
+  w.WriteArray("primaryBuffer/z", mPrimaryBuffer.mPositionZ.data(), n);
+  w.WriteArray("primaryBuffer/dx", mPrimaryBuffer.mDirectionX.data(), n);
+  w.WriteArray("primaryBuffer/dy", mPrimaryBuffer.mDirectionY.data(), n);
+  w.WriteArray("primaryBuffer/dz", mPrimaryBuffer.mDirectionZ.data(), n);
+  w.WriteArray("primaryBuffer/energy", mPrimaryBuffer.mEnergy.data(), n);
+  w.WriteArray("primaryBuffer/weight", mPrimaryBuffer.mWeight.data(), n);
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+void GateVSource::LoadCheckpoint(GateCheckpointReader & r)
+{
+  size_t n, current;
+  r.Read("primaryBuffer/size", n);
+  r.Read("primaryBuffer/current", current);
+  mPrimaryBuffer.Resize(n);
+  r.ReadArray("primaryBuffer/x", mPrimaryBuffer.mPositionX.data(), n);
+  r.ReadArray("primaryBuffer/y", mPrimaryBuffer.mPositionY.data(), n);
+  r.ReadArray("primaryBuffer/z", mPrimaryBuffer.mPositionZ.data(), n);
+  r.ReadArray("primaryBuffer/dx", mPrimaryBuffer.mDirectionX.data(), n);
+  r.ReadArray("primaryBuffer/dy", mPrimaryBuffer.mDirectionY.data(), n);
+  r.ReadArray("primaryBuffer/dz", mPrimaryBuffer.mDirectionZ.data(), n);
+  r.ReadArray("primaryBuffer/energy", mPrimaryBuffer.mEnergy.data(), n);
+  r.ReadArray("primaryBuffer/weight", mPrimaryBuffer.mWeight.data(), n);
+  mPrimaryBuffer.SetCurrent(current);
+}
+//-------------------------------------------------------------------------------------------------
+
+
+//-------------------------------------------------------------------------------------------------
+void GateVSource::GetRelativePlacementTransform(G4RotationMatrix & rotation, G4ThreeVector & translation)
+{
+  rotation = G4RotationMatrix();
+  translation = G4ThreeVector();
+  if (mRelativePlacementVolumeName == "world") return;
+
+  // Same composition as ChangeParticlePositionRelativeToAttachedVolume:
+  // p -> r*p + t for each volume up to the world
+  GateVVolume * v = mVolume;
+  while (v->GetObjectName() != "world") {
+    G4RotationMatrix r = v->GetPhysicalVolume(0)->GetObjectRotationValue();
+    const G4ThreeVector & t = v->GetPhysicalVolume(0)->GetObjectTranslation();
+    rotation = r*rotation;
+    translation = r*translation + t;
+    v = v->GetParentVolume();
+  }
+}
+//-------------------------------------------------------------------------------------------------
+
+
 //-------------------------------------------------------------------------------------------------
 void GateVSource::ChangeParticlePositionRelativeToAttachedVolume(G4ThreeVector & position) {
   // Do nothing if attached to world
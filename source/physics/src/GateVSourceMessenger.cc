@@ -145,6 +145,12 @@ GateVSourceMessenger::GateVSourceMessenger(GateVSource* source)
   cmdName = GetDirectoryName()+"setEnergyRange";
   setEnergyRangecmd = new G4UIcmdWithADoubleAndUnit(cmdName,this);
 
+  cmdName = GetDirectoryName()+"setPrimaryBlockSize";
+  PrimaryBlockSizeCmd = new G4UIcmdWithAnInteger(cmdName,this);
+  PrimaryBlockSizeCmd->SetGuidance("Sample the primaries by blocks of N (gps sources with one particle per vertex). 0 (default) samples one primary per event.");
+  PrimaryBlockSizeCmd->SetParameterName("N",false);
+  PrimaryBlockSizeCmd->SetRange("N>=0");
+
   cmdName = GetDirectoryName()+"visualize";
   VisualizeCmd = new G4UIcmdWithAString(cmdName,this);
   VisualizeCmd->SetGuidance("Visualize the source in the geometry");
@@ -178,6 +184,7 @@ GateVSourceMessenger::~GateVSourceMessenger()
   delete setEnergyRangecmd;
   //    delete GateSourceDir;
   delete VisualizeCmd;
+  delete PrimaryBlockSizeCmd;
 }
 //----------------------------------------------------------------------------------------
 
@@ -236,6 +243,8 @@ void GateVSourceMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
   }
   else if(command == setEnergyRangecmd) {
     m_source->GetEneDist()->SetEnergyRange(setEnergyRangecmd->GetNewDoubleValue(newValue));
+  } else if(command == PrimaryBlockSizeCmd) {
+    m_source->SetPrimaryBlockSize(PrimaryBlockSizeCmd->GetNewIntValue(newValue));
   }
 }
 //----------------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateWeightWindowMessenger.hh"
+#include "GateVProcess.hh"
+
+//-----------------------------------------------------------------------------
+GateWeightWindowMessenger::GateWeightWindowMessenger(GateVProcess *pb):GateVProcessMessenger(pb)
+{
+  BuildCommands("processes/" + pb->GetG4ProcessName());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+GateWeightWindowMessenger::~GateWeightWindowMessenger()
+{
+  delete pSetImportanceMapCmd;
+  delete pSetImportanceFromFluenceCmd;
+  delete pSaveImportanceMapCmd;
+  delete pSetMaximumImportanceCmd;
+  delete pSetWindowRatioCmd;
+  delete pSetMaximumSplittingCmd;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateWeightWindowMessenger::BuildCommands(G4String base)
+{
+  G4String bb = mPrefix+base+"/setImportanceMap";
+  pSetImportanceMapCmd = new G4UIcmdWithAString(bb,this);
+  pSetImportanceMapCmd->SetGuidance("Image of the importance, positioned in the world by its origin (0 kills the particles).");
+  pSetImportanceMapCmd->SetParameterName("Filename", false);
+
+  bb = mPrefix+base+"/setImportanceFromFluence";
+  pSetImportanceFromFluenceCmd = new G4UIcmdWithAString(bb,this);
+  pSetImportanceFromFluenceCmd->SetGuidance("Generate the importance map from the fluence image of a forward run: max(fluence)/fluence.");
+  pSetImportanceFromFluenceCmd->SetParameterName("Filename", false);
+
+  bb = mPrefix+base+"/saveImportanceMap";
+  pSaveImportanceMapCmd = new G4UIcmdWithAString(bb,this);
+  pSaveImportanceMapCmd->SetGuidance("Write the importance map used by the simulation.");
+  pSaveImportanceMapCmd->SetParameterName("Filename", false);
+
+  bb = mPrefix+base+"/setMaximumImportance";
+  pSetMaximumImportanceCmd = new G4UIcmdWithADouble(bb,this);
+  pSetMaximumImportanceCmd->SetGuidance("Upper bound of the importance generated from a fluence image (default 1e4).");
+  pSetMaximumImportanceCmd->SetParameterName("Importance", false);
+  pSetMaximumImportanceCmd->SetRange("Importance>=1");
+
+  bb = mPrefix+base+"/setWindowRatio";
+  pSetWindowRatioCmd = new G4UIcmdWithADouble(bb,this);
+  pSetWindowRatioCmd->SetGuidance("Ratio between the upper and lower bounds of the weight windows (default 5).");
+  pSetWindowRatioCmd->SetParameterName("Ratio", false);
+  pSetWindowRatioCmd->SetRange("Ratio>1");
+
+  bb = mPrefix+base+"/setMaximumSplitting";
+  pSetMaximumSplittingCmd = new G4UIcmdWithAnInteger(bb,this);
+  pSetMaximumSplittingCmd->SetGuidance("Maximum number of copies of a track split at once (default 100).");
+  pSetMaximumSplittingCmd->SetParameterName("Number", false);
+  pSetMaximumSplittingCmd->SetRange("Number>=2");
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateWeightWindowMessenger::SetNewValue(G4UIcommand* command, G4String param)
+{
+  if (command == pSetImportanceMapCmd) mImportanceMap.SetImportanceFilename(param);
+  if (command == pSetImportanceFromFluenceCmd) mImportanceMap.SetFluenceFilename(param);
+  if (command == pSaveImportanceMapCmd) mImportanceMap.SetOutputFilename(param);
+  if (command == pSetMaximumImportanceCmd) mImportanceMap.SetMaximumImportance(pSetMaximumImportanceCmd->GetNewDoubleValue(param));
+  if (command == pSetWindowRatioCmd) mImportanceMap.SetWindowRatio(pSetWindowRatioCmd->GetNewDoubleValue(param));
+  if (command == pSetMaximumSplittingCmd) mImportanceMap.SetMaximumSplitting(pSetMaximumSplittingCmd->GetNewIntValue(param));
+}
+//-----------------------------------------------------------------------------
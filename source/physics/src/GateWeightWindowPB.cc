@@ -0,0 +1,51 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include "GateWeightWindowPB.hh"
+#include "GateWeightWindowProcess.hh"
+#include "GateWeightWindowMessenger.hh"
+
+//-----------------------------------------------------------------------------
+GateWeightWindowPB::GateWeightWindowPB():GateVProcess("WeightWindow")
+{
+  SetDefaultParticle("gamma");
+  SetDefaultParticle("neutron");
+  SetProcessInfo("Splitting and Russian roulette with the weight windows of an importance map");
+  pMessenger = new GateWeightWindowMessenger(this);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4VProcess* GateWeightWindowPB::CreateProcess(G4ParticleDefinition *)
+{
+  GateWeightWindowMessenger* messenger = static_cast<GateWeightWindowMessenger*>(pMessenger);
+  return new GateWeightWindowProcess(GetG4ProcessName(), messenger->GetImportanceMap());
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateWeightWindowPB::ConstructProcess(G4ProcessManager * manager)
+{
+  manager->AddDiscreteProcess(GetProcess());
+  // After the physics process of the step: splitting before the interaction would
+  // copy the state before the collision and give its secondaries the split weight
+  manager->SetProcessOrderingToLast(GetProcess(), idxPostStep);
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+bool GateWeightWindowPB::IsApplicable(G4ParticleDefinition * par)
+{
+  return !par->IsShortLived();
+}
+//-----------------------------------------------------------------------------
+
+MAKE_PROCESS_AUTO_CREATOR_CC(GateWeightWindowPB)
@@ -0,0 +1,119 @@
+/*----------------------
+  Copyright (C): OpenGATE Collaboration
+
+  This software is distributed under the terms
+  of the GNU Lesser General  Public Licence (LGPL)
+  See LICENSE.md for further details
+  ----------------------*/
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "Randomize.hh"
+
+#include "GateWeightWindowProcess.hh"
+#include "GateImportanceMap.hh"
+
+//-----------------------------------------------------------------------------
+GateWeightWindowProcess::GateWeightWindowProcess(const G4String & name, GateImportanceMap * map):
+  G4VDiscreteProcess(name, fGeneral)
+{
+  pImportanceMap = map;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateWeightWindowProcess::BuildPhysicsTable(const G4ParticleDefinition &)
+{
+  pImportanceMap->Initialize();
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateWeightWindowProcess::PostStepGetPhysicalInteractionLength(const G4Track &, G4double,
+                                                                       G4ForceCondition * condition)
+{
+  *condition = StronglyForced;
+  return DBL_MAX;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4double GateWeightWindowProcess::GetMeanFreePath(const G4Track &, G4double, G4ForceCondition * condition)
+{
+  *condition = StronglyForced;
+  return DBL_MAX;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+G4VParticleChange * GateWeightWindowProcess::PostStepDoIt(const G4Track & track, const G4Step &)
+{
+  aParticleChange.Initialize(track);
+
+  // Killed or stopped by the physics of the step, or out of the map
+  if (track.GetTrackStatus() != fAlive) return &aParticleChange;
+  const G4double importance = pImportanceMap->GetImportance(track.GetPosition());
+  if (importance < 0) return &aParticleChange;
+
+  // Null importance: the particle cannot contribute
+  if (importance == 0) {
+    aParticleChange.ProposeTrackStatus(fStopAndKill);
+    return &aParticleChange;
+  }
+
+  G4double lower, survival, upper;
+  pImportanceMap->GetWeightWindow(importance, lower, survival, upper);
+  const G4double weight = track.GetWeight();
+  // The random number is only drawn for the roulette
+  const G4double u = (weight < lower) ? G4UniformRand() : 0.;
+  G4int n;
+  G4double w;
+  ApplyWindow(weight, lower, survival, upper, pImportanceMap->GetMaximumSplitting(), u, n, w);
+
+  if (n == 0) {
+    aParticleChange.ProposeTrackStatus(fStopAndKill);
+    return &aParticleChange;
+  }
+  if (w != weight) aParticleChange.ProposeWeight(w);
+  if (n > 1) {
+    aParticleChange.SetSecondaryWeightByProcess(true);
+    aParticleChange.SetNumberOfSecondaries(n-1);
+    for (G4int i = 1; i < n; i++) {
+      G4Track * copy = new G4Track(new G4DynamicParticle(*track.GetDynamicParticle()),
+                                   track.GetGlobalTime(), track.GetPosition());
+      copy->SetWeight(w);
+      copy->SetTouchableHandle(track.GetTouchableHandle());
+      aParticleChange.AddSecondary(copy);
+    }
+  }
+  return &aParticleChange;
+}
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+void GateWeightWindowProcess::ApplyWindow(G4double weight, G4double lower, G4double survival, G4double upper,
+                                          G4int maximumSplitting, G4double u, G4int & n, G4double & w)
+{
+  n = 1;
+  w = weight;
+  if (weight > upper) {
+    const G4int copies = std::min((G4int)std::ceil(weight/survival), maximumSplitting);
+    if (copies < 2) return;
+    n = copies;
+    w = weight/n;
+  }
+  else if (weight < lower) {
+    if (u*survival < weight) w = survival;
+    else n = 0;
+  }
+}
+//-----------------------------------------------------------------------------